@@ -0,0 +1,126 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "client.h"
+#include "compression.h"
+#include "configoptions.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Report the compression ratio and put/unpack throughput of a smooth
+// double precision field for each codec, compression level and error bound
+int main(int argc, char* argv[]) {
+
+    // A smooth 3D field, similar to a simulation state variable
+    std::vector<size_t> dims = {64, 128, 128};
+    size_t n_values = dims[0] * dims[1] * dims[2];
+    std::vector<double> field(n_values);
+    for (size_t i = 0, c = 0; i < dims[0]; i++)
+        for (size_t j = 0; j < dims[1]; j++)
+            for (size_t k = 0; k < dims[2]; k++, c++)
+                field[c] = std::sin(0.05 * i) * std::cos(0.03 * j) +
+                           0.25 * std::sin(0.07 * k + 0.01 * i * j);
+    double n_megabytes = n_values * sizeof(double) / 1.0e6;
+
+    struct Setting {
+        std::string codec;
+        int level;
+        double error_bound;
+    };
+    std::vector<Setting> settings = {
+        {"none", 1, 0.0}, {"shuffle-lz", 1, 0.0}, {"shuffle-lz", 5, 0.0},
+        {"shuffle-lz", 9, 0.0}, {"quantize", 1, 1.0e-6},
+        {"quantize", 1, 1.0e-4}, {"quantize", 1, 1.0e-2}
+    };
+
+    std::cout << std::left << std::setw(12) << "codec"
+              << std::setw(7) << "level" << std::setw(8) << "bound"
+              << std::setw(8) << "ratio"
+              << std::setw(12) << "put MB/s" << "unpack MB/s" << std::endl;
+
+    const int n_reps = 5;
+    std::vector<double> result(n_values);
+    for (const Setting& setting : settings) {
+        // The codec is selected per client through its ConfigOptions
+        auto cfgopts = SmartRedis::ConfigOptions::create_from_environment("");
+        cfgopts->override_string_option("SR_COMPRESSION", setting.codec);
+        cfgopts->override_integer_option("SR_COMPRESSION_LEVEL", setting.level);
+        cfgopts->override_string_option("SR_COMPRESSION_ERROR_BOUND",
+                                        std::to_string(setting.error_bound));
+        SmartRedis::Client client(cfgopts.get(), __FILE__);
+
+        std::string key = "compression_field_" + setting.codec;
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < n_reps; rep++) {
+            client.put_tensor(key, field.data(), dims,
+                              SRTensorTypeDouble, SRMemLayoutContiguous);
+        }
+        auto put_done = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < n_reps; rep++) {
+            client.unpack_tensor(key, result.data(), {n_values},
+                                 SRTensorTypeDouble, SRMemLayoutContiguous);
+        }
+        auto unpack_done = std::chrono::steady_clock::now();
+        client.delete_tensor(key);
+
+        for (size_t i = 0; i < n_values; i++) {
+            if (std::fabs(result[i] - field[i]) > setting.error_bound) {
+                std::cerr << "The field did not survive the round trip "
+                          << "with the " << setting.codec << " codec"
+                          << std::endl;
+                return 1;
+            }
+        }
+
+        // The stored size is the size of the compression container
+        std::string_view raw((const char*)field.data(),
+                             n_values * sizeof(double));
+        std::string stored = SmartRedis::compress_buffer(
+            raw, sizeof(double), SRTensorTypeDouble, dims,
+            SmartRedis::compression_codec_from_string(setting.codec),
+            setting.level, setting.error_bound);
+
+        std::chrono::duration<double> put_time = put_done - start;
+        std::chrono::duration<double> unpack_time = unpack_done - put_done;
+        std::cout << std::left << std::setw(12) << setting.codec
+                  << std::setw(7) << setting.level << std::defaultfloat
+                  << std::setprecision(2) << std::setw(8)
+                  << setting.error_bound << std::fixed
+                  << std::setprecision(2) << std::setw(8)
+                  << raw.size() / (double)stored.size()
+                  << std::setprecision(1) << std::setw(12)
+                  << n_reps * n_megabytes / put_time.count()
+                  << n_reps * n_megabytes / unpack_time.count() << std::endl;
+    }
+
+    return 0;
+}
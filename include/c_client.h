@@ -138,6 +138,45 @@ SRError get_dataset(void* c_client,
                     const size_t name_length,
                     void** dataset);
 
+/*!
+*   \brief Put multiple DataSet objects into the database
+*   \details The commands for all DataSets are sent in one pipeline
+*            per database shard. The final dataset keys under which the
+*            datasets are stored are generated from the names that were
+*            supplied when the datasets were created and may be
+*            prefixed. See use_dataset_ensemble_prefix() for more
+*            details.
+*   \param c_client The client object to use for communication
+*   \param datasets The DataSet objects to send
+*   \param n_datasets The number of DataSet objects in datasets
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_datasets(void* c_client,
+                     void** datasets,
+                     const size_t n_datasets);
+
+/*!
+*   \brief Get multiple DataSet objects from the database
+*   \details The final dataset keys used to locate the datasets
+*            may be formed by applying a prefix to the supplied
+*            names. See set_data_source() and
+*            use_dataset_ensemble_prefix() for more details.
+*   \param c_client The client object to use for communication
+*   \param names The names of the dataset objects to fetch
+*   \param name_lengths The lengths of the name strings,
+*                       excluding null terminating characters
+*   \param n_names The number of names
+*   \param datasets An array of n_names entries allocated by the
+*                   caller that receives the DataSets, in the order
+*                   of names
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError get_datasets(void* c_client,
+                     const char** names,
+                     const size_t* name_lengths,
+                     const size_t n_names,
+                     void** datasets);
+
 /*!
 *   \brief Move a DataSet to a new name
 *   \details The old and new dataset keys used to
@@ -224,6 +263,205 @@ SRError put_tensor(void* c_client,
                    SRTensorType type,
                    SRMemoryLayout mem_layout);
 
+/*!
+*   \brief Put a tensor into the database, converting its values
+*          to another tensor type
+*   \details The values are converted while they are copied into the
+*            outgoing tensor.  Floating point values converted to
+*            integer types are rounded using the rounding mode of the
+*            current floating point environment (see fesetround()),
+*            and values outside the range of the integer type are
+*            rejected.  The key under which the tensor is stored
+*            may be formed by applying a prefix to the supplied
+*            name. See use_tensor_ensemble_prefix()
+*            for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the tensor name string,
+*                      excluding null terminating character
+*   \param data The data to store with the tensor
+*   \param dims The number of elements for each dimension of the tensor
+*   \param n_dims The number of dimensions of the tensor
+*   \param type The data type of the provided data
+*   \param store_type The data type with which the tensor is stored
+*   \param mem_layout The memory layout of the data
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_tensor_as(void* c_client,
+                      const char* name,
+                      const size_t name_length,
+                      void* data,
+                      const size_t* dims,
+                      const size_t n_dims,
+                      SRTensorType type,
+                      SRTensorType store_type,
+                      SRMemoryLayout mem_layout);
+
+/*!
+*   \brief Put a tensor into the database as a delta against the
+*          values this client last put under the same name
+*   \details Only the bytewise XOR with the previously sent values is
+*            sent, compressed, except for a full keyframe every
+*            SR_DELTA_KEYFRAME_INTERVAL puts and whenever the tensor
+*            type or dimensions change.  Readers reconstruct the
+*            current values transparently.  Only one client should put
+*            deltas under a given name.  The key under which the tensor
+*            is stored may be formed by applying a prefix to the
+*            supplied name. See use_tensor_ensemble_prefix()
+*            for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the tensor name string,
+*                      excluding null terminating character
+*   \param data The data to store with the tensor
+*   \param dims The number of elements for each dimension of the tensor
+*   \param n_dims The number of dimensions of the tensor
+*   \param type The data type of the tensor
+*   \param mem_layout The memory layout of the data
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_tensor_delta(void* c_client,
+                         const char* name,
+                         const size_t name_length,
+                         void* data,
+                         const size_t* dims,
+                         const size_t n_dims,
+                         SRTensorType type,
+                         SRMemoryLayout mem_layout);
+
+/*!
+*   \brief Put a tensor into the database split into N-dimensional
+*          tiles, so that sub-regions of it can be read without
+*          fetching the whole tensor
+*   \details Each tile is stored under its own key, followed by a
+*            manifest under the tensor key.  Tiles at the upper edge of
+*            a dimension that does not divide into whole tiles are
+*            smaller.  The key under which the tensor is stored may be
+*            formed by applying a prefix to the supplied name. See
+*            use_tensor_ensemble_prefix() for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the tensor name string,
+*                      excluding null terminating character
+*   \param data The data to store with the tensor
+*   \param dims The number of elements for each dimension of the tensor
+*   \param tile_dims The number of elements for each dimension of a tile
+*   \param n_dims The number of dimensions of the tensor
+*   \param type The data type of the tensor
+*   \param mem_layout The memory layout of the data
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_tensor_tiled(void* c_client,
+                         const char* name,
+                         const size_t name_length,
+                         void* data,
+                         const size_t* dims,
+                         const size_t* tile_dims,
+                         const size_t n_dims,
+                         SRTensorType type,
+                         SRMemoryLayout mem_layout);
+
+/*!
+*   \brief Put a tensor into the database from a file, without reading
+*          the file into memory first
+*   \details The file is mapped into memory and its pages are sent
+*            without an intermediate copy.  If n_dims is zero, the file
+*            must be a .npy file, whose header gives the tensor type
+*            and dimensions.  Otherwise the file holds raw row major
+*            values of the given type and dimensions, starting offset
+*            bytes into the file.  The key under which the tensor is
+*            stored may be formed by applying a prefix to the supplied
+*            name. See use_tensor_ensemble_prefix() for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the tensor name string,
+*                      excluding null terminating character
+*   \param path The path of the file
+*   \param path_length The length of the path string,
+*                      excluding null terminating character
+*   \param dims The number of elements for each dimension of the tensor
+*               in a raw file
+*   \param n_dims The number of dimensions of the tensor in a raw file,
+*                 or zero for a .npy file
+*   \param type The data type of the tensor in a raw file
+*   \param offset The position of the first value in a raw file
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_tensor_from_file(void* c_client,
+                             const char* name,
+                             const size_t name_length,
+                             const char* path,
+                             const size_t path_length,
+                             const size_t* dims,
+                             const size_t n_dims,
+                             SRTensorType type,
+                             const size_t offset);
+
+/*!
+*   \brief Append a record to a tensor that grows along its leading
+*          dimension, such as a time series
+*   \details Only the new record is sent.  The tensor has the number
+*            of records as its leading dimension followed by the
+*            dimensions of a record, and all records must have the same
+*            type and dimensions.  The key under which the tensor is
+*            stored may be formed by applying a prefix to the supplied
+*            name. See use_tensor_ensemble_prefix() for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the tensor name string,
+*                      excluding null terminating character
+*   \param data The data of the record
+*   \param dims The number of elements for each dimension of the record
+*   \param n_dims The number of dimensions of the record
+*   \param type The data type of the record
+*   \param mem_layout The memory layout of the data
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError append_to_tensor(void* c_client,
+                         const char* name,
+                         const size_t name_length,
+                         void* data,
+                         const size_t* dims,
+                         const size_t n_dims,
+                         SRTensorType type,
+                         SRMemoryLayout mem_layout);
+
+/*!
+*   \brief Put a tensor into the database, gathering its values
+*          from strided memory
+*   \details The value at position (i_0, ..., i_n) of the tensor is
+*            read from element offset + i_0*strides[0] + ... +
+*            i_n*strides[n] of data, so an interior sub-block of a
+*            larger array can be sent without a packing copy.
+*            Strides and offset are given in elements, not bytes.
+*            The key under which the tensor is stored
+*            may be formed by applying a prefix to the supplied
+*            name. See use_tensor_ensemble_prefix()
+*            for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the tensor name string,
+*                      excluding null terminating character
+*   \param data The base of the memory holding the tensor data
+*   \param dims The number of elements for each dimension of the tensor
+*   \param strides The distance, in elements, between consecutive
+*                  entries along each dimension of the tensor
+*   \param n_dims The number of dimensions of the tensor
+*   \param offset The position, in elements, of the first tensor
+*                 entry relative to data
+*   \param type The data type of the tensor
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_tensor_strided(void* c_client,
+                           const char* name,
+                           const size_t name_length,
+                           void* data,
+                           const size_t* dims,
+                           const size_t* strides,
+                           const size_t n_dims,
+                           const size_t offset,
+                           SRTensorType type);
+
 /*!
 *   \brief Get the data, dimensions, and type for a tensor in the
 *          database. This function will allocate and retain management of the
@@ -265,6 +503,46 @@ SRError get_tensor(void* c_client,
                    size_t* n_dims,
                    SRTensorType* type,
                    SRMemoryLayout mem_layout);
+
+/*!
+*   \brief Get a window of the records of a tensor put with
+*          append_to_tensor(). This function will allocate and retain
+*          management of the memory for the tensor data.
+*   \details The records from start up to but not including stop are
+*            joined into a tensor whose leading dimension is the number
+*            of records.  A window extending past the last record is
+*            shortened to the records that exist.  The final tensor key
+*            used to retrieve the tensor may be formed by applying a
+*            prefix to the supplied name. See set_data_source()
+*            and use_tensor_ensemble_prefix() for more details.
+*
+*            As for get_tensor(), the memory returned in data is valid
+*            until the client is destroyed.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the supplied name string,
+*                      excluding null terminating character
+*   \param start The index of the first record
+*   \param stop The index one past the last record
+*   \param data Receives tensor data in newly allocated memory
+*   \param dims Receives the number of elements in each dimension of the
+*               tensor in newly allocated memory
+*   \param n_dims Receives the number of dimensions for the tensor
+*   \param type Receives the data type for the tensor as retrieved from
+*               the database
+*   \param mem_layout The layout requested for the allocated memory space
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError get_tensor_range(void* c_client,
+                         const char* name,
+                         const size_t name_length,
+                         const size_t start,
+                         const size_t stop,
+                         void** data,
+                         size_t** dims,
+                         size_t* n_dims,
+                         SRTensorType* type,
+                         SRMemoryLayout mem_layout);
 /*!
 *   \brief Retrieve a tensor from the database into memory provided
 *          by the caller
@@ -294,6 +572,130 @@ SRError unpack_tensor(void* c_client,
                      SRTensorType type,
                      SRMemoryLayout mem_layout);
 
+/*!
+*   \brief Retrieve a tensor from the database into memory provided
+*          by the caller, converting its values to the data type of
+*          that memory
+*   \details The tensor may be stored with any data type; its values
+*            are converted with the same rules as put_tensor_as().
+*            The final tensor key used to retrieve the tensor
+*            may be formed by applying a prefix to the supplied
+*            name. See set_data_source()
+*            and use_tensor_ensemble_prefix() for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the supplied name string,
+*                      excluding null terminating character
+*   \param result The data buffer into which the tensor data should
+*                 be written
+*   \param dims The number of elements in each dimension of the
+*               provided memory space
+*   \param n_dims The number of dimensions in the provided memory space
+*   \param type The data type for the provided memory space.
+*   \param mem_layout The memory layout for the provided memory space.
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError unpack_tensor_as(void* c_client,
+                         const char* name,
+                         const size_t name_length,
+                         void* result,
+                         const size_t* dims,
+                         const size_t n_dims,
+                         SRTensorType type,
+                         SRMemoryLayout mem_layout);
+
+/*!
+*   \brief Retrieve a tensor from the database into strided memory
+*          provided by the caller
+*   \details The value at position (i_0, ..., i_n) of the tensor is
+*            written to element offset + i_0*strides[0] + ... +
+*            i_n*strides[n] of result; all other elements are left
+*            untouched.  Strides and offset are given in elements,
+*            not bytes.  The final tensor key used to retrieve the
+*            tensor may be formed by applying a prefix to the supplied
+*            name. See set_data_source()
+*            and use_tensor_ensemble_prefix() for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the supplied name string,
+*                      excluding null terminating character
+*   \param result The base of the memory receiving the tensor data
+*   \param dims The number of elements in each dimension of the tensor
+*   \param strides The distance, in elements, between consecutive
+*                  entries along each dimension of the tensor
+*   \param n_dims The number of dimensions of the tensor
+*   \param offset The position, in elements, of the first tensor
+*                 entry relative to result
+*   \param type The data type for the provided memory space.
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError unpack_tensor_strided(void* c_client,
+                              const char* name,
+                              const size_t name_length,
+                              void* result,
+                              const size_t* dims,
+                              const size_t* strides,
+                              const size_t n_dims,
+                              const size_t offset,
+                              SRTensorType type);
+
+/*!
+*   \brief Retrieve a tensor from the database into a file
+*   \details The file is created, or replaced, and mapped into memory.
+*            If path ends in .npy, a .npy header is written before the
+*            values; otherwise the file holds only the raw row major
+*            values.  The final tensor key used to retrieve the tensor
+*            may be formed by applying a prefix to the supplied name.
+*            See set_data_source() and use_tensor_ensemble_prefix()
+*            for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the supplied name string,
+*                      excluding null terminating character
+*   \param path The path of the file
+*   \param path_length The length of the path string,
+*                      excluding null terminating character
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError unpack_tensor_to_file(void* c_client,
+                              const char* name,
+                              const size_t name_length,
+                              const char* path,
+                              const size_t path_length);
+
+/*!
+*   \brief Retrieve a sub-region (hyperslab) of a tensor into
+*          contiguous memory provided by the caller
+*   \details The region starts at the tensor coordinates given by
+*            offsets and spans counts values along each dimension, in
+*            the row major order of the stored tensor.  It is written
+*            to result in row major order.  For a tensor put with
+*            put_tensor_tiled(), only the tiles intersecting the region
+*            are fetched.  The final tensor key used to retrieve the
+*            tensor may be formed by applying a prefix to the supplied
+*            name. See set_data_source()
+*            and use_tensor_ensemble_prefix() for more details.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the supplied name string,
+*                      excluding null terminating character
+*   \param offsets The coordinates of the first value of the region
+*   \param counts The number of values of the region along each
+*                 dimension
+*   \param n_dims The number of dimensions of the tensor
+*   \param result The memory receiving the region
+*   \param type The data type for the provided memory space.
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError unpack_tensor_slice(void* c_client,
+                            const char* name,
+                            const size_t name_length,
+                            const size_t* offsets,
+                            const size_t* counts,
+                            const size_t n_dims,
+                            void* result,
+                            SRTensorType type);
+
 /*!
 *   \brief Move a tensor to a new name
 *   \details The old and new tensor keys used to find and
@@ -1335,6 +1737,96 @@ SRError use_tensor_ensemble_prefix(void* c_client, bool use_prefix);
 */
 SRError use_dataset_ensemble_prefix(void* c_client, bool use_prefix);
 
+/*!
+*   \brief Control whether DataSets are stored in the packed format
+*   \details In the packed format, all tensors and metadata fields of
+*            a DataSet are serialized into a single buffer, reducing
+*            the number of database commands needed to store and
+*            retrieve DataSets made of many small tensors. DataSets
+*            are retrieved correctly regardless of this setting.
+*            By default, the client does not pack DataSets.
+*
+*   \param c_client The client object to use for communication
+*   \param use_packed If true, all future put_dataset() operations
+*                     will use the packed format
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError use_packed_datasets(void* c_client, bool use_packed);
+
+/*!
+*   \brief Control whether DataSets are published atomically
+*   \details When enabled, the commands that place a DataSet in the
+*            database are wrapped in a MULTI/EXEC transaction, so other
+*            clients observe either the complete DataSet or no DataSet
+*            at all. By default, DataSets are published in a pipeline
+*            and completion is signalled by the DataSet ack field.
+*
+*   \param c_client The client object to use for communication
+*   \param use_transactions If true, all future DataSet placement
+*                           operations will be atomic
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError use_dataset_transactions(void* c_client, bool use_transactions);
+
+/*!
+*   \brief Control whether column major tensors are stored in their
+*          native layout
+*   \details When enabled, tensors put or unpacked with
+*            SRMemLayoutFortranContiguous are copied without a
+*            transpose and stored with their dimensions reversed.
+*            Producers and consumers of such tensors should use the
+*            same setting. By default, column major tensors are
+*            transposed to row major order.
+*
+*   \param c_client The client object to use for communication
+*   \param use_native If true, future Fortran ordered put_tensor()
+*                     and unpack_tensor() calls will not transpose
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError use_native_fortran_layout(void* c_client, bool use_native);
+
+/*!
+*   \brief Set the time to live of tensors placed by put_tensor()
+*   \details The expiry is applied in the same pipeline as the tensor
+*            placement. By default, tensors do not expire.
+*
+*   \param c_client The client object to use for communication
+*   \param ttl_ms The time to live in milliseconds, or zero to disable
+*                 expiry for future put_tensor() calls
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError set_tensor_ttl(void* c_client, const int ttl_ms);
+
+/*!
+*   \brief Set the time to live of DataSets placed by put_dataset(),
+*          put_datasets() and copy_dataset()
+*   \details The expiry is applied to the metadata and every tensor of
+*            the DataSet in the same pipeline as the DataSet placement.
+*            By default, DataSets do not expire.
+*
+*   \param c_client The client object to use for communication
+*   \param ttl_ms The time to live in milliseconds, or zero to disable
+*                 expiry for future DataSet placements
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError set_dataset_ttl(void* c_client, const int ttl_ms);
+
+/*!
+*   \brief Set the maximum number of entries retained in aggregation
+*          lists by append_to_list()
+*   \details Lists are trimmed to their most recent entries in the same
+*            pipeline as the append. The DataSets referenced by trimmed
+*            entries are not deleted; combine this setting with
+*            set_dataset_ttl() to bound the memory they use.
+*            By default, aggregation lists are not trimmed.
+*
+*   \param c_client The client object to use for communication
+*   \param max_length The number of entries to retain, or zero to
+*                     disable trimming for future appends
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError set_list_retention(void* c_client, const int max_length);
+
 /*!
 *   \brief Control whether model and script names are
 *          prefixed (e.g. in an ensemble) when forming database keys
@@ -38,9 +38,13 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "srobject.h"
 #include "redisserver.h"
 #include "rediscluster.h"
+#include "redisshards.h"
 #include "redis.h"
 #include "dataset.h"
 #include "sharedmemorylist.h"
@@ -49,6 +53,10 @@
 #include "commandreply.h"
 #include "tensorbase.h"
 #include "tensor.h"
+#include "compression.h"
+#include "tensordelta.h"
+#include "tensorchunks.h"
+#include "tensorrecords.h"
 #include "sr_enums.h"
 #include "logger.h"
 
@@ -160,6 +168,46 @@ class Client : public SRObject
         */
         DataSet get_dataset(const std::string& name);
 
+        /*!
+        *   \brief Put multiple DataSet objects into the database
+        *   \details The commands for all DataSets are collected into a
+        *            single CommandList and sent in one pipeline per
+        *            database shard, with the shards served in parallel.
+        *            The dataset keys under which the datasets are
+        *            stored may be formed by applying a prefix to the
+        *            names supplied when the datasets were created. See
+        *            use_dataset_ensemble_prefix() for more details.
+        *            If DataSet transactions are enabled, each DataSet
+        *            is published in its own transaction instead.
+        *   \param datasets The DataSet objects to send to the database
+        *   \throw SmartRedis::Exception if put datasets command fails
+        */
+        void put_datasets(const std::vector<DataSet*>& datasets);
+
+        /*!
+        *   \brief Put multiple DataSet objects into the database
+        *   \details See put_datasets(const std::vector<DataSet*>&)
+        *   \param datasets The DataSet objects to send to the database
+        *   \throw SmartRedis::Exception if put datasets command fails
+        */
+        void put_datasets(std::vector<DataSet>& datasets);
+
+        /*!
+        *   \brief Get multiple DataSet objects from the database
+        *   \details The metadata for all DataSets is retrieved in one
+        *            pipeline per database shard, followed by one
+        *            pipeline per shard for the tensors, with the shards
+        *            served in parallel. The dataset keys used to locate
+        *            the datasets may be formed by applying a prefix to
+        *            the supplied names. See set_data_source()
+        *            and use_dataset_ensemble_prefix() for more details.
+        *   \param names The names of the datasets to retrieve
+        *   \returns The DataSet objects, in the order of names
+        *   \throw SmartRedis::Exception if get datasets command fails
+        *          or any of the datasets does not exist
+        */
+        std::vector<DataSet> get_datasets(const std::vector<std::string>& names);
+
         /*!
         *   \brief Move a dataset to a new name.  All tensors
         *          and metdata in the dataset will be moved with it.
@@ -198,6 +246,11 @@ class Client : public SRObject
         *            deleted may be formed by applying a prefix to the
         *            supplied name. See set_data_source()
         *            and use_dataset_ensemble_prefix() for more details.
+        *            The tensor names are read in one round trip and the
+        *            deletion is performed by a server-side script in a
+        *            second, which is loaded first if the database does
+        *            not know it yet. The keys are removed with UNLINK so
+        *            that their memory is reclaimed asynchronously.
         *   \param name The dataset key for the dataset to be deleted.
         *   \throw SmartRedis::Exception if delete dataset command fails
         */
@@ -223,6 +276,195 @@ class Client : public SRObject
                         const SRTensorType type,
                         const SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Put a tensor into the database, converting its
+        *          values to another tensor type
+        *   \details The values are converted while they are copied
+        *            into the outgoing tensor, so e.g. double precision
+        *            simulation data can be stored as float or float16
+        *            without an extra buffer in the caller.  Floating
+        *            point values converted to integer types are
+        *            rounded using the rounding mode of the current
+        *            floating point environment (see std::fesetround()),
+        *            and values outside the range of the integer type
+        *            are rejected.  The final tensor key may be formed
+        *            by applying a prefix to the supplied name. See
+        *            use_tensor_ensemble_prefix() for more details.
+        *   \param name The tensor name for this tensor in the database
+        *   \param data The data for this tensor
+        *   \param dims The number of elements for each dimension
+        *          of the tensor
+        *   \param type The data type of the provided tensor data
+        *   \param store_type The data type with which the tensor
+        *                     is stored in the database
+        *   \param mem_layout The memory layout of the provided tensor data
+        *   \throw SmartRedis::Exception if a value cannot be converted
+        *          or the put tensor command fails
+        */
+        void put_tensor_as(const std::string& name,
+                           const void* data,
+                           const std::vector<size_t>& dims,
+                           const SRTensorType type,
+                           const SRTensorType store_type,
+                           const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Put a tensor into the database, gathering its
+        *          values from strided memory
+        *   \details The value at position (i_0, ..., i_n) of the
+        *            tensor is read from element
+        *            offset + i_0*strides[0] + ... + i_n*strides[n]
+        *            of data.  This allows an interior sub-block of a
+        *            larger (e.g. halo-padded) array to be sent without
+        *            first copying it into a packed buffer.  Strides and
+        *            offset are given in elements, not bytes.  The final
+        *            tensor key may be formed by applying a prefix to the
+        *            supplied name. See use_tensor_ensemble_prefix() for
+        *            more details.
+        *   \param name The tensor name for this tensor in the database
+        *   \param data The base of the memory holding the tensor data
+        *   \param dims The number of elements for each dimension
+        *          of the tensor
+        *   \param strides The distance, in elements, between consecutive
+        *                  entries along each dimension of the tensor
+        *   \param offset The position, in elements, of the first tensor
+        *                 entry relative to data
+        *   \param type The data type for the tensor
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void put_tensor_strided(const std::string& name,
+                                const void* data,
+                                const std::vector<size_t>& dims,
+                                const std::vector<size_t>& strides,
+                                const size_t offset,
+                                const SRTensorType type);
+
+        /*!
+        *   \brief Put a tensor into the database as a delta against
+        *          the values this client last put under the same name
+        *   \details This is intended for tensors that are overwritten
+        *            with slowly changing values, e.g. once per time
+        *            step.  The client keeps the values it last sent
+        *            and sends only their bytewise XOR with the new
+        *            values, compressed, except for a full keyframe every
+        *            SR_DELTA_KEYFRAME_INTERVAL puts and whenever the
+        *            tensor type or dimensions change.  The frames since
+        *            the last keyframe are kept in the database and
+        *            readers reconstruct the current values transparently
+        *            in get_tensor() and unpack_tensor().  Only one
+        *            client should put deltas under a given name.  The
+        *            final tensor key may be formed by applying a prefix
+        *            to the supplied name. See use_tensor_ensemble_prefix()
+        *            for more details.
+        *   \param name The tensor name for this tensor in the database
+        *   \param data The data for this tensor
+        *   \param dims The number of elements for each dimension
+        *          of the tensor
+        *   \param type The data type for the tensor
+        *   \param mem_layout The memory layout of the provided tensor data
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void put_tensor_delta(const std::string& name,
+                              const void* data,
+                              const std::vector<size_t>& dims,
+                              const SRTensorType type,
+                              const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Put a tensor into the database split into N-dimensional
+        *          tiles, so that sub-regions of it can be read without
+        *          fetching the whole tensor
+        *   \details Each tile is stored under its own key, uncompressed,
+        *            followed by a manifest under the tensor key.  In a
+        *            cluster the tiles are spread over the shards and
+        *            sent in parallel.  Tiles at the upper edge of a
+        *            dimension that does not divide into whole tiles are
+        *            smaller.  The tensor can be read whole with
+        *            get_tensor() and unpack_tensor(), or in part with
+        *            unpack_tensor_slice().  The final tensor key may be
+        *            formed by applying a prefix to the supplied name.
+        *            See use_tensor_ensemble_prefix() for more details.
+        *   \param name The tensor name for this tensor in the database
+        *   \param data The data for this tensor
+        *   \param dims The number of elements for each dimension
+        *          of the tensor
+        *   \param tile_dims The number of elements for each dimension
+        *          of a tile
+        *   \param type The data type for the tensor
+        *   \param mem_layout The memory layout of the provided tensor data
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void put_tensor_tiled(const std::string& name,
+                              const void* data,
+                              const std::vector<size_t>& dims,
+                              const std::vector<size_t>& tile_dims,
+                              const SRTensorType type,
+                              const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Append a record to a tensor that grows along its
+        *          leading dimension, such as a time series
+        *   \details The tensor is stored as a list with one element
+        *            per record, so each append sends only the new
+        *            record.  The tensor has the number of records as
+        *            its leading dimension followed by the dimensions of
+        *            a record, and all records must have the same type
+        *            and dimensions.  Records are compressed with the
+        *            codec selected by SR_COMPRESSION, if any.  The whole
+        *            tensor can be read with get_tensor() and
+        *            unpack_tensor(), and a window of records with
+        *            get_tensor_range().  The final tensor key may be
+        *            formed by applying a prefix to the supplied name.
+        *            See use_tensor_ensemble_prefix() for more details.
+        *   \param name The tensor name for this tensor in the database
+        *   \param data The data for the record
+        *   \param dims The number of elements for each dimension
+        *          of the record
+        *   \param type The data type for the record
+        *   \param mem_layout The memory layout of the provided record data
+        *   \throw SmartRedis::Exception if the name holds a tensor that
+        *          is not appendable or the append command fails
+        */
+        void append_to_tensor(const std::string& name,
+                              const void* data,
+                              const std::vector<size_t>& dims,
+                              const SRTensorType type,
+                              const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Put a tensor into the database from a file, without
+        *          reading the file into memory first
+        *   \details The file is mapped into memory and its pages are
+        *            referenced directly by the commands sent to the
+        *            database, so the memory used stays small regardless
+        *            of the size of the tensor.  If dims is empty, the
+        *            file must be a .npy file, whose header gives the
+        *            tensor type and dimensions.  Otherwise the file holds
+        *            raw row major values of the given type and
+        *            dimensions, starting offset bytes into the file so
+        *            that a fixed-size header can be skipped.  A column
+        *            major .npy file is stored without transposing it
+        *            when use_native_fortran_layout() is enabled and is
+        *            transposed in memory otherwise.  The final tensor
+        *            key may be formed by applying a prefix to the
+        *            supplied name. See use_tensor_ensemble_prefix() for
+        *            more details.
+        *   \param name The tensor name for this tensor in the database
+        *   \param path The path of the file
+        *   \param dims The dimensions of the tensor in a raw file, or
+        *               an empty vector for a .npy file
+        *   \param type The data type of the tensor in a raw file
+        *   \param offset The position of the first value in a raw file
+        *   \throw SmartRedis::Exception if the file cannot be read, is
+        *          too small or the put tensor command fails
+        */
+        void put_tensor_from_file(
+            const std::string& name,
+            const std::string& path,
+            const std::vector<size_t>& dims = std::vector<size_t>(),
+            const SRTensorType type = SRTensorTypeInvalid,
+            const size_t offset = 0);
+
         /*!
         *   \brief Retrieve the tensor data, dimensions, and type for the
         *          provided tensor key. This function will allocate and retain
@@ -298,6 +540,69 @@ class Client : public SRObject
                         SRTensorType& type,
                         const SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Retrieve a window of the records of a tensor put with
+        *          append_to_tensor(). This function will allocate and
+        *          retain management of the memory for the tensor data.
+        *   \details The records from start up to but not including stop
+        *            are joined into a tensor whose leading dimension is
+        *            the number of records.  A window extending past the
+        *            last record is shortened to the records that exist.
+        *            The key used to locate the tensor may be formed by
+        *            applying a prefix to the supplied name. See
+        *            set_data_source() and use_tensor_ensemble_prefix()
+        *            for more details.
+        *
+        *            As for get_tensor(), the memory of the data pointer
+        *            is valid until the Client is destroyed.
+        *   \param name The tensor name for the tensor
+        *   \param start The index of the first record
+        *   \param stop The index one past the last record
+        *   \param data Receives tensor data
+        *   \param dims Receives the number of elements in each dimension
+        *               of the tensor data
+        *   \param type Receives the type for the tensor data
+        *   \param mem_layout The memory layout into which tensor
+        *                     data should be written
+        *   \throw SmartRedis::Exception if the window holds no records
+        *          or the get command fails
+        */
+        void get_tensor_range(const std::string& name,
+                              const size_t start,
+                              const size_t stop,
+                              void*& data,
+                              std::vector<size_t>& dims,
+                              SRTensorType& type,
+                              const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Retrieve a window of the records of a tensor put with
+        *          append_to_tensor(). This is a c-style interface for
+        *          the tensor dimensions.  Another function exists for
+        *          std::vector dimensions.
+        *   \details See the std::vector version for details.
+        *   \param name The tensor name for the tensor
+        *   \param start The index of the first record
+        *   \param stop The index one past the last record
+        *   \param data Receives tensor data
+        *   \param dims Receives the number of elements in each dimension
+        *               of the tensor data
+        *   \param n_dims Receives the number tensor dimensions
+        *   \param type Receives the type for the tensor data
+        *   \param mem_layout The memory layout into which tensor
+        *                     data should be written
+        *   \throw SmartRedis::Exception if the window holds no records
+        *          or the get command fails
+        */
+        void get_tensor_range(const std::string& name,
+                              const size_t start,
+                              const size_t stop,
+                              void*& data,
+                              size_t*& dims,
+                              size_t& n_dims,
+                              SRTensorType& type,
+                              const SRMemoryLayout mem_layout);
+
         /*!
         *   \brief Retrieve a tensor from the database into memory provided
         *          by the caller
@@ -318,12 +623,120 @@ class Client : public SRObject
                            const SRTensorType type,
                            const SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Retrieve a tensor from the database into memory
+        *          provided by the caller, converting its values to the
+        *          tensor type of that memory
+        *   \details The tensor may be stored with any tensor type;
+        *            its values are converted as they are copied into
+        *            the caller's memory using the same rules as
+        *            put_tensor_as().  The tensor key used to locate
+        *            the tensor may be formed by applying a prefix to
+        *            the supplied name. See set_data_source()
+        *            and use_tensor_ensemble_prefix() for more details.
+        *   \param name  The tensor name for the tensor
+        *   \param data A buffer into which to place tensor data
+        *   \param dims The dimensions for the provided data buffer
+        *   \param type The tensor type for the provided data buffer
+        *   \param mem_layout The memory layout for the provided data buffer
+        *   \throw SmartRedis::Exception if a value cannot be converted
+        *          or the unpack tensor command fails
+        */
+        void unpack_tensor_as(const std::string& name,
+                              void* data,
+                              const std::vector<size_t>& dims,
+                              const SRTensorType type,
+                              const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Retrieve a tensor from the database into strided
+        *          memory provided by the caller
+        *   \details The value at position (i_0, ..., i_n) of the
+        *            tensor is written to element
+        *            offset + i_0*strides[0] + ... + i_n*strides[n]
+        *            of data, leaving all other elements untouched.
+        *            Strides and offset are given in elements, not bytes.
+        *            The tensor key used to locate the tensor
+        *            may be formed by applying a prefix to the supplied
+        *            name. See set_data_source()
+        *            and use_tensor_ensemble_prefix() for more details.
+        *   \param name  The tensor name for the tensor
+        *   \param data The base of the memory receiving the tensor data
+        *   \param dims The dimensions of the tensor
+        *   \param strides The distance, in elements, between consecutive
+        *                  entries along each dimension of the tensor
+        *   \param offset The position, in elements, of the first tensor
+        *                 entry relative to data
+        *   \param type The tensor type for the provided data buffer
+        *   \throw SmartRedis::Exception if unpack tensor command fails
+        */
+        void unpack_tensor_strided(const std::string& name,
+                                   void* data,
+                                   const std::vector<size_t>& dims,
+                                   const std::vector<size_t>& strides,
+                                   const size_t offset,
+                                   const SRTensorType type);
+
+        /*!
+        *   \brief Retrieve a sub-region (hyperslab) of a tensor into
+        *          contiguous memory provided by the caller
+        *   \details The region starts at the tensor coordinates given
+        *            by offsets and spans counts values along each
+        *            dimension, in the row major order of the stored
+        *            tensor.  It is written to data in row major order,
+        *            as a tensor with dimensions counts.  For a tensor put
+        *            with put_tensor_tiled(), only the tiles intersecting
+        *            the region are fetched, in parallel across the
+        *            shards of a cluster; any other tensor is fetched
+        *            whole.  The tensor key used to locate the tensor
+        *            may be formed by applying a prefix to the supplied
+        *            name. See set_data_source()
+        *            and use_tensor_ensemble_prefix() for more details.
+        *   \param name  The tensor name for the tensor
+        *   \param offsets The coordinates of the first value of the region
+        *   \param counts The number of values of the region along each
+        *                 dimension
+        *   \param data A buffer of the product of counts values
+        *               receiving the region
+        *   \param type The tensor type for the provided data buffer
+        *   \throw SmartRedis::Exception if the region is outside the
+        *          tensor or the unpack tensor command fails
+        */
+        void unpack_tensor_slice(const std::string& name,
+                                 const std::vector<size_t>& offsets,
+                                 const std::vector<size_t>& counts,
+                                 void* data,
+                                 const SRTensorType type);
+
+        /*!
+        *   \brief Retrieve a tensor from the database into a file
+        *   \details The file is created, or replaced, and mapped into
+        *            memory.  If path ends in .npy, a .npy header is
+        *            written before the values; otherwise the file holds
+        *            only the raw row major values.  The chunks or tiles
+        *            of a tensor stored in parts are written straight
+        *            into the mapped file, so the memory used stays
+        *            bounded regardless of the size of the tensor.  The
+        *            tensor key used to locate the tensor may be formed by
+        *            applying a prefix to the supplied name. See
+        *            set_data_source() and use_tensor_ensemble_prefix()
+        *            for more details.
+        *   \param name The tensor name for the tensor
+        *   \param path The path of the file
+        *   \throw SmartRedis::Exception if the file cannot be written
+        *          or the unpack tensor command fails
+        */
+        void unpack_tensor_to_file(const std::string& name,
+                                   const std::string& path);
+
         /*!
         *   \brief Move a tensor to a new name
         *   \details The old and new tensor keys used to find and relocate
         *            the tensor may be formed by applying prefixes to the
         *            supplied old_name and new_name. See set_data_source()
         *            and use_tensor_ensemble_prefix() for more details.
+        *            The chunks or tiles of a tensor stored in parts are
+        *            moved with it.
         *   \param old_name The original tensor name
         *   \param new_name The new tensor name
         *   \throw SmartRedis::Exception if rename tensor command fails
@@ -348,7 +761,8 @@ class Client : public SRObject
         *            locate and store the tensor may be formed by applying
         *            prefixes to the supplied src_name and dest_name.
         *            See set_data_source() and use_tensor_ensemble_prefix()
-        *            for more details.
+        *            for more details.  The chunks or tiles of a tensor
+        *            stored in parts are copied with it.
         *   \param src_name The source tensor name
         *   \param dest_name The destination tensor name
         *   \throw SmartRedis::Exception if copy tensor command fails
@@ -966,6 +1380,110 @@ class Client : public SRObject
         */
         void use_dataset_ensemble_prefix(bool use_prefix);
 
+        /*!
+        *   \brief Control whether DataSets are stored in the packed format
+        *   \details In the packed format, all tensors and metadata fields
+        *            of a DataSet are serialized into a single
+        *            self-describing buffer that is stored with the
+        *            DataSet metadata. This replaces one tensor key per
+        *            DataSet tensor and reduces put_dataset() to two
+        *            commands and get_dataset() to a single command,
+        *            which favors DataSets made of many small tensors.
+        *            DataSet tensors stored in the packed format are not
+        *            addressable as {dataset_name}.tensor_name by
+        *            run_model() or run_script(). DataSets are always
+        *            retrieved correctly regardless of this setting, as
+        *            the format is detected when the DataSet is read.
+        *            By default, the client does not pack DataSets.
+        *  \param use_packed If set to true, all future put_dataset()
+        *                    operations will use the packed format
+        */
+        void use_packed_datasets(bool use_packed);
+
+        /*!
+        *   \brief Control whether DataSets are published atomically
+        *   \details When enabled, the commands that place a DataSet
+        *            in the database are wrapped in a MULTI/EXEC
+        *            transaction. Because every key of a DataSet shares
+        *            the {dataset_name} hash tag, this is possible for
+        *            both standalone and clustered databases. Other
+        *            clients then observe either the complete DataSet or
+        *            no DataSet at all, so consumers do not need to poll
+        *            for the DataSet to be complete, and a put that
+        *            fails to be queued leaves no partially written keys
+        *            behind. By default, DataSets are published in a
+        *            plain pipeline and completion is signalled by the
+        *            DataSet ack field.
+        *  \param use_transactions If set to true, all future DataSet
+        *                          placement operations will be atomic
+        */
+        void use_dataset_transactions(bool use_transactions);
+
+        /*!
+        *   \brief Control whether column major tensors are stored in
+        *          their native layout
+        *   \details By default, tensors provided or requested with
+        *            SRMemLayoutFortranContiguous are transposed to row
+        *            major order on every put_tensor() and back again on
+        *            every unpack_tensor(). When this setting is enabled,
+        *            the column major bytes are stored unchanged and the
+        *            dimensions are written in reversed order, which
+        *            describes the same memory as a row major tensor.
+        *            Column major producers and consumers that both enable
+        *            this setting then exchange tensors with plain memory
+        *            copies. Row major readers, such as the Python client,
+        *            see the tensor with its dimensions reversed and can
+        *            obtain the column major view with a transpose only
+        *            when they need it. Tensors in DataSets are not
+        *            affected by this setting.
+        *  \param use_native If set to true, future Fortran ordered
+        *                    put_tensor() and unpack_tensor() calls will
+        *                    store and read tensors without transposing
+        */
+        void use_native_fortran_layout(bool use_native);
+
+        /*!
+        *   \brief Set the time to live of tensors placed by put_tensor()
+        *   \details When set, an expiry is applied to each tensor in
+        *            the same pipeline as the put_tensor() command, so
+        *            the database reclaims old tensors without explicit
+        *            delete_tensor() calls or additional round trips.
+        *            By default, tensors do not expire.
+        *   \param ttl_ms The time to live in milliseconds, or zero to
+        *                 disable expiry for future put_tensor() calls
+        *   \throw SmartRedis::Exception if ttl_ms is negative
+        */
+        void set_tensor_ttl(int ttl_ms);
+
+        /*!
+        *   \brief Set the time to live of DataSets placed by
+        *          put_dataset(), put_datasets() and copy_dataset()
+        *   \details When set, an expiry is applied to the metadata and
+        *            to every tensor of each DataSet in the same pipeline
+        *            (or transaction) that places the DataSet, so all of
+        *            its keys expire together. By default, DataSets do
+        *            not expire.
+        *   \param ttl_ms The time to live in milliseconds, or zero to
+        *                 disable expiry for future DataSet placements
+        *   \throw SmartRedis::Exception if ttl_ms is negative
+        */
+        void set_dataset_ttl(int ttl_ms);
+
+        /*!
+        *   \brief Set the maximum number of entries retained in
+        *          aggregation lists by append_to_list()
+        *   \details When set, append_to_list() trims the list to its
+        *            most recent max_length entries with LTRIM in the same
+        *            pipeline as the append. The DataSets referenced by
+        *            trimmed entries are not deleted; combine this setting
+        *            with set_dataset_ttl() to bound the memory they use.
+        *            By default, aggregation lists are not trimmed.
+        *   \param max_length The number of entries to retain, or zero to
+        *                     disable trimming for future appends
+        *   \throw SmartRedis::Exception if max_length is negative
+        */
+        void set_list_retention(int max_length);
+
         /*!
         *   \brief Control whether model and script keys are
         *          prefixed (e.g. in an ensemble) when forming database keys.
@@ -1356,6 +1874,13 @@ class Client : public SRObject
         */
         Redis* _redis;
 
+        /*!
+        *  \brief Dynamically allocated RedisShards object if the Client is
+        *         being run in sharded mode. This
+        *         object will be destroyed with the Client.
+        */
+        RedisShards* _redis_shards;
+
         /*!
         *   \brief Execute an AddressAtCommand
         *   \param cmd The AddresseAtCommand to execute
@@ -1422,6 +1947,33 @@ class Client : public SRObject
         */
         void _get_prefix_settings();
 
+        /*!
+        *  \brief Set the codec, level and error bound used to compress
+        *         tensors and packed DataSets from the SR_COMPRESSION,
+        *         SR_COMPRESSION_LEVEL and SR_COMPRESSION_ERROR_BOUND
+        *         config settings
+        *  \throw SmartRedis::ParameterException if the codec is unknown
+        *         or a lossy codec is selected without a positive bound
+        */
+        void _get_compression_settings();
+
+        /*!
+        *  \brief Set the number of delta-encoded puts from one keyframe
+        *         to the next from the SR_DELTA_KEYFRAME_INTERVAL config
+        *         setting
+        *  \throw SmartRedis::ParameterException if the interval is not
+        *         positive
+        */
+        void _get_delta_settings();
+
+        /*!
+        *  \brief Set the size above which tensors are stored in chunks
+        *         from the SR_TENSOR_CHUNK_SIZE config setting
+        *  \throw SmartRedis::ParameterException if the size is not
+        *         positive
+        */
+        void _get_chunk_settings();
+
         /*!
         *  \brief Get the key prefix for placement methods
         *  \returns std::string container the placement prefix
@@ -1474,6 +2026,23 @@ class Client : public SRObject
                                 int start_index,
                                 int end_index);
 
+        /*!
+        *   \brief Retrieve DataSets given their database keys
+        *   \details Metadata and tensors are each fetched with one
+        *            pipeline per database shard.
+        *   \param dataset_keys The database keys of the DataSets, in the
+        *                       form prefix.{dataset_name}
+        *   \param dataset_names The names of the DataSets
+        *   \param require_exists If true, a missing DataSet is an error;
+        *                         otherwise an empty DataSet is returned
+        *   \returns A vector containing DataSet objects.
+        *   \throw SmartRedis::Exception if retrieval fails
+        */
+        std::vector<DataSet>
+        _get_datasets_by_key(const std::vector<std::string>& dataset_keys,
+                             const std::vector<std::string>& dataset_names,
+                             bool require_exists);
+
         /*!
         *  \brief Add a tensor retrieved via get_tensor() to a dataset
         *  \param dataset The dataset which will receive the tensor
@@ -1488,6 +2057,20 @@ class Client : public SRObject
             const std::string& name,
             CommandReply tensor_data);
 
+        /*!
+        *   \brief Retrieve the tensors of unpacked DataSets
+        *   \details The tensors are fetched with AI.TENSORGET in one
+        *            round trip per shard. Tensors of types that RedisAI
+        *            does not support are stored in a compression
+        *            container, which AI.TENSORGET rejects. If any
+        *            tensor is rejected, the type of each key is read and
+        *            the containers are fetched with GET instead.
+        *   \param keys The keys of the tensors
+        *   \returns The replies, in the order of keys
+        *   \throw SmartRedis::Exception if retrieval fails
+        */
+        PipelineReply _get_dataset_tensors(const std::vector<std::string>& keys);
+
         /*!
         *   \brief Retrieve the tensor from the DataSet and return
         *          a TensorBase object that can be used to return
@@ -1502,13 +2085,193 @@ class Client : public SRObject
         */
         TensorBase* _get_tensorbase_obj(const std::string& name);
 
+        /*!
+        *   \brief Retrieve a window of the records of an appendable
+        *          tensor and return a TensorBase object holding them.
+        *          The returned TensorBase object has been dynamically
+        *          allocated, but not yet tracked for memory management
+        *          in any object.
+        *   \param name The name used to reference the tensor
+        *   \param start The index of the first record
+        *   \param stop The index one past the last record
+        *   \returns A TensorBase object.
+        *   \throw SmartRedis::Exception if the window holds no records
+        */
+        TensorBase* _get_tensor_range_obj(const std::string& name,
+                                          size_t start,
+                                          size_t stop);
+
+        /*!
+        *   \brief Map column major user memory stored in the native
+        *          layout onto the row major tensor sharing its memory
+        *   \details When the native Fortran layout is in use, the
+        *            dimensions of SRMemLayoutFortranContiguous memory
+        *            are reversed and its layout becomes
+        *            SRMemLayoutContiguous. Other memory is unchanged.
+        *   \param dims The dimensions to adjust in place
+        *   \param mem_layout The memory layout to adjust in place
+        *   \returns True if the dimensions and layout were adjusted
+        */
+        bool _to_native_layout(std::vector<size_t>& dims,
+                               SRMemoryLayout& mem_layout) const;
+
+        /*!
+        *   \brief Check the dimensions of a user memory space against
+        *          those of a fetched tensor before unpacking into it
+        *   \param dims The dimensions of the user memory space
+        *   \param reply_dims The dimensions of the fetched tensor
+        *   \param mem_layout The memory layout of the user memory space
+        *   \throw SmartRedis::RuntimeException if the dimensions
+        *          do not match
+        */
+        void _check_unpack_dims(const std::vector<size_t>& dims,
+                                const std::vector<size_t>& reply_dims,
+                                const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Allocate a Tensor holding a copy of source data
+        *   \param key The key of the tensor
+        *   \param data The source data
+        *   \param dims The dimensions of the tensor
+        *   \param type The data type of the tensor
+        *   \param mem_layout The memory layout of the source data
+        *   \returns The dynamically allocated Tensor
+        *   \throw SmartRedis::Exception if the type is invalid
+        */
+        TensorBase* _build_tensor(const std::string& key,
+                                  const void* data,
+                                  const std::vector<size_t>& dims,
+                                  const SRTensorType type,
+                                  const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Allocate a Tensor holding a copy of source data
+        *          gathered from strided memory
+        *   \param key The key of the tensor
+        *   \param data The source data
+        *   \param dims The dimensions of the tensor
+        *   \param strides The stride of each dimension, in elements
+        *   \param offset The offset of the first element, in elements
+        *   \param type The data type of the tensor
+        *   \returns The dynamically allocated Tensor
+        *   \throw SmartRedis::Exception if the type is invalid
+        */
+        TensorBase* _build_tensor(const std::string& key,
+                                  const void* data,
+                                  const std::vector<size_t>& dims,
+                                  const std::vector<size_t>& strides,
+                                  const size_t offset,
+                                  const SRTensorType type);
+
+        /*!
+        *   \brief Allocate a Tensor holding contiguous source data
+        *          converted from another tensor type
+        *   \param key The key of the tensor
+        *   \param data The contiguous source data
+        *   \param dims The dimensions of the tensor
+        *   \param type The data type of the tensor
+        *   \param src_type The data type of the source data
+        *   \returns The dynamically allocated Tensor
+        *   \throw SmartRedis::Exception if a type is invalid or a
+        *          value cannot be converted
+        */
+        TensorBase* _build_converted_tensor(const std::string& key,
+                                            const void* data,
+                                            const std::vector<size_t>& dims,
+                                            const SRTensorType type,
+                                            const SRTensorType src_type);
+
         /*!
         *   \brief The name of the hash field used to confirm that the
         *          DataSet placement operation was successfully completed.
         */
         inline static const std::string _DATASET_ACK_FIELD = ".COMPLETE";
 
+        /*!
+        *   \brief The name of the hash field holding a DataSet stored
+        *          in the packed format
+        */
+        inline static const std::string _DATASET_PACKED_FIELD = ".PACKED";
+
+        /*!
+        *   \brief Lua script that deletes a DataSet atomically
+        *   \details KEYS[1] is the DataSet metadata key and KEYS[2..]
+        *            its tensor keys, which share the DataSet hash tag.
+        *            ARGV[1] is the .tensor_names field the tensor keys
+        *            were built from. The script returns 0 if the DataSet
+        *            does not exist and -1, deleting nothing, if its
+        *            tensors changed since the field was read. UNLINK is
+        *            used so that large tensors are freed off the Redis
+        *            event loop.
+        */
+        inline static const std::string _DATASET_DELETE_SCRIPT =
+            "if redis.call('EXISTS', KEYS[1]) == 0 then return 0 end "
+            "local names = redis.call('HGET', KEYS[1], '.tensor_names') "
+            "if (names or '') ~= ARGV[1] then return -1 end "
+            "for i = 1, #KEYS do redis.call('UNLINK', KEYS[i]) end "
+            "return 1";
+
+        /*!
+        *   \brief The number of times a DataSet deletion is retried when
+        *          the DataSet is modified while it is being deleted
+        */
+        inline static const int _DATASET_DELETE_ATTEMPTS = 10;
+
+        /*!
+        *   \brief SHA1 digest of the loaded DataSet deletion script, or
+        *          empty if it has not been loaded yet
+        */
+        std::string _dataset_delete_script_sha;
+
+        /*!
+        *   \brief Lua script reading the type of a tensor key and, for
+        *          a string or list, its value in the same round trip
+        *   \details KEYS[1] is the tensor key. The script returns the
+        *            type of the key followed by its value if the key
+        *            is a string or a list, and the type alone otherwise.
+        */
+        inline static const std::string _TENSOR_READ_SCRIPT =
+            "local t = redis.call('TYPE', KEYS[1]).ok "
+            "if t == 'string' then "
+            "return {t, redis.call('GET', KEYS[1])} end "
+            "if t == 'list' then "
+            "return {t, redis.call('LRANGE', KEYS[1], 0, -1)} end "
+            "return {t}";
+
+        /*!
+        *   \brief SHA1 digest of the loaded tensor read script, or
+        *          empty if it has not been loaded yet
+        */
+        std::string _tensor_read_script_sha;
+
+        /*!
+        *   \brief Lua script appending a record to an appendable tensor
+        *   \details KEYS[1] is the tensor key, ARGV[1] the record and
+        *            ARGV[2] the time to live in milliseconds, or zero.
+        *            The record is only pushed if the list is empty or
+        *            starts with a record, which is recognized by the
+        *            8 byte magic number at the start of ARGV[1]. The
+        *            script returns the new length of the list, or -1
+        *            if the list holds the frames of a delta-encoded
+        *            tensor.
+        */
+        inline static const std::string _TENSOR_APPEND_SCRIPT =
+            "local first = redis.call('LINDEX', KEYS[1], 0) "
+            "if first and string.sub(first, 1, 8) ~= "
+            "string.sub(ARGV[1], 1, 8) then return -1 end "
+            "local n = redis.call('RPUSH', KEYS[1], ARGV[1]) "
+            "if tonumber(ARGV[2]) > 0 then "
+            "redis.call('PEXPIRE', KEYS[1], ARGV[2]) end "
+            "return n";
+
+        /*!
+        *   \brief SHA1 digest of the loaded tensor append script, or
+        *          empty if it has not been loaded yet
+        */
+        std::string _tensor_append_script_sha;
+
         friend class PyClient;
+        friend class PyAsyncClient;
 
     private:
 
@@ -1569,6 +2332,82 @@ class Client : public SRObject
         */
         bool _use_list_prefix;
 
+        /*!
+        * \brief Flag determining whether DataSets are stored
+        *        in the packed format
+        */
+        bool _use_packed_datasets;
+
+        /*!
+        * \brief Flag determining whether DataSets are published
+        *        in a MULTI/EXEC transaction
+        */
+        bool _use_dataset_transactions;
+
+        /*!
+        * \brief Flag determining whether Fortran ordered tensors are
+        *        stored column major with reversed dimensions
+        */
+        bool _use_native_fortran_layout;
+
+        /*!
+        * \brief Time to live in milliseconds of tensors placed by
+        *        put_tensor(), or zero if they do not expire
+        */
+        int _tensor_ttl;
+
+        /*!
+        * \brief Time to live in milliseconds of DataSets, or zero
+        *        if they do not expire
+        */
+        int _dataset_ttl;
+
+        /*!
+        * \brief Maximum number of entries retained in aggregation
+        *        lists, or zero if lists are not trimmed
+        */
+        int _list_retention;
+
+        /*!
+        * \brief Codec used to compress tensors and packed DataSets
+        */
+        SRCompressionCodec _compression_codec;
+
+        /*!
+        * \brief Compression level, from 1 (fastest) to 9 (smallest)
+        */
+        int _compression_level;
+
+        /*!
+        * \brief Largest absolute error allowed by lossy compression
+        */
+        double _compression_error_bound;
+
+        /*!
+        * \brief Number of delta-encoded puts from one keyframe to
+        *        the next
+        */
+        int _delta_keyframe_interval;
+
+        /*!
+        * \brief Size in bytes above which tensors are stored in chunks,
+        *        and the size of each chunk
+        */
+        size_t _tensor_chunk_size;
+
+        /*!
+        * \brief Encoders for the tensors put with put_tensor_delta(),
+        *        by tensor key
+        */
+        std::unordered_map<std::string, DeltaEncoder> _delta_encoders;
+
+        /*!
+        * \brief Lock serializing delta-encoded puts, held by pointer
+        *        so that the Client remains movable
+        */
+        std::unique_ptr<std::mutex> _delta_lock =
+            std::make_unique<std::mutex>();
+
         /*!
         * \brief Our configuration options, used to access runtime settings
         */
@@ -1701,15 +2540,354 @@ class Client : public SRObject
         void _append_dataset_ack_command(CommandList& cmd_list,
                                          DataSet& dataset);
 
+        /*!
+        *   \brief Append all Commands associated with placing a DataSet
+        *          in the database to a CommandList, using the packed
+        *          format if it is enabled
+        *   \param cmd_list The CommandList to append DataSet
+        *                   commands
+        *   \param dataset The dataset used for the Command
+        *                  construction
+        *   \param packed_buf Receives the packed DataSet buffer, if any,
+        *                     which must outlive the execution of cmd_list
+        */
+        void _append_dataset_commands(CommandList& cmd_list,
+                                      DataSet& dataset,
+                                      std::string& packed_buf);
+
+        /*!
+        *   \brief Append the Commands setting the expiry of all keys
+        *          of a DataSet to a CommandList
+        *   \param cmd_list The CommandList to append DataSet
+        *                   commands
+        *   \param dataset The dataset used for the Command
+        *                  construction
+        *   \param packed True if the DataSet is placed in the packed
+        *                 format and therefore has no tensor keys
+        */
+        void _append_dataset_expire_commands(CommandList& cmd_list,
+                                             DataSet& dataset,
+                                             bool packed);
+
+        /*!
+        *   \brief Send a tensor to the database, together with its
+        *          expiry if a tensor time to live has been set
+        *   \param tensor The tensor to send
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void _send_tensor(TensorBase& tensor);
+
+        /*!
+        *   \brief Send tensor values held in contiguous row major memory
+        *          to the database, together with their expiry if a
+        *          tensor time to live has been set
+        *   \details The values are referenced by the commands rather
+        *            than copied, so they must stay valid until this
+        *            method returns.
+        *   \param key The key of the tensor
+        *   \param type The tensor type
+        *   \param dims The tensor dimensions
+        *   \param values The tensor values
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void _send_tensor(const std::string& key,
+                          SRTensorType type,
+                          const std::vector<size_t>& dims,
+                          std::string_view values);
+
+        /*!
+        *   \brief Send a tensor to the database as a keyframe or as a
+        *          delta against the values last sent under its key
+        *   \param tensor The tensor to send
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void _send_tensor_delta(TensorBase& tensor);
+
+        /*!
+        *   \brief Append a delta frame to the frames stored under a
+        *          key, discarding the previous frames for a keyframe
+        *   \param key The key of the tensor
+        *   \param frame The encoded frame
+        *   \param keyframe Whether the frame is a keyframe
+        *   \returns The number of frames stored under the key, or zero
+        *            if a delta could not be stored because the key
+        *            holds a tensor that was not put as deltas
+        *   \throw SmartRedis::Exception if the frame cannot be stored
+        */
+        long long _push_delta_frame(const std::string& key,
+                                    std::string_view frame,
+                                    bool keyframe);
+
+        /*!
+        *   \brief Fetch a tensor, decompressing it if it was stored
+        *          by a client with compression enabled and
+        *          reassembling it if it was stored in chunks or tiles
+        *   \param key The key of the tensor
+        *   \param reply Receives the reply to the fetch
+        *   \param decompressed Receives the values of a compressed,
+        *                       chunked or tiled tensor
+        *   \param type Receives the tensor type
+        *   \param dims Receives the tensor dimensions
+        *   \param blob Receives a view of the tensor values, which
+        *               refers to reply, to decompressed or to dest
+        *   \param dest Optional memory into which the parts of a
+        *               chunked or tiled tensor of type dest_type and
+        *               dest_size bytes are reassembled directly
+        *   \param dest_type The tensor type expected in dest
+        *   \param dest_size The size of dest in bytes
+        *   \throw SmartRedis::Exception if the tensor cannot be fetched
+        */
+        void _fetch_tensor(const std::string& key,
+                           CommandReply& reply,
+                           std::string& decompressed,
+                           SRTensorType& type,
+                           std::vector<size_t>& dims,
+                           std::string_view& blob,
+                           void* dest = NULL,
+                           SRTensorType dest_type = SRTensorTypeInvalid,
+                           size_t dest_size = 0);
+
+        /*!
+        *   \brief Fetch a tensor by name, as _fetch_tensor() does
+        *   \details Used by the language bindings to fill user memory
+        *            without first copying the tensor into a TensorBase
+        *   \param name The name of the tensor
+        *   \param reply Receives the reply to the fetch
+        *   \param decompressed Receives the values of a compressed,
+        *                       chunked or tiled tensor
+        *   \param type Receives the tensor type
+        *   \param dims Receives the tensor dimensions
+        *   \param blob Receives a view of the tensor values
+        *   \param dest Optional memory into which chunked or tiled
+        *               tensors are reassembled directly
+        *   \param dest_type The tensor type expected in dest
+        *   \param dest_size The size of dest in bytes
+        *   \throw SmartRedis::Exception if the tensor cannot be fetched
+        */
+        void _fetch_named_tensor(const std::string& name,
+                                 CommandReply& reply,
+                                 std::string& decompressed,
+                                 SRTensorType& type,
+                                 std::vector<size_t>& dims,
+                                 std::string_view& blob,
+                                 void* dest,
+                                 SRTensorType dest_type,
+                                 size_t dest_size);
+
+        /*!
+        *   \brief Send a tensor to the database in chunks, followed by
+        *          the manifest describing them
+        *   \details The chunks of the tensor previously stored under
+        *            the same key, if any, are deleted once the new
+        *            manifest is in place.
+        *   \param key The key of the tensor
+        *   \param type The tensor type
+        *   \param dims The tensor dimensions
+        *   \param values The tensor values
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void _send_chunked_tensor(const std::string& key,
+                                  SRTensorType type,
+                                  const std::vector<size_t>& dims,
+                                  std::string_view values);
+
+        /*!
+        *   \brief Send a tensor to the database in tiles, followed by
+        *          the manifest describing them
+        *   \details The parts of the tensor previously stored under
+        *            the same key, if any, are deleted once the new
+        *            manifest is in place.
+        *   \param tensor The tensor to send
+        *   \param tile_dims The tile dimensions
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void _send_tiled_tensor(TensorBase& tensor,
+                                const std::vector<size_t>& tile_dims);
+
+        /*!
+        *   \brief Send tensor values with AI.TENSORSET, together with
+        *          their expiry if any
+        *   \param key The key of the tensor
+        *   \param type The tensor type
+        *   \param dims The tensor dimensions
+        *   \param values The tensor values in row major order
+        *   \throw SmartRedis::Exception if the tensor cannot be sent
+        */
+        void _send_tensorset(const std::string& key,
+                             SRTensorType type,
+                             const std::vector<size_t>& dims,
+                             std::string_view values);
+
+        /*!
+        *   \brief Delete the value stored under a tensor key if it was
+        *          stored in a format other than a RedisAI tensor,
+        *          together with its chunks or tiles
+        *   \param key The key of the tensor
+        *   \returns True if the key held a string or a list, which
+        *            was deleted
+        *   \throw SmartRedis::Exception if the value cannot be deleted
+        */
+        bool _unlink_other_format(const std::string& key);
+
+        /*!
+        *   \brief Read the start of the value stored under a key, which
+        *          is long enough to hold a chunk or tile manifest
+        *   \param key The key of the tensor
+        *   \param reply Receives the reply holding the value
+        *   \returns False if the key does not hold a string
+        */
+        bool _get_manifest_prefix(const std::string& key,
+                                  CommandReply& reply);
+
+        /*!
+        *   \brief Read the chunk manifest stored under a key
+        *   \param key The key of the tensor
+        *   \param manifest Receives the manifest
+        *   \returns True if the key holds a chunk manifest
+        */
+        bool _get_chunk_manifest(const std::string& key,
+                                 ChunkManifest& manifest);
+
+        /*!
+        *   \brief Read the tile manifest stored under a key
+        *   \param key The key of the tensor
+        *   \param manifest Receives the manifest
+        *   \returns True if the key holds a tile manifest
+        */
+        bool _get_tile_manifest(const std::string& key,
+                                TileManifest& manifest);
+
+        /*!
+        *   \brief Get the keys of the chunks or tiles of the tensor
+        *          stored under a key
+        *   \param key The key of the tensor
+        *   \returns The keys, which are empty unless the key holds a
+        *            chunk or tile manifest
+        */
+        std::vector<std::string> _get_part_keys(const std::string& key);
+
+        /*!
+        *   \brief Fetch the chunks of a tensor into memory
+        *   \param key The key of the tensor
+        *   \param manifest The manifest of the tensor
+        *   \param dest Memory of manifest.total_bytes bytes receiving
+        *               the tensor data
+        *   \returns False if a chunk no longer exists because the
+        *            tensor was replaced while it was being fetched
+        *   \throw SmartRedis::Exception if a chunk cannot be fetched
+        */
+        bool _fetch_chunks(const std::string& key,
+                           const ChunkManifest& manifest,
+                           char* dest);
+
+        /*!
+        *   \brief Fetch the tiles of a tensor intersecting a region into
+        *          memory
+        *   \param key The key of the tensor
+        *   \param manifest The manifest of the tensor
+        *   \param offsets The coordinates of the first value of the region
+        *   \param counts The number of values of the region along each
+        *                 dimension
+        *   \param dest Memory receiving the region in row major order
+        *   \returns False if a tile no longer exists because the
+        *            tensor was replaced while it was being fetched
+        *   \throw SmartRedis::Exception if a tile cannot be fetched
+        */
+        bool _fetch_tiles(const std::string& key,
+                          const TileManifest& manifest,
+                          const std::vector<size_t>& offsets,
+                          const std::vector<size_t>& counts,
+                          char* dest);
+
+        /*!
+        *   \brief Get the keys of a tensor stored as a string, with
+        *          its chunks or tiles, and the keys they take under
+        *          another tensor key
+        *   \param key The key of the tensor
+        *   \param new_key The other tensor key
+        *   \param keys Receives the keys of the parts, followed by key
+        *   \param new_keys Receives the keys of the parts under
+        *                   new_key, followed by new_key
+        *   \param batch_size Receives the number of parts that can be
+        *                     copied at once within a bounded amount of
+        *                     memory
+        *   \returns False if the key does not hold a string, in which
+        *            case it holds a RedisAI tensor, a list or nothing
+        */
+        bool _get_string_tensor_keys(const std::string& key,
+                                     const std::string& new_key,
+                                     std::vector<std::string>& keys,
+                                     std::vector<std::string>& new_keys,
+                                     size_t& batch_size);
+
+        /*!
+        *   \brief Copy a tensor stored as a string, with its chunks or
+        *          tiles, to other keys
+        *   \details The parts are copied before the manifest, so that
+        *            readers of the destination never see a manifest
+        *            whose parts are missing.
+        *   \param src_keys The keys to copy, ending with the tensor key
+        *   \param dest_keys The keys to copy to, ending with the
+        *                    destination tensor key
+        *   \param batch_size The number of parts copied at once
+        *   \throw SmartRedis::Exception if the tensor cannot be copied
+        */
+        void _copy_string_tensor(const std::vector<std::string>& src_keys,
+                                 const std::vector<std::string>& dest_keys,
+                                 size_t batch_size);
+
+        /*!
+        *   \brief Delete the chunks or tiles of a tensor
+        *   \param keys The keys to delete
+        *   \throw SmartRedis::Exception if the keys cannot be deleted
+        */
+        void _unlink_keys(const std::vector<std::string>& keys);
+
+        /*!
+        *   \brief Append the Command setting the expiry of a key
+        *          to a CommandList
+        *   \param cmd_list The CommandList to append the command
+        *   \param key The key to expire
+        *   \param ttl_ms The time to live of the key in milliseconds
+        */
+        void _append_expire_command(CommandList& cmd_list,
+                                    const std::string& key,
+                                    int ttl_ms);
+
+        /*!
+        *   \brief Append the Commands associated with placing
+        *          a DataSet in the packed format to a CommandList
+        *   \param cmd_list The CommandList to append DataSet
+        *                   commands
+        *   \param dataset The dataset used for the Command
+        *                  construction
+        *   \param packed_buf Receives the packed DataSet buffer, which
+        *                     must outlive the execution of cmd_list
+        */
+        void _append_packed_dataset_commands(CommandList& cmd_list,
+                                             DataSet& dataset,
+                                             std::string& packed_buf);
+
+        /*!
+        *   \brief Run the Commands that place a single DataSet in the
+        *          database, atomically if DataSet transactions are enabled
+        *   \param cmd_list The CommandList holding the DataSet commands
+        *   \returns The PipelineReply with the result of each command
+        */
+        PipelineReply _run_dataset_commands(CommandList& cmd_list);
+
         /*!
         *   \brief Put the metadata fields embedded in a
         *          CommandReply into the DataSet
         *   \param dataset The DataSet that will have
         *                  metadata place in it.
+        *   \details If the DataSet was stored in the packed format,
+        *            its tensors are placed in the DataSet as well.
         *   \param reply The CommandReply containing the
         *                metadata fields.
+        *   \returns True if the DataSet was stored in the packed format
         */
-        void _unpack_dataset_metadata(DataSet& dataset,
+        bool _unpack_dataset_metadata(DataSet& dataset,
                                       CommandReply& reply);
 
         /*!
@@ -1758,6 +2936,54 @@ class Client : public SRObject
         *   \throw SmartRedis::Exception if poll list length command fails
         */
        void _report_reply_errors(CommandReply &reply, std::string error_message);
+
+       /*!
+        *   \brief Run a SingleKeyCommand, catching one kind of error
+        *          reply from the database
+        *   \param cmd The SingleKeyCommand to execute
+        *   \param error_code The error code to catch, e.g. WRONGTYPE
+        *   \param caught Set to whether the error was returned
+        *   \returns The CommandReply after execution, or an empty
+        *            CommandReply if the error was caught
+        *   \throw SmartRedis::Exception for any other error
+        */
+       CommandReply _run_catching(SingleKeyCommand& cmd,
+                                  const std::string& error_code,
+                                  bool& caught);
+
+       /*!
+        *   \brief Load a Lua script into every database node
+        *   \param script The source of the script
+        *   \returns The SHA1 digest with which to run the script
+        *   \throw SmartRedis::Exception if the script cannot be loaded
+        */
+       std::string _load_script(const std::string& script);
+
+       /*!
+        *   \brief Read the type of a tensor key and, if the tensor is
+        *          stored as a string or list, its value
+        *   \param key The key of the tensor
+        *   \returns The reply of the tensor read script, holding the
+        *            type of the key followed by any value
+        *   \throw SmartRedis::Exception if the key cannot be read
+        */
+       CommandReply _read_stored_tensor(const std::string& key);
+
+       /*!
+        *   \brief Run a Lua script on the shard holding a key, loading
+        *          it first if the database does not know it
+        *   \param script The source of the script
+        *   \param sha The SHA1 digest of the script, set when the
+        *             script is first loaded
+        *   \param key The single key the script accesses
+        *   \param args The arguments of the script
+        *   \returns The reply of the script
+        *   \throw SmartRedis::Exception if the script fails
+        */
+       CommandReply _run_key_script(const std::string& script,
+                                    std::string& sha,
+                                    const std::string& key,
+                                    const std::vector<std::string_view>& args);
 };
 
 /*!
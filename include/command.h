@@ -35,7 +35,10 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <cstring>
+#include <charconv>
 #include <iostream>
+#include <memory>
+#include <type_traits>
 #include "commandreply.h"
 
 ///@file
@@ -73,7 +76,10 @@ class Keyfield: public std::string
 *          while the Command.add_field_ptr() methods
 *          will only maintain a pointer to the field data.
 *          The Command.add_field_ptr() methods are ideal
-*          for large field values.
+*          for large field values.  Copied fields are stored
+*          in an arena owned by the Command: a small inline
+*          buffer that holds the fields of most commands,
+*          followed by larger heap blocks when it fills up.
 */
 class Command
 {
@@ -90,9 +96,10 @@ class Command
         Command(const Command& cmd);
 
         /*!
-        *   \brief Command default move constructor
+        *   \brief Command move constructor
+        *   \param cmd The Command to move for construction
         */
-        Command(Command&& cmd) = default;
+        Command(Command&& cmd);
 
         /*!
         *   \brief Command copy assignment operator
@@ -191,8 +198,9 @@ class Command
 
         /*!
         *   \brief Command move assignment operator
+        *   \param cmd The Command to move for assignment
         */
-        Command& operator=(Command&& cmd) = default;
+        Command& operator=(Command&& cmd);
 
         /*!
         *   \brief Deep copy operator
@@ -247,7 +255,7 @@ class Command
         *                 should be treated as a key for the
         *                 Command.
         */
-        void add_field(std::string field,
+        void add_field(const std::string& field,
                        bool is_key=false);
 
         /*!
@@ -292,8 +300,9 @@ class Command
         *   \brief Add fields to the Command
         *          from a vector of type T
         *   \details The field values are copied to the
-        *            Command.  The type T must be convertable
-        *            to a string via std::to_string.
+        *            Command.  Integers are formatted straight
+        *            into the Command arena; other types must be
+        *            convertable to a string via std::to_string.
         *   \tparam T Any type that can be converted
         *             to a string via std::to_string.
         *   \param fields The fields to add to the Command
@@ -317,8 +326,9 @@ class Command
         *   \brief Add key fields to the Command
         *          from a vector of type T
         *   \details The key field values are copied to the
-        *            Command.  The type T must be convertible
-        *            to a string via std::to_string.
+        *            Command.  Integers are formatted straight
+        *            into the Command arena; other types must be
+        *            convertible to a string via std::to_string.
         *   \tparam T Any type that can be converted
         *             to a string via std::to_string.
         *   \param keyfields The key fields to add to the Command
@@ -339,6 +349,34 @@ class Command
         */
         std::vector<std::string> get_keys();
 
+        /*!
+        *   \brief Get the number of Command keys
+        *   \returns The number of Command keys
+        */
+        size_t get_key_count() const { return _keys.size(); }
+
+        /*!
+        *   \brief Get the cluster hash slot of a Command key
+        *   \details The hash slot is computed once, when the key
+        *            is added to the Command.
+        *   \param index The position of the key among the Command
+        *                keys, in the order they were added
+        *   \returns The hash slot of the key
+        */
+        uint16_t get_key_hash_slot(size_t index) const {
+            return _keys[index].hash_slot;
+        }
+
+        /*!
+        *   \brief Compute the cluster hash slot of a key
+        *   \details As in Redis, only the part of the key between
+        *            the first "{" and the first "}" after it is
+        *            hashed, if that part is not empty.
+        *   \param key The key to hash
+        *   \returns The hash slot of the key
+        */
+        static uint16_t get_hash_slot(std::string_view key);
+
         /*!
         *   \brief Change a Command key value
         *   \param old_key The value of the old key field
@@ -353,6 +391,14 @@ class Command
         */
         std::string first_field() const;
 
+        /*!
+        *   \brief Check whether the Command only reads data
+        *   \details Read-only commands, such as AI.TENSORGET, HGETALL
+        *            and EXISTS, may be served by a cluster replica.
+        *   \returns True if the Command does not modify the database
+        */
+        bool is_read_only() const;
+
         /*!
         *   \brief Get a string of the entire Command
         *   \returns std::string concatenating all Command
@@ -410,12 +456,95 @@ class Command
         *   \param is_key True IFF the field supplied in new_field
         *                 is a key field
         */
-        void set_field_at(std::string new_field,
+        void set_field_at(const std::string& new_field,
                           size_t pos,
                           bool is_key=false);
 
     private:
 
+        /*!
+        *   \brief A Command key
+        */
+        struct CommandKey {
+            /*!
+            *   \brief The index of the key in _fields
+            */
+            size_t field;
+
+            /*!
+            *   \brief The cluster hash slot of the key
+            */
+            uint16_t hash_slot;
+        };
+
+        /*!
+        *   \brief A heap block of the Command arena
+        */
+        struct ArenaBlock {
+            /*!
+            *   \brief The memory of the block
+            */
+            std::unique_ptr<char[]> data;
+
+            /*!
+            *   \brief The size of the block in bytes
+            */
+            size_t size;
+
+            /*!
+            *   \brief The number of bytes handed out from the block
+            */
+            size_t used;
+        };
+
+        /*!
+        *   \brief Copy field data into the Command arena
+        *   \param data The field data to copy
+        *   \param size The length of the field data
+        *   \returns The copy of the field in the arena
+        */
+        std::string_view _store(const char* data, size_t size);
+
+        /*!
+        *   \brief Append a copied field to the Command
+        *   \param data The field data to copy
+        *   \param size The length of the field data
+        *   \param is_key Boolean indicating if the field
+        *                 should be treated as a key for the
+        *                 Command.
+        */
+        void _add_local_field(const char* data, size_t size, bool is_key);
+
+        /*!
+        *   \brief Append a copied field formatted from a value
+        *   \details Integers are formatted without a temporary
+        *            string; other values use std::to_string.
+        *   \tparam T The type of the value
+        *   \param value The value to format
+        *   \param is_key Boolean indicating if the field
+        *                 should be treated as a key for the
+        *                 Command.
+        */
+        template <class T>
+        void _add_value_field(const T& value, bool is_key);
+
+        /*!
+        *   \brief Hand out memory from the Command arena
+        *   \param size The number of bytes needed
+        *   \returns A pointer to size bytes that stay valid
+        *            until the Command is emptied
+        *   \throw SmartRedis::BadAllocException if a heap block
+        *          cannot be allocated
+        */
+        char* _allocate(size_t size);
+
+        /*!
+        *   \brief Repoint fields that refer into the inline buffer
+        *          of another Command to the same place in this one
+        *   \param source_inline The inline buffer of the other Command
+        */
+        void _rebase_inline_fields(const char* source_inline);
+
         /*!
         *   \brief All local fields and
         *          pointer fields in the order that
@@ -424,25 +553,37 @@ class Command
         std::vector<std::string_view> _fields;
 
         /*!
-        *   \brief All of the fields whose memory was
-                   allocated by Command, along with
-                   their associated index in _fields
+        *   \brief The Command keys, with their hash slots
+        */
+        std::vector<CommandKey> _keys;
+
+        /*!
+        *   \brief The heap blocks of the Command arena.  The last
+        *          block is the one that small fields are taken from.
+        */
+        std::vector<ArenaBlock> _arena_blocks;
+
+        /*!
+        *   \brief The number of bytes handed out from _inline_arena
+        */
+        size_t _inline_used = 0;
+
+        /*!
+        *   \brief The size of the inline part of the arena, which
+        *          holds the copied fields of a typical command
         */
-        std::vector<std::pair<char*, size_t> > _local_fields;
+        static constexpr size_t _INLINE_ARENA_SIZE = 192;
 
         /*!
-        *   \brief All of the fields whose memory was not
-        *          allocated by Command, along with their
-        *          associated index in _fields
+        *   \brief The size of a shared heap block of the arena.
+        *          Larger fields get a block of their own.
         */
-        std::vector<std::pair<char*, size_t> > _ptr_fields;
+        static constexpr size_t _ARENA_BLOCK_SIZE = 4096;
 
         /*!
-        *   \brief Unordered map of std::string_view to
-        *          the index of _fields and _local_fields
-        *          for the std::string_view
+        *   \brief The inline part of the Command arena
         */
-        std::unordered_map<std::string_view, size_t> _cmd_keys;
+        char _inline_arena[_INLINE_ARENA_SIZE];
 
         /*!
         *   \brief Helper function for emptying the Command
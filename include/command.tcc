@@ -33,7 +33,7 @@ template <class T>
 void Command::add_fields(const std::vector<T>& fields, bool is_key)
 {
     for (size_t i = 0; i < fields.size(); i++) {
-        this->add_field(std::to_string(fields[i]), is_key);
+        _add_value_field(fields[i], is_key);
     }
 }
 
@@ -41,7 +41,23 @@ template <class T>
 void Command::add_keys(const std::vector<T>& keyfields)
 {
     for (size_t i = 0; i < keyfields.size(); i++) {
-        this->add_field(std::to_string(keyfields[i]), true);
+        _add_value_field(keyfields[i], true);
+    }
+}
+
+template <class T>
+void Command::_add_value_field(const T& value, bool is_key)
+{
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        // Large enough for any 64-bit integer and its sign
+        char buf[24];
+        std::to_chars_result result =
+            std::to_chars(buf, buf + sizeof(buf), value);
+        _add_local_field(buf, result.ptr - buf, is_key);
+    }
+    else {
+        std::string field = std::to_string(value);
+        _add_local_field(field.data(), field.size(), is_key);
     }
 }
 
@@ -275,6 +275,14 @@ class CommandReply {
             return _reply->type == REDIS_REPLY_ARRAY;
         }
 
+        /*!
+        *   \brief Determine whether the response is nil
+        *   \returns true iff the response is of type REDIS_REPLY_NIL
+        */
+        bool is_nil() {
+            return _reply->type == REDIS_REPLY_NIL;
+        }
+
         /*!
         *   \brief Print the reply structure of the CommandReply
         */
@@ -0,0 +1,228 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_COMPRESSION_H
+#define SMARTREDIS_COMPRESSION_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sr_enums.h"
+
+///@file
+
+namespace SmartRedis {
+
+/*!
+*   \brief The codecs that can compress tensor and DataSet buffers
+*/
+enum SRCompressionCodec {
+    SRCompressionNone      = 0,   // Buffers are stored uncompressed
+    SRCompressionShuffleLZ = 1,   // Byte shuffle followed by LZ compression
+    SRCompressionQuantize  = 2,   // Error-bounded quantization of floats
+    SRCompressionUserFirst = 128, // First identifier for registered codecs
+    SRCompressionUserLast  = 255  // Last identifier for registered codecs
+};
+
+/*!
+*   \brief Interface for the codecs that compress tensor and DataSet
+*          buffers
+*   \details Sites can add their own codecs by implementing this
+*            interface and registering it with
+*            register_compression_codec().  A codec only produces and
+*            consumes the payload of a compression container; the
+*            container header is written and checked by
+*            compress_buffer() and decompress_buffer().
+*/
+class CompressionCodec
+{
+    public:
+
+        /*!
+        *   \brief CompressionCodec destructor
+        */
+        virtual ~CompressionCodec() = default;
+
+        /*!
+        *   \brief Whether the codec discards information
+        *   \details Lossy codecs are given the error bound configured
+        *            for the client, which is recorded in the container
+        *            header.  They must reproduce every value to within
+        *            that absolute error.
+        *   \returns True if the codec is lossy
+        */
+        virtual bool is_lossy() const { return false; }
+
+        /*!
+        *   \brief Whether the codec can compress values of a type
+        *   \details Buffers of unsupported types, including DataSet
+        *            buffers (which have type SRTensorTypeInvalid), are
+        *            compressed with the lossless shuffle-lz codec
+        *            instead.
+        *   \param type The tensor type of the values
+        *   \returns True if the codec supports the type
+        */
+        virtual bool supports(SRTensorType type) const { return true; }
+
+        /*!
+        *   \brief Compress a buffer
+        *   \param raw The bytes to compress
+        *   \param element_size The size in bytes of the values in raw
+        *   \param type The tensor type of the values
+        *   \param level The compression level, from 1 (fastest) to 9
+        *               (smallest)
+        *   \param error_bound The largest absolute error allowed in a
+        *                     value, for lossy codecs
+        *   \returns The compressed payload
+        */
+        virtual std::string compress(std::string_view raw,
+                                     size_t element_size,
+                                     SRTensorType type,
+                                     int level,
+                                     double error_bound) const = 0;
+
+        /*!
+        *   \brief Decompress a payload produced by compress()
+        *   \param payload The compressed payload
+        *   \param element_size The size in bytes of the values
+        *   \param type The tensor type of the values
+        *   \param error_bound The error bound the payload was
+        *                     compressed with
+        *   \param raw Receives exactly raw_size uncompressed bytes
+        *   \param raw_size The size of the uncompressed buffer
+        *   \throw SmartRedis::RuntimeException if the payload is
+        *          malformed
+        */
+        virtual void decompress(std::string_view payload,
+                                size_t element_size,
+                                SRTensorType type,
+                                double error_bound,
+                                void* raw,
+                                size_t raw_size) const = 0;
+};
+
+/*!
+*   \brief Register a site-specific compression codec
+*   \details Once registered, the codec can be selected by name through
+*            SR_COMPRESSION.  Clients that read buffers compressed with
+*            the codec must register it as well.
+*   \param name The name used to select the codec (case insensitive)
+*   \param id The identifier recorded in compressed buffers, from
+*             SRCompressionUserFirst to SRCompressionUserLast
+*   \param codec The codec
+*   \throw SmartRedis::ParameterException if the identifier is out of
+*          range or the name or identifier is already registered
+*/
+void register_compression_codec(const std::string& name,
+                                SRCompressionCodec id,
+                                std::shared_ptr<CompressionCodec> codec);
+
+/*!
+*   \brief Retrieve a built-in or registered compression codec
+*   \param id The codec identifier
+*   \returns The codec
+*   \throw SmartRedis::ParameterException if no codec has the identifier
+*/
+std::shared_ptr<CompressionCodec> get_compression_codec(SRCompressionCodec id);
+
+/*!
+*   \brief Look up a compression codec by name
+*   \param name The codec name: "none", "shuffle-lz", "quantize" or the
+*               name of a registered codec (case insensitive)
+*   \returns The codec
+*   \throw SmartRedis::ParameterException if the name is not known
+*/
+SRCompressionCodec compression_codec_from_string(const std::string& name);
+
+/*!
+*   \brief Compress a buffer into a self-describing container
+*   \details The container header records the codec, the tensor type
+*            and dimensions (if any) and the uncompressed size.  For
+*            the shuffle-lz codec, the bytes of values of element_size
+*            bytes are first regrouped by significance, which turns the
+*            slowly varying high order bytes of smooth fields into long
+*            runs that the LZ stage compresses well.  If compression
+*            does not reduce the size, the values are stored as they
+*            are and the container records no codec.  Lossy codecs
+*            record the error bound in the header; buffers they do
+*            not support are compressed losslessly.
+*   \param raw The bytes to compress
+*   \param element_size The size in bytes of the values in raw
+*   \param type The tensor type of the values, or SRTensorTypeInvalid
+*               for a plain buffer
+*   \param dims The tensor dimensions, or an empty vector for a plain
+*               buffer
+*   \param codec The codec to apply
+*   \param level The compression level, from 1 (fastest) to 9
+*               (smallest)
+*   \param error_bound The largest absolute error allowed in a value,
+*                     for lossy codecs
+*   \returns The container
+*   \throw SmartRedis::ParameterException if the codec is not known or
+*          is lossy and error_bound is not positive
+*/
+std::string compress_buffer(std::string_view raw,
+                            size_t element_size,
+                            SRTensorType type,
+                            const std::vector<size_t>& dims,
+                            SRCompressionCodec codec,
+                            int level,
+                            double error_bound = 0.0);
+
+/*!
+*   \brief Check whether a buffer is a compression container
+*   \param buf The buffer to check
+*   \returns True if buf starts with a compression container header
+*/
+bool is_compressed_buffer(std::string_view buf);
+
+/*!
+*   \brief Get the error bound recorded in a compression container
+*   \param buf The container
+*   \returns The largest absolute error in any value of the container,
+*            or zero if it was compressed losslessly
+*   \throw SmartRedis::RuntimeException if buf is not a container
+*/
+double compressed_buffer_error_bound(std::string_view buf);
+
+/*!
+*   \brief Decompress a container produced by compress_buffer()
+*   \param buf The container
+*   \param type Receives the tensor type recorded in the container
+*   \param dims Receives the tensor dimensions recorded in the container
+*   \returns The uncompressed bytes
+*   \throw SmartRedis::RuntimeException if the container is malformed
+*/
+std::string decompress_buffer(std::string_view buf,
+                              SRTensorType& type,
+                              std::vector<size_t>& dims);
+
+} // namespace SmartRedis
+
+#endif // SMARTREDIS_COMPRESSION_H
@@ -31,6 +31,7 @@
 
 #ifdef __cplusplus
 #include <stdlib.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "srobject.h"
@@ -452,6 +453,38 @@ class DataSet : public SRObject
         */
         TensorBase* _get_tensorbase_obj(const std::string& name) const;
 
+        /*!
+        *   \brief Serialize all metadata fields and tensors of the
+        *          DataSet into a single self-describing buffer
+        *   \details The packed buffer starts with a fixed header and an
+        *            offset index that locates every field name, metadata
+        *            serialization, tensor name, dimension list, and
+        *            tensor data blob in the payload that follows.
+        *   \returns The packed DataSet buffer
+        *   \throw SmartRedis::Exception if the DataSet is empty
+        */
+        std::string _pack();
+
+        /*!
+        *   \brief Populate the DataSet from a packed buffer
+        *   \details Fields and tensors are decoded in place from the
+        *            supplied buffer; only the copy into the DataSet
+        *            storage is made.
+        *   \param buf The packed buffer produced by _pack()
+        *   \param buf_size The length of the buffer
+        *   \throw SmartRedis::Exception if the buffer is malformed
+        */
+        void _unpack(const char* buf, size_t buf_size);
+
+        /*!
+        *   \brief Check whether a buffer holds a packed DataSet
+        *   \param buf The buffer to inspect
+        *   \param buf_size The length of the buffer
+        *   \returns True iff the buffer starts with the packed
+        *            DataSet header
+        */
+        static bool _is_packed(const char* buf, size_t buf_size);
+
     private:
 
         /*!
@@ -497,6 +530,16 @@ class DataSet : public SRObject
         */
         mutable TensorPack _tensor_memory;
 
+        /*!
+        *   \brief Magic bytes identifying a packed DataSet buffer
+        */
+        inline static const std::string _PACKED_MAGIC = "SRDSPACK";
+
+        /*!
+        *   \brief Version of the packed DataSet buffer layout
+        */
+        inline static const uint32_t _PACKED_VERSION = 1;
+
 };
 
 /*!
@@ -31,6 +31,7 @@
 
 #include <stdlib.h>
 #include <string>
+#include <vector>
 #include "address.h"
 
 ///@file
@@ -138,6 +139,12 @@ class DBNode {
         */
         std::string prefix;
 
+        /*!
+        *   \brief The TCP addresses of the replicas of the DBNode,
+        *          as reported by CLUSTER SLOTS
+        */
+        std::vector<SRAddress> replicas;
+
 };
 
 } // namespace SmartRedis
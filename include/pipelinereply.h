@@ -161,6 +161,21 @@ class PipelineReply {
         */
         void reorder(std::vector<size_t> index_order);
 
+        /*!
+        *   \brief Replace some of the stored replies with replies
+        *          from another PipelineReply
+        *   \details This is used to splice in the replies of commands
+        *            that were run again, for example after a cluster
+        *            redirect.  The other PipelineReply is consumed.
+        *   \param reply The PipelineReply holding the new replies
+        *   \param index_map Pairs of the index of a reply to replace
+        *                    and the index of its replacement in reply
+        *   \throw SmartRedis::InternalException if an index is out
+        *          of range
+        */
+        void replace(PipelineReply&& reply,
+                     const std::vector<std::pair<size_t, size_t>>& index_map);
+
     private:
 
         /*!
@@ -0,0 +1,313 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_PYASYNCCLIENT_H
+#define SMARTREDIS_PYASYNCCLIENT_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "threadpool.h"
+#include "pyclient.h"
+#include "pydataset.h"
+#include "pysrobject.h"
+
+///@file
+
+namespace py = pybind11;
+
+namespace SmartRedis {
+
+/*!
+*   \brief The PyAsyncClient class executes requests for the Python
+*          AsyncClient on a C++ thread pool
+*   \details Each worker thread runs requests on one of a set of
+*            PyClient connections, without the GIL. Completed requests
+*            are announced by writing to a pipe, which the asyncio event
+*            loop watches; their results are then collected with the
+*            GIL held on the event loop thread.
+*/
+class PyAsyncClient : public PySRObject
+{
+    public:
+
+        /*!
+        *   \brief PyAsyncClient constructor
+        *   \param clients The connections on which requests are run,
+        *                  one per worker thread. They must outlive
+        *                  the PyAsyncClient.
+        *   \param logger_name Name to use for this object in log messages
+        *   \throw SmartRedis::Exception if no connection is given or
+        *         the completion pipe cannot be created
+        */
+        PyAsyncClient(std::vector<PyClient*> clients,
+                      const std::string& logger_name);
+
+        /*!
+        *   \brief PyAsyncClient destructor. Waits for the requests
+        *          in flight.
+        */
+        ~PyAsyncClient();
+
+        /*!
+        *   \brief Get the file descriptor that becomes readable when
+        *          requests complete
+        *   \returns The read end of the completion pipe
+        */
+        int completion_fd();
+
+        /*!
+        *   \brief Take the identifiers of the requests that completed
+        *          since the last call
+        *   \returns The request identifiers
+        */
+        std::vector<uint64_t> completed();
+
+        /*!
+        *   \brief Take the result of a completed request
+        *   \param request_id The identifier of the request
+        *   \returns The result: a numpy array for get_tensor, a PyDataset
+        *            for get_dataset, a bool for the existence checks and
+        *            None otherwise
+        *   \throw SmartRedis::Exception raised by the request, or if the
+        *         request has not completed
+        */
+        py::object result(uint64_t request_id);
+
+        /*!
+        *   \brief Wait for the requests in flight and stop the worker
+        *          threads. Further requests are rejected.
+        */
+        void shutdown();
+
+        /*!
+        *   \brief Submit a put_tensor request
+        *   \param name The name of the tensor
+        *   \param type The data type of the tensor
+        *   \param data The C-contiguous array of tensor data, which the
+        *               caller keeps alive and unchanged until the
+        *               request completes
+        *   \param store_type The data type in which to store the tensor,
+        *                     or the empty string for type
+        *   \returns The identifier of the request
+        */
+        uint64_t put_tensor(const std::string& name,
+                            const std::string& type,
+                            py::array data,
+                            const std::string& store_type);
+
+        /*!
+        *   \brief Submit a get_tensor request
+        *   \param name The name of the tensor
+        *   \returns The identifier of the request
+        */
+        uint64_t get_tensor(const std::string& name);
+
+        /*!
+        *   \brief Submit a delete_tensor request
+        *   \param name The name of the tensor
+        *   \returns The identifier of the request
+        */
+        uint64_t delete_tensor(const std::string& name);
+
+        /*!
+        *   \brief Submit a tensor_exists request
+        *   \param name The name of the tensor
+        *   \returns The identifier of the request
+        */
+        uint64_t tensor_exists(const std::string& name);
+
+        /*!
+        *   \brief Submit a put_dataset request
+        *   \param dataset The DataSet, which the caller keeps alive and
+        *                  unchanged until the request completes
+        *   \returns The identifier of the request
+        */
+        uint64_t put_dataset(PyDataset& dataset);
+
+        /*!
+        *   \brief Submit a get_dataset request
+        *   \param name The name of the DataSet
+        *   \returns The identifier of the request
+        */
+        uint64_t get_dataset(const std::string& name);
+
+        /*!
+        *   \brief Submit a delete_dataset request
+        *   \param name The name of the DataSet
+        *   \returns The identifier of the request
+        */
+        uint64_t delete_dataset(const std::string& name);
+
+        /*!
+        *   \brief Submit a dataset_exists request
+        *   \param name The name of the DataSet
+        *   \returns The identifier of the request
+        */
+        uint64_t dataset_exists(const std::string& name);
+
+        /*!
+        *   \brief Submit a run_model request
+        *   \param name The name of the model
+        *   \param inputs The names of the input tensors
+        *   \param outputs The names of the output tensors
+        *   \returns The identifier of the request
+        */
+        uint64_t run_model(const std::string& name,
+                           std::vector<std::string> inputs,
+                           std::vector<std::string> outputs);
+
+        /*!
+        *   \brief Submit a run_script request
+        *   \param name The name of the script
+        *   \param function The name of the function in the script
+        *   \param inputs The names of the input tensors
+        *   \param outputs The names of the output tensors
+        *   \returns The identifier of the request
+        */
+        uint64_t run_script(const std::string& name,
+                            const std::string& function,
+                            std::vector<std::string> inputs,
+                            std::vector<std::string> outputs);
+
+    private:
+
+        /*!
+        *   \brief The outcome of a request
+        */
+        struct Result
+        {
+            /*!
+            *   \brief The exception raised by the request, if any
+            */
+            std::exception_ptr error;
+
+            /*!
+            *   \brief The tensor fetched by get_tensor
+            */
+            std::unique_ptr<TensorBase> tensor;
+
+            /*!
+            *   \brief The DataSet fetched by get_dataset
+            */
+            std::unique_ptr<DataSet> dataset;
+
+            /*!
+            *   \brief Whether the result of the request is a flag
+            */
+            bool has_flag = false;
+
+            /*!
+            *   \brief The answer of an existence check
+            */
+            bool flag = false;
+        };
+
+        /*!
+        *   \brief Queue a request for the worker threads
+        *   \param request The request, run on a connection's C++ client
+        *   \returns The identifier of the request
+        */
+        uint64_t _submit(std::function<void(Client&, Result&)> request);
+
+        /*!
+        *   \brief Run a request on a free connection and record its result
+        *   \param request_id The identifier of the request
+        *   \param request The request
+        */
+        void _execute(uint64_t request_id,
+                      const std::function<void(Client&, Result&)>& request);
+
+        /*!
+        *   \brief The connections on which requests are run
+        */
+        std::vector<PyClient*> _clients;
+
+        /*!
+        *   \brief Indices of the connections not running a request
+        */
+        std::vector<size_t> _free_clients;
+
+        /*!
+        *   \brief The worker threads
+        */
+        std::unique_ptr<ThreadPool> _tp;
+
+        /*!
+        *   \brief Lock protecting the request bookkeeping below
+        */
+        std::mutex _lock;
+
+        /*!
+        *   \brief Signalled when a request completes
+        */
+        std::condition_variable _request_done;
+
+        /*!
+        *   \brief The identifier of the next request
+        */
+        uint64_t _next_id;
+
+        /*!
+        *   \brief The number of requests submitted but not completed
+        */
+        size_t _n_in_flight;
+
+        /*!
+        *   \brief Whether shutdown() has been called
+        */
+        bool _shut_down;
+
+        /*!
+        *   \brief Results of the completed requests, by identifier
+        */
+        std::unordered_map<uint64_t, Result> _results;
+
+        /*!
+        *   \brief Identifiers of requests completed since the last
+        *          call to completed()
+        */
+        std::vector<uint64_t> _completed;
+
+        /*!
+        *   \brief The read and write ends of the completion pipe
+        */
+        int _completion_pipe[2];
+};
+
+} // namespace SmartRedis
+
+#endif // SMARTREDIS_PYASYNCCLIENT_H
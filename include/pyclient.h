@@ -34,6 +34,7 @@
 #include <pybind11/stl_bind.h>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include "client.h"
@@ -90,6 +91,9 @@ class PyClient : public PySRObject
 
         /*!
         *   \brief Put a tensor into the database
+        *   \details Arrays that are not C-contiguous (e.g. transposed
+        *            or sliced views) are gathered into contiguous
+        *            memory in a single pass over their strides.
         *   \param name The name to associate with this tensor
         *              in the database
         *   \param type The data type of the tensor
@@ -100,6 +104,88 @@ class PyClient : public PySRObject
                         std::string& type,
                         py::array data);
 
+        /*!
+        *   \brief Put a tensor into the database, converting it
+        *          to another tensor type
+        *   \details Arrays that are not C-contiguous are gathered
+        *            before their values are converted.
+        *   \param name The name to associate with this tensor
+        *              in the database
+        *   \param type The data type of the array
+        *   \param data Numpy array with Pybind*
+        *   \param store_type The data type with which the tensor
+        *                     is stored in the database
+        *   \throw RuntimeException for all client errors
+        */
+        void put_tensor_as(std::string& name,
+                           std::string& type,
+                           py::array data,
+                           std::string& store_type);
+
+        /*!
+        *   \brief Put a tensor into the database as a delta against
+        *          the values this client last put under the same name
+        *   \details Arrays that are not C-contiguous are gathered
+        *            before they are encoded.
+        *   \param name The name to associate with this tensor
+        *              in the database
+        *   \param type The data type of the tensor
+        *   \param data Numpy array with Pybind*
+        *   \throw RuntimeException for all client errors
+        */
+        void put_tensor_delta(std::string& name,
+                              std::string& type,
+                              py::array data);
+
+        /*!
+        *   \brief Put a tensor into the database split into
+        *          N-dimensional tiles
+        *   \details Arrays that are not C-contiguous are gathered
+        *            before they are split.
+        *   \param name The name to associate with this tensor
+        *              in the database
+        *   \param type The data type of the tensor
+        *   \param data Numpy array with Pybind*
+        *   \param tile_dims The number of elements for each dimension
+        *                    of a tile
+        *   \throw RuntimeException for all client errors
+        */
+        void put_tensor_tiled(std::string& name,
+                              std::string& type,
+                              py::array data,
+                              std::vector<size_t>& tile_dims);
+
+        /*!
+        *   \brief Put a tensor into the database from a file
+        *   \param name The name to associate with this tensor
+        *              in the database
+        *   \param path The path of the file
+        *   \param dims The dimensions of the tensor in a raw file, or
+        *               an empty list for a .npy file
+        *   \param type The data type of the tensor in a raw file
+        *   \param offset The position of the first value in a raw file
+        *   \throw RuntimeException for all client errors
+        */
+        void put_tensor_from_file(const std::string& name,
+                                  const std::string& path,
+                                  std::vector<size_t>& dims,
+                                  const std::string& type,
+                                  size_t offset);
+
+        /*!
+        *   \brief Append a record to a tensor that grows along its
+        *          leading dimension
+        *   \details Arrays that are not C-contiguous are gathered
+        *            before they are sent.
+        *   \param name The name of the appendable tensor
+        *   \param type The data type of the record
+        *   \param data Numpy array with Pybind*
+        *   \throw RuntimeException for all client errors
+        */
+        void append_to_tensor(std::string& name,
+                              std::string& type,
+                              py::array data);
+
         /*!
         *   \brief  Retrieve a tensor from the database.
         *   \details The memory of the data pointer used
@@ -117,6 +203,78 @@ class PyClient : public PySRObject
         */
         py::array get_tensor(const std::string& name);
 
+        /*!
+        *   \brief Retrieve a window of the records of an appendable
+        *          tensor from the database
+        *   \param name The name used to reference the tensor
+        *   \param start The index of the first record
+        *   \param stop The index one past the last record
+        *   \throw RuntimeException for all client errors
+        */
+        py::array get_tensor_range(const std::string& name,
+                                   size_t start,
+                                   size_t stop);
+
+        /*!
+        *   \brief Retrieve a tensor from the database into an
+        *          existing array
+        *   \details The array must be writeable and have the shape
+        *            and data type of the stored tensor. Arrays that
+        *            are not C-contiguous are filled in a single pass
+        *            over their strides.
+        *   \param name The name used to reference the tensor
+        *   \param type The data type of the array
+        *   \param out The array that receives the tensor data
+        *   \throw RuntimeException for all client errors
+        */
+        void unpack_tensor(const std::string& name,
+                           const std::string& type,
+                           py::array out);
+
+        /*!
+        *   \brief Retrieve a tensor of any type from the database
+        *          into an existing array, converting its values to
+        *          the data type of the array
+        *   \details The array must be writeable and have the shape
+        *            of the stored tensor.
+        *   \param name The name used to reference the tensor
+        *   \param type The data type of the array
+        *   \param out The array that receives the tensor data
+        *   \throw RuntimeException for all client errors
+        */
+        void unpack_tensor_as(const std::string& name,
+                              const std::string& type,
+                              py::array out);
+
+        /*!
+        *   \brief Retrieve a tensor from the database into a file
+        *   \param name The name used to reference the tensor
+        *   \param path The path of the file
+        *   \throw RuntimeException for all client errors
+        */
+        void unpack_tensor_to_file(const std::string& name,
+                                   const std::string& path);
+
+        /*!
+        *   \brief Retrieve a sub-region of a tensor from the database
+        *          into an existing array
+        *   \details The array must be writeable and have the data type
+        *            of the stored tensor and the shape given by counts.
+        *   \param name The name used to reference the tensor
+        *   \param type The data type of the array
+        *   \param offsets The coordinates of the first value of the
+        *                  region
+        *   \param counts The number of values of the region along each
+        *                 dimension
+        *   \param out The array that receives the region
+        *   \throw RuntimeException for all client errors
+        */
+        void unpack_tensor_slice(const std::string& name,
+                                 const std::string& type,
+                                 std::vector<size_t>& offsets,
+                                 std::vector<size_t>& counts,
+                                 py::array out);
+
         /*!
         *   \brief delete a tensor stored in the database
         *   \param name The name of tensor to delete
@@ -161,6 +319,23 @@ class PyClient : public PySRObject
         PyDataset* get_dataset(const std::string& name);
 
 
+        /*!
+        *   \brief Send multiple PyDataSet objects to the database
+        *   \param datasets The PyDataSet objects to send to the database
+        *   \throw RuntimeException for all client errors
+        */
+        void put_datasets(std::vector<PyDataset*>& datasets);
+
+
+        /*!
+        *   \brief Get multiple PyDataSet objects from the database
+        *   \param names The names of the datasets to retrieve
+        *   \returns A list of PyDataSet objects, in the order of names
+        *   \throw RuntimeException for all client errors
+        */
+        py::list get_datasets(const std::vector<std::string>& names);
+
+
         /*!
         *   \brief delete a dataset stored in the database
         *   \param name The name of dataset to delete
@@ -685,6 +860,58 @@ class PyClient : public PySRObject
         */
         void use_dataset_ensemble_prefix(bool use_prefix);
 
+        /*!
+        * \brief Set whether DataSets should be stored in the packed
+        *        format, with all tensors and metadata fields serialized
+        *        into a single buffer. DataSets are retrieved correctly
+        *        regardless of this setting.
+        *        By default, the client does not pack DataSets.
+        *
+        * \param use_packed If set to true, all future put_dataset()
+        *                   operations will use the packed format
+        */
+        void use_packed_datasets(bool use_packed);
+
+        /*!
+        * \brief Set whether DataSets should be published atomically
+        *        by wrapping their placement in a MULTI/EXEC transaction.
+        *        By default, DataSets are published in a pipeline and
+        *        completion is signalled by the DataSet ack field.
+        *
+        * \param use_transactions If set to true, all future DataSet
+        *                         placement operations will be atomic
+        */
+        void use_dataset_transactions(bool use_transactions);
+
+        /*!
+        * \brief Set the time to live of tensors placed by put_tensor().
+        *        By default, tensors do not expire.
+        *
+        * \param ttl_ms The time to live in milliseconds, or zero to
+        *               disable expiry
+        */
+        void set_tensor_ttl(int ttl_ms);
+
+        /*!
+        * \brief Set the time to live of DataSets placed by
+        *        put_dataset(), put_datasets() and copy_dataset().
+        *        By default, DataSets do not expire.
+        *
+        * \param ttl_ms The time to live in milliseconds, or zero to
+        *               disable expiry
+        */
+        void set_dataset_ttl(int ttl_ms);
+
+        /*!
+        * \brief Set the maximum number of entries retained in
+        *        aggregation lists by append_to_list().
+        *        By default, aggregation lists are not trimmed.
+        *
+        * \param max_length The number of entries to retain, or zero
+        *                   to disable trimming
+        */
+        void set_list_retention(int max_length);
+
         /*!
         *   \brief Returns information about the given database nodes
         *   \param addresses The addresses of the database nodes. Each address is
@@ -981,8 +1208,26 @@ class PyClient : public PySRObject
         */
         Client* _client;
 
+        /*!
+        *   \brief Lock serializing the calls of Python threads that
+        *          share this Client
+        */
+        std::mutex _client_lock;
+
+        /*!
+        *   \brief PyAsyncClient runs requests on the C++ client of
+        *          its connections
+        */
+        friend class PyAsyncClient;
 };
 
+/*!
+*   \brief Wrap a TensorBase in a numpy array that takes ownership of it
+*   \param tensor The TensorBase, allocated on the heap
+*   \returns The numpy array
+*/
+py::array tensor_to_array(TensorBase* tensor);
+
 } // namespace SmartRedis
 
 #endif // SMARTREDIS_PYCLIENT_H
@@ -31,6 +31,7 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include <string>
 #include "srobject.h"
 
@@ -108,6 +109,24 @@ class PySRObject
         SRObject* _srobject;
 };
 
+/*!
+*   \brief Get the numpy dtype used for bfloat16 tensors
+*   \details numpy has no native bfloat16 type. The type registered
+*            by the ml_dtypes package is used when it is installed;
+*            otherwise the raw 16 bit patterns are exposed as uint16.
+*   \returns The numpy dtype for bfloat16 tensor data
+*/
+inline py::dtype bfloat16_dtype()
+{
+    try {
+        py::object bfloat16 = py::module_::import("ml_dtypes").attr("bfloat16");
+        return py::dtype::from_args(bfloat16);
+    }
+    catch (py::error_already_set& e) {
+        return py::dtype::of<uint16_t>();
+    }
+}
+
 } // namespace SmartRedis
 
 #endif // SMARTREDIS_PYSROBJECT_H
@@ -538,6 +538,14 @@ class Redis : public RedisServer
         */
         PipelineReply run_in_pipeline(CommandList& cmdlist);
 
+        /*!
+        *   \brief Run a CommandList atomically in a MULTI/EXEC transaction
+        *   \param cmdlist The list of commands to run
+        *   \returns The PipelineReply with the result of each command
+        *   \throw SmartRedis::Exception if execution fails
+        */
+        PipelineReply run_in_transaction(CommandList& cmdlist);
+
         /*!
         *   \brief Create a string representation of the Redis connection
         *   \returns A string representation of the Redis connection
@@ -546,6 +554,11 @@ class Redis : public RedisServer
 
     private:
 
+        /*!
+        *   \brief RedisShards runs pipelines on its shards directly
+        */
+        friend class RedisShards;
+
         /*!
         *   \brief sw::redis::Redis object pointer
         */
@@ -580,6 +593,14 @@ class Redis : public RedisServer
         */
         PipelineReply _run_pipeline(std::vector<Command*>& cmds);
 
+        /*!
+        *   \brief Execute a series of commands in a MULTI/EXEC transaction
+        *   \param cmds The commands to execute
+        *   \returns Reply from the command execution
+        *   \throw SmartRedis::Exception if command execution fails
+        */
+        PipelineReply _run_transaction(std::vector<Command*>& cmds);
+
 };
 
 } // namespace SmartRedis
@@ -31,6 +31,9 @@
 
 #include <unordered_set>
 #include <mutex>
+#include <shared_mutex>
+#include <chrono>
+#include <memory>
 #include <algorithm>
 
 #include "redisserver.h"
@@ -46,6 +49,15 @@ namespace SmartRedis {
 
 class SRObject;
 
+/*!
+*   \brief  Policies for serving reads from the replicas of a cluster
+*/
+enum SRReplicaReadPolicy {
+    SRReplicaReadsNone       = 0, // All reads are served by masters
+    SRReplicaReadsRandom     = 1, // Reads go to a random replica
+    SRReplicaReadsRoundRobin = 2  // Reads rotate over the replicas
+};
+
 /*!
 *   \brief  The RedisCluster class executes RedisServer
 *           commands on a redis cluster.
@@ -547,6 +559,15 @@ class RedisCluster : public RedisServer
         */
         PipelineReply run_in_pipeline(CommandList& cmdlist);
 
+        /*!
+        *   \brief Run a CommandList atomically in a MULTI/EXEC transaction.
+        *          All commands must address keys in the same hash slot
+        *   \param cmdlist The list of commands to run
+        *   \returns The PipelineReply with the result of each command
+        *   \throw SmartRedis::Exception if execution fails
+        */
+        PipelineReply run_in_transaction(CommandList& cmdlist);
+
         /*!
         *   \brief Create a string representation of the Redis connection
         *   \returns A string representation of the Redis connection
@@ -564,6 +585,43 @@ class RedisCluster : public RedisServer
         */
         std::string _get_crc16_prefix(uint64_t hash_slot);
 
+        /*!
+        *   \brief Get the prefix that can be used to address
+        *          the correct database for a given command
+        *   \details The hash slots of the Command keys are cached
+        *            by the Command, so routing only looks them up
+        *            in the slot table and does not allocate.  The
+        *            prefix is returned by value because the slot
+        *            map may be rebuilt by another thread.
+        *   \param cmd The Command to analyze for DBNode prefix
+        *   \returns The DBNode prefix
+        *   \throw RuntimeException if the Command does not have
+        *          keys or if multiple keys have different prefixes
+        */
+        std::string _get_db_node_prefix(const Command& cmd);
+
+        /*!
+        *   \brief Rebuild the slot map after the cluster changed
+        *   \details Refreshes are serialized and throttled.  If
+        *            another thread started a refresh after the change
+        *            was observed, this returns without refreshing.
+        *   \param observed When the change was observed
+        *   \param hash_slot A hash slot affected by the change
+        *   \throw SmartRedis::Exception if CLUSTER SLOTS fails
+        */
+        void _refresh_cluster_map(
+            std::chrono::steady_clock::time_point observed,
+            uint16_t hash_slot);
+
+        /*!
+        *   \brief Get a copy of the DBNodes of the cluster
+        *   \details The copy stays valid when the slot map is
+        *            refreshed, so it can be iterated while running
+        *            commands that may be redirected.
+        *   \returns The DBNodes of the cluster
+        */
+        std::vector<DBNode> _get_db_nodes();
+
     private:
 
         /*!
@@ -576,11 +634,304 @@ class RedisCluster : public RedisServer
         */
         std::vector<DBNode> _db_nodes;
 
+        /*!
+        *   \brief The index in _db_nodes of the DBNode serving each
+        *          hash slot, or _UNSERVED_SLOT, rebuilt from
+        *          CLUSTER SLOTS
+        */
+        std::vector<uint16_t> _slot_db_nodes;
+
+        /*!
+        *   \brief The _slot_db_nodes entry of a hash slot that no
+        *          DBNode serves
+        */
+        static constexpr uint16_t _UNSERVED_SLOT = 0xFFFF;
+
+        /*!
+        *   \brief The number of hash slots in a Redis cluster
+        */
+        static constexpr size_t _N_HASH_SLOTS = 16384;
+
         /*!
         *   \brief Prefix of the most recently used DBNode
         */
         std::string _last_prefix;
 
+        /*!
+        *   \brief Guards _db_nodes, _address_node_map and
+        *          _slot_db_nodes.  Routing takes it shared; a slot
+        *          map refresh takes it exclusively.
+        */
+        mutable std::shared_mutex _slot_map_lock;
+
+        /*!
+        *   \brief Serializes slot map refreshes
+        */
+        std::mutex _refresh_lock;
+
+        /*!
+        *   \brief When the most recent slot map refresh started
+        */
+        std::chrono::steady_clock::time_point _last_map_refresh;
+
+        /*!
+        *   \brief The minimum time between slot map refreshes,
+        *          in milliseconds
+        */
+        static constexpr int _MIN_MAP_REFRESH_INTERVAL = 100;
+
+        /*!
+        *   \brief The maximum number of MOVED or ASK redirects
+        *          followed for one command
+        */
+        static constexpr int _MAX_REDIRECTS = 5;
+
+        /*!
+        *   \brief A connection to a cluster node through a Unix
+        *          domain socket
+        */
+        struct UDSConnection {
+            /*!
+            *   \brief The Unix domain socket address of the node
+            */
+            SRAddress address;
+
+            /*!
+            *   \brief The connection to the node
+            */
+            std::unique_ptr<sw::redis::Redis> redis;
+        };
+
+        /*!
+        *   \brief Unix domain socket connections to local cluster
+        *          nodes, by the TCP address the cluster knows each
+        *          node by.  Filled in the constructor only.
+        */
+        std::unordered_map<std::string, UDSConnection> _uds_connections;
+
+        /*!
+        *   \brief The Unix domain socket connection to each DBNode
+        *          that has one, by DBNode prefix.  Rebuilt with the
+        *          slot map and guarded by _slot_map_lock.
+        */
+        std::unordered_map<std::string, sw::redis::Redis*> _uds_prefixes;
+
+        /*!
+        *   \brief Connect to a cluster node through a Unix domain
+        *          socket and find the TCP address by which the rest
+        *          of the cluster knows it
+        *   \param uds_address The Unix domain socket of the node
+        *   \returns The TCP address of the node
+        *   \throw SmartRedis::Exception if the node cannot be reached
+        *          or does not report its address
+        */
+        SRAddress _connect_uds_node(const SRAddress& uds_address);
+
+        /*!
+        *   \brief Get the Unix domain socket connection to a DBNode
+        *   \param db_prefix The prefix of the DBNode
+        *   \returns The connection, or NULL if the DBNode is reached
+        *            over TCP
+        */
+        sw::redis::Redis* _get_uds_connection(const std::string& db_prefix);
+
+        /*!
+        *   \brief Get a Pipeline to a DBNode, through its Unix domain
+        *          socket if it has one
+        *   \param db_prefix The prefix of the DBNode
+        *   \returns A Pipeline that shares a pooled connection
+        */
+        sw::redis::Pipeline _get_pipeline(const std::string& db_prefix);
+
+        /*!
+        *   \brief How reads are spread over replicas, read from the
+        *          SR_REPLICA_READS configuration setting
+        */
+        SRReplicaReadPolicy _replica_read_policy;
+
+        /*!
+        *   \brief The number of reads sent to replicas, which
+        *          drives the round robin policy
+        */
+        uint64_t _replica_read_count;
+
+        /*!
+        *   \brief A READONLY connection to a replica
+        */
+        struct ReplicaConnection {
+            /*!
+            *   \brief The connection to the replica
+            */
+            std::unique_ptr<sw::redis::Redis> redis;
+
+            /*!
+            *   \brief Reads skip the replica until this time after
+            *          it failed to answer
+            */
+            std::chrono::steady_clock::time_point retry_after;
+        };
+
+        /*!
+        *   \brief Replica connections by address.  Connections are
+        *          opened on first use and kept for the lifetime of
+        *          the RedisCluster.
+        */
+        std::unordered_map<std::string, ReplicaConnection>
+            _replica_connections;
+
+        /*!
+        *   \brief Guards _replica_connections, _replica_read_count
+        *          and the random number generator used to pick replicas
+        */
+        std::mutex _replica_lock;
+
+        /*!
+        *   \brief How long reads skip a replica that failed to
+        *          answer, in milliseconds
+        */
+        static constexpr int _REPLICA_RETRY_INTERVAL = 1000;
+
+        /*!
+        *   \brief Read the replica read policy from the
+        *          SR_REPLICA_READS configuration setting
+        *   \throw SmartRedis::ParameterException if the setting
+        *          is not a known policy
+        */
+        void _get_replica_read_settings();
+
+        /*!
+        *   \brief Pick a replica of the DBNode serving a hash slot
+        *          according to the replica read policy
+        *   \param hash_slot The hash slot to be read
+        *   \returns The connection to the replica, or NULL if reads
+        *            of the hash slot should go to its master
+        */
+        ReplicaConnection* _get_replica(uint16_t hash_slot);
+
+        /*!
+        *   \brief Check whether a Command may be served by a replica
+        *   \param cmd The Command to check
+        *   \returns True if replica reads are enabled and the Command
+        *            is a keyed read-only Command
+        */
+        bool _is_replica_read(const Command& cmd) const;
+
+        /*!
+        *   \brief Check whether a reply from a replica must be
+        *          confirmed by the master
+        *   \details A replica may lag behind its master, so errors,
+        *            nil and empty replies and a count of zero from a
+        *            replica are read again from the master.
+        *   \param reply The reply from the replica
+        *   \returns True if the read should go to the master
+        */
+        bool _is_replica_miss(CommandReply& reply);
+
+        /*!
+        *   \brief Run a read-only Command on a replica
+        *   \param cmd The Command to run
+        *   \param reply Receives the reply of the replica
+        *   \returns True if a replica answered the Command.  When
+        *            false, the Command must be run on the master.
+        */
+        bool _run_on_replica(const Command& cmd, CommandReply& reply);
+
+        /*!
+        *   \brief Run read-only Commands for one hash slot on a
+        *          replica via a Pipeline
+        *   \param cmds The Commands to run
+        *   \param reply Receives the replies of the replica
+        *   \returns True if a replica answered every Command.  When
+        *            false, the Commands must be run on the master.
+        */
+        bool _run_pipeline_on_replica(std::vector<Command*>& cmds,
+                                      PipelineReply& reply);
+
+        /*!
+        *   \brief A MOVED or ASK redirect returned by a cluster node
+        */
+        struct Redirect {
+            /*!
+            *   \brief True for ASK, false for MOVED
+            */
+            bool ask;
+
+            /*!
+            *   \brief The hash slot of the redirected key
+            */
+            uint16_t slot;
+
+            /*!
+            *   \brief The address of the node to redirect to
+            */
+            std::string address;
+        };
+
+        /*!
+        *   \brief Check whether a reply is a MOVED or ASK redirect
+        *   \param reply The reply to check
+        *   \param redirect Receives the redirect
+        *   \returns True if the reply is a redirect
+        */
+        bool _get_redirect(CommandReply& reply, Redirect& redirect);
+
+        /*!
+        *   \brief Build a Redirect from a redis++ redirection error
+        *   \param error The error thrown by redis++
+        *   \param ask True for an ASK redirect, false for MOVED
+        *   \returns The redirect
+        */
+        Redirect _get_redirect(const sw::redis::RedirectionError& error,
+                               bool ask);
+
+        /*!
+        *   \brief Get the prefix of the DBNode a redirect points to
+        *   \details A MOVED redirect is resolved with the slot map,
+        *            which should be refreshed first.  An ASK redirect
+        *            is resolved with the node address.
+        *   \param redirect The redirect
+        *   \returns The DBNode prefix
+        *   \throw RuntimeException if the node is not known
+        */
+        std::string _get_redirect_prefix(const Redirect& redirect);
+
+        /*!
+        *   \brief Refresh the slot map after a connection failure,
+        *          such as a master going down, and route a keyed
+        *          command again
+        *   \details Failures to refresh are logged, not thrown,
+        *            since the cluster may still be electing a new
+        *            master.  Commands without keys are not rerouted.
+        *   \param cmd The command being run
+        *   \param db_prefix The prefix to update with the new route
+        */
+        void _reroute_after_failure(const Command& cmd,
+                                    std::string& db_prefix);
+
+        /*!
+        *   \brief Run a command on a node after ASKING, for a key
+        *          in a hash slot that the node is importing
+        *   \param cmd The command to run
+        *   \param db_prefix The prefix of the importing node
+        *   \returns The reply to the command
+        */
+        CommandReply _run_asking(const Command& cmd,
+                                 const std::string& db_prefix);
+
+        /*!
+        *   \brief Run the redirected commands of a pipeline again on
+        *          the nodes they were redirected to
+        *   \details Only the redirected commands are run again,
+        *            grouped into one pipeline per node, and their
+        *            replies are spliced into reply.
+        *   \param cmds The commands of the pipeline
+        *   \param reply The replies of the pipeline
+        *   \returns False if a reply has an error other than a
+        *            redirect, or redirects persist
+        */
+        bool _reroute_pipeline(std::vector<Command*>& cmds,
+                               PipelineReply& reply);
+
         /*!
         *   \brief Run the command on the correct db node
         *   \param cmd The command to run on the server
@@ -589,7 +940,8 @@ class RedisCluster : public RedisServer
         *   \returns The CommandReply from the command execution
         *   \throw SmartRedis::Exception if command execution fails
         */
-        inline CommandReply _run(const Command& cmd, std::string db_prefix);
+        inline CommandReply _run(const Command& cmd,
+                                 const std::string& db_prefix);
 
         /*!
         *   \brief Connect to the cluster at the address and port
@@ -604,24 +956,54 @@ class RedisCluster : public RedisServer
         */
         inline void _map_cluster();
 
-        /*!
-        *   \brief Get the prefix that can be used to address
-        *          the correct database for a given command
-        *   \param cmd The Command to analyze for DBNode prefix
-        *   \returns The DBNode prefix as a string
-        *   \throw RuntimeException if the Command does not have
-        *          keys or if multiple keys have different prefixes
-        */
-        std::string _get_db_node_prefix(Command& cmd);
-
         /*!
         *   \brief Get the index of the database node corresponding
         *          to the provided key
+        *   \details The index is only meaningful until the slot map
+        *            is next refreshed.
         *   \param key The command key
         *   \returns The index in _db_nodes corresponding to the key
+        *   \throw RuntimeException if no DBNode serves the hash
+        *          slot of the key
         */
         inline uint16_t _get_db_node_index(const std::string& key);
 
+        /*!
+        *   \brief Get the prefix of the database node serving the
+        *          provided key
+        *   \param key The key
+        *   \returns The prefix of the DBNode serving the key
+        *   \throw RuntimeException if no DBNode serves the hash
+        *          slot of the key
+        */
+        std::string _get_key_prefix(const std::string& key);
+
+        /*!
+        *   \brief Get the prefix of the database node at an address
+        *   \param address The address of the DBNode
+        *   \returns The prefix of the DBNode
+        *   \throw RuntimeException if no DBNode has the address
+        */
+        std::string _get_address_prefix(const SRAddress& address);
+
+        /*!
+        *   \brief Get the prefix of the first database node, under
+        *          which models and scripts are stored
+        *   \returns The prefix of the first DBNode
+        *   \throw RuntimeException if the cluster has no DBNode
+        */
+        std::string _get_first_prefix();
+
+        /*!
+        *   \brief Get the index of the database node serving a
+        *          hash slot
+        *   \details The caller must hold _slot_map_lock.
+        *   \param hash_slot The hash slot
+        *   \returns The index in _db_nodes serving the hash slot
+        *   \throw RuntimeException if no DBNode serves the hash slot
+        */
+        inline uint16_t _get_db_node_index(uint16_t hash_slot);
+
         /*!
         *   \brief Processes the CommandReply for CLUSTER SLOTS
         *          to build DBNode information
@@ -666,24 +1048,6 @@ class RedisCluster : public RedisServer
         bool _is_valid_inverse(uint64_t char_bits,
                                const size_t n_chars);
 
-        /*!
-        *   \brief Determine if the key has a substring
-        *          enclosed by "{" and "}" characters
-        *   \param key The key to examine
-        *   \returns True if the key contains a substring
-        *            enclosed by "{" and "}" characters
-        */
-        bool _has_hash_tag(const std::string& key);
-
-        /*!
-        *   \brief  Return the key enclosed by "{" and "}"
-        *           characters
-        *   \param key The key to examine
-        *   \returns The first substring enclosed by "{" and "}"
-        *           characters
-        */
-        std::string _get_hash_tag(const std::string& key);
-
         /*!
         *   \brief  Get the hash slot for a key
         *   \param key The key to examine
@@ -691,20 +1055,6 @@ class RedisCluster : public RedisServer
         */
         uint16_t _get_hash_slot(const std::string& key);
 
-        /*!
-        *   \brief  Get the index of the DBNode responsible
-        *           for the hash slot
-        *   \param hash_slot The hash slot to search for
-        *   \param lhs The lower bound of the DBNode array to
-        *              search (inclusive)
-        *   \param rhs The upper bound of the DBNode array to
-        *              search (inclusive)
-        *   \returns DBNode index responsible for the hash slot
-        */
-        uint16_t _db_node_hash_search(uint16_t hash_slot,
-                                      unsigned lhs,
-                                      unsigned rhs);
-
         /*!
         *   \brief  Attaches a prefix and constant suffix to keys to
         *           enforce identical hash slot constraint
@@ -748,9 +1098,10 @@ class RedisCluster : public RedisServer
         *                 in the model
         *   \param outputs The keys of output tensors that
         *                 will be used to save model results
+        *   \returns The prefix of the db node
         */
-        DBNode* _get_model_script_db(std::vector<std::string>& inputs,
-                                     std::vector<std::string>& outputs);
+        std::string _get_model_script_db(std::vector<std::string>& inputs,
+                                         std::vector<std::string>& outputs);
 
         /*!
         *   \brief Reconfigure the chunking size that Redis uses for model
@@ -783,6 +1134,21 @@ class RedisCluster : public RedisServer
         */
         PipelineReply _run_pipeline(std::vector<Command*>& cmds,
                                     std::string& shard_prefix);
+
+        /*!
+        *   \brief Execute the provided commands in a MULTI/EXEC
+        *          transaction. The provided commands MUST address
+        *          keys in a single hash slot.
+        *   \param cmds Vector of Command pointers to execute
+        *   \param shard_prefix The prefix corresponding to the shard
+        *                       where the transaction is executed
+        *   \return A PipelineReply for the provided commands.  The
+        *           PipelineReply will be in the same order as the provided
+        *           Command vector.
+        *   \throw SmartRedis::Exception if transaction execution fails
+        */
+        PipelineReply _run_transaction(std::vector<Command*>& cmds,
+                                       std::string& shard_prefix);
 };
 
 } // namespace SmartRedis
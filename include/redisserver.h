@@ -30,6 +30,7 @@
 #define SMARTREDIS_REDISSERVER_H
 
 #include <thread>
+#include <mutex>
 #include <iostream>
 #include <random>
 #include <limits.h>
@@ -562,6 +563,16 @@ class RedisServer {
         */
         virtual PipelineReply run_in_pipeline(CommandList& cmdlist) = 0;
 
+        /*!
+        *   \brief Run a CommandList atomically in a MULTI/EXEC
+        *          transaction. For clustered databases all commands
+        *          must address keys in the same hash slot
+        *   \param cmdlist The list of commands to run
+        *   \returns The PipelineReply with the result of each command
+        *   \throw SmartRedis::Exception if execution fails
+        */
+        virtual PipelineReply run_in_transaction(CommandList& cmdlist) = 0;
+
         /*!
         *   \brief Create a string representation of the Redis connection
         *   \returns A string representation of the Redis connection
@@ -673,10 +684,15 @@ class RedisServer {
         int _thread_count;
 
         /*!
-        *   \brief The thread pool
+        *   \brief The thread pool, or NULL until it is first used
         */
         ThreadPool *_tp;
 
+        /*!
+        *   \brief Guards the creation of the thread pool
+        */
+        std::once_flag _tp_created;
+
         /*!
         *   \brief Indicates whether the server was connected to
         *          via a Unix domain socket (true) or TCP connection
@@ -740,6 +756,15 @@ class RedisServer {
         */
         SRAddress _get_ssdb();
 
+        /*!
+        *   \brief Retrieve all of the addresses listed in the
+        *          SSDB environment variable
+        *   \returns The SRAddress of each listed server, in order
+        *   \throw RuntimeException if SSDB is not set or is not
+        *          well formed
+        */
+        std::vector<SRAddress> _get_ssdb_addresses();
+
         /*!
         *   \brief Unordered map of server address string to DBNode in the cluster
         */
@@ -763,6 +788,15 @@ class RedisServer {
         */
         void _check_runtime_variables();
 
+        /*!
+        *   \brief Get the thread pool, creating it on first use
+        *   \details The connections to the shards of a sharded
+        *            database never use their thread pool, so none is
+        *            started for them.
+        *   \returns The thread pool
+        */
+        ThreadPool* _get_thread_pool();
+
         /*!
         *   \brief Modular arithmetic that supports negative numbers
         *   \param value The number to be modularized
@@ -61,15 +61,20 @@ typedef enum {
 *   \brief  Enumeration for tensor data types
 */
 typedef enum {
-    SRTensorTypeInvalid = 0, // Invalid or uninitialized tensor type
-    SRTensorTypeDouble  = 1, // Double-precision floating point tensor type
-    SRTensorTypeFloat   = 2, // Floating point tensor type
-    SRTensorTypeInt8    = 3, // 8-bit signed integer tensor type
-    SRTensorTypeInt16   = 4, // 16-bit signed integer tensor type
-    SRTensorTypeInt32   = 5, // 32-bit signed integer tensor type
-    SRTensorTypeInt64   = 6, // 64-bit signed integer tensor type
-    SRTensorTypeUint8   = 7, // 8-bit unsigned integer tensor type
-    SRTensorTypeUint16  = 8  // 16-bit unsigned integer tensor type
+    SRTensorTypeInvalid  = 0,  // Invalid or uninitialized tensor type
+    SRTensorTypeDouble   = 1,  // Double-precision floating point tensor type
+    SRTensorTypeFloat    = 2,  // Floating point tensor type
+    SRTensorTypeInt8     = 3,  // 8-bit signed integer tensor type
+    SRTensorTypeInt16    = 4,  // 16-bit signed integer tensor type
+    SRTensorTypeInt32    = 5,  // 32-bit signed integer tensor type
+    SRTensorTypeInt64    = 6,  // 64-bit signed integer tensor type
+    SRTensorTypeUint8    = 7,  // 8-bit unsigned integer tensor type
+    SRTensorTypeUint16   = 8,  // 16-bit unsigned integer tensor type
+    SRTensorTypeBool     = 9,  // Boolean tensor type
+    SRTensorTypeUint32   = 10, // 32-bit unsigned integer tensor type
+    SRTensorTypeUint64   = 11, // 64-bit unsigned integer tensor type
+    SRTensorTypeFloat16  = 12, // IEEE half-precision floating point tensor type
+    SRTensorTypeBFloat16 = 13  // bfloat16 floating point tensor type
 } SRTensorType;
 
 /*!
@@ -35,6 +35,7 @@
 #include "tensorbase.h"
 #include "sharedmemorylist.h"
 #include "srexception.h"
+#include "tensorconvert.h"
 
 ///@file
 
@@ -64,6 +65,50 @@ class Tensor : public TensorBase
                const SRTensorType type,
                const SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Tensor constructor from strided source data
+        *   \details Element (i_0, ..., i_n) of the tensor is read
+        *            from data[offset + i_0*strides[0] + ... +
+        *            i_n*strides[n]], so a sub-block of a larger
+        *            (e.g. halo-padded) array can be gathered
+        *            without an intermediate copy
+        *   \param name The name used to reference the tensor
+        *   \param data c-ptr to the source data for the tensor
+        *   \param dims The dimensions of the tensor
+        *   \param strides The distance, in elements, between
+        *                  consecutive entries along each dimension
+        *   \param offset The position, in elements, of the first
+        *                 tensor entry relative to data
+        *   \param type The data type of the tensor
+        */
+        Tensor(const std::string& name,
+               const void* data,
+               const std::vector<size_t>& dims,
+               const std::vector<size_t>& strides,
+               const size_t offset,
+               const SRTensorType type);
+
+        /*!
+        *   \brief Tensor constructor converting contiguous source
+        *          data of another tensor type
+        *   \details The source values are converted to the tensor
+        *            type while they are copied into the tensor, so
+        *            no intermediate buffer is needed.  See
+        *            convert_tensor_values() for the conversion rules.
+        *   \param name The name used to reference the tensor
+        *   \param data c-ptr to the contiguous source data
+        *   \param dims The dimensions of the tensor
+        *   \param type The data type of the tensor
+        *   \param src_type The data type of the source data
+        *   \throw SmartRedis::ParameterException if a source value
+        *          cannot be represented in the tensor type
+        */
+        Tensor(const std::string& name,
+               const void* data,
+               const std::vector<size_t>& dims,
+               const SRTensorType type,
+               const SRTensorType src_type);
+
         /*!
         *   \brief Tensor copy constructor
         *   \param tensor The Tensor to copy for construction
@@ -131,6 +176,21 @@ class Tensor : public TensorBase
                                     std::vector<size_t> dims,
                                     SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Fill a user provided strided memory space with
+        *          values from tensor data
+        *   \param data Pointer to the allocated memory space
+        *   \param dims The dimensions of the memory space
+        *   \param strides The distance, in elements, between
+        *                  consecutive entries along each dimension
+        *   \param offset The position, in elements, of the first
+        *                 entry relative to data
+        */
+        virtual void fill_mem_space_strided(void* data,
+                                            const std::vector<size_t>& dims,
+                                            const std::vector<size_t>& strides,
+                                            const size_t offset);
+
     protected:
 
     private:
@@ -217,6 +277,38 @@ class Tensor : public TensorBase
                                       const std::vector<size_t>& dims,
                                       const SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Copy values between a contiguous row major
+        *          memory space and a strided memory space
+        *   \details The outer dimensions are walked with an
+        *            odometer so that only one pass is made over
+        *            the data.  Rows with a unit innermost stride
+        *            are copied with a single memcpy.
+        *   \param contiguous A pointer to the row major memory space
+        *   \param strided A pointer to the first entry of the
+        *                  strided memory space
+        *   \param dims The dimensions of the tensor
+        *   \param strides The distance, in elements, between
+        *                  consecutive entries along each dimension
+        *   \param gather True to copy from the strided space into
+        *                 the contiguous space, false to scatter the
+        *                 contiguous space into the strided space
+        */
+        void _strided_memcpy(T* contiguous,
+                             T* strided,
+                             const std::vector<size_t>& dims,
+                             const std::vector<size_t>& strides,
+                             const bool gather);
+
+        /*!
+        *   \brief Check that a strides vector is valid for
+        *          the given dimensions
+        *   \param dims The dimensions of the tensor
+        *   \param strides The strides to validate
+        */
+        void _check_strides(const std::vector<size_t>& dims,
+                            const std::vector<size_t>& strides);
+
         /*!
         *   \brief This function will copy a fortran array
         *          memory space (column major) to a c-style
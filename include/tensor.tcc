@@ -43,6 +43,53 @@ Tensor<T>::Tensor(const std::string& name,
     _set_tensor_data(data, dims, mem_layout);
 }
 
+// Tensor constructor from strided source data
+template <class T>
+Tensor<T>::Tensor(const std::string& name,
+                  const void* data,
+                  const std::vector<size_t>& dims,
+                  const std::vector<size_t>& strides,
+                  const size_t offset,
+                  const SRTensorType type) :
+                  TensorBase(name, data, dims, type)
+{
+    _data = NULL;
+    _check_strides(dims, strides);
+
+    try {
+        _data = new unsigned char[_n_data_bytes()];
+    }
+    catch (std::bad_alloc& e) {
+        throw SRBadAllocException("tensor data");
+    }
+
+    // Gather the source entries straight into the tensor buffer
+    T* src = (T*)data + offset;
+    _strided_memcpy((T*)_data, src, dims, strides, true);
+}
+
+// Tensor constructor converting source data of another type
+template <class T>
+Tensor<T>::Tensor(const std::string& name,
+                  const void* data,
+                  const std::vector<size_t>& dims,
+                  const SRTensorType type,
+                  const SRTensorType src_type) :
+                  TensorBase(name, data, dims, type)
+{
+    _data = NULL;
+
+    try {
+        _data = new unsigned char[_n_data_bytes()];
+    }
+    catch (std::bad_alloc& e) {
+        throw SRBadAllocException("tensor data");
+    }
+
+    // Convert the source values straight into the tensor buffer
+    convert_tensor_values(data, src_type, _data, type, num_values());
+}
+
 // Tensor copy constructor
 template <class T>
 Tensor<T>::Tensor(const Tensor<T>& tensor) : TensorBase(tensor)
@@ -216,6 +263,35 @@ void Tensor<T>::fill_mem_space(void* data,
     }
 }
 
+// Fill a user provided strided memory space with values from tensor data
+template <class T>
+void Tensor<T>::fill_mem_space_strided(void* data,
+                                       const std::vector<size_t>& dims,
+                                       const std::vector<size_t>& strides,
+                                       const size_t offset)
+{
+    if (_data == NULL) {
+        throw SRRuntimeException("The tensor does not have "\
+                                 "a data array to fill with.");
+    }
+    if (data == NULL) {
+        throw SRParameterException("A destination memory space "\
+                                   "must be provided.");
+    }
+
+    // The destination must have exactly the shape of the tensor
+    if (dims != _dims) {
+        throw SRRuntimeException("The provided dimensions do "\
+                                 "not match the dimensions of the "\
+                                 "tensor data array");
+    }
+    _check_strides(dims, strides);
+
+    // Scatter the tensor entries into the user memory space
+    T* dest = (T*)data + offset;
+    _strided_memcpy((T*)_data, dest, dims, strides, false);
+}
+
 // copy values from nested memory structure to contiguous memory structure
 template <class T>
 void* Tensor<T>::_copy_nested_to_contiguous(const void* src_data,
@@ -329,6 +405,74 @@ size_t Tensor<T>::_n_data_bytes()
 {
     return num_values() * sizeof(T);
 }
+
+// Copy between contiguous row major memory and strided memory
+template <class T>
+void Tensor<T>::_strided_memcpy(T* contiguous,
+                                T* strided,
+                                const std::vector<size_t>& dims,
+                                const std::vector<size_t>& strides,
+                                const bool gather)
+{
+    if (contiguous == NULL || strided == NULL) {
+        throw SRRuntimeException("Invalid buffer suppplied to "\
+                                 "_strided_memcpy");
+    }
+
+    // The innermost dimension is copied a row at a time
+    size_t n_dims = dims.size();
+    size_t row_length = dims[n_dims - 1];
+    size_t row_stride = strides[n_dims - 1];
+    size_t n_rows = 1;
+    for (size_t i = 0; i < n_dims - 1; i++)
+        n_rows *= dims[i];
+
+    std::vector<size_t> position(n_dims, 0);
+    size_t strided_index = 0;
+    for (size_t row = 0; row < n_rows; row++) {
+        T* c_row = contiguous + row * row_length;
+        T* s_row = strided + strided_index;
+        if (row_stride == 1) {
+            if (gather)
+                std::memcpy(c_row, s_row, row_length * sizeof(T));
+            else
+                std::memcpy(s_row, c_row, row_length * sizeof(T));
+        }
+        else if (gather) {
+            for (size_t i = 0; i < row_length; i++)
+                c_row[i] = s_row[i * row_stride];
+        }
+        else {
+            for (size_t i = 0; i < row_length; i++)
+                s_row[i * row_stride] = c_row[i];
+        }
+
+        // Advance the position in the outer dimensions
+        for (size_t d = n_dims - 1; d-- > 0; ) {
+            position[d]++;
+            strided_index += strides[d];
+            if (position[d] < dims[d])
+                break;
+            strided_index -= position[d] * strides[d];
+            position[d] = 0;
+        }
+    }
+}
+
+// Check that a strides vector is valid for the given dimensions
+template <class T>
+void Tensor<T>::_check_strides(const std::vector<size_t>& dims,
+                               const std::vector<size_t>& strides)
+{
+    if (strides.size() != dims.size()) {
+        throw SRParameterException("The number of strides, " +
+                                   std::to_string(strides.size()) +
+                                   ", does not match the number "\
+                                   "of dimensions, " +
+                                   std::to_string(dims.size()));
+    }
+}
+
 // Copy a fortran memory space layout (col major) to a
 // c-style array memory space (row major)
 template <class T>
@@ -54,6 +54,11 @@ static std::string DATATYPE_TENSOR_STR_INT32 = "INT32";
 static std::string DATATYPE_TENSOR_STR_INT64 = "INT64";
 static std::string DATATYPE_TENSOR_STR_UINT8 = "UINT8";
 static std::string DATATYPE_TENSOR_STR_UINT16 = "UINT16";
+static std::string DATATYPE_TENSOR_STR_UINT32 = "UINT32";
+static std::string DATATYPE_TENSOR_STR_UINT64 = "UINT64";
+static std::string DATATYPE_TENSOR_STR_BOOL = "BOOL";
+static std::string DATATYPE_TENSOR_STR_FLOAT16 = "FLOAT16";
+static std::string DATATYPE_TENSOR_STR_BFLOAT16 = "BFLOAT16";
 
 static const std::unordered_map<std::string, SRTensorType>
     TENSOR_TYPE_MAP{
@@ -64,7 +69,12 @@ static const std::unordered_map<std::string, SRTensorType>
         {DATATYPE_TENSOR_STR_INT16, SRTensorTypeInt16},
         {DATATYPE_TENSOR_STR_INT8, SRTensorTypeInt8},
         {DATATYPE_TENSOR_STR_UINT16, SRTensorTypeUint16},
-        {DATATYPE_TENSOR_STR_UINT8, SRTensorTypeUint8} };
+        {DATATYPE_TENSOR_STR_UINT8, SRTensorTypeUint8},
+        {DATATYPE_TENSOR_STR_UINT32, SRTensorTypeUint32},
+        {DATATYPE_TENSOR_STR_UINT64, SRTensorTypeUint64},
+        {DATATYPE_TENSOR_STR_BOOL, SRTensorTypeBool},
+        {DATATYPE_TENSOR_STR_FLOAT16, SRTensorTypeFloat16},
+        {DATATYPE_TENSOR_STR_BFLOAT16, SRTensorTypeBFloat16} };
 
 static const std::unordered_map<SRTensorType, std::string>
     TENSOR_STR_MAP{
@@ -75,7 +85,12 @@ static const std::unordered_map<SRTensorType, std::string>
         {SRTensorTypeInt16, DATATYPE_TENSOR_STR_INT16},
         {SRTensorTypeInt8, DATATYPE_TENSOR_STR_INT8},
         {SRTensorTypeUint16, DATATYPE_TENSOR_STR_UINT16},
-        {SRTensorTypeUint8, DATATYPE_TENSOR_STR_UINT8} };
+        {SRTensorTypeUint8, DATATYPE_TENSOR_STR_UINT8},
+        {SRTensorTypeUint32, DATATYPE_TENSOR_STR_UINT32},
+        {SRTensorTypeUint64, DATATYPE_TENSOR_STR_UINT64},
+        {SRTensorTypeBool, DATATYPE_TENSOR_STR_BOOL},
+        {SRTensorTypeFloat16, DATATYPE_TENSOR_STR_FLOAT16},
+        {SRTensorTypeBFloat16, DATATYPE_TENSOR_STR_BFLOAT16} };
 
 /*!
 *   \brief  The TensorBase class is a base class that
@@ -211,6 +226,21 @@ class TensorBase{
                                     std::vector<size_t> dims,
                                     SRMemoryLayout mem_layout) = 0;
 
+        /*!
+        *   \brief Fill a user provided strided memory space with
+        *          values from tensor data
+        *   \param data Pointer to the allocated memory space
+        *   \param dims The dimensions of the memory space
+        *   \param strides The distance, in elements, between
+        *                  consecutive entries along each dimension
+        *   \param offset The position, in elements, of the first
+        *                 entry relative to data
+        */
+        virtual void fill_mem_space_strided(void* data,
+                                            const std::vector<size_t>& dims,
+                                            const std::vector<size_t>& strides,
+                                            const size_t offset) = 0;
+
 
         protected:
 
@@ -0,0 +1,322 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_TENSORCHUNKS_H
+#define SMARTREDIS_TENSORCHUNKS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sr_enums.h"
+
+///@file
+
+namespace SmartRedis {
+
+/*!
+*   \brief Describes a tensor stored in fixed-size chunks
+*   \details Tensors whose data exceed the chunk size are stored as
+*            a manifest under the tensor key and chunk keys holding
+*            consecutive byte ranges of the tensor data.  The chunk
+*            keys are formed from the tensor key, a generation number
+*            drawn when the tensor is put and the chunk index, so they
+*            hash to different slots and are spread over the shards of
+*            a cluster, and a new put never overwrites the chunks that
+*            a reader of the previous manifest may still be fetching.
+*/
+class ChunkManifest
+{
+    public:
+
+        /*!
+        *   \brief Default ChunkManifest constructor
+        */
+        ChunkManifest() = default;
+
+        /*!
+        *   \brief ChunkManifest constructor for a new put
+        *   \param type The tensor type
+        *   \param dims The tensor dimensions
+        *   \param total_bytes The size of the tensor data in bytes
+        *   \param chunk_size The size of each chunk in bytes; the last
+        *                     chunk may be smaller
+        */
+        ChunkManifest(SRTensorType type,
+                      const std::vector<size_t>& dims,
+                      uint64_t total_bytes,
+                      uint64_t chunk_size);
+
+        /*!
+        *   \brief Get the number of chunks
+        *   \returns The number of chunks
+        */
+        size_t n_chunks() const;
+
+        /*!
+        *   \brief Get the key of a chunk
+        *   \param key The tensor key
+        *   \param index The chunk index
+        *   \returns The chunk key
+        */
+        std::string chunk_key(const std::string& key, size_t index) const;
+
+        /*!
+        *   \brief Get the keys of all chunks
+        *   \param key The tensor key
+        *   \returns The chunk keys
+        */
+        std::vector<std::string> part_keys(const std::string& key) const;
+
+        /*!
+        *   \brief Get the byte offset of a chunk in the tensor data
+        *   \param index The chunk index
+        *   \returns The offset of the chunk
+        */
+        uint64_t chunk_offset(size_t index) const;
+
+        /*!
+        *   \brief Get the size of a chunk
+        *   \param index The chunk index
+        *   \returns The size of the chunk in bytes
+        */
+        uint64_t chunk_bytes(size_t index) const;
+
+        /*!
+        *   \brief Serialize the manifest
+        *   \returns The serialized manifest
+        */
+        std::string pack() const;
+
+        /*!
+        *   \brief Check whether a buffer holds a serialized manifest
+        *   \param buf The buffer to check
+        *   \returns True if buf starts with a manifest header
+        */
+        static bool is_manifest(std::string_view buf);
+
+        /*!
+        *   \brief Deserialize a manifest
+        *   \param buf The serialized manifest
+        *   \returns The manifest
+        *   \throw SmartRedis::RuntimeException if buf is malformed
+        */
+        static ChunkManifest unpack(std::string_view buf);
+
+        /*!
+        *   \brief The largest size of a serialized manifest
+        */
+        static const size_t max_packed_size;
+
+        /*!
+        *   \brief The tensor type
+        */
+        SRTensorType type = SRTensorTypeInvalid;
+
+        /*!
+        *   \brief The tensor dimensions
+        */
+        std::vector<size_t> dims;
+
+        /*!
+        *   \brief The size of the tensor data in bytes
+        */
+        uint64_t total_bytes = 0;
+
+        /*!
+        *   \brief The size of each chunk in bytes
+        */
+        uint64_t chunk_size = 0;
+
+        /*!
+        *   \brief The generation number included in the chunk keys
+        */
+        uint64_t generation = 0;
+};
+
+/*!
+*   \brief Describes a tensor stored in N-dimensional tiles
+*   \details A tiled tensor is stored as a manifest under the tensor
+*            key and one key per tile, holding the tile values in row
+*            major order.  Tiles at the upper edge of a dimension that
+*            does not divide into whole tiles are smaller.  As for
+*            chunks, the tile keys include a generation number drawn
+*            when the tensor is put, so that they are spread over the
+*            shards of a cluster and a new put never overwrites tiles
+*            that a reader may still be fetching.  A sub-region of the
+*            tensor can be read by fetching only the tiles it
+*            intersects.
+*/
+class TileManifest
+{
+    public:
+
+        /*!
+        *   \brief Default TileManifest constructor
+        */
+        TileManifest() = default;
+
+        /*!
+        *   \brief TileManifest constructor for a new put
+        *   \param type The tensor type
+        *   \param dims The tensor dimensions
+        *   \param tile_dims The tile dimensions
+        *   \throw SmartRedis::ParameterException if the tile dimensions
+        *          do not match the tensor dimensions or are zero
+        */
+        TileManifest(SRTensorType type,
+                     const std::vector<size_t>& dims,
+                     const std::vector<size_t>& tile_dims);
+
+        /*!
+        *   \brief Get the number of tiles
+        *   \returns The number of tiles
+        */
+        size_t n_tiles() const;
+
+        /*!
+        *   \brief Get the key of a tile
+        *   \param key The tensor key
+        *   \param index The tile index, in row major order of tiles
+        *   \returns The tile key
+        */
+        std::string tile_key(const std::string& key, size_t index) const;
+
+        /*!
+        *   \brief Get the keys of all tiles
+        *   \param key The tensor key
+        *   \returns The tile keys
+        */
+        std::vector<std::string> part_keys(const std::string& key) const;
+
+        /*!
+        *   \brief Get the position of the first value of a tile
+        *   \param index The tile index
+        *   \returns The tensor coordinates of the tile origin
+        */
+        std::vector<size_t> tile_origin(size_t index) const;
+
+        /*!
+        *   \brief Get the dimensions of a tile, which are smaller than
+        *          the tile dimensions at the upper edges of the tensor
+        *   \param index The tile index
+        *   \returns The tile dimensions
+        */
+        std::vector<size_t> tile_extent(size_t index) const;
+
+        /*!
+        *   \brief Get the tiles that intersect a region of the tensor
+        *   \param offsets The coordinates of the first value of the
+        *                  region
+        *   \param counts The number of values of the region along
+        *                 each dimension
+        *   \returns The indices of the tiles, in ascending order
+        */
+        std::vector<size_t> tiles_in_region(
+            const std::vector<size_t>& offsets,
+            const std::vector<size_t>& counts) const;
+
+        /*!
+        *   \brief Serialize the manifest
+        *   \returns The serialized manifest
+        */
+        std::string pack() const;
+
+        /*!
+        *   \brief Check whether a buffer holds a serialized manifest
+        *   \param buf The buffer to check
+        *   \returns True if buf starts with a manifest header
+        */
+        static bool is_manifest(std::string_view buf);
+
+        /*!
+        *   \brief Deserialize a manifest
+        *   \param buf The serialized manifest
+        *   \returns The manifest
+        *   \throw SmartRedis::RuntimeException if buf is malformed
+        */
+        static TileManifest unpack(std::string_view buf);
+
+        /*!
+        *   \brief The largest size of a serialized manifest
+        */
+        static const size_t max_packed_size;
+
+        /*!
+        *   \brief The tensor type
+        */
+        SRTensorType type = SRTensorTypeInvalid;
+
+        /*!
+        *   \brief The tensor dimensions
+        */
+        std::vector<size_t> dims;
+
+        /*!
+        *   \brief The tile dimensions
+        */
+        std::vector<size_t> tile_dims;
+
+        /*!
+        *   \brief The generation number included in the tile keys
+        */
+        uint64_t generation = 0;
+};
+
+/*!
+*   \brief Copy the values in a box of tensor coordinates from one
+*          row major block of values to another
+*   \details Each block is described by its dimensions and by the
+*            tensor coordinates of its first value, so that tiles,
+*            whole tensors and output regions can be copied between
+*            with one function.  Rows along the last dimension are
+*            copied with memcpy.
+*   \param src The source values
+*   \param src_dims The dimensions of the source block
+*   \param src_origin The tensor coordinates of the first source value
+*   \param dest The destination values
+*   \param dest_dims The dimensions of the destination block
+*   \param dest_origin The tensor coordinates of the first destination
+*                      value
+*   \param lo The lowest tensor coordinates of the box to copy
+*   \param hi The tensor coordinates one past the highest of the box
+*   \param value_size The size of each value in bytes
+*/
+void copy_tensor_box(const char* src,
+                     const std::vector<size_t>& src_dims,
+                     const std::vector<size_t>& src_origin,
+                     char* dest,
+                     const std::vector<size_t>& dest_dims,
+                     const std::vector<size_t>& dest_origin,
+                     const std::vector<size_t>& lo,
+                     const std::vector<size_t>& hi,
+                     size_t value_size);
+
+} // namespace SmartRedis
+
+#endif // SMARTREDIS_TENSORCHUNKS_H
@@ -0,0 +1,115 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_TENSORCONVERT_H
+#define SMARTREDIS_TENSORCONVERT_H
+
+#include <cstddef>
+#include <cstdint>
+#include "sr_enums.h"
+
+///@file
+
+namespace SmartRedis {
+
+/*!
+*   \brief Convert tensor values from one tensor type to another
+*   \details The values are read from src and written to dest in a
+*            single pass.  Conversions between floating point types
+*            and from integers to floating point types follow IEEE
+*            semantics.  Conversions to double, float and integer
+*            types round using the rounding mode of the floating point
+*            environment of the calling thread (see std::fesetround()),
+*            which defaults to round half to even; integer targets
+*            round to the nearest integer in that mode.  Half
+*            precision (float16 and bfloat16) targets always round
+*            half to even, once, whatever the source type and the
+*            floating point environment.  Any non-zero value converts
+*            to true for boolean targets.
+*   \param src The values to convert
+*   \param src_type The tensor type of the values in src
+*   \param dest The memory receiving the converted values
+*   \param dest_type The tensor type of the values in dest
+*   \param n_values The number of values to convert
+*   \throw SmartRedis::ParameterException if either type is invalid,
+*          or if a value is NaN or does not fit in an integer
+*          destination type
+*/
+void convert_tensor_values(const void* src,
+                           SRTensorType src_type,
+                           void* dest,
+                           SRTensorType dest_type,
+                           size_t n_values);
+
+/*!
+*   \brief Convert a float to IEEE half precision bits
+*   \param value The value to convert
+*   \returns The half precision bits, rounded half to even
+*/
+uint16_t float_to_float16(float value);
+
+/*!
+*   \brief Convert a double to IEEE half precision bits
+*   \details The value is rounded once, directly from double
+*   \param value The value to convert
+*   \returns The half precision bits, rounded half to even
+*/
+uint16_t double_to_float16(double value);
+
+/*!
+*   \brief Convert IEEE half precision bits to a float
+*   \param bits The half precision bits
+*   \returns The value as a float
+*/
+float float16_to_float(uint16_t bits);
+
+/*!
+*   \brief Convert a float to bfloat16 bits
+*   \param value The value to convert
+*   \returns The bfloat16 bits, rounded half to even
+*/
+uint16_t float_to_bfloat16(float value);
+
+/*!
+*   \brief Convert a double to bfloat16 bits
+*   \details The value is rounded once, directly from double
+*   \param value The value to convert
+*   \returns The bfloat16 bits, rounded half to even
+*/
+uint16_t double_to_bfloat16(double value);
+
+/*!
+*   \brief Convert bfloat16 bits to a float
+*   \param bits The bfloat16 bits
+*   \returns The value as a float
+*/
+float bfloat16_to_float(uint16_t bits);
+
+} // namespace SmartRedis
+
+#endif // SMARTREDIS_TENSORCONVERT_H
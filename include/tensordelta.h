@@ -0,0 +1,158 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_TENSORDELTA_H
+#define SMARTREDIS_TENSORDELTA_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sr_enums.h"
+
+///@file
+
+namespace SmartRedis {
+
+/*!
+*   \brief Encodes successive values of a tensor as keyframes and
+*          deltas against the previously encoded values
+*   \details Each frame starts with a small header holding the frame
+*            kind, the identifier of the stream it belongs to and its
+*            sequence number within the stream.  A keyframe holds the
+*            tensor values and starts a new stream; a delta holds the
+*            bytewise XOR of the values with those of the previous
+*            frame.  Both are stored in compression containers (see
+*            compress_buffer()) with the lossless shuffle-lz codec, so
+*            the near-zero deltas of slowly changing fields shrink to a
+*            small fraction of the tensor size.  A keyframe is encoded
+*            every keyframe_interval frames and whenever the tensor
+*            type or dimensions change.
+*/
+class DeltaEncoder
+{
+    public:
+
+        /*!
+        *   \brief DeltaEncoder constructor
+        *   \param keyframe_interval The number of frames from one
+        *                            keyframe to the next
+        *   \param level The compression level, from 1 (fastest) to 9
+        *               (smallest)
+        */
+        DeltaEncoder(int keyframe_interval, int level);
+
+        /*!
+        *   \brief Encode the next values of the tensor
+        *   \param values The tensor values
+        *   \param type The tensor type
+        *   \param dims The tensor dimensions
+        *   \param keyframe Receives whether the frame is a keyframe
+        *   \returns The encoded frame
+        */
+        std::string encode(std::string_view values,
+                           SRTensorType type,
+                           const std::vector<size_t>& dims,
+                           bool& keyframe);
+
+        /*!
+        *   \brief Make the next frame a keyframe
+        */
+        void reset();
+
+        /*!
+        *   \brief Get the number of frames encoded since the last
+        *          keyframe, including the keyframe
+        *   \returns The number of frames in the current stream
+        */
+        uint64_t stream_length() const;
+
+    private:
+
+        /*!
+        *   \brief The identifier of the current stream
+        */
+        uint64_t _stream_id;
+
+        /*!
+        *   \brief The sequence number of the next frame
+        */
+        uint64_t _sequence;
+
+        /*!
+        *   \brief The tensor type of the previous frame
+        */
+        SRTensorType _type;
+
+        /*!
+        *   \brief The tensor dimensions of the previous frame
+        */
+        std::vector<size_t> _dims;
+
+        /*!
+        *   \brief The tensor values of the previous frame
+        */
+        std::string _last;
+
+        /*!
+        *   \brief The number of frames from one keyframe to the next
+        */
+        int _keyframe_interval;
+
+        /*!
+        *   \brief The compression level
+        */
+        int _level;
+};
+
+/*!
+*   \brief Check whether a buffer is a frame encoded by DeltaEncoder
+*   \param buf The buffer to check
+*   \returns True if buf starts with a delta frame header
+*/
+bool is_delta_frame(std::string_view buf);
+
+/*!
+*   \brief Reconstruct tensor values from encoded frames
+*   \details The frames are given in the order they were encoded.
+*            Reconstruction starts from the last keyframe and applies
+*            the deltas that follow it, so earlier frames are ignored.
+*   \param frames The encoded frames
+*   \param type Receives the tensor type
+*   \param dims Receives the tensor dimensions
+*   \returns The tensor values
+*   \throw SmartRedis::RuntimeException if there is no keyframe or the
+*          frames after it do not form a single unbroken stream
+*/
+std::string decode_delta_frames(const std::vector<std::string_view>& frames,
+                                SRTensorType& type,
+                                std::vector<size_t>& dims);
+
+} // namespace SmartRedis
+
+#endif // SMARTREDIS_TENSORDELTA_H
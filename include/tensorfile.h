@@ -0,0 +1,181 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SMARTREDIS_TENSORFILE_H
+#define SMARTREDIS_TENSORFILE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sr_enums.h"
+
+///@file
+
+namespace SmartRedis {
+
+/*!
+*   \brief A file mapped into memory, for moving tensor data between
+*          files and the database without staging it in a buffer
+*   \details A file opened for reading is mapped read-only in full.  A
+*            file opened for writing is created or truncated to the
+*            requested size and mapped read-write, and its pages are
+*            flushed to the file when the MappedFile is destroyed.
+*            Pages are brought in and written back by the kernel as
+*            they are touched, so the resident memory stays small
+*            regardless of the size of the file.
+*/
+class MappedFile
+{
+    public:
+
+        /*!
+        *   \brief Map an existing file for reading
+        *   \param path The path of the file
+        *   \throw SmartRedis::RuntimeException if the file cannot be
+        *          opened or mapped
+        */
+        MappedFile(const std::string& path);
+
+        /*!
+        *   \brief Create a file of a given size and map it for writing
+        *   \param path The path of the file
+        *   \param size The size of the file in bytes
+        *   \throw SmartRedis::RuntimeException if the file cannot be
+        *          created or mapped
+        */
+        MappedFile(const std::string& path, size_t size);
+
+        /*!
+        *   \brief MappedFile copy constructor is not available
+        */
+        MappedFile(const MappedFile& file) = delete;
+
+        /*!
+        *   \brief MappedFile copy assignment is not available
+        */
+        MappedFile& operator=(const MappedFile& file) = delete;
+
+        /*!
+        *   \brief MappedFile destructor, which unmaps and closes the
+        *          file after flushing the pages of a file opened for
+        *          writing
+        */
+        ~MappedFile();
+
+        /*!
+        *   \brief Get the mapped contents of the file
+        *   \returns A pointer to the first byte of the file
+        */
+        char* data() const;
+
+        /*!
+        *   \brief Get the size of the file
+        *   \returns The size of the file in bytes
+        */
+        size_t size() const;
+
+        /*!
+        *   \brief Write the modified pages of a file opened for writing
+        *          back to the file
+        *   \throw SmartRedis::RuntimeException if the pages cannot be
+        *          written
+        */
+        void sync();
+
+    private:
+
+        /*!
+        *   \brief Map the open file
+        *   \param writable Whether the mapping may be written
+        */
+        void _map(bool writable);
+
+        /*!
+        *   \brief The path of the file, for error messages
+        */
+        std::string _path;
+
+        /*!
+        *   \brief The file descriptor
+        */
+        int _fd;
+
+        /*!
+        *   \brief The mapped contents, or NULL for an empty file
+        */
+        char* _data;
+
+        /*!
+        *   \brief The size of the file in bytes
+        */
+        size_t _size;
+
+        /*!
+        *   \brief Whether the file was opened for writing
+        */
+        bool _writable;
+};
+
+/*!
+*   \brief Check whether a buffer starts with a .npy file header
+*   \param buf The buffer to check
+*   \returns True if buf starts with the .npy magic string
+*/
+bool is_npy_file(std::string_view buf);
+
+/*!
+*   \brief Read the header of a .npy file
+*   \param buf The start of the file, including the whole header
+*   \param type Receives the tensor type of the array
+*   \param dims Receives the shape of the array
+*   \param fortran_order Receives whether the array is stored in
+*                        column major order
+*   \returns The size of the header in bytes, where the array data
+*            starts
+*   \throw SmartRedis::RuntimeException if the header is malformed or
+*          describes a data type that has no tensor type
+*/
+size_t parse_npy_header(std::string_view buf,
+                        SRTensorType& type,
+                        std::vector<size_t>& dims,
+                        bool& fortran_order);
+
+/*!
+*   \brief Build the header of a .npy file holding a row major array
+*   \param type The tensor type of the array
+*   \param dims The shape of the array
+*   \returns The header, padded so that the array data that follows it
+*            is aligned to 64 bytes
+*   \throw SmartRedis::ParameterException if the tensor type has no
+*          .npy data type
+*/
+std::string build_npy_header(SRTensorType type,
+                             const std::vector<size_t>& dims);
+
+} // namespace SmartRedis
+
+#endif // SMARTREDIS_TENSORFILE_H
@@ -0,0 +1,91 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SMARTREDIS_TENSORRECORDS_H
+#define SMARTREDIS_TENSORRECORDS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sr_enums.h"
+#include "compression.h"
+
+///@file
+
+namespace SmartRedis {
+
+/*!
+*   \brief Encode one record of an appendable tensor
+*   \details An appendable tensor is a list with one element per
+*            record along its leading dimension.  Each element starts
+*            with a record marker followed by a compression container
+*            (see compress_buffer()) holding the record values, type
+*            and dimensions, so records can be compressed with any
+*            codec and are decoded without knowing how they were
+*            written.
+*   \param values The record values
+*   \param type The tensor type of the record
+*   \param dims The dimensions of the record
+*   \param codec The codec to apply
+*   \param level The compression level, from 1 (fastest) to 9
+*               (smallest)
+*   \param error_bound The largest absolute error allowed in a value,
+*                     for lossy codecs
+*   \returns The encoded record
+*/
+std::string encode_tensor_record(std::string_view values,
+                                 SRTensorType type,
+                                 const std::vector<size_t>& dims,
+                                 SRCompressionCodec codec,
+                                 int level,
+                                 double error_bound = 0.0);
+
+/*!
+*   \brief Check whether a buffer is a record of an appendable tensor
+*   \param buf The buffer to check
+*   \returns True if buf starts with a record marker
+*/
+bool is_tensor_record(std::string_view buf);
+
+/*!
+*   \brief Join consecutive records of an appendable tensor into a
+*          single tensor
+*   \param records The encoded records, in the order they were appended
+*   \param type Receives the tensor type
+*   \param dims Receives the tensor dimensions, which are the number of
+*               records followed by the dimensions of each record
+*   \returns The tensor values
+*   \throw SmartRedis::RuntimeException if there are no records or they
+*          differ in type or dimensions
+*/
+std::string join_tensor_records(const std::vector<std::string_view>& records,
+                                SRTensorType& type,
+                                std::vector<size_t>& dims);
+
+} // namespace SmartRedis
+
+#endif // SMARTREDIS_TENSORRECORDS_H
@@ -93,6 +93,23 @@ std::string to_string(SRTensorType ttype);
 */
 std::string to_string(SRMetaDataType mdtype);
 
+/*!
+*   \brief Retrieve the size in bytes of a single element of a tensor type
+*   \param ttype The tensor type to size
+*   \returns The number of bytes per tensor element
+*   \throw ParameterException if the tensor type is invalid
+*/
+size_t tensor_type_size(SRTensorType ttype);
+
+/*!
+*   \brief Check whether RedisAI can store tensors of a type
+*   \details Tensors of the other types are stored in a compression
+*            container, which records their type
+*   \param ttype The tensor type to check
+*   \returns True if AI.TENSORSET accepts the tensor type
+*/
+bool is_redisai_tensor_type(SRTensorType ttype);
+
 
 } // namespace SmartRedis
 
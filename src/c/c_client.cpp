@@ -185,6 +185,64 @@ extern "C" SRError get_dataset(
   });
 }
 
+// Put multiple datasets into the database
+extern "C" SRError put_datasets(
+  void* c_client, void** datasets, const size_t n_datasets)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && datasets != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::vector<DataSet*> dataset_ptrs(n_datasets);
+    for (size_t i = 0; i < n_datasets; i++) {
+      SR_CHECK_PARAMS(datasets[i] != NULL);
+      dataset_ptrs[i] = reinterpret_cast<DataSet*>(datasets[i]);
+    }
+    s->put_datasets(dataset_ptrs);
+  });
+}
+
+// Get multiple datasets from the database into an already allocated
+// array of dataset pointers
+extern "C" SRError get_datasets(
+  void* c_client, const char** names, const size_t* name_lengths,
+  const size_t n_names, void** datasets)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && names != NULL &&
+                    name_lengths != NULL && datasets != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::vector<std::string> dataset_names;
+    for (size_t i = 0; i < n_names; i++) {
+      SR_CHECK_PARAMS(names[i] != NULL);
+      dataset_names.push_back(std::string(names[i], name_lengths[i]));
+    }
+
+    std::vector<DataSet> result_datasets = s->get_datasets(dataset_names);
+    if (result_datasets.size() != n_names) {
+      throw SRInternalException(
+        "Returned dataset count is not equal to the requested count");
+    }
+
+    size_t i = 0;
+    try {
+      for (; i < n_names; i++) {
+        datasets[i] = reinterpret_cast<void*>(
+          new DataSet(std::move(result_datasets[i])));
+      }
+    } catch (const std::bad_alloc& e) {
+      for (size_t j = 0; j < i; j++) {
+        delete reinterpret_cast<DataSet*>(datasets[j]);
+        datasets[j] = NULL;
+      }
+      throw SRBadAllocException("dataset allocation");
+    }
+  });
+}
+
 // Rename a dataset in the database
 extern "C" SRError rename_dataset(
   void* c_client, const char* old_name,
@@ -261,6 +319,167 @@ extern "C" SRError put_tensor(
   });
 }
 
+// Put a tensor into the database, converting it to another type
+extern "C" SRError put_tensor_as(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  void* data,
+  const size_t* dims,
+  const size_t n_dims,
+  const SRTensorType type,
+  const SRTensorType store_type,
+  const SRMemoryLayout mem_layout)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL &&
+                    data != NULL && dims != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    std::vector<size_t> dims_vec(dims, dims + n_dims);
+
+    s->put_tensor_as(name_str, data, dims_vec, type, store_type, mem_layout);
+  });
+}
+
+// Put a tensor into the database as a delta against the values last put
+extern "C" SRError put_tensor_delta(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  void* data,
+  const size_t* dims,
+  const size_t n_dims,
+  const SRTensorType type,
+  const SRMemoryLayout mem_layout)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL &&
+                    data != NULL && dims != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    std::vector<size_t> dims_vec(dims, dims + n_dims);
+
+    s->put_tensor_delta(name_str, data, dims_vec, type, mem_layout);
+  });
+}
+
+// Put a tensor of a specified type into the database in tiles
+extern "C" SRError put_tensor_tiled(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  void* data,
+  const size_t* dims,
+  const size_t* tile_dims,
+  const size_t n_dims,
+  const SRTensorType type,
+  const SRMemoryLayout mem_layout)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL && data != NULL &&
+                    dims != NULL && tile_dims != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    std::vector<size_t> dims_vec(dims, dims + n_dims);
+    std::vector<size_t> tile_dims_vec(tile_dims, tile_dims + n_dims);
+
+    s->put_tensor_tiled(name_str, data, dims_vec, tile_dims_vec, type,
+                        mem_layout);
+  });
+}
+
+// Put a tensor into the database from a file
+extern "C" SRError put_tensor_from_file(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  const char* path,
+  const size_t path_length,
+  const size_t* dims,
+  const size_t n_dims,
+  const SRTensorType type,
+  const size_t offset)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL && path != NULL &&
+                    (n_dims == 0 || dims != NULL));
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+    std::string path_str(path, path_length);
+
+    std::vector<size_t> dims_vec;
+    if (n_dims > 0)
+        dims_vec.assign(dims, dims + n_dims);
+
+    s->put_tensor_from_file(name_str, path_str, dims_vec, type, offset);
+  });
+}
+
+// Append a record to a tensor that grows along its leading dimension
+extern "C" SRError append_to_tensor(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  void* data,
+  const size_t* dims,
+  const size_t n_dims,
+  const SRTensorType type,
+  const SRMemoryLayout mem_layout)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL &&
+                    data != NULL && dims != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    std::vector<size_t> dims_vec(dims, dims + n_dims);
+
+    s->append_to_tensor(name_str, data, dims_vec, type, mem_layout);
+  });
+}
+
+// Put a tensor of a specified type into the database,
+// gathering it from strided memory
+extern "C" SRError put_tensor_strided(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  void* data,
+  const size_t* dims,
+  const size_t* strides,
+  const size_t n_dims,
+  const size_t offset,
+  const SRTensorType type)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL &&
+                    data != NULL && dims != NULL && strides != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    std::vector<size_t> dims_vec(dims, dims + n_dims);
+    std::vector<size_t> strides_vec(strides, strides + n_dims);
+
+    s->put_tensor_strided(name_str, data, dims_vec, strides_vec, offset, type);
+  });
+}
+
 // Get a tensor of a specified type from the database
 extern "C" SRError get_tensor(
   void* c_client,
@@ -284,6 +503,32 @@ extern "C" SRError get_tensor(
   });
 }
 
+// Get a window of the records of an appendable tensor
+extern "C" SRError get_tensor_range(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  const size_t start,
+  const size_t stop,
+  void** result,
+  size_t** dims,
+  size_t* n_dims,
+  SRTensorType* type,
+  const SRMemoryLayout mem_layout)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL && result != NULL &&
+                    dims != NULL && n_dims != NULL && type != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    s->get_tensor_range(name_str, start, stop, *result, *dims, *n_dims,
+                        *type, mem_layout);
+  });
+}
+
 // Get a tensor of a specified type from the database
 // and put the values into the user provided memory space
 extern "C" SRError unpack_tensor(
@@ -311,6 +556,107 @@ extern "C" SRError unpack_tensor(
   });
 }
 
+// Get a tensor from the database and put the values, converted to
+// the specified type, into the user provided memory space
+extern "C" SRError unpack_tensor_as(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  void* result,
+  const size_t* dims,
+  const size_t n_dims,
+  const SRTensorType type,
+  const SRMemoryLayout mem_layout)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL && result != NULL &&
+                    dims != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    std::vector<size_t> dims_vec(dims, dims + n_dims);
+
+    s->unpack_tensor_as(name_str, result, dims_vec, type, mem_layout);
+  });
+}
+
+// Get a tensor of a specified type from the database
+// and scatter the values into the user provided strided memory space
+extern "C" SRError unpack_tensor_strided(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  void* result,
+  const size_t* dims,
+  const size_t* strides,
+  const size_t n_dims,
+  const size_t offset,
+  const SRTensorType type)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL && result != NULL &&
+                    dims != NULL && strides != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    std::vector<size_t> dims_vec(dims, dims + n_dims);
+    std::vector<size_t> strides_vec(strides, strides + n_dims);
+
+    s->unpack_tensor_strided(name_str, result, dims_vec, strides_vec,
+                             offset, type);
+  });
+}
+
+// Get a tensor from the database into a file
+extern "C" SRError unpack_tensor_to_file(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  const char* path,
+  const size_t path_length)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL && path != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+    std::string path_str(path, path_length);
+
+    s->unpack_tensor_to_file(name_str, path_str);
+  });
+}
+
+// Get a sub-region of a tensor into contiguous memory
+extern "C" SRError unpack_tensor_slice(
+  void* c_client,
+  const char* name,
+  const size_t name_length,
+  const size_t* offsets,
+  const size_t* counts,
+  const size_t n_dims,
+  void* result,
+  const SRTensorType type)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL && result != NULL &&
+                    offsets != NULL && counts != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string name_str(name, name_length);
+
+    std::vector<size_t> offsets_vec(offsets, offsets + n_dims);
+    std::vector<size_t> counts_vec(counts, counts + n_dims);
+
+    s->unpack_tensor_slice(name_str, offsets_vec, counts_vec, result, type);
+  });
+}
+
 // Rename a tensor from old_name to new_name
 extern "C" SRError rename_tensor(
   void* c_client,
@@ -1208,6 +1554,80 @@ extern "C" SRError use_dataset_ensemble_prefix(void* c_client, bool use_prefix)
   });
 }
 
+// Control whether DataSets are stored in the packed format
+extern "C" SRError use_packed_datasets(void* c_client, bool use_packed)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    s->use_packed_datasets(use_packed);
+  });
+}
+
+// Control whether DataSets are published atomically
+extern "C" SRError use_dataset_transactions(void* c_client,
+                                            bool use_transactions)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    s->use_dataset_transactions(use_transactions);
+  });
+}
+
+// Control whether column major tensors are stored without a transpose
+extern "C" SRError use_native_fortran_layout(void* c_client,
+                                             bool use_native)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    s->use_native_fortran_layout(use_native);
+  });
+}
+
+// Set the time to live of tensors
+extern "C" SRError set_tensor_ttl(void* c_client, const int ttl_ms)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    s->set_tensor_ttl(ttl_ms);
+  });
+}
+
+// Set the time to live of DataSets
+extern "C" SRError set_dataset_ttl(void* c_client, const int ttl_ms)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    s->set_dataset_ttl(ttl_ms);
+  });
+}
+
+// Set the maximum number of entries retained in aggregation lists
+extern "C" SRError set_list_retention(void* c_client, const int max_length)
+{
+  return MAKE_CLIENT_API({
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    s->set_list_retention(max_length);
+  });
+}
+
 // Control whether aggregation lists are prefixed
 extern "C" SRError use_list_ensemble_prefix(void* c_client, bool use_prefix)
 {
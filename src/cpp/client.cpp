@@ -28,19 +28,67 @@
 
 #include <ctype.h>
 #include <algorithm>
+#include <memory>
 #include <cctype>
 #include <stdlib.h>
 #include <fcntl.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <unordered_set>
 #include "client.h"
 #include "srexception.h"
 #include "logger.h"
 #include "utility.h"
 #include "configoptions.h"
+#include "metadatabuffer.h"
+#include "tensorfile.h"
 
 using namespace SmartRedis;
 
+// Allocate a Tensor whose element type matches a tensor type, passing
+// the remaining arguments to its constructor
+template <typename... Args>
+static TensorBase* new_tensor(const SRTensorType type,
+                              const std::string& context,
+                              Args&&... args)
+{
+    try {
+        switch (type) {
+            case SRTensorTypeDouble:
+                return new Tensor<double>(std::forward<Args>(args)...);
+            case SRTensorTypeFloat:
+                return new Tensor<float>(std::forward<Args>(args)...);
+            case SRTensorTypeInt64:
+                return new Tensor<int64_t>(std::forward<Args>(args)...);
+            case SRTensorTypeInt32:
+                return new Tensor<int32_t>(std::forward<Args>(args)...);
+            case SRTensorTypeInt16:
+                return new Tensor<int16_t>(std::forward<Args>(args)...);
+            case SRTensorTypeInt8:
+                return new Tensor<int8_t>(std::forward<Args>(args)...);
+            case SRTensorTypeUint16:
+                return new Tensor<uint16_t>(std::forward<Args>(args)...);
+            case SRTensorTypeUint8:
+                return new Tensor<uint8_t>(std::forward<Args>(args)...);
+            case SRTensorTypeUint32:
+                return new Tensor<uint32_t>(std::forward<Args>(args)...);
+            case SRTensorTypeUint64:
+                return new Tensor<uint64_t>(std::forward<Args>(args)...);
+            case SRTensorTypeBool:
+                return new Tensor<bool>(std::forward<Args>(args)...);
+            case SRTensorTypeFloat16:
+                // Fall through
+            case SRTensorTypeBFloat16:
+                return new Tensor<uint16_t>(std::forward<Args>(args)...);
+            default:
+                throw SRTypeException("Invalid type for " + context);
+        }
+    }
+    catch (std::bad_alloc& e) {
+        throw SRBadAllocException("tensor");
+    }
+}
+
 // Simple Client constructor
 Client::Client(const char* logger_name)
     : SRObject(logger_name)
@@ -72,6 +120,11 @@ Client::Client(ConfigOptions* cfgopts, const std::string& logger_name)
 // Initialize a connection to the back-end database
 void Client::_establish_server_connection()
 {
+    // Validate the tensor storage settings before connecting
+    _get_compression_settings();
+    _get_delta_settings();
+    _get_chunk_settings();
+
     // See what type of connection the user wants
     std::string server_type = _cfgopts->_resolve_string_option(
         "SR_DB_TYPE", "Clustered");
@@ -85,12 +138,21 @@ void Client::_establish_server_connection()
         log_data(LLDeveloper, "Instantiating clustered Redis connection");
         _redis_cluster = new RedisCluster(_cfgopts);
         _redis = NULL;
+        _redis_shards = NULL;
         _redis_server =  _redis_cluster;
     }
+    else if (server_type == "sharded") {
+        log_data(LLDeveloper, "Instantiating sharded Redis connection");
+        _redis_cluster = NULL;
+        _redis = NULL;
+        _redis_shards = new RedisShards(_cfgopts);
+        _redis_server =  _redis_shards;
+    }
     else { // Standalone or Colocated
         log_data(LLDeveloper, "Instantiating standalone Redis connection");
         _redis_cluster = NULL;
         _redis = new Redis(_cfgopts);
+        _redis_shards = NULL;
         _redis_server =  _redis;
     }
     log_data(LLDeveloper, "Redis connection established");
@@ -101,6 +163,12 @@ void Client::_establish_server_connection()
     _use_dataset_prefix = true;
     _use_model_prefix = false;
     _use_list_prefix = true;
+    _use_packed_datasets = false;
+    _use_dataset_transactions = false;
+    _use_native_fortran_layout = false;
+    _tensor_ttl = 0;
+    _dataset_ttl = 0;
+    _list_retention = 0;
 }
 
 // Constructor (deprecated)
@@ -114,12 +182,16 @@ Client::Client(bool cluster, const std::string& logger_name)
     auto cfgopts = ConfigOptions::create_from_environment("");
     _cfgopts = cfgopts.release();
     _cfgopts->_set_log_context(this);
+    _get_compression_settings();
+    _get_delta_settings();
+    _get_chunk_settings();
 
     // Set up Redis server connection
     // A std::bad_alloc exception on the initializer will be caught
     // by the call to new for the client
     _redis_cluster = (cluster ? new RedisCluster(_cfgopts) : NULL);
     _redis = (cluster ? NULL : new Redis(_cfgopts));
+    _redis_shards = NULL;
     if (cluster)
         _redis_server =  _redis_cluster;
     else
@@ -131,6 +203,12 @@ Client::Client(bool cluster, const std::string& logger_name)
     _use_dataset_prefix = true;
     _use_model_prefix = false;
     _use_list_prefix = true;
+    _use_packed_datasets = false;
+    _use_dataset_transactions = false;
+    _use_native_fortran_layout = false;
+    _tensor_ttl = 0;
+    _dataset_ttl = 0;
+    _list_retention = 0;
 }
 
 // Destructor
@@ -146,6 +224,11 @@ Client::~Client()
         delete _redis;
         _redis = NULL;
     }
+    if (_redis_shards != NULL)
+    {
+        delete _redis_shards;
+        _redis_shards = NULL;
+    }
     _redis_server = NULL;
     delete _cfgopts;
     _cfgopts = NULL;
@@ -161,10 +244,9 @@ void Client::put_dataset(DataSet& dataset)
     LOG_API_FUNCTION();
 
     CommandList cmds;
-    _append_dataset_metadata_commands(cmds, dataset);
-    _append_dataset_tensor_commands(cmds, dataset);
-    _append_dataset_ack_command(cmds, dataset);
-    _redis_server->run_in_pipeline(cmds);
+    std::string packed_buf;
+    _append_dataset_commands(cmds, dataset, packed_buf);
+    (void)_run_dataset_commands(cmds);
 }
 
 // Retrieve a DataSet object from the database
@@ -183,7 +265,8 @@ DataSet Client::get_dataset(const std::string& name)
     }
 
     DataSet dataset(name);
-    _unpack_dataset_metadata(dataset, reply);
+    if (_unpack_dataset_metadata(dataset, reply))
+        return dataset; // Packed DataSets arrive with their tensors
 
     // Build the tensor keys
     std::vector<std::string> tensor_names = dataset.get_tensor_names();
@@ -199,7 +282,7 @@ DataSet Client::get_dataset(const std::string& name)
         });
 
     // Retrieve DataSet tensors
-    PipelineReply tensors = _redis_server->get_tensors(tensor_keys);
+    PipelineReply tensors = _get_dataset_tensors(tensor_keys);
 
     // Put them into the dataset
     for (size_t i = 0; i < tensor_names.size(); i++) {
@@ -209,6 +292,77 @@ DataSet Client::get_dataset(const std::string& name)
     return dataset;
 }
 
+// Put multiple DataSet objects into the database
+void Client::put_datasets(const std::vector<DataSet*>& datasets)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    // Validate all of the DataSets before anything is written
+    for (size_t i = 0; i < datasets.size(); i++) {
+        if (datasets[i] == NULL)
+            throw SRParameterException("A NULL DataSet was supplied");
+    }
+
+    // Transactions cover a single DataSet, so publish them one at a time
+    if (_use_dataset_transactions) {
+        for (size_t i = 0; i < datasets.size(); i++) {
+            CommandList cmds;
+            std::string packed_buf;
+            _append_dataset_commands(cmds, *datasets[i], packed_buf);
+            (void)_run_dataset_commands(cmds);
+        }
+        return;
+    }
+
+    // Build one CommandList for all DataSets; every command of a DataSet
+    // goes to the same shard, so the per-shard pipelines keep their order
+    CommandList cmds;
+    std::vector<std::string> packed_bufs(datasets.size());
+    for (size_t i = 0; i < datasets.size(); i++)
+        _append_dataset_commands(cmds, *datasets[i], packed_bufs[i]);
+    if (cmds.size() == 0)
+        return;
+
+    PipelineReply replies = _redis_server->run_via_unordered_pipelines(cmds);
+    if (replies.has_error()) {
+        throw SRRuntimeException("An error was encountered when putting "\
+                                 "multiple DataSets into the database.");
+    }
+}
+
+// Put multiple DataSet objects into the database
+void Client::put_datasets(std::vector<DataSet>& datasets)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::vector<DataSet*> dataset_ptrs;
+    for (size_t i = 0; i < datasets.size(); i++)
+        dataset_ptrs.push_back(&datasets[i]);
+    put_datasets(dataset_ptrs);
+}
+
+// Retrieve multiple DataSet objects from the database
+std::vector<DataSet> Client::get_datasets(const std::vector<std::string>& names)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::vector<std::string> dataset_keys;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i].size() == 0) {
+            throw SRParameterException("DataSet names must have length "\
+                                       "greater than zero");
+        }
+        dataset_keys.push_back(_build_dataset_key(names[i], true));
+    }
+    if (dataset_keys.size() == 0)
+        return std::vector<DataSet>();
+
+    return _get_datasets_by_key(dataset_keys, names, true);
+}
+
 // Rename the current dataset
 void Client::rename_dataset(const std::string& old_name,
                             const std::string& new_name)
@@ -234,7 +388,17 @@ void Client::copy_dataset(const std::string& src_name,
                              src_name + " does not exist.");
     }
     DataSet dataset(src_name);
-    _unpack_dataset_metadata(dataset, reply);
+    if (_unpack_dataset_metadata(dataset, reply)) {
+        // A packed DataSet is copied by rewriting its single buffer
+        dataset.set_name(dest_name);
+        CommandList put_packed_cmds;
+        std::string packed_buf;
+        _append_packed_dataset_commands(put_packed_cmds, dataset, packed_buf);
+        if (_dataset_ttl > 0)
+            _append_dataset_expire_commands(put_packed_cmds, dataset, true);
+        (void)_run_dataset_commands(put_packed_cmds);
+        return;
+    }
 
     // Build tensor keys for cloning
     std::vector<std::string> tensor_names = dataset.get_tensor_names();
@@ -243,8 +407,28 @@ void Client::copy_dataset(const std::string& src_name,
     std::vector<std::string> tensor_dest_names =
          _build_dataset_tensor_keys(dest_name, tensor_names, false);
 
-    // Clone tensors
-    _redis_server->copy_tensors(tensor_src_names, tensor_dest_names);
+    // Clone tensors. Tensors of types that RedisAI does not support are
+    // stored in a compression container, which AI.TENSORGET rejects,
+    // and are copied as strings instead.
+    try {
+        _redis_server->copy_tensors(tensor_src_names, tensor_dest_names);
+    }
+    catch (RuntimeException& e) {
+        for (size_t i = 0; i < tensor_src_names.size(); i++) {
+            std::vector<std::string> src_keys;
+            std::vector<std::string> dest_keys;
+            size_t batch_size = 1;
+            if (_get_string_tensor_keys(tensor_src_names[i],
+                                        tensor_dest_names[i],
+                                        src_keys, dest_keys, batch_size)) {
+                _copy_string_tensor(src_keys, dest_keys, batch_size);
+                continue;
+            }
+            CommandReply reply = _redis_server->copy_tensor(
+                tensor_src_names[i], tensor_dest_names[i]);
+            _report_reply_errors(reply, "copy_dataset failed");
+        }
+    }
 
     // Update the DataSet name to the destination name
     // so we can reuse the object for placing metadata
@@ -253,7 +437,9 @@ void Client::copy_dataset(const std::string& src_name,
     CommandList put_meta_cmds;
     _append_dataset_metadata_commands(put_meta_cmds, dataset);
     _append_dataset_ack_command(put_meta_cmds, dataset);
-    (void)_redis_server->run_in_pipeline(put_meta_cmds);
+    if (_dataset_ttl > 0)
+        _append_dataset_expire_commands(put_meta_cmds, dataset, false);
+    (void)_run_dataset_commands(put_meta_cmds);
 }
 
 // Delete a DataSet from the database.
@@ -263,30 +449,55 @@ void Client::delete_dataset(const std::string& name)
     // Track calls to this API function
     LOG_API_FUNCTION();
 
-    CommandReply reply = _get_dataset_metadata(name);
-    if (reply.n_elements() == 0) {
-        throw SRRuntimeException("The requested DataSet " +
-                                 name + " does not exist.");
-    }
-
-    DataSet dataset(name);
-    _unpack_dataset_metadata(dataset, reply);
-
-    // Delete the metadata (which contains the ack key)
-    MultiKeyCommand cmd;
-    cmd << "DEL" << Keyfield(_build_dataset_meta_key(dataset.get_name(), true));
-
-    // Add in all the tensors to be deleted
-    std::vector<std::string> tensor_names = dataset.get_tensor_names();
-    std::vector<std::string> tensor_keys =
-        _build_dataset_tensor_keys(dataset.get_name(), tensor_names, true);
-    cmd.add_keys(tensor_keys);
-
-    // Run the command
-    reply = _run(cmd);
+    std::string meta_key = _build_dataset_meta_key(name, true);
+    std::string tensor_key_prefix = _build_dataset_key(name, true) + ".";
+    if (_dataset_delete_script_sha.size() == 0)
+        _dataset_delete_script_sha = _load_script(_DATASET_DELETE_SCRIPT);
+
+    for (int attempt = 0; attempt < _DATASET_DELETE_ATTEMPTS; attempt++) {
+        // Read the tensor names so that the script can declare every
+        // key it deletes
+        SingleKeyCommand names_cmd;
+        names_cmd << "HGET" << Keyfield(meta_key) << ".tensor_names";
+        CommandReply names_reply = _run(names_cmd);
+        _report_reply_errors(names_reply, "An error was encountered when "\
+                                          "executing DataSet " + name +
+                                          " deletion.");
+        std::string_view names_buf;
+        if (names_reply.redis_reply_type() == "REDIS_REPLY_STRING")
+            names_buf = std::string_view(names_reply.str(),
+                                         names_reply.str_len());
+        std::vector<std::string> tensor_names =
+            MetadataBuffer::unpack_string_buf(names_buf);
+
+        // Unlink the metadata and tensors, unless they have changed
+        SingleKeyCommand cmd;
+        cmd << "EVALSHA" << _dataset_delete_script_sha
+            << std::to_string(tensor_names.size() + 1) << Keyfield(meta_key);
+        for (size_t i = 0; i < tensor_names.size(); i++)
+            cmd << Keyfield(tensor_key_prefix + tensor_names[i]);
+        cmd << names_buf;
+
+        // A database restarted or added since the script was loaded
+        // does not know it
+        bool no_script = false;
+        CommandReply reply = _run_catching(cmd, "NOSCRIPT", no_script);
+        if (no_script) {
+            _load_script(_DATASET_DELETE_SCRIPT);
+            reply = _run(cmd);
+        }
+        _report_reply_errors(reply, "An error was encountered when executing "\
+                                    "DataSet " + name + " deletion.");
 
-    _report_reply_errors(reply, "An error was encountered when executing "\
-                                "DataSet " + name + " deletion.");
+        if (reply.integer() == 0) {
+            throw SRRuntimeException("The requested DataSet " +
+                                     name + " does not exist.");
+        }
+        if (reply.integer() > 0)
+            return;
+    }
+    throw SRRuntimeException("DataSet " + name + " was modified during "\
+                             "each attempt to delete it.");
 }
 
 // Put a tensor into the database
@@ -301,48 +512,216 @@ void Client::put_tensor(const std::string& name,
 
     std::string key = _build_tensor_key(name, false);
 
-    TensorBase* tensor = NULL;
-    try {
-        switch (type) {
-            case SRTensorTypeDouble:
-                tensor = new Tensor<double>(key, data, dims, type, mem_layout);
-                break;
-            case SRTensorTypeFloat:
-                tensor = new Tensor<float>(key, data, dims, type, mem_layout);
-                break;
-            case SRTensorTypeInt64:
-                tensor = new Tensor<int64_t>(key, data, dims, type, mem_layout);
-                break;
-            case SRTensorTypeInt32:
-                tensor = new Tensor<int32_t>(key, data, dims, type, mem_layout);
-                break;
-            case SRTensorTypeInt16:
-                tensor = new Tensor<int16_t>(key, data, dims, type, mem_layout);
-                break;
-            case SRTensorTypeInt8:
-                tensor = new Tensor<int8_t>(key, data, dims, type, mem_layout);
-                break;
-            case SRTensorTypeUint16:
-                tensor = new Tensor<uint16_t>(key, data, dims, type, mem_layout);
-                break;
-            case SRTensorTypeUint8:
-                tensor = new Tensor<uint8_t>(key, data, dims, type, mem_layout);
-                break;
-            default:
-                throw SRTypeException("Invalid type for put_tensor");
+    std::vector<size_t> tensor_dims(dims);
+    SRMemoryLayout tensor_layout = mem_layout;
+    _to_native_layout(tensor_dims, tensor_layout);
+
+    std::unique_ptr<TensorBase> tensor(
+        _build_tensor(key, data, tensor_dims, type, tensor_layout));
+
+    // Send the tensor
+    _send_tensor(*tensor);
+}
+
+// Put a tensor into the database as a delta against the values this
+// client last put under the same name
+void Client::put_tensor_delta(const std::string& name,
+                              const void* data,
+                              const std::vector<size_t>& dims,
+                              const SRTensorType type,
+                              const SRMemoryLayout mem_layout)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::string key = _build_tensor_key(name, false);
+
+    std::vector<size_t> tensor_dims(dims);
+    SRMemoryLayout tensor_layout = mem_layout;
+    _to_native_layout(tensor_dims, tensor_layout);
+
+    std::unique_ptr<TensorBase> tensor(
+        _build_tensor(key, data, tensor_dims, type, tensor_layout));
+
+    // Send the tensor
+    _send_tensor_delta(*tensor);
+}
+
+// Put a tensor into the database split into N-dimensional tiles
+void Client::put_tensor_tiled(const std::string& name,
+                              const void* data,
+                              const std::vector<size_t>& dims,
+                              const std::vector<size_t>& tile_dims,
+                              const SRTensorType type,
+                              const SRMemoryLayout mem_layout)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::string key = _build_tensor_key(name, false);
+
+    // The tiles of native column major data are reversed with it
+    std::vector<size_t> tensor_dims(dims);
+    std::vector<size_t> tensor_tile_dims(tile_dims);
+    SRMemoryLayout tensor_layout = mem_layout;
+    if (_to_native_layout(tensor_dims, tensor_layout))
+        std::reverse(tensor_tile_dims.begin(), tensor_tile_dims.end());
+
+    std::unique_ptr<TensorBase> tensor(
+        _build_tensor(key, data, tensor_dims, type, tensor_layout));
+
+    // Send the tensor
+    _send_tiled_tensor(*tensor, tensor_tile_dims);
+}
+
+// Put a tensor into the database from a file
+void Client::put_tensor_from_file(const std::string& name,
+                                  const std::string& path,
+                                  const std::vector<size_t>& dims,
+                                  const SRTensorType type,
+                                  const size_t offset)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::string key = _build_tensor_key(name, false);
+    MappedFile file(path);
+    std::string_view contents(file.data(), file.size());
+
+    // A .npy file describes its values in its header
+    std::vector<size_t> file_dims(dims);
+    SRTensorType file_type = type;
+    size_t start = offset;
+    bool fortran_order = false;
+    if (dims.size() == 0) {
+        if (!is_npy_file(contents)) {
+            throw SRParameterException("The dimensions of the tensor in " +
+                                       path + " must be given, since it "\
+                                       "is not a .npy file.");
         }
+        start = parse_npy_header(contents, file_type, file_dims,
+                                 fortran_order);
     }
-    catch (std::bad_alloc& e) {
-        throw SRBadAllocException("tensor");
+
+    size_t n_values = 1;
+    for (size_t i = 0; i < file_dims.size(); i++)
+        n_values *= file_dims[i];
+    size_t n_bytes = n_values * tensor_type_size(file_type);
+    if (start > contents.size() || contents.size() - start < n_bytes) {
+        throw SRParameterException("The file " + path + " is too small "\
+                                   "for a tensor of the given type and "\
+                                   "dimensions.");
+    }
+    std::string_view values = contents.substr(start, n_bytes);
+
+    // A column major file is either stored as it is, with its dimensions
+    // reversed, or transposed like any column major tensor
+    SRMemoryLayout file_layout = SRMemLayoutFortranContiguous;
+    if (fortran_order && !_to_native_layout(file_dims, file_layout)) {
+        std::unique_ptr<TensorBase> tensor(
+            _build_tensor(key, values.data(), file_dims, file_type,
+                          file_layout));
+        _send_tensor(*tensor);
+        return;
+    }
+
+    // The mapped pages are sent without an intermediate copy
+    _send_tensor(key, file_type, file_dims, values);
+}
+
+// Append a record to a tensor that grows along its leading dimension
+void Client::append_to_tensor(const std::string& name,
+                              const void* data,
+                              const std::vector<size_t>& dims,
+                              const SRTensorType type,
+                              const SRMemoryLayout mem_layout)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::string key = _build_tensor_key(name, false);
+
+    std::vector<size_t> record_dims(dims);
+    SRMemoryLayout record_layout = mem_layout;
+    _to_native_layout(record_dims, record_layout);
+
+    std::unique_ptr<TensorBase> tensor(
+        _build_tensor(key, data, record_dims, type, record_layout));
+    std::string record = encode_tensor_record(
+        tensor->buf(), tensor->type(), tensor->dims(), _compression_codec,
+        _compression_level, _compression_error_bound);
+
+    // Only the new record is sent, and never onto the frames of a
+    // delta-encoded tensor, which would no longer decode
+    std::string ttl = std::to_string(_tensor_ttl > 0 ? _tensor_ttl : 0);
+    CommandReply reply = _run_key_script(
+        _TENSOR_APPEND_SCRIPT, _tensor_append_script_sha, key,
+        {std::string_view(record), std::string_view(ttl)});
+    _report_reply_errors(reply, "append_to_tensor failed");
+    if (reply.integer() < 0) {
+        throw SRRuntimeException("The tensor " + name + " is not an "\
+                                 "appendable tensor, so records cannot "\
+                                 "be appended to it.");
+    }
+}
+
+// Put a tensor into the database, converting it to another tensor type
+void Client::put_tensor_as(const std::string& name,
+                           const void* data,
+                           const std::vector<size_t>& dims,
+                           const SRTensorType type,
+                           const SRTensorType store_type,
+                           const SRMemoryLayout mem_layout)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    if (type == store_type) {
+        put_tensor(name, data, dims, type, mem_layout);
+        return;
+    }
+
+    std::string key = _build_tensor_key(name, false);
+
+    std::vector<size_t> tensor_dims(dims);
+    SRMemoryLayout tensor_layout = mem_layout;
+    _to_native_layout(tensor_dims, tensor_layout);
+
+    // Other layouts are first gathered into row major order in the
+    // source type; contiguous data is converted without staging
+    std::unique_ptr<TensorBase> staged;
+    const void* src_data = data;
+    if (tensor_layout != SRMemLayoutContiguous) {
+        staged.reset(_build_tensor(key, data, tensor_dims, type, tensor_layout));
+        src_data = staged->data_view(SRMemLayoutContiguous);
     }
 
+    std::unique_ptr<TensorBase> tensor(
+        _build_converted_tensor(key, src_data, tensor_dims, store_type, type));
+    staged.reset();
+
     // Send the tensor
-    CommandReply reply = _redis_server->put_tensor(*tensor);
+    _send_tensor(*tensor);
+}
 
-    // Cleanup
-    delete tensor;
-    tensor = NULL;
-    _report_reply_errors(reply, "put_tensor failed");
+// Put a tensor into the database, gathering it from strided memory
+void Client::put_tensor_strided(const std::string& name,
+                                const void* data,
+                                const std::vector<size_t>& dims,
+                                const std::vector<size_t>& strides,
+                                const size_t offset,
+                                const SRTensorType type)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::string key = _build_tensor_key(name, false);
+
+    std::unique_ptr<TensorBase> tensor(
+        _build_tensor(key, data, dims, strides, offset, type));
+
+    // Send the tensor
+    _send_tensor(*tensor);
 }
 
 // Get the tensor data, dimensions, and type for the provided tensor name.
@@ -363,7 +742,9 @@ void Client::get_tensor(const std::string& name,
     // Set the user values
     dims = ptr->dims();
     type = ptr->type();
-    data = ptr->data_view(mem_layout);
+    SRMemoryLayout tensor_layout = mem_layout;
+    _to_native_layout(dims, tensor_layout);
+    data = ptr->data_view(tensor_layout);
 
     // Hold the Tensor in memory for memory management
     _tensor_memory.add_tensor(ptr);
@@ -395,6 +776,58 @@ void Client::get_tensor(const std::string& name,
         dims[i] = *it;
 }
 
+// Get a window of the records of an appendable tensor
+void Client::get_tensor_range(const std::string& name,
+                              const size_t start,
+                              const size_t stop,
+                              void*& data,
+                              std::vector<size_t>& dims,
+                              SRTensorType& type,
+                              const SRMemoryLayout mem_layout)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    // Retrieve the records from the database
+    TensorBase* ptr = _get_tensor_range_obj(name, start, stop);
+
+    // Set the user values
+    dims = ptr->dims();
+    type = ptr->type();
+    SRMemoryLayout tensor_layout = mem_layout;
+    _to_native_layout(dims, tensor_layout);
+    data = ptr->data_view(tensor_layout);
+
+    // Hold the Tensor in memory for memory management
+    _tensor_memory.add_tensor(ptr);
+}
+
+// Get a window of the records of an appendable tensor. This is a c-style
+// interface for the tensor dimensions.
+void Client::get_tensor_range(const std::string& name,
+                              const size_t start,
+                              const size_t stop,
+                              void*& data,
+                              size_t*& dims,
+                              size_t& n_dims,
+                              SRTensorType& type,
+                              const SRMemoryLayout mem_layout)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::vector<size_t> dims_vec;
+    get_tensor_range(name, start, stop, data, dims_vec, type, mem_layout);
+
+    size_t dims_bytes = sizeof(size_t) * dims_vec.size();
+    dims = _dim_queries.allocate_bytes(dims_bytes);
+    n_dims = dims_vec.size();
+
+    std::vector<size_t>::const_iterator it = dims_vec.cbegin();
+    for (size_t i = 0; it != dims_vec.cend(); i++, it++)
+        dims[i] = *it;
+}
+
 // Get tensor data and fill an already allocated array memory space that
 // has the specified MemoryLayout. The provided type and dimensions are
 // checked against retrieved values to ensure the provided memory space is
@@ -416,111 +849,269 @@ void Client::unpack_tensor(const std::string& name,
                                  "layout is contiguous.");
     }
 
-    std::string get_key = _build_tensor_key(name, true);
-    CommandReply reply = _redis_server->get_tensor(get_key);
-
-    std::vector<size_t> reply_dims = GetTensorCommand::get_dims(reply);
-
-    // Make sure we have the right dims to unpack into (Contiguous case)
-    if (mem_layout == SRMemLayoutContiguous ||
-        mem_layout == SRMemLayoutFortranContiguous) {
-        size_t total_dims = 1;
-        for (size_t i = 0; i < reply_dims.size(); i++) {
-            total_dims *= reply_dims[i];
-        }
-        if (total_dims != dims[0] &&
-            mem_layout == SRMemLayoutContiguous) {
-            throw SRRuntimeException("The dimensions of the fetched "\
-                                     "tensor do not match the length of "\
-                                     "the contiguous memory space.");
-        }
+    // A chunked tensor is reassembled directly into contiguous memory
+    void* dest = NULL;
+    size_t dest_size = 0;
+    if (mem_layout == SRMemLayoutContiguous && dims.size() == 1) {
+        dest = data;
+        dest_size = dims[0] * tensor_type_size(type);
     }
 
-    // Make sure we have the right dims to unpack into (Nested case)
-    if (mem_layout == SRMemLayoutNested) {
-        if (dims.size() != reply_dims.size()) {
-            // Same number of dimensions
-            throw SRRuntimeException("The number of dimensions of the  "\
-                                     "fetched tensor, " +
-                                     std::to_string(reply_dims.size()) + " "\
-                                     "does not match the number of "\
-                                     "dimensions of the user memory space, " +
-                                     std::to_string(dims.size()));
-        }
+    std::string get_key = _build_tensor_key(name, true);
+    CommandReply reply;
+    std::string decompressed;
+    SRTensorType reply_type;
+    std::vector<size_t> reply_dims;
+    std::string_view blob;
+    _fetch_tensor(get_key, reply, decompressed, reply_type, reply_dims, blob,
+                  dest, type, dest_size);
 
-        // Same size in each dimension
-        for (size_t i = 0; i < reply_dims.size(); i++) {
-            if (dims[i] != reply_dims[i]) {
-                throw SRRuntimeException("The dimensions of the fetched tensor "\
-                                         "do not match the provided "\
-                                         "dimensions of the user memory space.");
-            }
-        }
-    }
+    _check_unpack_dims(dims, reply_dims, mem_layout);
 
     // Make sure we're unpacking the right type of data
-    SRTensorType reply_type = GetTensorCommand::get_data_type(reply);
     if (type != reply_type)
         throw SRRuntimeException("The type of the fetched tensor "\
                                  "does not match the provided type");
+    if (dest != NULL && blob.data() == (const char*)dest)
+        return;
 
-    // Retrieve the tensor data into a Tensor
-    std::string_view blob = GetTensorCommand::get_data_blob(reply);
-    TensorBase* tensor = NULL;
-    try {
-        switch (reply_type) {
-            case SRTensorTypeDouble:
-                tensor = new Tensor<double>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeFloat:
-                tensor = new Tensor<float>(get_key, (void*)blob.data(),
-                                           reply_dims, reply_type,
-                                           SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeInt64:
-                tensor = new Tensor<int64_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeInt32:
-                tensor = new Tensor<int32_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeInt16:
-                tensor = new Tensor<int16_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeInt8:
-                tensor = new Tensor<int8_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeUint16:
-                tensor = new Tensor<uint16_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeUint8:
-                tensor = new Tensor<uint8_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            default:
-                throw SRTypeException("Invalid type for unpack_tensor");
-        }
+    // A tensor stored in the native column major layout is copied
+    // into the user memory space unchanged
+    std::vector<size_t> tensor_dims(dims);
+    SRMemoryLayout tensor_layout = mem_layout;
+    if (_to_native_layout(tensor_dims, tensor_layout)) {
+        std::memcpy(data, blob.data(), blob.size());
+        return;
     }
-    catch (std::bad_alloc& e) {
-        throw SRBadAllocException("tensor");
+
+    // Retrieve the tensor data into a Tensor and unpack it
+    std::unique_ptr<TensorBase> tensor(
+        _build_tensor(get_key, blob.data(), reply_dims, reply_type,
+                      SRMemLayoutContiguous));
+    tensor->fill_mem_space(data, dims, mem_layout);
+}
+
+// Retrieve a tensor from the database into memory provided by the
+// caller, converting it to the tensor type of that memory
+void Client::unpack_tensor_as(const std::string& name,
+                              void* data,
+                              const std::vector<size_t>& dims,
+                              const SRTensorType type,
+                              const SRMemoryLayout mem_layout)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    if (mem_layout == SRMemLayoutContiguous && dims.size() > 1) {
+        throw SRRuntimeException("The destination memory space "\
+                                 "dimension vector should only "\
+                                 "be of size one if the memory "\
+                                 "layout is contiguous.");
     }
 
-    // Unpack the tensor and reclaim it
+    std::string get_key = _build_tensor_key(name, true);
+    CommandReply reply;
+    std::string decompressed;
+    SRTensorType reply_type;
+    std::vector<size_t> reply_dims;
+    std::string_view blob;
+    _fetch_tensor(get_key, reply, decompressed, reply_type, reply_dims, blob);
+
+    _check_unpack_dims(dims, reply_dims, mem_layout);
+
+    // Row major memory, including native column major memory with
+    // reversed dimensions, is filled by converting the reply directly
+    std::vector<size_t> tensor_dims(dims);
+    SRMemoryLayout tensor_layout = mem_layout;
+    _to_native_layout(tensor_dims, tensor_layout);
+    if (tensor_layout == SRMemLayoutContiguous) {
+        size_t n_values = 1;
+        for (size_t i = 0; i < reply_dims.size(); i++)
+            n_values *= reply_dims[i];
+        convert_tensor_values(blob.data(), reply_type, data, type, n_values);
+        return;
+    }
+
+    // Other layouts are converted into a Tensor and then unpacked
+    std::unique_ptr<TensorBase> tensor(
+        _build_converted_tensor(get_key, blob.data(), reply_dims,
+                                type, reply_type));
     tensor->fill_mem_space(data, dims, mem_layout);
-    delete tensor;
-    tensor = NULL;
+}
+
+// Retrieve a tensor from the database into strided memory
+void Client::unpack_tensor_strided(const std::string& name,
+                                   void* data,
+                                   const std::vector<size_t>& dims,
+                                   const std::vector<size_t>& strides,
+                                   const size_t offset,
+                                   const SRTensorType type)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    if (strides.size() != dims.size()) {
+        throw SRParameterException("The number of strides must match "\
+                                   "the number of dimensions.");
+    }
+
+    std::unique_ptr<TensorBase> tensor(_get_tensorbase_obj(name));
+
+    // Make sure we're unpacking the right type of data
+    if (type != tensor->type())
+        throw SRRuntimeException("The type of the fetched tensor "\
+                                 "does not match the provided type");
+
+    // Scatter the tensor into the user memory space
+    tensor->fill_mem_space_strided(data, dims, strides, offset);
+}
+
+// Retrieve a tensor from the database into a file
+void Client::unpack_tensor_to_file(const std::string& name,
+                                   const std::string& path)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    std::string get_key = _build_tensor_key(name, true);
+    bool npy = path.size() >= 4 &&
+               path.compare(path.size() - 4, 4, ".npy") == 0;
+
+    // Create and map a file for the values and the header, if any
+    std::unique_ptr<MappedFile> file;
+    std::string header;
+    auto create_file = [&](SRTensorType type,
+                           const std::vector<size_t>& dims) {
+        size_t n_bytes = tensor_type_size(type);
+        for (size_t i = 0; i < dims.size(); i++)
+            n_bytes *= dims[i];
+        header = npy ? build_npy_header(type, dims) : std::string();
+        file.reset();
+        file = std::make_unique<MappedFile>(path, header.size() + n_bytes);
+        if (header.size() > 0)
+            std::memcpy(file->data(), header.data(), header.size());
+    };
+
+    // The size of a tensor stored in parts is known from its manifest,
+    // so its parts are fetched straight into the file
+    CommandReply prefix;
+    SRTensorType dest_type = SRTensorTypeInvalid;
+    if (_get_manifest_prefix(get_key, prefix)) {
+        std::string_view buf(prefix.str(), prefix.str_len());
+        if (ChunkManifest::is_manifest(buf)) {
+            ChunkManifest manifest = ChunkManifest::unpack(buf);
+            dest_type = manifest.type;
+            create_file(dest_type, manifest.dims);
+        }
+        else if (TileManifest::is_manifest(buf)) {
+            TileManifest manifest = TileManifest::unpack(buf);
+            dest_type = manifest.type;
+            create_file(dest_type, manifest.dims);
+        }
+    }
+
+    void* dest = NULL;
+    size_t dest_size = 0;
+    if (file != nullptr) {
+        dest = file->data() + header.size();
+        dest_size = file->size() - header.size();
+    }
+
+    CommandReply reply;
+    std::string decompressed;
+    SRTensorType reply_type;
+    std::vector<size_t> reply_dims;
+    std::string_view blob;
+    _fetch_tensor(get_key, reply, decompressed, reply_type, reply_dims, blob,
+                  dest, dest_type, dest_size);
+
+    // Any other tensor, or one replaced in the meantime, is copied from
+    // the reply
+    if (file == nullptr || blob.data() != (const char*)dest) {
+        create_file(reply_type, reply_dims);
+        if (blob.size() > 0) {
+            std::memcpy(file->data() + header.size(), blob.data(),
+                        blob.size());
+        }
+    }
+    file->sync();
+}
+
+// Get a sub-region of a tensor into contiguous memory
+void Client::unpack_tensor_slice(const std::string& name,
+                                 const std::vector<size_t>& offsets,
+                                 const std::vector<size_t>& counts,
+                                 void* data,
+                                 const SRTensorType type)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    if (offsets.size() != counts.size()) {
+        throw SRParameterException("The offsets and counts of a tensor "\
+                                   "region must have the same length.");
+    }
+
+    // Check that the region lies within the tensor
+    auto check_region = [&](const std::vector<size_t>& dims,
+                            SRTensorType tensor_type) {
+        if (tensor_type != type)
+            throw SRRuntimeException("The type of the fetched tensor "\
+                                     "does not match the provided type");
+        if (dims.size() != offsets.size()) {
+            throw SRParameterException("The region has " +
+                                       std::to_string(offsets.size()) +
+                                       " dimensions but the tensor has " +
+                                       std::to_string(dims.size()) + ".");
+        }
+        for (size_t i = 0; i < dims.size(); i++) {
+            if (offsets[i] > dims[i] || counts[i] > dims[i] - offsets[i]) {
+                throw SRParameterException("The region extends beyond "\
+                                           "dimension " + std::to_string(i) +
+                                           " of the tensor.");
+            }
+        }
+    };
+
+    // Only the tiles of a tiled tensor that intersect the region are
+    // fetched
+    std::string get_key = _build_tensor_key(name, true);
+    TileManifest manifest;
+    if (_get_tile_manifest(get_key, manifest)) {
+        const int max_attempts = 3;
+        for (int attempt = 1; ; attempt++) {
+            check_region(manifest.dims, manifest.type);
+            if (_fetch_tiles(get_key, manifest, offsets, counts,
+                             (char*)data)) {
+                return;
+            }
+
+            // The tensor was replaced while its tiles were fetched
+            if (attempt == max_attempts ||
+                !_get_tile_manifest(get_key, manifest)) {
+                throw SRRuntimeException("The tiles of tensor " + get_key +
+                                         " changed while they were "\
+                                         "being fetched.");
+            }
+        }
+    }
+
+    // Any other tensor is fetched whole and the region copied out of it
+    CommandReply reply;
+    std::string decompressed;
+    SRTensorType reply_type;
+    std::vector<size_t> reply_dims;
+    std::string_view blob;
+    _fetch_tensor(get_key, reply, decompressed, reply_type, reply_dims, blob);
+    check_region(reply_dims, reply_type);
+
+    std::vector<size_t> hi(offsets);
+    for (size_t i = 0; i < hi.size(); i++)
+        hi[i] += counts[i];
+    copy_tensor_box(blob.data(), reply_dims,
+                    std::vector<size_t>(reply_dims.size(), 0),
+                    (char*)data, counts, offsets, offsets, hi,
+                    tensor_type_size(type));
 }
 
 // Move a tensor from one name to another name
@@ -532,6 +1123,21 @@ void Client::rename_tensor(const std::string& old_name,
 
     std::string old_key = _build_tensor_key(old_name, true);
     std::string new_key = _build_tensor_key(new_name, false);
+
+    // Tensors stored as strings may have chunks or tiles whose keys are
+    // formed from the tensor key, so they are copied under the new key
+    // and then deleted
+    std::vector<std::string> old_keys;
+    std::vector<std::string> new_keys;
+    size_t batch_size = 1;
+    if (old_key != new_key &&
+        _get_string_tensor_keys(old_key, new_key, old_keys, new_keys,
+                                batch_size)) {
+        _copy_string_tensor(old_keys, new_keys, batch_size);
+        _unlink_keys(old_keys);
+        return;
+    }
+
     CommandReply reply = _redis_server->rename_tensor(old_key, new_key);
     _report_reply_errors(reply, "rename_tensor failed");
 }
@@ -543,8 +1149,14 @@ void Client::delete_tensor(const std::string& name)
     LOG_API_FUNCTION();
 
     std::string key = _build_tensor_key(name, true);
+    std::vector<std::string> part_keys = _get_part_keys(key);
     CommandReply reply = _redis_server->delete_tensor(key);
     _report_reply_errors(reply, "delete_tensor failed");
+    _unlink_keys(part_keys);
+
+    // A tensor put with put_tensor_delta() must restart with a keyframe
+    std::lock_guard<std::mutex> guard(*_delta_lock);
+    _delta_encoders.erase(key);
 }
 
 // Copy the tensor from the source name to the destination name
@@ -556,6 +1168,18 @@ void Client::copy_tensor(const std::string& src_name,
 
     std::string src_key = _build_tensor_key(src_name, true);
     std::string dest_key = _build_tensor_key(dest_name, false);
+
+    // Tensors stored as strings are copied with their chunks or tiles
+    std::vector<std::string> src_keys;
+    std::vector<std::string> dest_keys;
+    size_t batch_size = 1;
+    if (src_key != dest_key &&
+        _get_string_tensor_keys(src_key, dest_key, src_keys, dest_keys,
+                                batch_size)) {
+        _copy_string_tensor(src_keys, dest_keys, batch_size);
+        return;
+    }
+
     CommandReply reply = _redis_server->copy_tensor(src_key, dest_key);
     _report_reply_errors(reply, "copy_tensor failed");
 }
@@ -1296,6 +1920,76 @@ void Client::use_dataset_ensemble_prefix(bool use_prefix)
     _use_dataset_prefix = use_prefix;
 }
 
+// Set whether DataSets should be stored in the packed format, with all
+// tensors and metadata fields serialized into a single buffer. DataSets
+// are read correctly regardless of this setting. By default, the client
+// does not pack DataSets.
+void Client::use_packed_datasets(bool use_packed)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    _use_packed_datasets = use_packed;
+}
+
+// Set whether the commands placing a DataSet in the database should be
+// wrapped in a MULTI/EXEC transaction so that the DataSet is published
+// atomically. By default, the client publishes DataSets in a pipeline.
+void Client::use_dataset_transactions(bool use_transactions)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    _use_dataset_transactions = use_transactions;
+}
+
+// Set whether Fortran ordered tensors should be stored column major, with
+// their dimensions reversed, instead of being transposed to row major
+// order. By default, the client transposes Fortran ordered tensors.
+void Client::use_native_fortran_layout(bool use_native)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    _use_native_fortran_layout = use_native;
+}
+
+// Set the time to live of tensors placed by put_tensor()
+void Client::set_tensor_ttl(int ttl_ms)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    if (ttl_ms < 0)
+        throw SRParameterException("The tensor time to live must not "\
+                                   "be negative.");
+    _tensor_ttl = ttl_ms;
+}
+
+// Set the time to live of DataSets
+void Client::set_dataset_ttl(int ttl_ms)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    if (ttl_ms < 0)
+        throw SRParameterException("The DataSet time to live must not "\
+                                   "be negative.");
+    _dataset_ttl = ttl_ms;
+}
+
+// Set the maximum number of entries retained in aggregation lists
+void Client::set_list_retention(int max_length)
+{
+    // Track calls to this API function
+    LOG_API_FUNCTION();
+
+    if (max_length < 0)
+        throw SRParameterException("The aggregation list retention must "\
+                                   "not be negative.");
+    _list_retention = max_length;
+}
+
 // Returns information about the given database node
 parsed_reply_nested_map Client::get_db_node_info(const std::string address)
 {
@@ -1469,6 +2163,22 @@ void Client::append_to_list(const std::string& list_name,
     // The aggregation list stores dataset key (not the meta key)
     std::string dataset_key = _build_dataset_key(dataset.get_name(), false);
 
+    // Trim the list to its retained length in the same pipeline
+    if (_list_retention > 0) {
+        CommandList cmds;
+        SingleKeyCommand* push_cmd = cmds.add_command<SingleKeyCommand>();
+        *push_cmd << "RPUSH" << Keyfield(list_key) << dataset_key;
+        SingleKeyCommand* trim_cmd = cmds.add_command<SingleKeyCommand>();
+        *trim_cmd << "LTRIM" << Keyfield(list_key)
+                  << std::to_string(-_list_retention) << "-1";
+        PipelineReply replies = _redis_server->run_in_pipeline(cmds);
+        if (replies.has_error()) {
+            throw SRRuntimeException("RPUSH command failed. DataSet could "\
+                                     "not be added to the aggregation list.");
+        }
+        return;
+    }
+
     // Build the command
     SingleKeyCommand cmd;
     cmd << "RPUSH" << Keyfield(list_key) << dataset_key;
@@ -1762,6 +2472,69 @@ void Client::_get_prefix_settings()
         set_data_source(_get_key_prefixes[0].c_str());
 }
 
+// Set the codec, level and error bound used to compress tensors and
+// packed DataSets using the SR_COMPRESSION, SR_COMPRESSION_LEVEL and
+// SR_COMPRESSION_ERROR_BOUND configuration settings
+void Client::_get_compression_settings()
+{
+    _compression_codec = compression_codec_from_string(
+        _cfgopts->_resolve_string_option("SR_COMPRESSION", "none"));
+    int64_t level = _cfgopts->_resolve_integer_option(
+        "SR_COMPRESSION_LEVEL", 1);
+    if (level < 1 || level > 9) {
+        throw SRParameterException("SR_COMPRESSION_LEVEL must be between "\
+                                   "1 and 9, not " + std::to_string(level));
+    }
+    _compression_level = (int)level;
+
+    // Lossy codecs need the largest absolute error allowed in a value
+    std::string bound = _cfgopts->_resolve_string_option(
+        "SR_COMPRESSION_ERROR_BOUND", "0");
+    try {
+        _compression_error_bound = std::stod(bound);
+    }
+    catch (std::exception& e) {
+        throw SRParameterException("SR_COMPRESSION_ERROR_BOUND must be a "\
+                                   "number, not " + bound);
+    }
+    if (_compression_codec != SRCompressionNone &&
+        get_compression_codec(_compression_codec)->is_lossy() &&
+        !(_compression_error_bound > 0.0)) {
+        throw SRParameterException("SR_COMPRESSION_ERROR_BOUND must be "\
+                                   "positive for lossy compression");
+    }
+}
+
+// Set the number of delta-encoded puts between keyframes using the
+// SR_DELTA_KEYFRAME_INTERVAL configuration setting
+void Client::_get_delta_settings()
+{
+    int64_t interval = _cfgopts->_resolve_integer_option(
+        "SR_DELTA_KEYFRAME_INTERVAL", 16);
+    if (interval < 1 || interval > INT32_MAX) {
+        throw SRParameterException("SR_DELTA_KEYFRAME_INTERVAL must be "\
+                                   "positive, not " +
+                                   std::to_string(interval));
+    }
+    _delta_keyframe_interval = (int)interval;
+}
+
+// Set the size above which tensors are stored in chunks using the
+// SR_TENSOR_CHUNK_SIZE configuration setting
+void Client::_get_chunk_settings()
+{
+    // Redis limits bulk strings to 512 MiB by default, so tensors
+    // larger than that are stored in chunks unless configured otherwise
+    int64_t chunk_size = _cfgopts->_resolve_integer_option(
+        "SR_TENSOR_CHUNK_SIZE", 536870912);
+    if (chunk_size < 1) {
+        throw SRParameterException("SR_TENSOR_CHUNK_SIZE must be "\
+                                   "positive, not " +
+                                   std::to_string(chunk_size));
+    }
+    _tensor_chunk_size = (size_t)chunk_size;
+}
+
 // Get the key prefix for placement methods
 inline std::string Client::_put_prefix()
 {
@@ -1812,6 +2585,23 @@ inline void Client::_add_dataset_tensor(
     const std::string& name,
     CommandReply tensor_data)
 {
+    // Tensors of types that RedisAI does not support arrive as
+    // compression containers
+    if (tensor_data.redis_reply_type() == "REDIS_REPLY_STRING") {
+        std::string_view buf(tensor_data.str(), tensor_data.str_len());
+        if (!is_compressed_buffer(buf)) {
+            throw SRRuntimeException("Tensor " + name + " of DataSet " +
+                                     dataset.get_name() + " is not stored "\
+                                     "as a tensor.");
+        }
+        SRTensorType type;
+        std::vector<size_t> dims;
+        std::string values = decompress_buffer(buf, type, dims);
+        dataset._add_to_tensorpack(name, (void*)values.data(), dims,
+                                   type, SRMemLayoutContiguous);
+        return;
+    }
+
     // Extract tensor properties from command reply
     std::vector<size_t> reply_dims = GetTensorCommand::get_dims(tensor_data);
     std::string_view blob = GetTensorCommand::get_data_blob(tensor_data);
@@ -1822,6 +2612,41 @@ inline void Client::_add_dataset_tensor(
                                type, SRMemLayoutContiguous);
 }
 
+// Retrieve the tensors of unpacked DataSets, one round trip per shard
+// unless some of them are stored in a compression container
+PipelineReply Client::_get_dataset_tensors(const std::vector<std::string>& keys)
+{
+    CommandList tensor_cmds;
+    for (size_t i = 0; i < keys.size(); i++) {
+        SingleKeyCommand* cmd = tensor_cmds.add_command<SingleKeyCommand>();
+        *cmd << "AI.TENSORGET" << Keyfield(keys[i]) << "META" << "BLOB";
+    }
+    try {
+        return _redis_server->run_via_unordered_pipelines(tensor_cmds);
+    }
+    catch (RuntimeException& e) {
+        // AI.TENSORGET rejects containers as the wrong type of key, so
+        // the pipeline is run again with GET for the keys holding strings
+    }
+
+    CommandList type_cmds;
+    for (size_t i = 0; i < keys.size(); i++) {
+        SingleKeyCommand* cmd = type_cmds.add_command<SingleKeyCommand>();
+        *cmd << "TYPE" << Keyfield(keys[i]);
+    }
+    PipelineReply types = _redis_server->run_via_unordered_pipelines(type_cmds);
+
+    CommandList get_cmds;
+    for (size_t i = 0; i < keys.size(); i++) {
+        SingleKeyCommand* cmd = get_cmds.add_command<SingleKeyCommand>();
+        if (types[i].status_str() == "string")
+            *cmd << "GET" << Keyfield(keys[i]);
+        else
+            *cmd << "AI.TENSORGET" << Keyfield(keys[i]) << "META" << "BLOB";
+    }
+    return _redis_server->run_via_unordered_pipelines(get_cmds);
+}
+
 inline std::vector<DataSet>
 Client::_get_dataset_list_range(const std::string& list_name,
                                 int start_index,
@@ -1847,9 +2672,9 @@ Client::_get_dataset_list_range(const std::string& list_name,
         throw SRRuntimeException("An unexpected type was returned for "
                                  "for the aggregation list.");
 
-    // Create CommandList for retrieving all metadata values in pipeline
-    CommandList metadata_cmd_list;
-
+    // Collect the DataSet keys and names from the list entries
+    std::vector<std::string> dataset_keys;
+    std::vector<std::string> dataset_names;
     for (size_t i = 0; i < reply.n_elements(); i++) {
         // Check that the ith entry is a string (i.e. key)
         if (reply[i].redis_reply_type() != "REDIS_REPLY_STRING") {
@@ -1867,12 +2692,28 @@ Client::_get_dataset_list_range(const std::string& list_name,
         }
 
         // Get the dataset key from the list entry
-        std::string dataset_key_prefix(reply[i].str(), reply[i].str_len());
+        dataset_keys.push_back(std::string(reply[i].str(), reply[i].str_len()));
+        dataset_names.push_back(
+            _get_dataset_name_from_list_entry(dataset_keys.back()));
+    }
+
+    return _get_datasets_by_key(dataset_keys, dataset_names, false);
+}
 
+// Retrieve DataSets given their database keys, one round trip per shard
+// for the metadata and one for the tensors
+std::vector<DataSet>
+Client::_get_datasets_by_key(const std::vector<std::string>& dataset_keys,
+                             const std::vector<std::string>& dataset_names,
+                             bool require_exists)
+{
+    // Create CommandList for retrieving all metadata values in pipeline
+    CommandList metadata_cmd_list;
+    for (size_t i = 0; i < dataset_keys.size(); i++) {
         // Build the metadata retrieval command
         SingleKeyCommand* metadata_cmd =
             metadata_cmd_list.add_command<SingleKeyCommand>();
-        (*metadata_cmd) << "HGETALL" << Keyfield(dataset_key_prefix + ".meta");
+        (*metadata_cmd) << "HGETALL" << Keyfield(dataset_keys[i] + ".meta");
     }
 
     // Run the commands via unordered pipeline
@@ -1883,8 +2724,11 @@ Client::_get_dataset_list_range(const std::string& list_name,
     // Start a lists of datasets that will be returned to the users
     std::vector<DataSet> dataset_list;
 
-    // Command list for all tensorget commands
-    CommandList tensor_cmd_list;
+    // Keys of the tensors of unpacked DataSets
+    std::vector<std::string> tensor_keys;
+
+    // Whether each DataSet was stored in the packed format
+    std::vector<bool> packed_datasets;
 
     for (size_t i = 0; i < metadata_replies.size(); i++) {
 
@@ -1895,17 +2739,24 @@ Client::_get_dataset_list_range(const std::string& list_name,
         _report_reply_errors(metadata_reply, "An error was encountered in "\
                                              "metdata retrieval.");
 
-        std::string dataset_key =
-            std::string(reply[i].str(), reply[i].str_len());
-        std::string dataset_name =
-            _get_dataset_name_from_list_entry(dataset_key);
+        // If the reply has no elements, the DataSet didn't exist
+        if (require_exists && metadata_reply.n_elements() == 0) {
+            throw SRKeyException("The requested DataSet, \"" +
+                                 dataset_names[i] + "\", does not exist.");
+        }
+
+        const std::string& dataset_key = dataset_keys[i];
 
         // Unpack the dataset to get tensor names
-        dataset_list.push_back(DataSet(dataset_name));
+        dataset_list.push_back(DataSet(dataset_names[i]));
         DataSet& dataset = dataset_list.back();
 
-        // Unpack the metadata
-        _unpack_dataset_metadata(dataset, metadata_reply);
+        // Unpack the metadata; packed DataSets need no tensor retrieval
+        if (_unpack_dataset_metadata(dataset, metadata_reply)) {
+            packed_datasets.push_back(true);
+            continue;
+        }
+        packed_datasets.push_back(false);
 
         // Loop through tensor names in the dataset
         std::vector<std::string> tensor_names =
@@ -1914,27 +2765,20 @@ Client::_get_dataset_list_range(const std::string& list_name,
         for(size_t j = 0; j < tensor_names.size(); j++) {
 
             // Make the tensor key
-            std::string tensor_key = dataset_key + "." +
-                                     tensor_names[j];
-
-            // Build the tensor retrieval cmd
-            SingleKeyCommand* tensor_cmd =
-                tensor_cmd_list.add_command<SingleKeyCommand>();
-
-            (*tensor_cmd) << "AI.TENSORGET" << Keyfield(tensor_key)
-                          << "META" << "BLOB";
+            tensor_keys.push_back(dataset_key + "." + tensor_names[j]);
         }
     }
 
     // Run the tensor get pipeline
-    PipelineReply tensor_replies =
-        _redis_server->run_via_unordered_pipelines(tensor_cmd_list);
+    PipelineReply tensor_replies = _get_dataset_tensors(tensor_keys);
 
     // Unpack tensor replies
     size_t tensor_reply_index = 0;
     for (size_t i = 0; i < dataset_list.size(); i++) {
 
         DataSet& dataset = dataset_list[i];
+        if (packed_datasets[i])
+            continue;
 
         std::vector<std::string> tensor_names =
             dataset_list[i].get_tensor_names();
@@ -1942,17 +2786,9 @@ Client::_get_dataset_list_range(const std::string& list_name,
         // Add the tensor replies as tensors
         for (size_t j = 0; j < tensor_names.size(); j++) {
 
-            // Shallow copy of the pipeline reply for this tensor
-            CommandReply tensor_reply = tensor_replies[tensor_reply_index];
-
-            // Extract tensor properties from command reply
-            std::vector<size_t> reply_dims = GetTensorCommand::get_dims(tensor_reply);
-            std::string_view blob = GetTensorCommand::get_data_blob(tensor_reply);
-            SRTensorType type = GetTensorCommand::get_data_type(tensor_reply);
-
             // Add tensor to the dataset (deep copy)
-            dataset._add_to_tensorpack(tensor_names[j], (void*)blob.data(), reply_dims,
-                                       type, SRMemLayoutContiguous);
+            _add_dataset_tensor(dataset, tensor_names[j],
+                                tensor_replies[tensor_reply_index]);
 
             // Increment tensor reply index
             tensor_reply_index++;
@@ -2090,6 +2926,17 @@ void Client::_append_dataset_tensor_commands(CommandList& cmd_list,
         std::string tensor_key = _build_dataset_tensor_key(
             dataset.get_name(), tensor->name(), false);
         SingleKeyCommand* cmd = cmd_list.add_command<SingleKeyCommand>();
+
+        // Types that RedisAI does not support are stored in a compression
+        // container, as put_tensor() does. The command keeps a copy.
+        if (!is_redisai_tensor_type(tensor->type())) {
+            std::string container = compress_buffer(
+                tensor->buf(), tensor_type_size(tensor->type()),
+                tensor->type(), tensor->dims(), _compression_codec,
+                _compression_level, _compression_error_bound);
+            *cmd << "SET" << Keyfield(tensor_key) << container;
+            continue;
+        }
         *cmd << "AI.TENSORSET" << Keyfield(tensor_key) << tensor->type_str()
              << tensor->dims() << "BLOB" << tensor->buf();
     }
@@ -2104,8 +2951,625 @@ void Client::_append_dataset_ack_command(CommandList& cmd_list, DataSet& dataset
     *cmd << "HSET" << Keyfield(key) << _DATASET_ACK_FIELD << "1";
 }
 
+// Append all Commands associated with placing a DataSet in the database,
+// in the packed format if enabled, to a CommandList
+void Client::_append_dataset_commands(CommandList& cmd_list,
+                                      DataSet& dataset,
+                                      std::string& packed_buf)
+{
+    if (_use_packed_datasets) {
+        _append_packed_dataset_commands(cmd_list, dataset, packed_buf);
+    }
+    else {
+        _append_dataset_metadata_commands(cmd_list, dataset);
+        _append_dataset_tensor_commands(cmd_list, dataset);
+        _append_dataset_ack_command(cmd_list, dataset);
+    }
+    if (_dataset_ttl > 0)
+        _append_dataset_expire_commands(cmd_list, dataset, _use_packed_datasets);
+}
+
+// Append the Commands setting the expiry of all keys of a DataSet
+// to a CommandList
+void Client::_append_dataset_expire_commands(CommandList& cmd_list,
+                                             DataSet& dataset,
+                                             bool packed)
+{
+    _append_expire_command(
+        cmd_list, _build_dataset_meta_key(dataset.get_name(), false),
+        _dataset_ttl);
+    if (packed)
+        return;
+
+    std::vector<std::string> tensor_keys = _build_dataset_tensor_keys(
+        dataset.get_name(), dataset.get_tensor_names(), false);
+    for (size_t i = 0; i < tensor_keys.size(); i++)
+        _append_expire_command(cmd_list, tensor_keys[i], _dataset_ttl);
+}
+
+// Send a tensor to the database, together with its expiry if any
+void Client::_send_tensor(TensorBase& tensor)
+{
+    _send_tensor(tensor.name(), tensor.type(), tensor.dims(), tensor.buf());
+}
+
+// Send tensor values held in contiguous row major memory to the
+// database, together with their expiry if any
+void Client::_send_tensor(const std::string& key,
+                          SRTensorType type,
+                          const std::vector<size_t>& dims,
+                          std::string_view values)
+{
+    // Tensors too large for a single bulk string are stored in chunks
+    if (values.size() > _tensor_chunk_size) {
+        _send_chunked_tensor(key, type, dims, values);
+        return;
+    }
+
+    // Compressed tensors, and tensors of types that RedisAI does not
+    // support, are stored as plain strings in a compression container.
+    // SET replaces a value of any type, but not the chunks or tiles of
+    // a manifest.
+    if (_compression_codec != SRCompressionNone ||
+        !is_redisai_tensor_type(type)) {
+        std::string compressed = compress_buffer(
+            values, tensor_type_size(type), type, dims,
+            _compression_codec, _compression_level, _compression_error_bound);
+        std::vector<std::string> old_keys = _get_part_keys(key);
+
+        SingleKeyCommand cmd;
+        cmd << "SET" << Keyfield(key) << std::string_view(compressed);
+        if (_tensor_ttl > 0)
+            cmd << "PX" << std::to_string(_tensor_ttl);
+        CommandReply reply = _run(cmd);
+        _report_reply_errors(reply, "put_tensor failed");
+        _unlink_keys(old_keys);
+        return;
+    }
+
+    // AI.TENSORSET fails on a key holding a tensor stored in another
+    // format, which is then deleted so that the tensor can be sent again
+    try {
+        _send_tensorset(key, type, dims, values);
+    }
+    catch (RuntimeException& e) {
+        if (!_unlink_other_format(key))
+            throw;
+        _send_tensorset(key, type, dims, values);
+    }
+}
+
+// Send tensor values with AI.TENSORSET, together with their expiry if any
+void Client::_send_tensorset(const std::string& key,
+                             SRTensorType type,
+                             const std::vector<size_t>& dims,
+                             std::string_view values)
+{
+    if (_tensor_ttl > 0) {
+        CommandList cmds;
+        SingleKeyCommand* cmd = cmds.add_command<SingleKeyCommand>();
+        *cmd << "AI.TENSORSET" << Keyfield(key) << TENSOR_STR_MAP.at(type)
+             << dims << "BLOB" << values;
+        _append_expire_command(cmds, key, _tensor_ttl);
+        PipelineReply replies = _redis_server->run_in_pipeline(cmds);
+        if (replies.has_error())
+            throw SRRuntimeException("put_tensor failed");
+        return;
+    }
+
+    SingleKeyCommand cmd;
+    cmd << "AI.TENSORSET" << Keyfield(key) << TENSOR_STR_MAP.at(type)
+        << dims << "BLOB" << values;
+    CommandReply reply = _run(cmd);
+    _report_reply_errors(reply, "put_tensor failed");
+}
+
+// Delete the value stored under a tensor key if it is a string or a list,
+// as left by a tensor stored in another format, with its chunks or tiles
+bool Client::_unlink_other_format(const std::string& key)
+{
+    SingleKeyCommand cmd;
+    cmd << "TYPE" << Keyfield(key);
+    CommandReply reply = _run(cmd);
+    std::string type = reply.status_str();
+    if (type != "string" && type != "list")
+        return false;
+
+    std::vector<std::string> keys = _get_part_keys(key);
+    keys.push_back(key);
+    _unlink_keys(keys);
+    return true;
+}
+
+// Send a tensor to the database as a keyframe or as a delta against the
+// values last sent under its key
+void Client::_send_tensor_delta(TensorBase& tensor)
+{
+    std::lock_guard<std::mutex> guard(*_delta_lock);
+    std::string key = tensor.name();
+    auto it = _delta_encoders.find(key);
+    if (it == _delta_encoders.end()) {
+        it = _delta_encoders.emplace(
+            key, DeltaEncoder(_delta_keyframe_interval,
+                              _compression_level)).first;
+    }
+    DeltaEncoder& encoder = it->second;
+
+    try {
+        bool keyframe;
+        std::string frame = encoder.encode(tensor.buf(), tensor.type(),
+                                           tensor.dims(), keyframe);
+        long long n_frames = _push_delta_frame(key, frame, keyframe);
+
+        // If the frames were deleted, expired or written by another
+        // client in the meantime, the delta cannot be applied by
+        // readers, so the values are sent again as a keyframe
+        if (!keyframe && n_frames != (long long)encoder.stream_length()) {
+            encoder.reset();
+            frame = encoder.encode(tensor.buf(), tensor.type(),
+                                   tensor.dims(), keyframe);
+            _push_delta_frame(key, frame, keyframe);
+        }
+    }
+    catch (...) {
+        // The database may not hold the values the encoder last sent
+        _delta_encoders.erase(it);
+        throw;
+    }
+}
+
+// Append a delta frame to the frames stored under a key
+long long Client::_push_delta_frame(const std::string& key,
+                                    std::string_view frame,
+                                    bool keyframe)
+{
+    // The frame is pushed on its own, as pipelines fail as a whole on
+    // any error reply. The key may hold a tensor that was not put as
+    // deltas, which a keyframe replaces. A delta cannot be applied to
+    // it, so the caller is told that no frames are stored.
+    SingleKeyCommand push_cmd;
+    push_cmd << "RPUSH" << Keyfield(key) << frame;
+    bool wrong_type = false;
+    CommandReply reply = _run_catching(push_cmd, "WRONGTYPE", wrong_type);
+    if (wrong_type) {
+        if (!keyframe)
+            return 0;
+        std::vector<std::string> keys = _get_part_keys(key);
+        keys.push_back(key);
+        _unlink_keys(keys);
+        reply = _run(push_cmd);
+    }
+    _report_reply_errors(reply, "put_tensor_delta failed");
+    long long n_frames = reply.integer();
+
+    // A keyframe is appended before the older frames are trimmed away
+    // so that readers always find a keyframe
+    CommandList cmds;
+    if (keyframe) {
+        SingleKeyCommand* trim_cmd = cmds.add_command<SingleKeyCommand>();
+        *trim_cmd << "LTRIM" << Keyfield(key) << "-1" << "-1";
+        n_frames = 1;
+    }
+    if (_tensor_ttl > 0)
+        _append_expire_command(cmds, key, _tensor_ttl);
+    if (cmds.size() > 0)
+        _redis_server->run_in_pipeline(cmds);
+    return n_frames;
+}
+
+// Send a tensor to the database in chunks, followed by the manifest
+// describing them
+void Client::_send_chunked_tensor(const std::string& key,
+                                  SRTensorType type,
+                                  const std::vector<size_t>& dims,
+                                  std::string_view values)
+{
+    ChunkManifest manifest(type, dims, values.size(), _tensor_chunk_size);
+
+    // Note the parts of the tensor currently stored under the key
+    std::vector<std::string> old_keys = _get_part_keys(key);
+
+    // Send the chunks. In a cluster, the chunk keys are spread over the
+    // shards and the commands for each shard run in parallel pipelines
+    // on the thread pool.
+    CommandList chunk_cmds;
+    std::string ttl = std::to_string(_tensor_ttl);
+    for (size_t i = 0; i < manifest.n_chunks(); i++) {
+        SingleKeyCommand* cmd = chunk_cmds.add_command<SingleKeyCommand>();
+        *cmd << "SET" << Keyfield(manifest.chunk_key(key, i))
+             << values.substr(manifest.chunk_offset(i),
+                              manifest.chunk_bytes(i));
+        if (_tensor_ttl > 0)
+            *cmd << "PX" << ttl;
+    }
+    _redis_server->run_via_unordered_pipelines(chunk_cmds);
+
+    // The manifest makes the new chunks visible to readers
+    std::string packed = manifest.pack();
+    SingleKeyCommand cmd;
+    cmd << "SET" << Keyfield(key) << std::string_view(packed);
+    if (_tensor_ttl > 0)
+        cmd << "PX" << ttl;
+    CommandReply reply = _run(cmd);
+    _report_reply_errors(reply, "put_tensor failed");
+
+    _unlink_keys(old_keys);
+}
+
+// Send a tensor to the database in tiles, followed by the manifest
+// describing them
+void Client::_send_tiled_tensor(TensorBase& tensor,
+                                const std::vector<size_t>& tile_dims)
+{
+    std::string key = tensor.name();
+    std::string_view values = tensor.buf();
+    TileManifest manifest(tensor.type(), tensor.dims(), tile_dims);
+    size_t value_size = tensor_type_size(tensor.type());
+    std::vector<size_t> origin(manifest.dims.size(), 0);
+
+    // Note the parts of the tensor currently stored under the key
+    std::vector<std::string> old_keys = _get_part_keys(key);
+
+    // Send the tiles. Each tile is copied out of the tensor, so they are
+    // sent in batches that bound the memory held at once. In a cluster,
+    // the tile keys are spread over the shards and the commands for
+    // each shard run in parallel pipelines on the thread pool.
+    const size_t batch_bytes = (size_t)1 << 31;
+    std::string ttl = std::to_string(_tensor_ttl);
+    size_t n_tiles = manifest.n_tiles();
+    for (size_t first = 0; first < n_tiles; ) {
+        std::vector<std::string> tiles;
+        size_t bytes = 0;
+        size_t last = first;
+        while (last < n_tiles && (last == first || bytes < batch_bytes)) {
+            std::vector<size_t> lo = manifest.tile_origin(last);
+            std::vector<size_t> extent = manifest.tile_extent(last);
+            std::vector<size_t> hi(lo);
+            size_t n_values = 1;
+            for (size_t d = 0; d < hi.size(); d++) {
+                hi[d] += extent[d];
+                n_values *= extent[d];
+            }
+            tiles.push_back(std::string(n_values * value_size, '\0'));
+            copy_tensor_box(values.data(), manifest.dims, origin,
+                            tiles.back().data(), extent, lo, lo, hi,
+                            value_size);
+            bytes += tiles.back().size();
+            last++;
+        }
+
+        CommandList tile_cmds;
+        for (size_t i = first; i < last; i++) {
+            SingleKeyCommand* cmd = tile_cmds.add_command<SingleKeyCommand>();
+            *cmd << "SET" << Keyfield(manifest.tile_key(key, i))
+                 << std::string_view(tiles[i - first]);
+            if (_tensor_ttl > 0)
+                *cmd << "PX" << ttl;
+        }
+        _redis_server->run_via_unordered_pipelines(tile_cmds);
+        first = last;
+    }
+
+    // The manifest makes the new tiles visible to readers
+    std::string packed = manifest.pack();
+    SingleKeyCommand cmd;
+    cmd << "SET" << Keyfield(key) << std::string_view(packed);
+    if (_tensor_ttl > 0)
+        cmd << "PX" << ttl;
+    CommandReply reply = _run(cmd);
+    _report_reply_errors(reply, "put_tensor_tiled failed");
+
+    _unlink_keys(old_keys);
+}
+
+// Read the start of the value stored under a key
+bool Client::_get_manifest_prefix(const std::string& key,
+                                  CommandReply& reply)
+{
+    // Only the start of the value is read, since the key may hold a
+    // large compressed tensor instead
+    size_t length = std::max(ChunkManifest::max_packed_size,
+                             TileManifest::max_packed_size);
+    // A key holding a tensor or a list fails with WRONGTYPE
+    SingleKeyCommand cmd;
+    cmd << "GETRANGE" << Keyfield(key) << "0"
+        << std::to_string(length - 1);
+    bool wrong_type = false;
+    reply = _run_catching(cmd, "WRONGTYPE", wrong_type);
+    return !wrong_type && reply.has_error() == 0 &&
+           reply.redis_reply_type() == "REDIS_REPLY_STRING";
+}
+
+// Read the chunk manifest stored under a key
+bool Client::_get_chunk_manifest(const std::string& key,
+                                 ChunkManifest& manifest)
+{
+    CommandReply reply;
+    if (!_get_manifest_prefix(key, reply))
+        return false;
+    std::string_view buf(reply.str(), reply.str_len());
+    if (!ChunkManifest::is_manifest(buf))
+        return false;
+    manifest = ChunkManifest::unpack(buf);
+    return true;
+}
+
+// Read the tile manifest stored under a key
+bool Client::_get_tile_manifest(const std::string& key,
+                                TileManifest& manifest)
+{
+    CommandReply reply;
+    if (!_get_manifest_prefix(key, reply))
+        return false;
+    std::string_view buf(reply.str(), reply.str_len());
+    if (!TileManifest::is_manifest(buf))
+        return false;
+    manifest = TileManifest::unpack(buf);
+    return true;
+}
+
+// Get the keys of the chunks or tiles of the tensor stored under a key
+std::vector<std::string> Client::_get_part_keys(const std::string& key)
+{
+    CommandReply reply;
+    if (!_get_manifest_prefix(key, reply))
+        return std::vector<std::string>();
+    std::string_view buf(reply.str(), reply.str_len());
+    if (ChunkManifest::is_manifest(buf))
+        return ChunkManifest::unpack(buf).part_keys(key);
+    if (TileManifest::is_manifest(buf))
+        return TileManifest::unpack(buf).part_keys(key);
+    return std::vector<std::string>();
+}
+
+// Fetch the chunks of a tensor into memory
+bool Client::_fetch_chunks(const std::string& key,
+                           const ChunkManifest& manifest,
+                           char* dest)
+{
+    // Chunks are fetched in batches so that the replies held at once
+    // stay within a bounded amount of memory. In a cluster, the GETs
+    // for each shard run in parallel pipelines on the thread pool.
+    const uint64_t batch_bytes = (uint64_t)1 << 31;
+    size_t batch_size = (size_t)std::max<uint64_t>(
+        1, batch_bytes / manifest.chunk_size);
+    size_t n_chunks = manifest.n_chunks();
+
+    for (size_t first = 0; first < n_chunks; first += batch_size) {
+        size_t last = std::min(n_chunks, first + batch_size);
+        CommandList cmds;
+        for (size_t i = first; i < last; i++) {
+            SingleKeyCommand* cmd = cmds.add_command<SingleKeyCommand>();
+            *cmd << "GET" << Keyfield(manifest.chunk_key(key, i));
+        }
+        PipelineReply replies =
+            _redis_server->run_via_unordered_pipelines(cmds);
+
+        for (size_t i = first; i < last; i++) {
+            CommandReply reply = replies[i - first];
+            if (reply.is_nil())
+                return false;
+            if (reply.str_len() != manifest.chunk_bytes(i)) {
+                throw SRRuntimeException("A chunk of tensor " + key +
+                                         " has the wrong size.");
+            }
+            std::memcpy(dest + manifest.chunk_offset(i), reply.str(),
+                        reply.str_len());
+        }
+    }
+    return true;
+}
+
+// Fetch the tiles of a tensor intersecting a region into memory
+bool Client::_fetch_tiles(const std::string& key,
+                          const TileManifest& manifest,
+                          const std::vector<size_t>& offsets,
+                          const std::vector<size_t>& counts,
+                          char* dest)
+{
+    std::vector<size_t> tiles = manifest.tiles_in_region(offsets, counts);
+    size_t value_size = tensor_type_size(manifest.type);
+    size_t n_dims = manifest.dims.size();
+    size_t tile_bytes = value_size;
+    for (size_t d = 0; d < n_dims; d++)
+        tile_bytes *= manifest.tile_dims[d];
+
+    // Tiles are fetched in batches so that the replies held at once
+    // stay within a bounded amount of memory. In a cluster, the GETs
+    // for each shard run in parallel pipelines on the thread pool.
+    const uint64_t batch_bytes = (uint64_t)1 << 31;
+    size_t batch_size = (size_t)std::max<uint64_t>(
+        1, batch_bytes / std::max<size_t>(tile_bytes, 1));
+
+    for (size_t first = 0; first < tiles.size(); first += batch_size) {
+        size_t last = std::min(tiles.size(), first + batch_size);
+        CommandList cmds;
+        for (size_t i = first; i < last; i++) {
+            SingleKeyCommand* cmd = cmds.add_command<SingleKeyCommand>();
+            *cmd << "GET" << Keyfield(manifest.tile_key(key, tiles[i]));
+        }
+        PipelineReply replies =
+            _redis_server->run_via_unordered_pipelines(cmds);
+
+        // Scatter the part of each tile within the region into dest
+        for (size_t i = first; i < last; i++) {
+            CommandReply reply = replies[i - first];
+            if (reply.is_nil())
+                return false;
+
+            std::vector<size_t> origin = manifest.tile_origin(tiles[i]);
+            std::vector<size_t> extent = manifest.tile_extent(tiles[i]);
+            std::vector<size_t> lo(n_dims), hi(n_dims);
+            size_t n_values = 1;
+            for (size_t d = 0; d < n_dims; d++) {
+                n_values *= extent[d];
+                lo[d] = std::max(origin[d], offsets[d]);
+                hi[d] = std::min(origin[d] + extent[d],
+                                 offsets[d] + counts[d]);
+            }
+            if (reply.str_len() != n_values * value_size) {
+                throw SRRuntimeException("A tile of tensor " + key +
+                                         " has the wrong size.");
+            }
+            copy_tensor_box(reply.str(), extent, origin, dest, counts,
+                            offsets, lo, hi, value_size);
+        }
+    }
+    return true;
+}
+
+// Get the keys of a tensor stored as a string, with its chunks or tiles,
+// and the keys they take under another tensor key
+bool Client::_get_string_tensor_keys(const std::string& key,
+                                     const std::string& new_key,
+                                     std::vector<std::string>& keys,
+                                     std::vector<std::string>& new_keys,
+                                     size_t& batch_size)
+{
+    // A missing key reads as an empty string
+    CommandReply reply;
+    if (!_get_manifest_prefix(key, reply) || reply.str_len() == 0)
+        return false;
+
+    // Parts are copied in batches that bound the memory held at once
+    const uint64_t batch_bytes = (uint64_t)1 << 31;
+    std::string_view buf(reply.str(), reply.str_len());
+    batch_size = 1;
+    if (ChunkManifest::is_manifest(buf)) {
+        ChunkManifest manifest = ChunkManifest::unpack(buf);
+        keys = manifest.part_keys(key);
+        new_keys = manifest.part_keys(new_key);
+        batch_size = (size_t)std::max<uint64_t>(
+            1, batch_bytes / std::max<uint64_t>(manifest.chunk_size, 1));
+    }
+    else if (TileManifest::is_manifest(buf)) {
+        TileManifest manifest = TileManifest::unpack(buf);
+        keys = manifest.part_keys(key);
+        new_keys = manifest.part_keys(new_key);
+        uint64_t tile_bytes = tensor_type_size(manifest.type);
+        for (size_t d = 0; d < manifest.tile_dims.size(); d++)
+            tile_bytes *= manifest.tile_dims[d];
+        batch_size = (size_t)std::max<uint64_t>(
+            1, batch_bytes / std::max<uint64_t>(tile_bytes, 1));
+    }
+
+    // The manifest comes last, so that it is written after its parts
+    keys.push_back(key);
+    new_keys.push_back(new_key);
+    return true;
+}
+
+// Copy a tensor stored as a string, with its chunks or tiles, to other keys
+void Client::_copy_string_tensor(const std::vector<std::string>& src_keys,
+                                 const std::vector<std::string>& dest_keys,
+                                 size_t batch_size)
+{
+    // The parts of a manifest the destination held before are replaced.
+    // A copy of the same tensor has the same parts, which are kept.
+    std::vector<std::string> old_keys = _get_part_keys(dest_keys.back());
+    std::unordered_set<std::string> copied(dest_keys.begin(),
+                                           dest_keys.end());
+    old_keys.erase(std::remove_if(old_keys.begin(), old_keys.end(),
+                                  [&copied](const std::string& key) {
+                                      return copied.count(key) > 0;
+                                  }),
+                   old_keys.end());
+
+    // DUMP and RESTORE copy values between keys on different shards
+    std::string ttl = std::to_string(_tensor_ttl > 0 ? _tensor_ttl : 0);
+    for (size_t first = 0; first < src_keys.size(); ) {
+        // The manifest is copied on its own, after all of its parts
+        size_t last = std::min(src_keys.size() - 1, first + batch_size);
+        if (first == src_keys.size() - 1)
+            last = src_keys.size();
+
+        CommandList dump_cmds;
+        for (size_t i = first; i < last; i++) {
+            SingleKeyCommand* cmd = dump_cmds.add_command<SingleKeyCommand>();
+            *cmd << "DUMP" << Keyfield(src_keys[i]);
+        }
+        PipelineReply dumps =
+            _redis_server->run_via_unordered_pipelines(dump_cmds);
+
+        CommandList restore_cmds;
+        for (size_t i = first; i < last; i++) {
+            CommandReply dump = dumps[i - first];
+            if (dump.is_nil()) {
+                throw SRKeyException("The tensor stored under " +
+                                     src_keys.back() + " was modified "\
+                                     "while it was being copied.");
+            }
+            SingleKeyCommand* cmd =
+                restore_cmds.add_command<SingleKeyCommand>();
+            *cmd << "RESTORE" << Keyfield(dest_keys[i]) << ttl
+                 << std::string_view(dump.str(), dump.str_len())
+                 << "REPLACE";
+        }
+        _redis_server->run_via_unordered_pipelines(restore_cmds);
+        first = last;
+    }
+
+    _unlink_keys(old_keys);
+}
+
+// Delete the chunks or tiles of a tensor, which may be spread over
+// the shards of a cluster
+void Client::_unlink_keys(const std::vector<std::string>& keys)
+{
+    if (keys.size() == 0)
+        return;
+    CommandList cmds;
+    for (size_t i = 0; i < keys.size(); i++) {
+        SingleKeyCommand* cmd = cmds.add_command<SingleKeyCommand>();
+        *cmd << "UNLINK" << Keyfield(keys[i]);
+    }
+    _redis_server->run_via_unordered_pipelines(cmds);
+}
+
+// Append the Command setting the expiry of a key to a CommandList
+void Client::_append_expire_command(CommandList& cmd_list,
+                                    const std::string& key,
+                                    int ttl_ms)
+{
+    SingleKeyCommand* cmd = cmd_list.add_command<SingleKeyCommand>();
+    *cmd << "PEXPIRE" << Keyfield(key) << std::to_string(ttl_ms);
+}
+
+// Append the Commands associated with placing a DataSet in the packed
+// format to a CommandList
+void Client::_append_packed_dataset_commands(CommandList& cmd_list,
+                                             DataSet& dataset,
+                                             std::string& packed_buf)
+{
+    std::string meta_key = _build_dataset_meta_key(dataset.get_name(), false);
+    packed_buf = dataset._pack();
+    if (_compression_codec != SRCompressionNone) {
+        packed_buf = compress_buffer(packed_buf, 1, SRTensorTypeInvalid, {},
+                                     _compression_codec, _compression_level,
+                                     _compression_error_bound);
+    }
+
+    SingleKeyCommand* del_cmd = cmd_list.add_command<SingleKeyCommand>();
+    *del_cmd << "DEL" << Keyfield(meta_key);
+
+    // The buffer and the ack field are set together
+    SingleKeyCommand* cmd = cmd_list.add_command<SingleKeyCommand>();
+    *cmd << "HSET" << Keyfield(meta_key)
+         << _DATASET_PACKED_FIELD << std::string_view(packed_buf)
+         << _DATASET_ACK_FIELD << "1";
+}
+
+// Run the Commands that place a single DataSet in the database. All keys
+// of a DataSet share its hash tag, so a transaction is always possible.
+PipelineReply Client::_run_dataset_commands(CommandList& cmd_list)
+{
+    if (_use_dataset_transactions)
+        return _redis_server->run_in_transaction(cmd_list);
+    return _redis_server->run_in_pipeline(cmd_list);
+}
+
 // Put the metadata fields embedded in a CommandReply into the DataSet
-void Client::_unpack_dataset_metadata(DataSet& dataset, CommandReply& reply)
+bool Client::_unpack_dataset_metadata(DataSet& dataset, CommandReply& reply)
 {
     // Make sure we have paired elements
     if ((reply.n_elements() % 2) != 0)
@@ -2114,14 +3578,280 @@ void Client::_unpack_dataset_metadata(DataSet& dataset, CommandReply& reply)
                                  "elements.");
 
     // Process each pair of response fields
+    bool packed = false;
     for (size_t i = 0; i < reply.n_elements(); i += 2) {
         std::string field_name(reply[i].str(), reply[i].str_len());
-        if (field_name != _DATASET_ACK_FIELD) {
+        if (field_name == _DATASET_PACKED_FIELD) {
+            std::string_view buf(reply[i + 1].str(), reply[i + 1].str_len());
+            if (is_compressed_buffer(buf)) {
+                SRTensorType type;
+                std::vector<size_t> dims;
+                std::string packed_buf = decompress_buffer(buf, type, dims);
+                dataset._unpack(packed_buf.data(), packed_buf.size());
+            }
+            else {
+                dataset._unpack(buf.data(), buf.size());
+            }
+            packed = true;
+        }
+        else if (field_name != _DATASET_ACK_FIELD) {
             dataset._add_serialized_field(field_name,
                                           reply[i + 1].str(),
                                           reply[i + 1].str_len());
         }
     }
+    return packed;
+}
+
+// Map column major user memory stored natively onto the row major
+// tensor with reversed dimensions that shares its memory
+bool Client::_to_native_layout(std::vector<size_t>& dims,
+                               SRMemoryLayout& mem_layout) const
+{
+    if (!_use_native_fortran_layout ||
+        mem_layout != SRMemLayoutFortranContiguous)
+        return false;
+    std::reverse(dims.begin(), dims.end());
+    mem_layout = SRMemLayoutContiguous;
+    return true;
+}
+
+// Check the dimensions of a user memory space against those of a
+// fetched tensor before unpacking into it
+void Client::_check_unpack_dims(const std::vector<size_t>& dims,
+                                const std::vector<size_t>& reply_dims,
+                                const SRMemoryLayout mem_layout)
+{
+    // Native column major memory holds the tensor with reversed dims
+    std::vector<size_t> native_dims(dims);
+    SRMemoryLayout native_layout = mem_layout;
+    if (_to_native_layout(native_dims, native_layout)) {
+        if (native_dims != reply_dims) {
+            throw SRRuntimeException("The dimensions of the fetched tensor "\
+                                     "do not match the reversed dimensions "\
+                                     "of the column major user memory space.");
+        }
+        return;
+    }
+
+    // Make sure we have the right dims to unpack into (Contiguous case)
+    if (mem_layout == SRMemLayoutContiguous ||
+        mem_layout == SRMemLayoutFortranContiguous) {
+        size_t total_dims = 1;
+        for (size_t i = 0; i < reply_dims.size(); i++) {
+            total_dims *= reply_dims[i];
+        }
+        if (total_dims != dims[0] &&
+            mem_layout == SRMemLayoutContiguous) {
+            throw SRRuntimeException("The dimensions of the fetched "\
+                                     "tensor do not match the length of "\
+                                     "the contiguous memory space.");
+        }
+    }
+
+    // Make sure we have the right dims to unpack into (Nested case)
+    if (mem_layout == SRMemLayoutNested) {
+        if (dims.size() != reply_dims.size()) {
+            // Same number of dimensions
+            throw SRRuntimeException("The number of dimensions of the  "\
+                                     "fetched tensor, " +
+                                     std::to_string(reply_dims.size()) + " "\
+                                     "does not match the number of "\
+                                     "dimensions of the user memory space, " +
+                                     std::to_string(dims.size()));
+        }
+
+        // Same size in each dimension
+        for (size_t i = 0; i < reply_dims.size(); i++) {
+            if (dims[i] != reply_dims[i]) {
+                throw SRRuntimeException("The dimensions of the fetched tensor "\
+                                         "do not match the provided "\
+                                         "dimensions of the user memory space.");
+            }
+        }
+    }
+}
+
+// Allocate a Tensor of the given type holding a copy of the source data
+TensorBase* Client::_build_tensor(const std::string& key,
+                                  const void* data,
+                                  const std::vector<size_t>& dims,
+                                  const SRTensorType type,
+                                  const SRMemoryLayout mem_layout)
+{
+    return new_tensor(type, "put_tensor", key, data, dims, type, mem_layout);
+}
+
+// Allocate a Tensor of the given type gathered from strided source data
+TensorBase* Client::_build_tensor(const std::string& key,
+                                  const void* data,
+                                  const std::vector<size_t>& dims,
+                                  const std::vector<size_t>& strides,
+                                  const size_t offset,
+                                  const SRTensorType type)
+{
+    return new_tensor(type, "put_tensor_strided", key, data, dims, strides,
+                      offset, type);
+}
+
+// Allocate a Tensor of the given type holding the contiguous source
+// data converted from another type
+TensorBase* Client::_build_converted_tensor(const std::string& key,
+                                            const void* data,
+                                            const std::vector<size_t>& dims,
+                                            const SRTensorType type,
+                                            const SRTensorType src_type)
+{
+    return new_tensor(type, "tensor conversion", key, data, dims, type,
+                      src_type);
+}
+
+// Fetch a tensor, decompressing it if it was stored compressed
+void Client::_fetch_tensor(const std::string& key,
+                           CommandReply& reply,
+                           std::string& decompressed,
+                           SRTensorType& type,
+                           std::vector<size_t>& dims,
+                           std::string_view& blob,
+                           void* dest,
+                           SRTensorType dest_type,
+                           size_t dest_size)
+{
+    // Plain RedisAI tensors are read in a single round trip. A client
+    // that compresses its own tensors expects strings, so it reads the
+    // type and value of the key together instead.
+    bool plain = _compression_codec == SRCompressionNone;
+    if (plain) {
+        GetTensorCommand cmd;
+        cmd << "AI.TENSORGET" << Keyfield(key) << "META" << "BLOB";
+        bool wrong_type = false;
+        reply = _run_catching(cmd, "WRONGTYPE", wrong_type);
+        plain = !wrong_type;
+    }
+
+    // A compressed, chunked or tiled tensor is a string and a
+    // delta-encoded or appendable tensor a list
+    bool stored_string = false;
+    if (!plain) {
+        reply = _read_stored_tensor(key);
+        std::string key_type(reply[0].str(), reply[0].str_len());
+        if (key_type == "list") {
+            CommandReply values = reply[1];
+            std::vector<std::string_view> frames;
+            for (size_t i = 0; i < values.n_elements(); i++) {
+                CommandReply frame = values[i];
+                frames.push_back(std::string_view(frame.str(),
+                                                  frame.str_len()));
+            }
+            // A tensor put with append_to_tensor() is a list of records
+            if (frames.size() > 0 && is_tensor_record(frames[0])) {
+                decompressed = join_tensor_records(frames, type, dims);
+                blob = decompressed;
+                return;
+            }
+            if (frames.size() == 0 || !is_delta_frame(frames[0])) {
+                throw SRRuntimeException("The key " + key + " does not "\
+                                         "hold a tensor.");
+            }
+            decompressed = decode_delta_frames(frames, type, dims);
+            blob = decompressed;
+            return;
+        }
+        // Anything else is left to RedisAI, which reports missing keys
+        stored_string = key_type == "string";
+        if (!stored_string)
+            reply = _redis_server->get_tensor(key);
+    }
+    if (!stored_string) {
+        _report_reply_errors(reply, "tensor retrieval failed");
+        dims = GetTensorCommand::get_dims(reply);
+        type = GetTensorCommand::get_data_type(reply);
+        blob = GetTensorCommand::get_data_blob(reply);
+        return;
+    }
+
+    // A chunked tensor is a manifest of the chunks holding its data
+    CommandReply value = reply[1];
+    std::string_view buf(value.str(), value.str_len());
+    if (ChunkManifest::is_manifest(buf)) {
+        ChunkManifest manifest = ChunkManifest::unpack(buf);
+        const int max_attempts = 3;
+        for (int attempt = 1; ; attempt++) {
+            type = manifest.type;
+            dims = manifest.dims;
+            char* values = (char*)dest;
+            if (dest == NULL || dest_type != type ||
+                dest_size != manifest.total_bytes) {
+                decompressed.resize(manifest.total_bytes);
+                values = decompressed.data();
+            }
+            if (_fetch_chunks(key, manifest, values)) {
+                blob = std::string_view(values, manifest.total_bytes);
+                return;
+            }
+
+            // The tensor was replaced while its chunks were fetched
+            if (attempt == max_attempts ||
+                !_get_chunk_manifest(key, manifest)) {
+                throw SRRuntimeException("The chunks of tensor " + key +
+                                         " changed while they were "\
+                                         "being fetched.");
+            }
+        }
+    }
+    // A tiled tensor is a manifest of the tiles holding its data
+    if (TileManifest::is_manifest(buf)) {
+        TileManifest manifest = TileManifest::unpack(buf);
+        std::vector<size_t> origin(manifest.dims.size(), 0);
+        const int max_attempts = 3;
+        for (int attempt = 1; ; attempt++) {
+            type = manifest.type;
+            dims = manifest.dims;
+            size_t total_bytes = tensor_type_size(type);
+            for (size_t i = 0; i < dims.size(); i++)
+                total_bytes *= dims[i];
+            char* values = (char*)dest;
+            if (dest == NULL || dest_type != type ||
+                dest_size != total_bytes) {
+                decompressed.resize(total_bytes);
+                values = decompressed.data();
+            }
+            if (_fetch_tiles(key, manifest, origin, dims, values)) {
+                blob = std::string_view(values, total_bytes);
+                return;
+            }
+
+            // The tensor was replaced while its tiles were fetched
+            if (attempt == max_attempts ||
+                !_get_tile_manifest(key, manifest)) {
+                throw SRRuntimeException("The tiles of tensor " + key +
+                                         " changed while they were "\
+                                         "being fetched.");
+            }
+        }
+    }
+    if (!is_compressed_buffer(buf)) {
+        throw SRRuntimeException("The key " + key + " does not "\
+                                 "hold a tensor.");
+    }
+    decompressed = decompress_buffer(buf, type, dims);
+    blob = decompressed;
+}
+
+// Fetch a tensor by name into memory provided by a language binding
+void Client::_fetch_named_tensor(const std::string& name,
+                                 CommandReply& reply,
+                                 std::string& decompressed,
+                                 SRTensorType& type,
+                                 std::vector<size_t>& dims,
+                                 std::string_view& blob,
+                                 void* dest,
+                                 SRTensorType dest_type,
+                                 size_t dest_size)
+{
+    std::string get_key = _build_tensor_key(name, true);
+    _fetch_tensor(get_key, reply, decompressed, type, dims, blob,
+                  dest, dest_type, dest_size);
 }
 
 // Retrieve the tensor from the DataSet and return a TensorBase object that
@@ -2132,18 +3862,18 @@ TensorBase* Client::_get_tensorbase_obj(const std::string& name)
 {
     // Fetch the tensor
     std::string get_key = _build_tensor_key(name, true);
-    CommandReply reply = _redis_server->get_tensor(get_key);
-    _report_reply_errors(reply, "tensor retrieval failed");
+    CommandReply reply;
+    std::string decompressed;
+    SRTensorType type;
+    std::vector<size_t> dims;
+    std::string_view blob;
+    _fetch_tensor(get_key, reply, decompressed, type, dims, blob);
 
-    std::vector<size_t> dims = GetTensorCommand::get_dims(reply);
     if (dims.size() <= 0)
         throw SRRuntimeException("The number of dimensions of the "\
                                  "fetched tensor are invalid: " +
                                  std::to_string(dims.size()));
 
-    SRTensorType type = GetTensorCommand::get_data_type(reply);
-    std::string_view blob = GetTensorCommand::get_data_blob(reply);
-
     for (size_t i = 0; i < dims.size(); i++) {
         if (dims[i] <= 0) {
             throw SRRuntimeException("Dimension " +
@@ -2188,6 +3918,24 @@ TensorBase* Client::_get_tensorbase_obj(const std::string& name)
                 ptr = new Tensor<uint8_t>(get_key, (void*)blob.data(),
                                         dims, type, SRMemLayoutContiguous);
                 break;
+            case SRTensorTypeUint32:
+                ptr = new Tensor<uint32_t>(get_key, (void*)blob.data(),
+                                        dims, type, SRMemLayoutContiguous);
+                break;
+            case SRTensorTypeUint64:
+                ptr = new Tensor<uint64_t>(get_key, (void*)blob.data(),
+                                        dims, type, SRMemLayoutContiguous);
+                break;
+            case SRTensorTypeBool:
+                ptr = new Tensor<bool>(get_key, (void*)blob.data(),
+                                        dims, type, SRMemLayoutContiguous);
+                break;
+            case SRTensorTypeFloat16:
+                // Fall through
+            case SRTensorTypeBFloat16:
+                ptr = new Tensor<uint16_t>(get_key, (void*)blob.data(),
+                                        dims, type, SRMemLayoutContiguous);
+                break;
             default :
                 throw SRInternalException("The database provided an invalid "\
                                           "TensorType to Client::_get_tensorbase_obj(). "\
@@ -2200,6 +3948,45 @@ TensorBase* Client::_get_tensorbase_obj(const std::string& name)
     return ptr;
 }
 
+// Retrieve a window of the records of an appendable tensor
+TensorBase* Client::_get_tensor_range_obj(const std::string& name,
+                                          size_t start,
+                                          size_t stop)
+{
+    if (stop <= start) {
+        throw SRParameterException("The record window of tensor " + name +
+                                   " is empty.");
+    }
+
+    // Fetch the records in the window
+    std::string get_key = _build_tensor_key(name, true);
+    SingleKeyCommand cmd;
+    cmd << "LRANGE" << Keyfield(get_key) << std::to_string(start)
+        << std::to_string(stop - 1);
+    CommandReply reply = _run(cmd);
+    _report_reply_errors(reply, "get_tensor_range failed");
+
+    std::vector<std::string_view> records;
+    for (size_t i = 0; i < reply.n_elements(); i++) {
+        CommandReply record = reply[i];
+        records.push_back(std::string_view(record.str(), record.str_len()));
+    }
+    if (records.size() == 0) {
+        throw SRKeyException("The tensor " + get_key + " has no records "\
+                             "from " + std::to_string(start) + ".");
+    }
+    if (!is_tensor_record(records[0])) {
+        throw SRRuntimeException("The tensor " + get_key + " was not put "\
+                                 "with append_to_tensor().");
+    }
+
+    SRTensorType type;
+    std::vector<size_t> dims;
+    std::string values = join_tensor_records(records, type, dims);
+    return _build_tensor(get_key, values.data(), dims, type,
+                         SRMemLayoutContiguous);
+}
+
 // Determine datset name from aggregation list entry
 std::string Client::_get_dataset_name_from_list_entry(
     const std::string& dataset_key)
@@ -2301,3 +4088,72 @@ void Client::_report_reply_errors(CommandReply &reply, std::string error_message
     }
     throw SRRuntimeException(combined_error);
 }
+
+// Run a SingleKeyCommand, catching one kind of error reply
+CommandReply Client::_run_catching(SingleKeyCommand& cmd,
+                                   const std::string& error_code,
+                                   bool& caught)
+{
+    // Error replies are usually raised as exceptions carrying the
+    // message from the database, but may also be returned in the reply
+    caught = false;
+    try {
+        CommandReply reply = _run(cmd);
+        std::vector<std::string> errors = reply.get_reply_errors();
+        if (errors.size() > 0 && errors[0].rfind(error_code, 0) == 0) {
+            caught = true;
+            return CommandReply();
+        }
+        return reply;
+    }
+    catch (RuntimeException& e) {
+        if (std::string(e.what()).find(error_code) == std::string::npos)
+            throw;
+        caught = true;
+        return CommandReply();
+    }
+}
+
+// Load a Lua script on every database node
+std::string Client::_load_script(const std::string& script)
+{
+    AddressAllCommand cmd;
+    cmd << "SCRIPT" << "LOAD" << script;
+    CommandReply reply = _redis_server->run(cmd);
+    _report_reply_errors(reply, "Failed to load a Lua script");
+    return std::string(reply.str(), reply.str_len());
+}
+
+// Read the type of a tensor key, with the value of a string or list
+CommandReply Client::_read_stored_tensor(const std::string& key)
+{
+    CommandReply reply = _run_key_script(_TENSOR_READ_SCRIPT,
+                                         _tensor_read_script_sha, key, {});
+    _report_reply_errors(reply, "tensor retrieval failed");
+    return reply;
+}
+
+// Run a Lua script on the shard holding its single key
+CommandReply Client::_run_key_script(const std::string& script,
+                                     std::string& sha,
+                                     const std::string& key,
+                                     const std::vector<std::string_view>& args)
+{
+    if (sha.size() == 0)
+        sha = _load_script(script);
+
+    SingleKeyCommand cmd;
+    cmd << "EVALSHA" << sha << "1" << Keyfield(key);
+    for (size_t i = 0; i < args.size(); i++)
+        cmd << args[i];
+
+    // A database restarted or added since the script was loaded
+    // does not know it
+    bool no_script = false;
+    CommandReply reply = _run_catching(cmd, "NOSCRIPT", no_script);
+    if (no_script) {
+        _load_script(script);
+        reply = _run(cmd);
+    }
+    return reply;
+}
@@ -26,17 +26,31 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <functional>
 #include "command.h"
 #include "srexception.h"
 
 using namespace SmartRedis;
 
+// Check whether a pointer lies inside a memory region
+static bool in_region(const char* ptr, const char* base, size_t size)
+{
+    std::less<const char*> less;
+    return !less(ptr, base) && less(ptr, base + size);
+}
+
 // Command copy constructor
 Command::Command(const Command& cmd)
 {
     *this = cmd;
 }
 
+// Command move constructor
+Command::Command(Command&& cmd)
+{
+    *this = std::move(cmd);
+}
+
 // Command copy assignment operator
 Command& Command::operator=(const Command& cmd)
 {
@@ -46,43 +60,75 @@ Command& Command::operator=(const Command& cmd)
 
     make_empty();
 
-    _fields.resize(cmd._fields.size());
-
-    // copy pointer fields and put into _fields
-    _ptr_fields = cmd._ptr_fields;
-    std::vector<std::pair<char*, size_t> >::const_iterator ptr_it =
-        _ptr_fields.begin();
-    for (; ptr_it != _ptr_fields.end(); ptr_it++)
-        _fields[ptr_it->second] = ptr_it->first;
-
-    // copy _local_fields and _cmd_keys, and put the fields into _fields
-    std::vector<std::pair<char*, size_t> >::const_iterator local_it =
-        cmd._local_fields.begin();
-    for (; local_it != cmd._local_fields.end(); local_it++) {
-        // allocate memory and copy a local field
-        size_t field_size = cmd._fields[local_it->second].size();
-        char* f = NULL;
-        try {
-            f = new char[field_size];
+    /* The arena of the other Command is copied as a whole: the
+    inline buffer into the inline buffer, and every heap block
+    into one block of the combined size.  The fields are then
+    repointed into the copies, which leaves pointer fields alone.
+    */
+    std::memcpy(_inline_arena, cmd._inline_arena, cmd._inline_used);
+    _inline_used = cmd._inline_used;
+
+    size_t heap_used = 0;
+    for (size_t i = 0; i < cmd._arena_blocks.size(); i++)
+        heap_used += cmd._arena_blocks[i].used;
+
+    std::vector<size_t> block_offsets(cmd._arena_blocks.size(), 0);
+    char* heap = NULL;
+    if (heap_used > 0) {
+        heap = _allocate(heap_used);
+        size_t offset = 0;
+        for (size_t i = 0; i < cmd._arena_blocks.size(); i++) {
+            const ArenaBlock& block = cmd._arena_blocks[i];
+            std::memcpy(heap + offset, block.data.get(), block.used);
+            block_offsets[i] = offset;
+            offset += block.used;
         }
-        catch (std::bad_alloc& e) {
-            throw SRBadAllocException("field data");
+    }
+
+    _fields = cmd._fields;
+    _keys = cmd._keys;
+    for (size_t f = 0; f < _fields.size(); f++) {
+        const char* data = _fields[f].data();
+        if (in_region(data, cmd._inline_arena, cmd._inline_used)) {
+            _fields[f] = std::string_view(
+                _inline_arena + (data - cmd._inline_arena), _fields[f].size());
+            continue;
         }
-        std::memcpy(f, local_it->first, field_size);
-        _local_fields.push_back(
-            std::pair<char*, size_t>(f, local_it->second));
-        _fields[local_it->second] = std::string_view(f, field_size);
-
-        if (cmd._cmd_keys.count(cmd._fields[local_it->second]) != 0) {
-            // copy a command key
-            _cmd_keys[std::string_view(f, field_size)] =
-                local_it->second;
+        for (size_t i = 0; i < cmd._arena_blocks.size(); i++) {
+            const ArenaBlock& block = cmd._arena_blocks[i];
+            if (in_region(data, block.data.get(), block.used)) {
+                _fields[f] = std::string_view(
+                    heap + block_offsets[i] + (data - block.data.get()),
+                    _fields[f].size());
+                break;
+            }
         }
     }
 
     return *this;
 }
 
+// Command move assignment operator
+Command& Command::operator=(Command&& cmd)
+{
+    // Check for self-assignment
+    if (this == &cmd)
+        return *this;
+
+    make_empty();
+
+    // Heap blocks keep their addresses; only the inline buffer moves
+    _fields = std::move(cmd._fields);
+    _keys = std::move(cmd._keys);
+    _arena_blocks = std::move(cmd._arena_blocks);
+    std::memcpy(_inline_arena, cmd._inline_arena, cmd._inline_used);
+    _inline_used = cmd._inline_used;
+    _rebase_inline_fields(cmd._inline_arena);
+
+    cmd.make_empty();
+    return *this;
+}
+
 // Command destructor
 Command::~Command()
 {
@@ -90,99 +136,44 @@ Command::~Command()
 }
 
 // Add a field to the Command from a string.
-void Command::add_field(std::string field, bool is_key)
+void Command::add_field(const std::string& field, bool is_key)
 {
-    /* Copy the field string into a char* that is stored
-    locally in the Command object.  The new string is not
-    null terminated because the fields vector is of type
-    string_view which stores the length of the string.
+    /* Copy the field string into the Command arena.  The
+    copy is not null terminated because the fields vector is
+    of type string_view which stores the length of the string.
     If is_key is true, the key will be added to the command
     keys.
     */
-
-    size_t field_size = field.size();
-    char* f = NULL;
-    try {
-        f = (char*)new unsigned char[field_size + 1];
-    }
-    catch (std::bad_alloc& e) {
-        throw SRBadAllocException("field");
-    }
-
-    field.copy(f, field_size, 0);
-    f[field_size] = '\0';
-    _local_fields.push_back({f, _fields.size()});
-    _fields.push_back(std::string_view(f, field_size));
-
-    if (is_key) {
-        _cmd_keys[std::string_view(f, field_size)] = _fields.size() - 1;
-    }
+    _add_local_field(field.data(), field.size(), is_key);
 }
 
 //  Replace a field in a command
-void Command::set_field_at(std::string new_field, size_t pos, bool is_key)
+void Command::set_field_at(const std::string& new_field, size_t pos, bool is_key)
 {
-    size_t field_size = new_field.size();
-    char* f = NULL;
-    try {
-        f = (char*)new unsigned char[field_size + 1];
-    }
-    catch (std::bad_alloc& e) {
-        throw SRBadAllocException("field");
-    }
-
-    new_field.copy(f, field_size, 0);
-    f[field_size] = '\0';
-
-    // Free memory from the previous occupant of this
-    // field if locally allocated. Replace if we find it,
-    // otherwise, add it fresh (happens if we're not
-    // replacing a field that was locally allcoated)
-    bool replaced = false;
-    std::vector<std::pair<char*, size_t> >::iterator it =
-        _local_fields.begin();
-    for ( ; it != _local_fields.end(); it++) {
-        if (it->second == pos) {
-            delete(it->first);
-            it->first = f;
-            replaced = true;
-        }
-    }
-    if (!replaced)
-        _local_fields.push_back({f, pos});
-    _fields.at(pos) = std::string_view(f, field_size);
-
-    if (is_key) {
-        _cmd_keys[std::string_view(f, field_size)] = pos;
-    }
+    // The previous value stays in the arena until the Command is emptied
+    _fields.at(pos) = _store(new_field.data(), new_field.size());
+
+    std::vector<CommandKey>::iterator it = _keys.begin();
+    for ( ; it != _keys.end() && it->field != pos; it++)
+        ;
+    if (is_key && it == _keys.end())
+        _keys.push_back({pos, get_hash_slot(_fields[pos])});
+    else if (is_key)
+        it->hash_slot = get_hash_slot(_fields[pos]);
+    else if (it != _keys.end())
+        _keys.erase(it);
 }
 
 // Add a field to the Command from a c-string.
 void Command::add_field(const char* field, bool is_key)
 {
-    /* Copy the field char* into a char* that is stored
-    locally in the Command object.  The new string is not
-    null terminated because the fields vector is of type
-    string_view which stores the length of the string.
-    If is_key is true, the key will be added to the command
-    keys.
+    /* Copy the field char* into the Command arena.  The new
+    string is not null terminated because the fields vector
+    is of type string_view which stores the length of the
+    string.  If is_key is true, the key will be added to the
+    command keys.
     */
-
-    size_t field_size = std::strlen(field);
-    char* f = NULL;
-    try {
-        f = new char[field_size];
-    }
-    catch (std::bad_alloc& e) {
-        throw SRBadAllocException("field");
-    }
-    std::memcpy(f, field, field_size);
-    _local_fields.push_back({f, _fields.size()});
-    _fields.push_back(std::string_view(f, field_size));
-
-    if (is_key) {
-        _cmd_keys[std::string_view(f, field_size)] = _fields.size() - 1;
-    }
+    _add_local_field(field, std::strlen(field), is_key);
 }
 
 // Add a field to the Command from a c-string without copying the data.
@@ -194,8 +185,7 @@ void Command::add_field_ptr(char* field, size_t field_size)
     accessed.  This function should be used for very large
     fields.  Field pointers cannot act as Command keys.
     */
-    _ptr_fields.push_back({field, _fields.size()});
-    _fields.push_back(std::string_view(field, field_size));
+    add_field_ptr(std::string_view(field, field_size));
 }
 
 // Add a field to the Command from a std::string_view without copying the data
@@ -205,20 +195,19 @@ void Command::add_field_ptr(std::string_view field)
     structure without copying the data.  This means
     that the memory needs to be valid when it is later
     accessed.  This function should be used for very large
-    fields.  If is_key is true, the key will be added to the
-    command keys.  Field pointers cannot act as Command keys.
+    fields.  Field pointers cannot act as Command keys.
     */
-    _ptr_fields.push_back({const_cast<char*>(field.data()), _fields.size()});
+    if (_fields.capacity() == 0)
+        _fields.reserve(16);
     _fields.push_back(field);
 }
 
 // Add fields to the Command from a vector of strings.
 void Command::add_fields(const std::vector<std::string>& fields, bool is_key)
 {
-    /* Copy field strings into a char* that is stored
-    locally in the Command object.  The new string is not
-    null terminated because the fields vector is of type
-    string_view which stores the length of the string
+    /* Copy field strings into the Command arena.  The copies
+    are not null terminated because the fields vector is of
+    type string_view which stores the length of the string
     */
     for (size_t i = 0; i < fields.size(); i++) {
         add_field(fields[i], is_key);
@@ -228,10 +217,9 @@ void Command::add_fields(const std::vector<std::string>& fields, bool is_key)
 // Add fields to the Command from a vector of strings.
 void Command::add_keys(const std::vector<std::string>& keyfields)
 {
-    /* Copy field strings into a char* that is stored
-    locally in the Command object.  The new string is not
-    null terminated because the fields vector is of type
-    string_view which stores the length of the string
+    /* Copy field strings into the Command arena.  The copies
+    are not null terminated because the fields vector is of
+    type string_view which stores the length of the string
     */
     for (size_t i = 0; i < keyfields.size(); i++) {
         add_field(keyfields[i], true);
@@ -246,6 +234,24 @@ std::string Command::first_field() const
     return std::string(cbegin()->data(), cbegin()->size());
 }
 
+// Check whether the Command only reads data
+bool Command::is_read_only() const
+{
+    // Commands issued by the client that never modify the database
+    static constexpr std::string_view read_only_commands[] = {
+        "AI.TENSORGET", "AI.MODELGET", "AI.SCRIPTGET", "GET", "GETRANGE",
+        "HGETALL", "HEXISTS", "EXISTS", "LRANGE", "LLEN"
+    };
+
+    if (cbegin() == cend())
+        return false;
+    for (std::string_view name : read_only_commands) {
+        if (*cbegin() == name)
+            return true;
+    }
+    return false;
+}
+
 // Get a string of the entire Command
 std::string Command::to_string()
 {
@@ -281,7 +287,7 @@ Command::const_iterator Command::cend() const
 // Return true if the Command has keys
 bool Command::has_keys()
 {
-    return (_cmd_keys.size()>0);
+    return (_keys.size()>0);
 }
 
 // Return a copy of all Command keys
@@ -293,27 +299,110 @@ std::vector<std::string> Command::get_keys() {
     may need to grow or decrease in size.
     */
     std::vector<std::string> keys;
-    std::unordered_map<std::string_view,size_t>::iterator it =
-        _cmd_keys.begin();
-    for ( ; it != _cmd_keys.end(); it++) {
-        keys.push_back(std::string(it->first.data(), it->first.length()));
+    keys.reserve(_keys.size());
+    for (size_t i = 0; i < _keys.size(); i++) {
+        std::string_view key = _fields[_keys[i].field];
+        keys.push_back(std::string(key.data(), key.length()));
     }
     return keys;
 }
 
-// Helper function for emptying the Command
-void Command::make_empty()
+// Compute the cluster hash slot of a key
+uint16_t Command::get_hash_slot(std::string_view key)
+{
+    // Only a non-empty hash tag is hashed
+    size_t open = key.find('{');
+    if (open != std::string_view::npos) {
+        size_t close = key.find('}', open + 1);
+        if (close != std::string_view::npos && close > open + 1)
+            key = key.substr(open + 1, close - open - 1);
+    }
+    return sw::redis::crc16(key.data(), key.size()) % 16384;
+}
+
+// Copy field data into the Command arena
+std::string_view Command::_store(const char* data, size_t size)
+{
+    // Empty fields need no storage, and would otherwise point past the
+    // end of the arena where they could not be told apart when moved
+    if (size == 0)
+        return std::string_view();
+
+    char* f = _allocate(size);
+    std::memcpy(f, data, size);
+    return std::string_view(f, size);
+}
+
+// Append a copied field to the Command
+void Command::_add_local_field(const char* data, size_t size, bool is_key)
+{
+    std::string_view field = _store(data, size);
+    if (_fields.capacity() == 0)
+        _fields.reserve(16);
+    _fields.push_back(field);
+
+    if (is_key) {
+        _keys.push_back({_fields.size() - 1, get_hash_slot(field)});
+    }
+}
+
+// Hand out memory from the Command arena
+char* Command::_allocate(size_t size)
 {
-    std::vector<std::pair<char*, size_t> >::iterator it =
-        _local_fields.begin();
+    // Most commands fit in the inline buffer
+    if (_INLINE_ARENA_SIZE - _inline_used >= size) {
+        char* ptr = _inline_arena + _inline_used;
+        _inline_used += size;
+        return ptr;
+    }
 
-    for ( ; it != _local_fields.end(); it++) {
-        if (it->first != NULL)
-            delete(it->first);
-        *it = {NULL, 0};
+    // Then the current shared heap block
+    if (!_arena_blocks.empty()) {
+        ArenaBlock& block = _arena_blocks.back();
+        if (block.size - block.used >= size) {
+            char* ptr = block.data.get() + block.used;
+            block.used += size;
+            return ptr;
+        }
+    }
+
+    // Large fields get a block of their own, placed before the shared
+    // block so that the rest of the shared block can still be used
+    bool dedicated = size > _ARENA_BLOCK_SIZE / 2;
+    ArenaBlock block;
+    block.size = dedicated ? size : _ARENA_BLOCK_SIZE;
+    block.used = size;
+    try {
+        block.data.reset(new char[block.size]);
     }
-    _local_fields.clear();
-    _ptr_fields.clear();
-    _cmd_keys.clear();
+    catch (std::bad_alloc& e) {
+        throw SRBadAllocException("field");
+    }
+    char* ptr = block.data.get();
+    if (dedicated && !_arena_blocks.empty())
+        _arena_blocks.insert(_arena_blocks.end() - 1, std::move(block));
+    else
+        _arena_blocks.push_back(std::move(block));
+    return ptr;
+}
+
+// Repoint fields that refer into the inline buffer of another Command
+void Command::_rebase_inline_fields(const char* source_inline)
+{
+    for (size_t i = 0; i < _fields.size(); i++) {
+        const char* data = _fields[i].data();
+        if (in_region(data, source_inline, _inline_used)) {
+            _fields[i] = std::string_view(
+                _inline_arena + (data - source_inline), _fields[i].size());
+        }
+    }
+}
+
+// Helper function for emptying the Command
+void Command::make_empty()
+{
+    _arena_blocks.clear();
+    _inline_used = 0;
+    _keys.clear();
     _fields.clear();
 }
@@ -0,0 +1,779 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include "compression.h"
+#include "srexception.h"
+#include "utility.h"
+
+using namespace SmartRedis;
+
+// Fixed-size header at the start of a compression container. The
+// tensor dimensions follow as uint64_t values, then the payload.
+struct CompressedHeader {
+    char magic[8];
+    uint8_t version;
+    uint8_t codec;
+    uint8_t element_size;
+    uint8_t n_dims;
+    uint32_t type;
+    uint64_t raw_size;
+    double error_bound;
+};
+
+static const char _COMPRESSED_MAGIC[8] = {'S', 'R', 'C', 'O', 'D', 'E', 'C', '1'};
+static const uint8_t _COMPRESSED_VERSION = 1;
+
+// LZ parameters. Matches are encoded as in the LZ4 block format: a
+// token holding the literal and match lengths, the literals, and a
+// two byte offset, so matches reach back at most 64 KiB.
+static const size_t _LZ_MIN_MATCH = 4;
+static const size_t _LZ_MAX_OFFSET = 65535;
+static const size_t _LZ_HASH_BITS = 16;
+static const size_t _LZ_WINDOW_MASK = 65535;
+static const size_t _LZ_NO_POSITION = (size_t)-1;
+
+// Read four bytes for hashing and match detection
+static inline uint32_t _lz_read32(const uint8_t* p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Hash the four bytes at a position
+static inline size_t _lz_hash(uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - _LZ_HASH_BITS);
+}
+
+// Append a length that overflows a token nibble
+static inline void _lz_put_length(std::string& out, size_t length)
+{
+    for ( ; length >= 255; length -= 255)
+        out.push_back((char)255);
+    out.push_back((char)length);
+}
+
+// Append a sequence of literals followed by an optional match
+static void _lz_put_sequence(std::string& out,
+                             const uint8_t* literals,
+                             size_t n_literals,
+                             size_t offset,
+                             size_t match_length)
+{
+    size_t match_code = match_length > 0 ? match_length - _LZ_MIN_MATCH : 0;
+    uint8_t token = (uint8_t)((std::min<size_t>(n_literals, 15) << 4) |
+                              std::min<size_t>(match_code, 15));
+    out.push_back((char)token);
+    if (n_literals >= 15)
+        _lz_put_length(out, n_literals - 15);
+    out.append((const char*)literals, n_literals);
+    if (match_length == 0)
+        return;
+    out.push_back((char)(offset & 0xff));
+    out.push_back((char)(offset >> 8));
+    if (match_code >= 15)
+        _lz_put_length(out, match_code - 15);
+}
+
+// Compress a buffer. Higher levels follow longer hash chains and
+// index every position inside matches.
+static std::string _lz_compress(const uint8_t* in, size_t n, int level)
+{
+    std::string out;
+    out.reserve(n / 2 + 16);
+
+    size_t max_attempts = (size_t)1 << (level - 1);
+    bool chained = level > 1;
+    std::vector<size_t> head((size_t)1 << _LZ_HASH_BITS, _LZ_NO_POSITION);
+    std::vector<size_t> prev(chained ? _LZ_WINDOW_MASK + 1 : 0,
+                             _LZ_NO_POSITION);
+
+    // Insert a position into the hash table (and chain)
+    auto insert = [&](size_t pos) {
+        size_t h = _lz_hash(_lz_read32(in + pos));
+        if (chained)
+            prev[pos & _LZ_WINDOW_MASK] = head[h];
+        head[h] = pos;
+    };
+
+    size_t anchor = 0;
+    size_t i = 0;
+    size_t misses = 0;
+    size_t limit = n > _LZ_MIN_MATCH ? n - _LZ_MIN_MATCH : 0;
+    while (i < limit) {
+        uint32_t seq = _lz_read32(in + i);
+        size_t candidate = head[_lz_hash(seq)];
+        size_t best_length = 0;
+        size_t best_offset = 0;
+        for (size_t attempt = 0; attempt < max_attempts &&
+             candidate != _LZ_NO_POSITION && candidate < i &&
+             i - candidate <= _LZ_MAX_OFFSET; attempt++) {
+            if (_lz_read32(in + candidate) == seq) {
+                size_t length = _LZ_MIN_MATCH;
+                while (i + length + 8 <= n &&
+                       std::memcmp(in + candidate + length, in + i + length, 8) == 0)
+                    length += 8;
+                while (i + length < n && in[candidate + length] == in[i + length])
+                    length++;
+                if (length > best_length) {
+                    best_length = length;
+                    best_offset = i - candidate;
+                }
+            }
+            if (!chained)
+                break;
+            size_t next = prev[candidate & _LZ_WINDOW_MASK];
+            if (next >= candidate)
+                break;
+            candidate = next;
+        }
+        insert(i);
+
+        // Incompressible stretches are skipped over with a growing
+        // stride, as in LZ4
+        if (best_length < _LZ_MIN_MATCH) {
+            i += 1 + (misses++ >> 6);
+            continue;
+        }
+        misses = 0;
+
+        _lz_put_sequence(out, in + anchor, i - anchor, best_offset, best_length);
+        size_t match_end = i + best_length;
+        if (chained) {
+            for (i++; i < match_end && i < limit; i++)
+                insert(i);
+        }
+        i = match_end;
+        anchor = i;
+    }
+
+    // The final sequence holds the remaining literals and no match
+    _lz_put_sequence(out, in + anchor, n - anchor, 0, 0);
+    return out;
+}
+
+// Read a length that overflows a token nibble
+static inline size_t _lz_get_length(const uint8_t*& ip, const uint8_t* end)
+{
+    size_t length = 0;
+    uint8_t byte;
+    do {
+        if (ip >= end)
+            throw SRRuntimeException("The compressed buffer is truncated.");
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return length;
+}
+
+// Decompress a buffer into exactly n bytes
+static void _lz_decompress(const uint8_t* ip, size_t in_size,
+                           uint8_t* out, size_t n)
+{
+    const uint8_t* end = ip + in_size;
+    size_t op = 0;
+    while (true) {
+        if (ip >= end)
+            throw SRRuntimeException("The compressed buffer is truncated.");
+        uint8_t token = *ip++;
+
+        // Literals
+        size_t n_literals = token >> 4;
+        if (n_literals == 15)
+            n_literals += _lz_get_length(ip, end);
+        if (n_literals > (size_t)(end - ip) || n_literals > n - op)
+            throw SRRuntimeException("The compressed buffer is malformed.");
+        std::memcpy(out + op, ip, n_literals);
+        ip += n_literals;
+        op += n_literals;
+        if (ip == end)
+            break;
+
+        // Match
+        if (end - ip < 2)
+            throw SRRuntimeException("The compressed buffer is truncated.");
+        size_t offset = ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        size_t length = (token & 15);
+        if (length == 15)
+            length += _lz_get_length(ip, end);
+        length += _LZ_MIN_MATCH;
+        if (offset == 0 || offset > op || length > n - op)
+            throw SRRuntimeException("The compressed buffer is malformed.");
+
+        // Matches may overlap their own output, in which case they
+        // are copied forwards a byte at a time
+        const uint8_t* match = out + op - offset;
+        if (offset >= length) {
+            std::memcpy(out + op, match, length);
+        }
+        else {
+            for (size_t k = 0; k < length; k++)
+                out[op + k] = match[k];
+        }
+        op += length;
+    }
+
+    if (op != n) {
+        throw SRRuntimeException("The compressed buffer does not hold the "\
+                                 "recorded number of bytes.");
+    }
+}
+
+// Regroup the bytes of each value by significance
+static void _shuffle(const uint8_t* in, uint8_t* out,
+                     size_t n_values, size_t element_size)
+{
+    for (size_t k = 0; k < element_size; k++) {
+        for (size_t j = 0; j < n_values; j++)
+            out[k * n_values + j] = in[j * element_size + k];
+    }
+}
+
+// Undo _shuffle()
+static void _unshuffle(const uint8_t* in, uint8_t* out,
+                       size_t n_values, size_t element_size)
+{
+    for (size_t j = 0; j < n_values; j++) {
+        for (size_t k = 0; k < element_size; k++)
+            out[j * element_size + k] = in[k * n_values + j];
+    }
+}
+
+// Byte shuffle followed by LZ compression
+class ShuffleLZCodec : public CompressionCodec
+{
+    public:
+        std::string compress(std::string_view raw,
+                             size_t element_size,
+                             SRTensorType type,
+                             int level,
+                             double error_bound) const override
+        {
+            const uint8_t* values = (const uint8_t*)raw.data();
+            std::string shuffled;
+            if (element_size > 1) {
+                shuffled.resize(raw.size());
+                _shuffle(values, (uint8_t*)shuffled.data(),
+                         raw.size() / element_size, element_size);
+                values = (const uint8_t*)shuffled.data();
+            }
+            return _lz_compress(values, raw.size(), level);
+        }
+
+        void decompress(std::string_view payload,
+                        size_t element_size,
+                        SRTensorType type,
+                        double error_bound,
+                        void* raw,
+                        size_t raw_size) const override
+        {
+            const uint8_t* in = (const uint8_t*)payload.data();
+            if (element_size <= 1) {
+                _lz_decompress(in, payload.size(), (uint8_t*)raw, raw_size);
+                return;
+            }
+            if (raw_size % element_size != 0)
+                throw SRRuntimeException("The compressed buffer is malformed.");
+            std::string shuffled(raw_size, '\0');
+            _lz_decompress(in, payload.size(),
+                           (uint8_t*)shuffled.data(), shuffled.size());
+            _unshuffle((const uint8_t*)shuffled.data(), (uint8_t*)raw,
+                       raw_size / element_size, element_size);
+        }
+};
+
+// Quantization parameters. Values are quantized in blocks, each with
+// its own offset and bit width, so that the width adapts to the local
+// range of the field. Blocks that cannot meet the error bound (those
+// holding NaN or infinite values, or spanning too wide a range) are
+// stored verbatim.
+static const size_t _QUANT_BLOCK_SIZE = 4096;
+static const uint8_t _QUANT_MAX_BITS = 32;
+static const uint8_t _QUANT_VERBATIM = 0xff;
+
+// Append the low bits of each code to a bit stream
+static void _pack_bits(std::string& out, const uint32_t* codes,
+                       size_t n, uint8_t bits)
+{
+    if (bits == 0)
+        return;
+    uint64_t acc = 0;
+    unsigned n_acc = 0;
+    for (size_t i = 0; i < n; i++) {
+        acc |= (uint64_t)codes[i] << n_acc;
+        n_acc += bits;
+        while (n_acc >= 8) {
+            out.push_back((char)(acc & 0xff));
+            acc >>= 8;
+            n_acc -= 8;
+        }
+    }
+    if (n_acc > 0)
+        out.push_back((char)(acc & 0xff));
+}
+
+// Read n codes of the given width from a bit stream
+static void _unpack_bits(const uint8_t*& ip, const uint8_t* end,
+                         uint32_t* codes, size_t n, uint8_t bits)
+{
+    if (bits == 0) {
+        std::fill(codes, codes + n, 0);
+        return;
+    }
+    size_t n_bytes = (n * bits + 7) / 8;
+    if (n_bytes > (size_t)(end - ip))
+        throw SRRuntimeException("The compressed buffer is truncated.");
+    uint64_t acc = 0;
+    unsigned n_acc = 0;
+    uint64_t mask = ((uint64_t)1 << bits) - 1;
+    for (size_t i = 0; i < n; i++) {
+        while (n_acc < bits) {
+            acc |= (uint64_t)(*ip++) << n_acc;
+            n_acc += 8;
+        }
+        codes[i] = (uint32_t)(acc & mask);
+        acc >>= bits;
+        n_acc -= bits;
+    }
+}
+
+// Quantize a block of values to within the error bound. Returns false
+// if the block must be stored verbatim.
+template <typename T>
+static bool _quantize_block(const T* values, size_t n, double step,
+                            double error_bound, double& offset,
+                            uint8_t& bits, uint32_t* codes)
+{
+    double lo = values[0];
+    double hi = values[0];
+    for (size_t i = 0; i < n; i++) {
+        double x = values[i];
+        if (!std::isfinite(x))
+            return false;
+        lo = std::min(lo, x);
+        hi = std::max(hi, x);
+    }
+    double max_code = std::floor((hi - lo) / step + 0.5);
+    if (max_code > (double)UINT32_MAX)
+        return false;
+
+    // Rounding in the reconstruction can push a value just past the
+    // bound, so every value is checked as the decoder will rebuild it
+    for (size_t i = 0; i < n; i++) {
+        uint32_t code = (uint32_t)std::floor((values[i] - lo) / step + 0.5);
+        T rebuilt = (T)(lo + code * step);
+        if (!(std::fabs((double)values[i] - (double)rebuilt) <= error_bound))
+            return false;
+        codes[i] = code;
+    }
+    offset = lo;
+    uint32_t n_codes = (uint32_t)max_code;
+    for (bits = 0; bits < _QUANT_MAX_BITS && (n_codes >> bits) != 0; bits++);
+    return true;
+}
+
+// Quantize values block by block into a stream
+template <typename T>
+static std::string _quantize(std::string_view raw, double error_bound)
+{
+    const T* values = (const T*)raw.data();
+    size_t n_values = raw.size() / sizeof(T);
+    double step = 2.0 * error_bound;
+    std::vector<uint32_t> codes(_QUANT_BLOCK_SIZE);
+
+    std::string out;
+    out.reserve(raw.size() / 2);
+    for (size_t start = 0; start < n_values; start += _QUANT_BLOCK_SIZE) {
+        size_t n = std::min(_QUANT_BLOCK_SIZE, n_values - start);
+        double offset;
+        uint8_t bits;
+        if (!_quantize_block(values + start, n, step, error_bound,
+                             offset, bits, codes.data())) {
+            out.push_back((char)_QUANT_VERBATIM);
+            out.append((const char*)(values + start), n * sizeof(T));
+            continue;
+        }
+        out.push_back((char)bits);
+        out.append((const char*)&offset, sizeof(offset));
+        _pack_bits(out, codes.data(), n, bits);
+    }
+    return out;
+}
+
+// Rebuild values from a quantized stream
+template <typename T>
+static void _dequantize(const uint8_t* ip, size_t in_size,
+                        double error_bound, T* values, size_t n_values)
+{
+    const uint8_t* end = ip + in_size;
+    double step = 2.0 * error_bound;
+    std::vector<uint32_t> codes(_QUANT_BLOCK_SIZE);
+    for (size_t start = 0; start < n_values; start += _QUANT_BLOCK_SIZE) {
+        size_t n = std::min(_QUANT_BLOCK_SIZE, n_values - start);
+        if (ip >= end)
+            throw SRRuntimeException("The compressed buffer is truncated.");
+        uint8_t bits = *ip++;
+        if (bits == _QUANT_VERBATIM) {
+            if (n * sizeof(T) > (size_t)(end - ip))
+                throw SRRuntimeException("The compressed buffer is truncated.");
+            std::memcpy(values + start, ip, n * sizeof(T));
+            ip += n * sizeof(T);
+            continue;
+        }
+        if (bits > _QUANT_MAX_BITS || (size_t)(end - ip) < sizeof(double))
+            throw SRRuntimeException("The compressed buffer is malformed.");
+        double offset;
+        std::memcpy(&offset, ip, sizeof(offset));
+        ip += sizeof(offset);
+        _unpack_bits(ip, end, codes.data(), n, bits);
+        for (size_t i = 0; i < n; i++)
+            values[start + i] = (T)(offset + codes[i] * step);
+    }
+    if (ip != end) {
+        throw SRRuntimeException("The compressed buffer does not hold the "\
+                                 "recorded number of values.");
+    }
+}
+
+// Error-bounded quantization of floating point values. The quantized
+// stream is further LZ compressed when that helps, which pays off for
+// blocks that are constant or nearly so.
+class QuantizeCodec : public CompressionCodec
+{
+    public:
+        bool is_lossy() const override { return true; }
+
+        bool supports(SRTensorType type) const override
+        {
+            return type == SRTensorTypeFloat || type == SRTensorTypeDouble;
+        }
+
+        std::string compress(std::string_view raw,
+                             size_t element_size,
+                             SRTensorType type,
+                             int level,
+                             double error_bound) const override
+        {
+            std::string stream = type == SRTensorTypeFloat ?
+                _quantize<float>(raw, error_bound) :
+                _quantize<double>(raw, error_bound);
+            std::string packed = _lz_compress(
+                (const uint8_t*)stream.data(), stream.size(), level);
+
+            // A flag byte and the stream size precede the stream
+            uint64_t stream_size = stream.size();
+            bool use_lz = packed.size() < stream.size();
+            std::string out(1, use_lz ? '\1' : '\0');
+            out.append((const char*)&stream_size, sizeof(stream_size));
+            out.append(use_lz ? packed : stream);
+            return out;
+        }
+
+        void decompress(std::string_view payload,
+                        size_t element_size,
+                        SRTensorType type,
+                        double error_bound,
+                        void* raw,
+                        size_t raw_size) const override
+        {
+            if (!supports(type) || !(error_bound > 0.0) ||
+                payload.size() < 1 + sizeof(uint64_t)) {
+                throw SRRuntimeException("The compressed buffer is malformed.");
+            }
+            bool use_lz = payload[0] != '\0';
+            uint64_t stream_size;
+            std::memcpy(&stream_size, payload.data() + 1, sizeof(stream_size));
+            const uint8_t* in = (const uint8_t*)payload.data() + 1 +
+                                sizeof(stream_size);
+            size_t in_size = payload.size() - 1 - sizeof(stream_size);
+
+            std::string stream;
+            if (use_lz) {
+                // A stream can never be more than a few bytes per value
+                // larger than the values themselves
+                if (stream_size > 2 * raw_size + 64) {
+                    throw SRRuntimeException("The compressed buffer is "\
+                                             "malformed.");
+                }
+                stream.resize(stream_size);
+                _lz_decompress(in, in_size,
+                               (uint8_t*)stream.data(), stream.size());
+                in = (const uint8_t*)stream.data();
+                in_size = stream.size();
+            }
+            else if (stream_size != in_size) {
+                throw SRRuntimeException("The compressed buffer is malformed.");
+            }
+
+            if (type == SRTensorTypeFloat) {
+                _dequantize(in, in_size, error_bound,
+                            (float*)raw, raw_size / sizeof(float));
+            }
+            else {
+                _dequantize(in, in_size, error_bound,
+                            (double*)raw, raw_size / sizeof(double));
+            }
+        }
+};
+
+// The codecs that can be selected, by identifier and by name
+struct CodecRegistry {
+    std::mutex lock;
+    std::map<uint8_t, std::shared_ptr<CompressionCodec>> codecs;
+    std::map<std::string, uint8_t> names;
+};
+
+// Get the codec registry, creating it with the built-in codecs
+static CodecRegistry& _codec_registry()
+{
+    static CodecRegistry* registry = [] {
+        CodecRegistry* r = new CodecRegistry;
+        r->codecs[SRCompressionShuffleLZ] = std::make_shared<ShuffleLZCodec>();
+        r->codecs[SRCompressionQuantize] = std::make_shared<QuantizeCodec>();
+        r->names["shuffle-lz"] = SRCompressionShuffleLZ;
+        r->names["quantize"] = SRCompressionQuantize;
+        return r;
+    }();
+    return *registry;
+}
+
+// Convert a codec name to lower case
+static std::string _lower_codec_name(const std::string& name)
+{
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+        [](unsigned char c){ return std::tolower(c); });
+    return lower;
+}
+
+// Register a site-specific compression codec
+void SmartRedis::register_compression_codec(
+    const std::string& name,
+    SRCompressionCodec id,
+    std::shared_ptr<CompressionCodec> codec)
+{
+    if (id < SRCompressionUserFirst || id > SRCompressionUserLast) {
+        throw SRParameterException("Registered compression codecs must "\
+                                   "use identifiers from " +
+                                   std::to_string(SRCompressionUserFirst) +
+                                   " to " +
+                                   std::to_string(SRCompressionUserLast));
+    }
+    if (codec == nullptr)
+        throw SRParameterException("The compression codec must not be null.");
+    std::string lower = _lower_codec_name(name);
+    if (lower == "" || lower == "none")
+        throw SRParameterException("Invalid compression codec name: " + name);
+
+    CodecRegistry& registry = _codec_registry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    if (registry.names.count(lower) > 0) {
+        throw SRParameterException("A compression codec named " + name +
+                                   " is already registered");
+    }
+    if (registry.codecs.count(id) > 0) {
+        throw SRParameterException("A compression codec with identifier " +
+                                   std::to_string(id) +
+                                   " is already registered");
+    }
+    registry.codecs[id] = codec;
+    registry.names[lower] = id;
+}
+
+// Retrieve a built-in or registered compression codec
+std::shared_ptr<CompressionCodec> SmartRedis::get_compression_codec(
+    SRCompressionCodec id)
+{
+    CodecRegistry& registry = _codec_registry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    auto it = registry.codecs.find(id);
+    if (it == registry.codecs.end()) {
+        throw SRParameterException("No compression codec has identifier " +
+                                   std::to_string(id));
+    }
+    return it->second;
+}
+
+// Look up a compression codec by name
+SRCompressionCodec SmartRedis::compression_codec_from_string(
+    const std::string& name)
+{
+    std::string lower = _lower_codec_name(name);
+    if (lower == "" || lower == "none")
+        return SRCompressionNone;
+
+    CodecRegistry& registry = _codec_registry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    auto it = registry.names.find(lower);
+    if (it == registry.names.end())
+        throw SRParameterException("Unknown compression codec: " + name);
+    return (SRCompressionCodec)it->second;
+}
+
+// Compress a buffer into a self-describing container
+std::string SmartRedis::compress_buffer(std::string_view raw,
+                                        size_t element_size,
+                                        SRTensorType type,
+                                        const std::vector<size_t>& dims,
+                                        SRCompressionCodec codec,
+                                        int level,
+                                        double error_bound)
+{
+    if (dims.size() > 255)
+        throw SRParameterException("Too many dimensions to compress.");
+    if (element_size == 0 || element_size > 255 ||
+        raw.size() % element_size != 0) {
+        element_size = 1;
+    }
+    level = std::max(1, std::min(level, 9));
+
+    std::string payload;
+    bool lossy = false;
+    if (codec != SRCompressionNone) {
+        std::shared_ptr<CompressionCodec> impl = get_compression_codec(codec);
+        if (!impl->supports(type)) {
+            codec = SRCompressionShuffleLZ;
+            impl = get_compression_codec(codec);
+        }
+        lossy = impl->is_lossy();
+        if (lossy && !(error_bound > 0.0)) {
+            throw SRParameterException("Lossy compression requires a "\
+                                       "positive error bound.");
+        }
+        payload = impl->compress(raw, element_size, type, level, error_bound);
+    }
+
+    // Keep the values as they are unless compression helps
+    if (codec == SRCompressionNone || payload.size() >= raw.size()) {
+        codec = SRCompressionNone;
+        lossy = false;
+        payload.assign(raw.data(), raw.size());
+    }
+
+    CompressedHeader header;
+    std::memcpy(header.magic, _COMPRESSED_MAGIC, sizeof(header.magic));
+    header.version = _COMPRESSED_VERSION;
+    header.codec = (uint8_t)codec;
+    header.element_size = (uint8_t)element_size;
+    header.n_dims = (uint8_t)dims.size();
+    header.type = (uint32_t)type;
+    header.raw_size = raw.size();
+    header.error_bound = lossy ? error_bound : 0.0;
+
+    std::string buf;
+    buf.reserve(sizeof(header) + dims.size() * sizeof(uint64_t) +
+                payload.size());
+    buf.append((const char*)&header, sizeof(header));
+    for (size_t i = 0; i < dims.size(); i++) {
+        uint64_t dim = dims[i];
+        buf.append((const char*)&dim, sizeof(dim));
+    }
+    buf.append(payload);
+    return buf;
+}
+
+// Check whether a buffer is a compression container
+bool SmartRedis::is_compressed_buffer(std::string_view buf)
+{
+    return buf.size() >= sizeof(CompressedHeader) &&
+           std::memcmp(buf.data(), _COMPRESSED_MAGIC,
+                       sizeof(_COMPRESSED_MAGIC)) == 0;
+}
+
+// Get the error bound recorded in a compression container
+double SmartRedis::compressed_buffer_error_bound(std::string_view buf)
+{
+    if (!is_compressed_buffer(buf))
+        throw SRRuntimeException("The buffer is not a compressed buffer.");
+    CompressedHeader header;
+    std::memcpy(&header, buf.data(), sizeof(header));
+    return header.error_bound;
+}
+
+// Decompress a container produced by compress_buffer()
+std::string SmartRedis::decompress_buffer(std::string_view buf,
+                                          SRTensorType& type,
+                                          std::vector<size_t>& dims)
+{
+    if (!is_compressed_buffer(buf))
+        throw SRRuntimeException("The buffer is not a compressed buffer.");
+
+    CompressedHeader header;
+    std::memcpy(&header, buf.data(), sizeof(header));
+    if (header.version != _COMPRESSED_VERSION) {
+        throw SRRuntimeException("The compressed buffer has unsupported "\
+                                 "version " + std::to_string(header.version));
+    }
+
+    size_t pos = sizeof(header);
+    size_t dims_bytes = header.n_dims * sizeof(uint64_t);
+    if (buf.size() - pos < dims_bytes)
+        throw SRRuntimeException("The compressed buffer is truncated.");
+    dims.resize(header.n_dims);
+    for (size_t i = 0; i < dims.size(); i++) {
+        uint64_t dim;
+        std::memcpy(&dim, buf.data() + pos, sizeof(dim));
+        dims[i] = dim;
+        pos += sizeof(dim);
+    }
+    type = (SRTensorType)header.type;
+
+    const uint8_t* payload = (const uint8_t*)buf.data() + pos;
+    size_t payload_size = buf.size() - pos;
+    std::string raw(header.raw_size, '\0');
+    if (header.codec == SRCompressionNone) {
+        if (payload_size != header.raw_size) {
+            throw SRRuntimeException("The compressed buffer does not "\
+                                     "hold the recorded number of bytes.");
+        }
+        std::memcpy(raw.data(), payload, payload_size);
+        return raw;
+    }
+
+    std::shared_ptr<CompressionCodec> codec;
+    try {
+        codec = get_compression_codec((SRCompressionCodec)header.codec);
+    }
+    catch (ParameterException& e) {
+        throw SRRuntimeException("The compressed buffer uses unknown codec " +
+                                 std::to_string(header.codec) +
+                                 "; it must be registered to be read");
+    }
+    codec->decompress(std::string_view((const char*)payload, payload_size),
+                      header.element_size, type, header.error_bound,
+                      raw.data(), raw.size());
+    return raw;
+}
@@ -27,6 +27,7 @@
  */
 
 #include <string_view>
+#include <cstring>
 #include "dataset.h"
 #include "srexception.h"
 #include "logger.h"
@@ -34,6 +35,53 @@
 
 using namespace SmartRedis;
 
+// Fixed-size header at the start of a packed DataSet buffer
+struct PackedDataSetHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t n_fields;
+    uint32_t n_tensors;
+    uint32_t reserved;
+};
+
+// Index entry locating a metadata field in a packed DataSet buffer
+struct PackedFieldEntry {
+    uint64_t name_offset;
+    uint64_t name_length;
+    uint64_t data_offset;
+    uint64_t data_length;
+};
+
+// Index entry locating a tensor in a packed DataSet buffer
+struct PackedTensorEntry {
+    uint64_t name_offset;
+    uint64_t name_length;
+    uint64_t dims_offset;
+    uint64_t n_dims;
+    uint64_t data_offset;
+    uint64_t data_length;
+    uint32_t type;
+    uint32_t reserved;
+};
+
+// Round a packed buffer offset up to an 8 byte boundary
+static inline size_t _packed_align(size_t offset)
+{
+    return (offset + 7) & ~((size_t)7);
+}
+
+// Check that a region of a packed buffer lies within the buffer
+static inline void _packed_check_range(uint64_t offset,
+                                       uint64_t length,
+                                       size_t buf_size)
+{
+    if (offset > buf_size || length > buf_size - offset) {
+        throw SRRuntimeException("The packed DataSet buffer is malformed: "\
+                                 "an index entry refers to bytes beyond "\
+                                 "the end of the buffer.");
+    }
+}
+
 // DataSet constructor
 DataSet::DataSet(const std::string& name)
  : SRObject(name), _dsname(name)
@@ -405,6 +453,174 @@ TensorBase* DataSet::_get_tensorbase_obj(const std::string& name) const
     return _tensorpack.get_tensor(name)->clone();
 }
 
+// Serialize all metadata fields and tensors into a single packed buffer
+std::string DataSet::_pack()
+{
+    std::vector<std::pair<std::string, std::string>> fields =
+        get_metadata_serialization_map();
+    std::vector<TensorBase*> tensors(tensor_begin(), tensor_end());
+    if (fields.size() == 0 && tensors.size() == 0) {
+        throw SRRuntimeException("An attempt was made to pack a DataSet "\
+                                 "that does not contain any fields or "\
+                                 "tensors.");
+    }
+
+    // Lay out the payload behind the header and the index
+    size_t offset = sizeof(PackedDataSetHeader) +
+                    fields.size() * sizeof(PackedFieldEntry) +
+                    tensors.size() * sizeof(PackedTensorEntry);
+
+    std::vector<PackedFieldEntry> field_index(fields.size());
+    for (size_t i = 0; i < fields.size(); i++) {
+        field_index[i].name_offset = offset;
+        field_index[i].name_length = fields[i].first.size();
+        offset += fields[i].first.size();
+        field_index[i].data_offset = offset;
+        field_index[i].data_length = fields[i].second.size();
+        offset += fields[i].second.size();
+    }
+
+    std::vector<PackedTensorEntry> tensor_index(tensors.size());
+    for (size_t i = 0; i < tensors.size(); i++) {
+        PackedTensorEntry& entry = tensor_index[i];
+        entry.name_offset = offset;
+        entry.name_length = tensors[i]->name().size();
+        offset = _packed_align(offset + entry.name_length);
+        entry.dims_offset = offset;
+        entry.n_dims = tensors[i]->dims().size();
+        offset += entry.n_dims * sizeof(uint64_t);
+        entry.data_offset = offset;
+        entry.data_length = tensors[i]->buf().size();
+        offset = _packed_align(offset + entry.data_length);
+        entry.type = (uint32_t)tensors[i]->type();
+        entry.reserved = 0;
+    }
+
+    // Fill in the buffer
+    std::string buf(offset, '\0');
+    char* dest = buf.data();
+
+    PackedDataSetHeader header;
+    std::memcpy(header.magic, _PACKED_MAGIC.data(), sizeof(header.magic));
+    header.version = _PACKED_VERSION;
+    header.n_fields = fields.size();
+    header.n_tensors = tensors.size();
+    header.reserved = 0;
+    std::memcpy(dest, &header, sizeof(header));
+    size_t pos = sizeof(header);
+    if (fields.size() > 0) {
+        std::memcpy(dest + pos, field_index.data(),
+                    fields.size() * sizeof(PackedFieldEntry));
+        pos += fields.size() * sizeof(PackedFieldEntry);
+    }
+    if (tensors.size() > 0) {
+        std::memcpy(dest + pos, tensor_index.data(),
+                    tensors.size() * sizeof(PackedTensorEntry));
+    }
+
+    for (size_t i = 0; i < fields.size(); i++) {
+        std::memcpy(dest + field_index[i].name_offset,
+                    fields[i].first.data(), field_index[i].name_length);
+        std::memcpy(dest + field_index[i].data_offset,
+                    fields[i].second.data(), field_index[i].data_length);
+    }
+
+    for (size_t i = 0; i < tensors.size(); i++) {
+        const PackedTensorEntry& entry = tensor_index[i];
+        std::string name = tensors[i]->name();
+        std::memcpy(dest + entry.name_offset, name.data(), entry.name_length);
+        std::vector<size_t> dims = tensors[i]->dims();
+        for (size_t j = 0; j < dims.size(); j++) {
+            uint64_t dim = dims[j];
+            std::memcpy(dest + entry.dims_offset + j * sizeof(uint64_t),
+                        &dim, sizeof(uint64_t));
+        }
+        std::memcpy(dest + entry.data_offset,
+                    tensors[i]->buf().data(), entry.data_length);
+    }
+
+    return buf;
+}
+
+// Populate the DataSet from a packed buffer
+void DataSet::_unpack(const char* buf, size_t buf_size)
+{
+    if (!_is_packed(buf, buf_size)) {
+        throw SRRuntimeException("The buffer supplied for DataSet " +
+                                 _dsname + " is not a packed DataSet.");
+    }
+
+    PackedDataSetHeader header;
+    std::memcpy(&header, buf, sizeof(header));
+    if (header.version != _PACKED_VERSION) {
+        throw SRRuntimeException("Unsupported packed DataSet version " +
+                                 std::to_string(header.version) +
+                                 " for DataSet " + _dsname + ".");
+    }
+
+    // Make sure the index itself fits in the buffer
+    size_t pos = sizeof(header);
+    _packed_check_range(pos,
+                        (uint64_t)header.n_fields * sizeof(PackedFieldEntry) +
+                        (uint64_t)header.n_tensors * sizeof(PackedTensorEntry),
+                        buf_size);
+
+    // Metadata fields are decoded directly from the buffer
+    for (uint32_t i = 0; i < header.n_fields; i++) {
+        PackedFieldEntry entry;
+        std::memcpy(&entry, buf + pos, sizeof(entry));
+        pos += sizeof(entry);
+        _packed_check_range(entry.name_offset, entry.name_length, buf_size);
+        _packed_check_range(entry.data_offset, entry.data_length, buf_size);
+        std::string name(buf + entry.name_offset, entry.name_length);
+        _add_serialized_field(name, const_cast<char*>(buf + entry.data_offset),
+                              entry.data_length);
+    }
+
+    // Tensor data is copied straight from the buffer into the TensorPack
+    for (uint32_t i = 0; i < header.n_tensors; i++) {
+        PackedTensorEntry entry;
+        std::memcpy(&entry, buf + pos, sizeof(entry));
+        pos += sizeof(entry);
+        _packed_check_range(entry.name_offset, entry.name_length, buf_size);
+        if (entry.n_dims > buf_size / sizeof(uint64_t)) {
+            throw SRRuntimeException("The packed DataSet buffer is "\
+                                     "malformed: invalid tensor rank.");
+        }
+        _packed_check_range(entry.dims_offset,
+                            entry.n_dims * sizeof(uint64_t), buf_size);
+        _packed_check_range(entry.data_offset, entry.data_length, buf_size);
+
+        std::string name(buf + entry.name_offset, entry.name_length);
+        std::vector<size_t> dims(entry.n_dims);
+        size_t n_values = 1;
+        for (size_t j = 0; j < dims.size(); j++) {
+            uint64_t dim;
+            std::memcpy(&dim, buf + entry.dims_offset + j * sizeof(uint64_t),
+                        sizeof(uint64_t));
+            dims[j] = dim;
+            n_values *= dims[j];
+        }
+
+        SRTensorType type = (SRTensorType)entry.type;
+        if (n_values * tensor_type_size(type) != entry.data_length) {
+            throw SRRuntimeException("The packed DataSet buffer is "\
+                                     "malformed: the data length of tensor " +
+                                     name + " does not match its dimensions.");
+        }
+        _add_to_tensorpack(name, buf + entry.data_offset, dims,
+                           type, SRMemLayoutContiguous);
+    }
+}
+
+// Check whether a buffer holds a packed DataSet
+bool DataSet::_is_packed(const char* buf, size_t buf_size)
+{
+    return buf != NULL &&
+           buf_size >= sizeof(PackedDataSetHeader) &&
+           std::memcmp(buf, _PACKED_MAGIC.data(), _PACKED_MAGIC.size()) == 0;
+}
+
 // Create a string representation of the DataSet
 std::string DataSet::to_string() const
 {
@@ -99,6 +99,30 @@ void PipelineReply::reorder(std::vector<size_t> index_order)
     }
 }
 
+// Replace stored replies with replies from another PipelineReply
+void PipelineReply::replace(
+    PipelineReply&& reply,
+    const std::vector<std::pair<size_t, size_t>>& index_map)
+{
+    for (size_t i = 0; i < index_map.size(); i++) {
+        if (index_map[i].first >= _all_replies.size() ||
+            index_map[i].second >= reply._all_replies.size()) {
+            throw SRInternalException("An attempt was made to replace a "\
+                                      "PipelineReply entry with an index "\
+                                      "out of range");
+        }
+        _all_replies[index_map[i].first] =
+            reply._all_replies[index_map[i].second];
+    }
+
+    // Keep the memory of the new replies alive with this object
+    for (size_t i = 0; i < reply._queued_replies.size(); i++) {
+        _queued_replies.push_back(std::move(reply._queued_replies[i]));
+    }
+    reply._queued_replies.clear();
+    reply._all_replies.clear();
+}
+
 // Add the QueuedReplies object to the inventory
 void PipelineReply::_add_queuedreplies(QueuedReplies&& reply)
 {
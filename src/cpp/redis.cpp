@@ -50,6 +50,7 @@ Redis::Redis(ConfigOptions* cfgopts, std::string addr_spec)
     : RedisServer(cfgopts)
 {
     SRAddress db_address(addr_spec);
+    _is_domain_socket = !db_address._is_tcp;
     _add_to_address_map(db_address);
     _connect(db_address);
 }
@@ -898,6 +899,93 @@ PipelineReply Redis::_run_pipeline(std::vector<Command*>& cmds)
     throw SRTimeoutException("Unable to execute pipeline");
 }
 
+// Run a CommandList atomically in a MULTI/EXEC transaction
+PipelineReply Redis::run_in_transaction(CommandList& cmdlist)
+{
+    // Convert from CommandList to vector
+    std::vector<Command*> cmds;
+    for (auto it = cmdlist.begin(); it != cmdlist.end(); ++it) {
+        cmds.push_back(*it);
+    }
+
+    // Run the commands
+    return _run_transaction(cmds);
+}
+
+// Build and run a MULTI/EXEC transaction
+PipelineReply Redis::_run_transaction(std::vector<Command*>& cmds)
+{
+    PipelineReply reply;
+    for (int i = 1; i <= _command_attempts; i++) {
+        try {
+            // Get transaction object (not piped, no new connection)
+            sw::redis::Transaction transaction = _redis->transaction(false, false);
+
+            // Loop over all commands and queue them in the transaction
+            for (size_t i = 0; i < cmds.size(); i++) {
+                transaction.command(cmds[i]->cbegin(), cmds[i]->cend());
+            }
+
+            // Execute the transaction
+            reply = transaction.exec();
+
+            // Check the replies
+            if (reply.has_error()) {
+                throw SRRuntimeException("Redis failed to execute the transaction");
+            }
+
+            // If we get here, it all worked
+            return reply;
+        }
+        catch (SmartRedis::Exception& e) {
+            // Exception is already prepared, just propagate it
+            throw;
+        }
+        catch (sw::redis::IoError &e) {
+            // For an error from Redis, retry unless we're out of chances
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis IO error when executing the transaction: ") +
+                    e.what());
+            }
+            // else, Fall through for a retry
+        }
+        catch (sw::redis::ClosedError &e) {
+            // For an error from Redis, retry unless we're out of chances
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis Closed error when executing the "\
+                                "transaction: ") + e.what());
+            }
+            // else, Fall through for a retry
+        }
+        catch (sw::redis::Error &e) {
+            // For other errors from Redis (including a transaction aborted
+            // by EXECABORT), report them immediately
+            throw SRRuntimeException(
+                std::string("Redis error when executing the transaction: ") +
+                    e.what());
+        }
+        catch (std::exception& e) {
+            // Should never hit this, so bail immediately if we do
+            throw SRInternalException(
+                std::string("Unexpected exception executing the transaction: ") +
+                    e.what());
+        }
+        catch (...) {
+            // Should never hit this, so bail immediately if we do
+            throw SRInternalException(
+                "Non-standard exception encountered executing the transaction");
+        }
+
+        // Sleep before the next attempt
+        std::this_thread::sleep_for(std::chrono::milliseconds(_command_interval));
+    }
+
+    // If we get here, we've run out of retry attempts
+    throw SRTimeoutException("Unable to execute transaction");
+}
+
 // Create a string representation of the Redis connection
 std::string Redis::to_string() const
 {
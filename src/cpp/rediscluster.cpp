@@ -26,6 +26,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <map>
+#include <sstream>
 #include <sw/redis++/redis++.h>
 #include "rediscluster.h"
 #include "nonkeyedcommand.h"
@@ -39,13 +41,20 @@ using namespace SmartRedis;
 
 // RedisCluster constructor
 RedisCluster::RedisCluster(ConfigOptions* cfgopts)
-    : RedisServer(cfgopts)
+    : RedisServer(cfgopts), _replica_read_count(0)
 {
-    SRAddress db_address(_get_ssdb());
-    if (!db_address._is_tcp) {
-        throw SRRuntimeException("Unix Domain Socket is not supported with clustered Redis");
-    }
+    _get_replica_read_settings();
     _is_domain_socket = false;
+
+    // Nodes listed by Unix domain socket are reached through it, while
+    // the cluster as a whole is reached by TCP
+    std::vector<SRAddress> addresses = _get_ssdb_addresses();
+    for (size_t i = 0; i < addresses.size(); i++) {
+        if (!addresses[i]._is_tcp)
+            addresses[i] = _connect_uds_node(addresses[i]);
+    }
+    std::uniform_int_distribution<size_t> distrib(0, addresses.size() - 1);
+    SRAddress db_address(addresses[distrib(_gen)]);
     _connect(db_address);
     _map_cluster();
     if (_address_node_map.count(db_address.to_string()) > 0)
@@ -59,9 +68,13 @@ RedisCluster::RedisCluster(ConfigOptions* cfgopts)
 // RedisCluster constructor. Uses address provided to constructor instead of
 // environment variables
 RedisCluster::RedisCluster(ConfigOptions* cfgopts, std::string address_spec)
-    : RedisServer(cfgopts)
+    : RedisServer(cfgopts), _replica_read_count(0)
 {
+    _get_replica_read_settings();
+    _is_domain_socket = false;
     SRAddress db_address(address_spec);
+    if (!db_address._is_tcp)
+        db_address = _connect_uds_node(db_address);
     _connect(db_address);
     _map_cluster();
     if (_address_node_map.count(db_address.to_string()) > 0)
@@ -85,50 +98,35 @@ RedisCluster::~RedisCluster()
 CommandReply RedisCluster::run(SingleKeyCommand& cmd)
 {
     // Preprend the target database to the command
-    std::string db_prefix;
-    if (cmd.has_keys())
-        db_prefix = _get_db_node_prefix(cmd);
-    else
+    if (!cmd.has_keys())
         throw SRRuntimeException("Redis has failed to find database");
 
-    return _run(cmd, db_prefix);
+    return _run(cmd, _get_db_node_prefix(cmd));
 }
 
 // Run a compound Command on the server
 CommandReply RedisCluster::run(CompoundCommand& cmd)
 {
-    std::string db_prefix;
-    if (cmd.has_keys())
-        db_prefix = _get_db_node_prefix(cmd);
-    else
+    if (!cmd.has_keys())
         throw SRRuntimeException("Redis has failed to find database");
 
-    return _run(cmd, db_prefix);
+    return _run(cmd, _get_db_node_prefix(cmd));
 }
 
 // Run a MultiKeyCommand on the server
 CommandReply RedisCluster::run(MultiKeyCommand& cmd)
 {
-    std::string db_prefix;
-    if (cmd.has_keys())
-        db_prefix = _get_db_node_prefix(cmd);
-    else
+    if (!cmd.has_keys())
         throw SRRuntimeException("Redis has failed to find database");
 
-    return _run(cmd, db_prefix);
+    return _run(cmd, _get_db_node_prefix(cmd));
 }
 
 // Run a non-keyed Command that addresses the given db node on the server
 CommandReply RedisCluster::run(AddressAtCommand& cmd)
 {
-    std::string db_prefix;
     SRAddress address(cmd.get_address());
-    if (is_addressable(address))
-        db_prefix = _address_node_map.at(address.to_string())->prefix;
-    else
-        throw SRRuntimeException("Redis has failed to find database");
-
-    return _run(cmd, db_prefix);
+    return _run(cmd, _get_address_prefix(address));
 }
 
 // Run a non-keyed Command that addresses any db node on the server
@@ -157,10 +155,12 @@ CommandReply RedisCluster::run(AddressAllCommand &cmd)
         }
     }
 
-    // Loop through all nodes to execute the command at each
-    std::vector<DBNode>::const_iterator node = _db_nodes.cbegin();
+    // Loop through all nodes to execute the command at each. The nodes
+    // are copied, since a redirect may refresh the slot map meanwhile.
+    std::vector<DBNode> db_nodes = _get_db_nodes();
+    std::vector<DBNode>::const_iterator node = db_nodes.cbegin();
     CommandReply reply;
-    for ( ; node != _db_nodes.cend(); node++) {
+    for ( ; node != db_nodes.cend(); node++) {
         // swap in a replacement segment for each one
         std::string new_field = "{" + node->prefix + "}." + field;
         cmd.set_field_at(new_field, cmd.key_index, true);
@@ -189,6 +189,16 @@ std::vector<CommandReply> RedisCluster::run(CommandList& cmds)
 // Run multiple single-key or single-hash slot Command on the server.
 PipelineReply RedisCluster::run_via_unordered_pipelines(CommandList& cmd_list)
 {
+    // Hold the slot map steady while the commands are assigned to shards.
+    // The lock is released before the pipelines run, since a pipeline
+    // that is redirected refreshes the map.
+    std::shared_lock<std::shared_mutex> map_lock(_slot_map_lock);
+
+    // Prefix of each shard
+    std::vector<std::string> shard_prefixes;
+    for (size_t s = 0; s < _db_nodes.size(); s++)
+        shard_prefixes.push_back(_db_nodes[s].prefix);
+
     // Map for shard index to Command indices so we can track order of execution
     std::vector<std::vector<size_t>> shard_cmd_index_list(_db_nodes.size());
 
@@ -208,18 +218,15 @@ PipelineReply RedisCluster::run_via_unordered_pipelines(CommandList& cmd_list)
                                       "_pipelines.");
         }
 
-        // Get keys for the command
-        std::vector<std::string> keys = (*cmd)->get_keys();
-
         // Check that there is only one key
-        if (keys.size() != 1) {
+        if ((*cmd)->get_key_count() != 1) {
             throw SRInternalException("Only single key commands are supported "\
                                       "by RedisCluster::run_via_unordered_"\
                                       "pipelines.");
         }
 
-        // Get the shard index for the first key
-        size_t db_index = _get_db_node_index(keys[0]);
+        // Get the shard index from the cached hash slot of the key
+        size_t db_index = _get_db_node_index((*cmd)->get_key_hash_slot(0));
 
         // Push back the command index to the shard list of commands
         shard_cmd_index_list[db_index].push_back(cmd_num);
@@ -227,6 +234,9 @@ PipelineReply RedisCluster::run_via_unordered_pipelines(CommandList& cmd_list)
         // Push back a pointer to the command for pipeline construction
         shard_cmds[db_index].push_back(*cmd);
     }
+    map_lock.unlock();
+
+    ThreadPool* tp = _get_thread_pool();
 
     // Define an empty PipelineReply object to store all shard replies
     PipelineReply all_replies;
@@ -248,7 +258,7 @@ PipelineReply RedisCluster::run_via_unordered_pipelines(CommandList& cmd_list)
     // Loop over all shards and execute pipelines
     for (size_t s = 0; s < num_shards; s++) {
         // Get shard prefix
-        std::string shard_prefix = _db_nodes[s].prefix;
+        std::string shard_prefix = shard_prefixes[s];
 
         // Only execute if there are commands
         if (shard_cmd_index_list[s].size() == 0) {
@@ -262,10 +272,10 @@ PipelineReply RedisCluster::run_via_unordered_pipelines(CommandList& cmd_list)
         }
 
         // Submit a task to execute these commands
-        _tp->submit_job([this, &shard_cmds, s, shard_prefix, &success_status,
-                         &results_mutex, &cmd_list_index_ooe,
-                         &shard_cmd_index_list, &all_replies,
-                         &pipeline_completion_count, &error_response]() mutable
+        tp->submit_job([this, &shard_cmds, s, shard_prefix, &success_status,
+                        &results_mutex, &cmd_list_index_ooe,
+                        &shard_cmd_index_list, &all_replies,
+                        &pipeline_completion_count, &error_response]() mutable
         {
             // Run the pipeline, catching any exceptions thrown
             PipelineReply reply;
@@ -322,10 +332,7 @@ PipelineReply RedisCluster::run_via_unordered_pipelines(CommandList& cmd_list)
 bool RedisCluster::model_key_exists(const std::string& key)
 {
     // Add model prefix to the key
-    DBNode* node = &(_db_nodes[0]);
-    if (node == NULL)
-        return false;
-    std::string prefixed_key = '{' + node->prefix + "}." + key;
+    std::string prefixed_key = '{' + _get_first_prefix() + "}." + key;
 
     // And perform key existence check
     return key_exists(prefixed_key);
@@ -366,6 +373,7 @@ bool RedisCluster::hash_field_exists(const std::string& key,
 // Check if a key exists in the database
 bool RedisCluster::is_addressable(const SRAddress& address) const
 {
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
     return _address_node_map.find(address.to_string()) !=
         _address_node_map.end();
 }
@@ -406,8 +414,7 @@ PipelineReply RedisCluster::get_tensors(const std::vector<std::string>& keys)
     }
 
     // Get the shard index for the first key
-    size_t db_index = _get_db_node_index(keys[0]);
-    std::string shard_prefix = _db_nodes[db_index].prefix;
+    std::string shard_prefix = _get_db_node_prefix(*cmds[0]);
 
     // Run them via pipeline
     return _run_pipeline(cmds, shard_prefix);
@@ -662,22 +669,17 @@ CommandReply RedisCluster::run_model(const std::string& model_name,
         We will choose it based on the db of the first input tensor.
     */
 
-    uint16_t hash_slot = _get_hash_slot(inputs[0]);
-    uint16_t db_index = _db_node_hash_search(hash_slot, 0, _db_nodes.size()-1);
-    DBNode* db = &(_db_nodes[db_index]);
-    if (db == NULL) {
-        throw SRRuntimeException("Missing DB node found in run_model");
-    }
+    std::string db_prefix = _get_key_prefix(inputs[0]);
 
     // Generate temporary names so that all keys go to same slot
-    std::vector<std::string> tmp_inputs = _get_tmp_names(inputs, db->prefix);
-    std::vector<std::string> tmp_outputs = _get_tmp_names(outputs, db->prefix);
+    std::vector<std::string> tmp_inputs = _get_tmp_names(inputs, db_prefix);
+    std::vector<std::string> tmp_outputs = _get_tmp_names(outputs, db_prefix);
 
     // Copy all input tensors to temporary names to align hash slots
     copy_tensors(inputs, tmp_inputs);
 
     // Use the model on our selected node
-    std::string model_key = "{" + db->prefix + "}." + std::string(model_name);
+    std::string model_key = "{" + db_prefix + "}." + std::string(model_name);
 
     // Build the MODELRUN command
     CompoundCommand cmd;
@@ -689,9 +691,7 @@ CommandReply RedisCluster::run_model(const std::string& model_name,
     // Run it
     CommandReply reply = run(cmd);
     if (reply.has_error() > 0) {
-        std::string error("run_model failed for node ");
-        error += db_index;
-        throw SRRuntimeException(error);
+        throw SRRuntimeException("run_model failed for node " + db_prefix);
     }
 
     // Store the outputs back to the database
@@ -736,20 +736,15 @@ CommandReply RedisCluster::run_script(const std::string& key,
                                       std::vector<std::string> outputs)
 {
     // Locate the DB node for the script
-    uint16_t hash_slot = _get_hash_slot(inputs[0]);
-    uint16_t db_index = _db_node_hash_search(hash_slot, 0, _db_nodes.size() - 1);
-    DBNode* db = &(_db_nodes[db_index]);
-    if (db == NULL) {
-        throw SRRuntimeException("Missing DB node found in run_script");
-    }
+    std::string db_prefix = _get_key_prefix(inputs[0]);
 
     // Generate temporary names so that all keys go to same slot
-    std::vector<std::string> tmp_inputs = _get_tmp_names(inputs, db->prefix);
-    std::vector<std::string> tmp_outputs = _get_tmp_names(outputs, db->prefix);
+    std::vector<std::string> tmp_inputs = _get_tmp_names(inputs, db_prefix);
+    std::vector<std::string> tmp_outputs = _get_tmp_names(outputs, db_prefix);
 
     // Copy all input tensors to temporary names to align hash slots
     copy_tensors(inputs, tmp_inputs);
-    std::string script_name = "{" + db->prefix + "}." + std::string(key);
+    std::string script_name = "{" + db_prefix + "}." + std::string(key);
 
     // Build the SCRIPTRUN command
     CompoundCommand cmd;
@@ -759,9 +754,7 @@ CommandReply RedisCluster::run_script(const std::string& key,
     // Run it
     CommandReply reply = run(cmd);
     if (reply.has_error() > 0) {
-        std::string error("run_model failed for node ");
-        error += db_index;
-        throw SRRuntimeException(error);
+        throw SRRuntimeException("run_script failed for node " + db_prefix);
     }
 
     // Store the output back to the database
@@ -899,7 +892,7 @@ void RedisCluster::delete_script_multigpu(
 CommandReply RedisCluster::get_model(const std::string& key)
 {
     // Build the node prefix
-    std::string prefixed_str = "{" + _db_nodes[0].prefix + "}." + key;
+    std::string prefixed_str = "{" + _get_first_prefix() + "}." + key;
 
     // Build the MODELGET command
     SingleKeyCommand cmd;
@@ -913,7 +906,7 @@ CommandReply RedisCluster::get_model(const std::string& key)
 CommandReply RedisCluster::get_script(const std::string& key)
 {
     // Build the node prefix
-    std::string prefixed_str = "{" + _db_nodes[0].prefix + "}." + key;
+    std::string prefixed_str = "{" + _get_first_prefix() + "}." + key;
 
     // Build the SCRIPTGET command
     SingleKeyCommand cmd;
@@ -937,7 +930,7 @@ CommandReply RedisCluster::get_model_script_ai_info(const std::string& address,
                                  "not match a cluster shard address.");
     }
 
-    std::string db_prefix = _address_node_map.at(db_address.to_string())->prefix;
+    std::string db_prefix = _get_address_prefix(db_address);
     std::string prefixed_key = "{" + db_prefix + "}." + key;
 
     // Build the Command
@@ -984,8 +977,9 @@ int RedisCluster::get_model_chunk_size()
 void RedisCluster::set_model_chunk_size(int chunk_size)
 {
     // Repeat for each server node:
-    auto node = _db_nodes.cbegin();
-    for ( ; node != _db_nodes.cend(); node++) {
+    std::vector<DBNode> db_nodes = _get_db_nodes();
+    auto node = db_nodes.cbegin();
+    for ( ; node != db_nodes.cend(); node++) {
         // Pick a node for the command
         AddressAtCommand cmd;
         cmd.set_exec_address(node->address);
@@ -1003,29 +997,65 @@ void RedisCluster::set_model_chunk_size(int chunk_size)
     _model_chunk_size = chunk_size;
 }
 
-inline CommandReply RedisCluster::_run(const Command& cmd, std::string db_prefix)
+inline CommandReply RedisCluster::_run(const Command& cmd,
+                                       const std::string& db_prefix)
 {
-    std::string_view sv_prefix(db_prefix.data(), db_prefix.size());
+    // Serve reads from a replica when enabled, unless it cannot answer
+    CommandReply replica_reply;
+    if (_is_replica_read(cmd) && _run_on_replica(cmd, replica_reply))
+        return replica_reply;
+
+    // The route changes if the command is redirected
+    std::string prefix(db_prefix);
+    bool asking = false;
+    int n_redirects = 0;
 
     // Execute the commmand
     for (int i = 1; i <= _command_attempts; i++) {
+        Redirect redirect;
+        bool redirected = false;
         try {
-            sw::redis::Redis db = _redis_cluster->redis(sv_prefix, false);
-            CommandReply reply = db.command(cmd.cbegin(), cmd.cend());
+            CommandReply reply;
+            if (asking) {
+                reply = _run_asking(cmd, prefix);
+            }
+            else {
+                sw::redis::Redis* local = _get_uds_connection(prefix);
+                if (local != NULL) {
+                    reply = local->command(cmd.cbegin(), cmd.cend());
+                }
+                else {
+                    std::string_view sv_prefix(prefix.data(), prefix.size());
+                    sw::redis::Redis db = _redis_cluster->redis(sv_prefix, false);
+                    reply = db.command(cmd.cbegin(), cmd.cend());
+                }
+            }
             if (reply.has_error() == 0) {
-                _last_prefix = db_prefix;
+                _last_prefix = prefix;
                 return reply;
             }
 
-            // On an error response, print the response and bail
-            reply.print_reply_error();
-            throw SRRuntimeException(
-                "Redis failed to execute command: " + cmd.first_field());
+            // A redirect is followed below; other error responses are
+            // printed before bailing
+            redirected = _get_redirect(reply, redirect);
+            if (!redirected) {
+                reply.print_reply_error();
+                throw SRRuntimeException(
+                    "Redis failed to execute command: " + cmd.first_field());
+            }
         }
         catch (SmartRedis::Exception& e) {
             // Exception is already prepared, just propagate it
             throw;
         }
+        catch (sw::redis::MovedError& e) {
+            redirect = _get_redirect(e, false);
+            redirected = true;
+        }
+        catch (sw::redis::AskError& e) {
+            redirect = _get_redirect(e, true);
+            redirected = true;
+        }
         catch (sw::redis::IoError &e) {
             // For an error from Redis, retry unless we're out of chances
             std::string message("Redis IO error when executing command: ");
@@ -1033,9 +1063,12 @@ inline CommandReply RedisCluster::_run(const Command& cmd, std::string db_prefix
             if (i == _command_attempts) {
                 throw SRDatabaseException(message);
             }
-            // Else log, retry, and fall through for a retry
+            // Else log, reroute in case of a failover, and fall through
+            // for a retry
             else {
                 _context->log_error(LLInfo, message);
+                _reroute_after_failure(cmd, prefix);
+                asking = false;
             }
         }
         catch (sw::redis::ClosedError &e) {
@@ -1045,9 +1078,12 @@ inline CommandReply RedisCluster::_run(const Command& cmd, std::string db_prefix
             if (i == _command_attempts) {
                 throw SRDatabaseException(message);
             }
-            // Else log, retry, and fall through for a retry
+            // Else log, reroute in case of a failover, and fall through
+            // for a retry
             else {
                 _context->log_error(LLInfo, message);
+                _reroute_after_failure(cmd, prefix);
+                asking = false;
             }
         }
         catch (sw::redis::Error &e) {
@@ -1069,6 +1105,23 @@ inline CommandReply RedisCluster::_run(const Command& cmd, std::string db_prefix
                 cmd.first_field());
         }
 
+        // Follow a redirect right away, without using up an attempt
+        if (redirected) {
+            if (++n_redirects > _MAX_REDIRECTS) {
+                throw SRRuntimeException(
+                    "Too many cluster redirects executing command: " +
+                    cmd.first_field());
+            }
+            if (!redirect.ask) {
+                _refresh_cluster_map(std::chrono::steady_clock::now(),
+                                     redirect.slot);
+            }
+            prefix = _get_redirect_prefix(redirect);
+            asking = redirect.ask;
+            i--;
+            continue;
+        }
+
         // Sleep before the next attempt
         std::this_thread::sleep_for(std::chrono::milliseconds(_command_interval));
     }
@@ -1160,10 +1213,6 @@ inline void RedisCluster::_connect(SRAddress& db_address)
 // Map the RedisCluster via the CLUSTER SLOTS command
 inline void RedisCluster::_map_cluster()
 {
-    // Clear out our old map
-    _db_nodes.clear();
-    _address_node_map.clear();
-
     // Build the CLUSTER SLOTS command
     AddressAnyCommand cmd;
     cmd << "CLUSTER" << "SLOTS";
@@ -1174,44 +1223,97 @@ inline void RedisCluster::_map_cluster()
         throw SRRuntimeException("CLUSTER SLOTS command failed");
     }
 
-    // Process results
+    // Replace the old map, keeping routing threads out meanwhile
+    std::unique_lock<std::shared_mutex> lock(_slot_map_lock);
+    _db_nodes.clear();
+    _address_node_map.clear();
+    _slot_db_nodes.clear();
     _parse_reply_for_slots(reply);
+
+    // Route the nodes reached by Unix domain socket through it
+    _uds_prefixes.clear();
+    for (size_t i = 0; i < _db_nodes.size(); i++) {
+        auto uds = _uds_connections.find(_db_nodes[i].address.to_string());
+        if (uds != _uds_connections.end())
+            _uds_prefixes[_db_nodes[i].prefix] = uds->second.redis.get();
+    }
 }
 
 // Get the prefix that can be used to address the correct database
 // for a given command
-std::string RedisCluster::_get_db_node_prefix(Command& cmd)
+std::string RedisCluster::_get_db_node_prefix(const Command& cmd)
 {
-    // Extract the keys from the command
-    std::vector<std::string> keys = cmd.get_keys();
-    if (keys.size() == 0) {
-        throw SRRuntimeException("Command " + cmd.to_string() +
+    size_t n_keys = cmd.get_key_count();
+    if (n_keys == 0) {
+        throw SRRuntimeException("Command " + cmd.first_field() +
                                  " does not have a key value.");
     }
 
-    // Walk through the keys to find the prefix
-    std::string prefix;
-    std::vector<std::string>::iterator key_it = keys.begin();
-    for ( ; key_it != keys.end(); key_it++) {
-        uint16_t db_index = _get_db_node_index(*key_it);
-        if (prefix.size() == 0) {
-            prefix = _db_nodes[db_index].prefix;
-        }
-        else if (prefix != _db_nodes[db_index].prefix) {
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
+
+    // Walk through the cached key hash slots to find the DBNode
+    uint16_t db_index = _get_db_node_index(cmd.get_key_hash_slot(0));
+    for (size_t i = 1; i < n_keys; i++) {
+        if (_get_db_node_index(cmd.get_key_hash_slot(i)) != db_index) {
             throw SRRuntimeException("Multi-key commands are not valid: " +
-                                     cmd.to_string());
+                                     cmd.first_field());
         }
     }
 
     // Done
-    return prefix;
+    return _db_nodes[db_index].prefix;
+}
+
+// Get the prefix of the DBNode serving the provided key
+std::string RedisCluster::_get_key_prefix(const std::string& key)
+{
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
+    return _db_nodes[_get_db_node_index(_get_hash_slot(key))].prefix;
+}
+
+// Get the prefix of the DBNode at an address
+std::string RedisCluster::_get_address_prefix(const SRAddress& address)
+{
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
+    auto node = _address_node_map.find(address.to_string());
+    if (node == _address_node_map.end())
+        throw SRRuntimeException("Redis has failed to find database");
+    return node->second->prefix;
+}
+
+// Get the prefix of the first DBNode, under which models and scripts
+// are stored
+std::string RedisCluster::_get_first_prefix()
+{
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
+    if (_db_nodes.size() == 0)
+        throw SRRuntimeException("Redis has failed to find database");
+    return _db_nodes[0].prefix;
+}
+
+// Get a copy of the DBNodes of the cluster
+std::vector<DBNode> RedisCluster::_get_db_nodes()
+{
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
+    return _db_nodes;
 }
 
 // Get the index in _db_nodes for the provided key
 inline uint16_t RedisCluster::_get_db_node_index(const std::string& key)
 {
-    uint16_t hash_slot = _get_hash_slot(key);
-    return  _db_node_hash_search(hash_slot, 0, _db_nodes.size() - 1);
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
+    return _get_db_node_index(_get_hash_slot(key));
+}
+
+// Get the index in _db_nodes of the DBNode serving a hash slot
+inline uint16_t RedisCluster::_get_db_node_index(uint16_t hash_slot)
+{
+    uint16_t db_index = _slot_db_nodes[hash_slot];
+    if (db_index == _UNSERVED_SLOT) {
+        throw SRRuntimeException("Hash slot " + std::to_string(hash_slot) +
+                                 " is not served by any database node.");
+    }
+    return db_index;
 }
 
 // Process the CommandReply for CLUSTER SLOTS to build DBNode information
@@ -1224,6 +1326,7 @@ inline void RedisCluster::_parse_reply_for_slots(CommandReply& reply)
     2) 0) "ip address"
        1) (integer) port   (note that for clustered Redis, this will always be a TCP address)
        2) "name"
+    3...) The replicas of the node, in the same form
     */
     size_t n_db_nodes = reply.n_elements();
     _db_nodes = std::vector<DBNode>(n_db_nodes);
@@ -1238,12 +1341,33 @@ inline void RedisCluster::_parse_reply_for_slots(CommandReply& reply)
         _db_nodes[i].name = std::string(reply[i][2][2].str(),
                                               reply[i][2][2].str_len());
         _db_nodes[i].prefix = _get_crc16_prefix(_db_nodes[i].lower_hash_slot);
-        _address_node_map.insert({_db_nodes[i].address.to_string(),
-                                  &_db_nodes[i]});
+
+        // Replicas without a known endpoint cannot be reached
+        for (size_t r = 3; r < reply[i].n_elements(); r++) {
+            SRAddress replica;
+            replica._is_tcp = true;
+            replica._tcp_host = std::string(reply[i][r][0].str(),
+                                            reply[i][r][0].str_len());
+            replica._tcp_port = reply[i][r][1].integer();
+            if (replica._tcp_host.size() > 0 && replica._tcp_host != "?")
+                _db_nodes[i].replicas.push_back(replica);
+        }
     }
 
     //Put the vector of db nodes in order based on lower hash slot
     std::sort(_db_nodes.begin(), _db_nodes.end());
+
+    // Index the sorted nodes by address and by hash slot
+    _slot_db_nodes.assign(_N_HASH_SLOTS, _UNSERVED_SLOT);
+    for (size_t i = 0; i < n_db_nodes; i++) {
+        _address_node_map.insert({_db_nodes[i].address.to_string(),
+                                  &_db_nodes[i]});
+        uint64_t lower = _db_nodes[i].lower_hash_slot;
+        uint64_t upper = std::min<uint64_t>(_db_nodes[i].upper_hash_slot,
+                                            _N_HASH_SLOTS - 1);
+        for (uint64_t slot = lower; slot <= upper; slot++)
+            _slot_db_nodes[slot] = i;
+    }
 }
 
 // Perform inverse CRC16 XOR and shifts
@@ -1336,58 +1460,423 @@ std::string RedisCluster::_get_crc16_prefix(uint64_t hash_slot)
     return prefix;
 }
 
-// Determine if the key has a substring enclosed by "{" and "}" characters
-bool RedisCluster::_has_hash_tag(const std::string& key)
+// Get the hash slot for a key
+uint16_t RedisCluster::_get_hash_slot(const std::string& key)
 {
-    size_t first = key.find('{');
-    size_t second = key.find('}');
-    return (first != std::string::npos && second != std::string::npos &&
-            second > first);
+    return Command::get_hash_slot(key);
 }
 
-// Return the key enclosed by "{" and "}" characters
-std::string RedisCluster::_get_hash_tag(const std::string& key)
+// Check whether a reply is a MOVED or ASK redirect
+bool RedisCluster::_get_redirect(CommandReply& reply, Redirect& redirect)
 {
-    // If no hash tag, bail
-    if (!_has_hash_tag(key))
-        return key;
+    if (reply.redis_reply_type() != "REDIS_REPLY_ERROR")
+        return false;
 
-    // Extract the hash tag
-    size_t first = key.find('{');
-    size_t second = key.find('}');
-    return key.substr(first + 1, second - first - 1);
+    // The error reads "MOVED <slot> <host>:<port>" or "ASK ..."
+    std::istringstream error(reply.get_reply_errors()[0]);
+    std::string kind;
+    unsigned long slot = 0;
+    error >> kind >> slot >> redirect.address;
+    if ((kind != "MOVED" && kind != "ASK") || error.fail() ||
+        slot >= _N_HASH_SLOTS) {
+        return false;
+    }
+    redirect.ask = (kind == "ASK");
+    redirect.slot = slot;
+    return true;
 }
 
-// Get the hash slot for a key
-uint16_t RedisCluster::_get_hash_slot(const std::string& key)
+// Build a Redirect from a redis++ redirection error
+RedisCluster::Redirect RedisCluster::_get_redirect(
+    const sw::redis::RedirectionError& error, bool ask)
 {
-    std::string hash_key = _get_hash_tag(key);
-    return sw::redis::crc16(hash_key.c_str(), hash_key.size()) % 16384;
+    Redirect redirect;
+    redirect.ask = ask;
+    redirect.slot = error.slot() % _N_HASH_SLOTS;
+    redirect.address = error.node().host + ":" +
+                       std::to_string(error.node().port);
+    return redirect;
 }
 
-// Get the index of the DBNode responsible for the hash slot
-uint16_t RedisCluster::_db_node_hash_search(uint16_t hash_slot,
-                                            unsigned lhs,
-                                            unsigned rhs)
+// Get the prefix of the DBNode a redirect points to
+std::string RedisCluster::_get_redirect_prefix(const Redirect& redirect)
 {
-    // Find the DBNode via binary search
-    uint16_t m = (lhs + rhs) / 2;
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
+    if (!redirect.ask)
+        return _db_nodes[_get_db_node_index(redirect.slot)].prefix;
+
+    auto node = _address_node_map.find(redirect.address);
+    if (node == _address_node_map.end()) {
+        throw SRRuntimeException("A cluster redirect pointed to " +
+                                 redirect.address + ", which does not "\
+                                 "serve any hash slots.");
+    }
+    return node->second->prefix;
+}
 
-    // If this is the correct slot, we're done
-    if (_db_nodes[m].lower_hash_slot <= hash_slot &&
-        _db_nodes[m].upper_hash_slot >= hash_slot) {
-        return m;
+// Rebuild the slot map after the cluster changed
+void RedisCluster::_refresh_cluster_map(
+    std::chrono::steady_clock::time_point observed, uint16_t hash_slot)
+{
+    std::unique_lock<std::mutex> lock(_refresh_lock);
+
+    // Another thread may have caught up with the change already
+    if (_last_map_refresh >= observed)
+        return;
+
+    // Throttle refreshes, so that a burst of redirects during a
+    // reshard does not turn into a burst of CLUSTER SLOTS commands
+    std::this_thread::sleep_until(_last_map_refresh +
+        std::chrono::milliseconds(_MIN_MAP_REFRESH_INTERVAL));
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    // redis++ keeps its own slot map, which redis() and pipeline() use
+    // to reach the node for a prefix.  A keyed command through its
+    // cluster-aware interface makes it notice the change and update.
+    try {
+        (void)_redis_cluster->exists(_get_crc16_prefix(hash_slot));
+    }
+    catch (sw::redis::Error& e) {
+        // If the cluster is unreachable, CLUSTER SLOTS reports it below
     }
 
-    // Otherwise search in the appropriate half
+    _map_cluster();
+    _last_map_refresh = start;
+    _context->log_data(LLDebug, "Refreshed the cluster slot map");
+}
+
+// Refresh the slot map after a connection failure and route again
+void RedisCluster::_reroute_after_failure(const Command& cmd,
+                                          std::string& db_prefix)
+{
+    // Commands without keys have no route to update.  This also keeps
+    // CLUSTER SLOTS, run during a refresh, from starting another one.
+    if (cmd.get_key_count() == 0)
+        return;
+
+    try {
+        _refresh_cluster_map(std::chrono::steady_clock::now(),
+                             cmd.get_key_hash_slot(0));
+        db_prefix = _get_db_node_prefix(cmd);
+    }
+    catch (Exception& e) {
+        _context->log_error(LLInfo, std::string("Could not refresh the "\
+                            "cluster slot map: ") + e.what());
+    }
+}
+
+// Run a command after ASKING on a node importing its hash slot
+CommandReply RedisCluster::_run_asking(const Command& cmd,
+                                       const std::string& db_prefix)
+{
+    // ASKING only applies to the next command on the same connection,
+    // so the two are sent together in one pipeline
+    sw::redis::Pipeline pipeline = _get_pipeline(db_prefix);
+    pipeline.command("ASKING");
+    pipeline.command(cmd.cbegin(), cmd.cend());
+    PipelineReply replies = pipeline.exec();
+
+    // Copy the reply out of the pipeline, which owns its memory
+    CommandReply reply = replies[1];
+    return CommandReply(static_cast<const CommandReply&>(reply));
+}
+
+// Connect to a cluster node through a Unix domain socket and find the
+// TCP address by which the rest of the cluster knows it
+SRAddress RedisCluster::_connect_uds_node(const SRAddress& uds_address)
+{
+    sw::redis::ConnectionOptions connectOpts;
+    connectOpts.path = uds_address._uds_file;
+    connectOpts.type = sw::redis::ConnectionType::UNIX;
+    connectOpts.socket_timeout = std::chrono::milliseconds(
+        _socket_timeout);
+
+    // The node marks itself as "myself" in its CLUSTER NODES listing
+    AddressAnyCommand cmd;
+    cmd << "CLUSTER" << "NODES";
+    std::unique_ptr<sw::redis::Redis> redis;
+    CommandReply reply;
+    for (int i = 1; i <= _connection_attempts; i++) {
+        try {
+            redis = std::make_unique<sw::redis::Redis>(connectOpts);
+            reply = redis->command(cmd.cbegin(), cmd.cend());
+            break;
+        }
+        catch (sw::redis::Error& e) {
+            std::string message("Unable to connect to cluster node " +
+                                uds_address.to_string() + ": " + e.what());
+            if (i == _connection_attempts)
+                throw SRDatabaseException(message);
+            _context->log_error(LLInfo, message);
+        }
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(_connection_interval));
+    }
+    if (reply.has_error() > 0 ||
+        reply.redis_reply_type() != "REDIS_REPLY_STRING") {
+        throw SRRuntimeException("CLUSTER NODES failed on " +
+                                 uds_address.to_string());
+    }
+
+    // Each line reads "<id> <host>:<port>@<bus port>[,<hostname>] <flags> ..."
+    std::istringstream nodes(std::string(reply.str(), reply.str_len()));
+    std::string line;
+    while (std::getline(nodes, line)) {
+        std::istringstream fields(line);
+        std::string id, address, flags;
+        fields >> id >> address >> flags;
+        if (("," + flags + ",").find(",myself,") == std::string::npos)
+            continue;
+
+        address = address.substr(0, address.find_first_of("@,"));
+        if (address.size() == 0 || address[0] == ':') {
+            throw SRRuntimeException("Cluster node " +
+                                     uds_address.to_string() +
+                                     " does not know its TCP address.");
+        }
+        SRAddress tcp_address(address);
+        _uds_connections[tcp_address.to_string()] =
+            UDSConnection{uds_address, std::move(redis)};
+        _context->log_data(LLDeveloper, "Reaching cluster node " +
+                           tcp_address.to_string() + " through " +
+                           uds_address.to_string());
+        return tcp_address;
+    }
+    throw SRRuntimeException("Cluster node " + uds_address.to_string() +
+                             " is not in cluster mode.");
+}
+
+// Get the Unix domain socket connection to a DBNode
+sw::redis::Redis* RedisCluster::_get_uds_connection(
+    const std::string& db_prefix)
+{
+    // Most deployments have none, so skip the lock
+    if (_uds_connections.empty())
+        return NULL;
+
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
+    auto uds = _uds_prefixes.find(db_prefix);
+    return uds == _uds_prefixes.end() ? NULL : uds->second;
+}
+
+// Get a Pipeline to the DBNode with a prefix
+sw::redis::Pipeline RedisCluster::_get_pipeline(const std::string& db_prefix)
+{
+    sw::redis::Redis* local = _get_uds_connection(db_prefix);
+    if (local != NULL)
+        return local->pipeline(false);
+    return _redis_cluster->pipeline(db_prefix, false);
+}
+
+// Read the replica read policy from the SR_REPLICA_READS setting
+void RedisCluster::_get_replica_read_settings()
+{
+    std::string policy = _cfgopts->_resolve_string_option(
+        "SR_REPLICA_READS", "none");
+    if (policy == "none")
+        _replica_read_policy = SRReplicaReadsNone;
+    else if (policy == "random")
+        _replica_read_policy = SRReplicaReadsRandom;
+    else if (policy == "round-robin")
+        _replica_read_policy = SRReplicaReadsRoundRobin;
     else {
-        if (_db_nodes[m].lower_hash_slot > hash_slot)
-            return _db_node_hash_search(hash_slot, lhs, m - 1);
-        else
-            return _db_node_hash_search(hash_slot, m + 1, rhs);
+        throw SRParameterException("SR_REPLICA_READS must be none, "\
+                                   "random or round-robin, not " + policy);
     }
 }
 
+// Pick a replica of the DBNode serving a hash slot
+RedisCluster::ReplicaConnection* RedisCluster::_get_replica(
+    uint16_t hash_slot)
+{
+    std::shared_lock<std::shared_mutex> map_lock(_slot_map_lock);
+    const std::vector<SRAddress>& replicas =
+        _db_nodes[_get_db_node_index(hash_slot)].replicas;
+    size_t n_replicas = replicas.size();
+    if (n_replicas == 0)
+        return NULL;
+
+    std::unique_lock<std::mutex> lock(_replica_lock);
+    size_t first;
+    if (_replica_read_policy == SRReplicaReadsRoundRobin) {
+        first = _replica_read_count++ % n_replicas;
+    }
+    else {
+        std::uniform_int_distribution<size_t> distrib(0, n_replicas - 1);
+        first = distrib(_gen);
+    }
+
+    // Take the first replica from there that has not failed recently
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    for (size_t r = 0; r < n_replicas; r++) {
+        const SRAddress& address = replicas[(first + r) % n_replicas];
+        ReplicaConnection& replica =
+            _replica_connections[address.to_string()];
+        if (replica.redis == nullptr) {
+            sw::redis::ConnectionOptions connectOpts;
+            connectOpts.host = address._tcp_host;
+            connectOpts.port = address._tcp_port;
+            connectOpts.type = sw::redis::ConnectionType::TCP;
+            connectOpts.socket_timeout = std::chrono::milliseconds(
+                _socket_timeout);
+            connectOpts.readonly = true;
+            replica.redis = std::make_unique<sw::redis::Redis>(connectOpts);
+        }
+        if (replica.retry_after <= now)
+            return &replica;
+    }
+    return NULL;
+}
+
+// Check whether a Command may be served by a replica
+bool RedisCluster::_is_replica_read(const Command& cmd) const
+{
+    return _replica_read_policy != SRReplicaReadsNone &&
+           cmd.get_key_count() > 0 && cmd.is_read_only();
+}
+
+// Check whether a reply from a replica must be confirmed by the master
+bool RedisCluster::_is_replica_miss(CommandReply& reply)
+{
+    if (reply.has_error() > 0 || reply.is_nil())
+        return true;
+    if (reply.is_array())
+        return reply.n_elements() == 0;
+    if (reply.redis_reply_type() == "REDIS_REPLY_INTEGER")
+        return reply.integer() == 0;
+    return false;
+}
+
+// Run a read-only Command on a replica
+bool RedisCluster::_run_on_replica(const Command& cmd, CommandReply& reply)
+{
+    ReplicaConnection* replica = _get_replica(cmd.get_key_hash_slot(0));
+    if (replica == NULL)
+        return false;
+
+    try {
+        reply = replica->redis->command(cmd.cbegin(), cmd.cend());
+    }
+    catch (sw::redis::Error& e) {
+        // Rest the replica for a while and read from the master
+        _context->log_data(LLDebug, std::string("Replica read failed: ") +
+                           e.what());
+        std::unique_lock<std::mutex> lock(_replica_lock);
+        replica->retry_after = std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(_REPLICA_RETRY_INTERVAL);
+        return false;
+    }
+    return !_is_replica_miss(reply);
+}
+
+// Run read-only Commands for one hash slot on a replica via a Pipeline
+bool RedisCluster::_run_pipeline_on_replica(std::vector<Command*>& cmds,
+                                            PipelineReply& reply)
+{
+    // Every Command must be a read of the node serving the first one
+    uint16_t hash_slot = cmds[0]->get_key_hash_slot(0);
+    {
+        std::shared_lock<std::shared_mutex> map_lock(_slot_map_lock);
+        uint16_t db_index = _get_db_node_index(hash_slot);
+        for (size_t i = 0; i < cmds.size(); i++) {
+            if (!_is_replica_read(*cmds[i]) ||
+                _get_db_node_index(cmds[i]->get_key_hash_slot(0)) != db_index)
+                return false;
+        }
+    }
+
+    ReplicaConnection* replica = _get_replica(hash_slot);
+    if (replica == NULL)
+        return false;
+
+    try {
+        sw::redis::Pipeline pipeline = replica->redis->pipeline(false);
+        for (size_t i = 0; i < cmds.size(); i++)
+            pipeline.command(cmds[i]->cbegin(), cmds[i]->cend());
+        reply = pipeline.exec();
+    }
+    catch (sw::redis::Error& e) {
+        // Rest the replica for a while and read from the master
+        _context->log_data(LLDebug, std::string("Replica read failed: ") +
+                           e.what());
+        std::unique_lock<std::mutex> lock(_replica_lock);
+        replica->retry_after = std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(_REPLICA_RETRY_INTERVAL);
+        return false;
+    }
+
+    // A single miss sends the whole pipeline to the master
+    for (size_t i = 0; i < reply.size(); i++) {
+        CommandReply cmd_reply = reply[i];
+        if (_is_replica_miss(cmd_reply))
+            return false;
+    }
+    return true;
+}
+
+// Run the redirected commands of a pipeline again
+bool RedisCluster::_reroute_pipeline(std::vector<Command*>& cmds,
+                                     PipelineReply& reply)
+{
+    for (int n_redirects = 0; n_redirects < _MAX_REDIRECTS; n_redirects++) {
+        std::chrono::steady_clock::time_point observed =
+            std::chrono::steady_clock::now();
+
+        // Find the redirected commands; any other error fails the pipeline
+        std::vector<std::pair<size_t, Redirect>> redirected;
+        bool moved = false;
+        for (size_t i = 0; i < reply.size(); i++) {
+            CommandReply cmd_reply = reply[i];
+            if (cmd_reply.has_error() == 0)
+                continue;
+            Redirect redirect;
+            if (!_get_redirect(cmd_reply, redirect))
+                return false;
+            moved = moved || !redirect.ask;
+            redirected.push_back({i, redirect});
+        }
+        if (redirected.size() == 0)
+            return true;
+
+        // One refresh covers all of the moved slots
+        for (size_t i = 0; moved && i < redirected.size(); i++) {
+            if (!redirected[i].second.ask) {
+                _refresh_cluster_map(observed, redirected[i].second.slot);
+                break;
+            }
+        }
+
+        // Group the commands by the node they were redirected to
+        std::map<std::pair<std::string, bool>, std::vector<size_t>> groups;
+        for (size_t i = 0; i < redirected.size(); i++) {
+            const Redirect& redirect = redirected[i].second;
+            groups[{_get_redirect_prefix(redirect), redirect.ask}].push_back(
+                redirected[i].first);
+        }
+
+        // Run each group in a pipeline and splice the replies in
+        for (auto group = groups.begin(); group != groups.end(); group++) {
+            const std::string& prefix = group->first.first;
+            bool ask = group->first.second;
+            const std::vector<size_t>& indices = group->second;
+
+            sw::redis::Pipeline pipeline = _get_pipeline(prefix);
+            std::vector<std::pair<size_t, size_t>> index_map;
+            for (size_t j = 0; j < indices.size(); j++) {
+                if (ask)
+                    pipeline.command("ASKING");
+                pipeline.command(cmds[indices[j]]->cbegin(),
+                                 cmds[indices[j]]->cend());
+                index_map.push_back({indices[j], ask ? 2 * j + 1 : j});
+            }
+            reply.replace(PipelineReply(pipeline.exec()), index_map);
+        }
+    }
+    return !reply.has_error();
+}
+
 // Attaches a prefix and constant suffix to keys to enforce identical
 //  hash slot constraint
 std::vector<std::string>
@@ -1415,41 +1904,40 @@ void RedisCluster::_delete_keys(std::vector<std::string> keys)
     (void)run(cmd);
 }
 
-// Retrieve the optimum db node for model and script execution
-DBNode* RedisCluster::_get_model_script_db(std::vector<std::string>& inputs,
-                                           std::vector<std::string>& outputs)
+// Retrieve the prefix of the optimum db node for model and script execution
+std::string RedisCluster::_get_model_script_db(
+    std::vector<std::string>& inputs,
+    std::vector<std::string>& outputs)
 {
     /* This function determines which db node in the cluster
     contains the most input and output tensors and
-    returns a pointer to that db node.
+    returns the prefix of that db node.
     */
 
     // TODO we should randomly choose the max if there are multiple maxes
 
+    // The indices are only valid while the slot map is held
+    std::shared_lock<std::shared_mutex> lock(_slot_map_lock);
     std::vector<int> hash_slot_tally(_db_nodes.size(), 0);
 
     for (size_t i = 0; i < inputs.size(); i++) {
-        uint16_t hash_slot = _get_hash_slot(inputs[i]);
-        uint16_t db_index = _db_node_hash_search(hash_slot, 0, _db_nodes.size());
-        hash_slot_tally[db_index]++;
+        hash_slot_tally[_get_db_node_index(_get_hash_slot(inputs[i]))]++;
     }
 
     for (size_t i = 0; i < outputs.size(); i++) {
-        uint16_t hash_slot = _get_hash_slot(outputs[i]);
-        uint16_t db_index = _db_node_hash_search(hash_slot, 0, _db_nodes.size());
-        hash_slot_tally[db_index]++;
+        hash_slot_tally[_get_db_node_index(_get_hash_slot(outputs[i]))]++;
     }
 
     // Determine which DBNode has the most hashes
     int max_hash = -1;
-    DBNode* db = NULL;
+    std::string prefix;
     for (size_t i = 0; i < _db_nodes.size(); i++) {
         if (hash_slot_tally[i] > max_hash) {
             max_hash = hash_slot_tally[i];
-            db = &(_db_nodes[i]);
+            prefix = _db_nodes[i].prefix;
         }
     }
-    return db;
+    return prefix;
 }
 
 // Run a CommandList via a Pipeline
@@ -1458,7 +1946,7 @@ PipelineReply RedisCluster::run_in_pipeline(CommandList& cmdlist)
     // Convert from CommandList to vector and grab the shard along
     // the way
     std::vector<Command*> cmds;
-    std::string shard_prefix = _db_nodes[0].prefix;
+    std::string shard_prefix;
     bool shard_found = false;
     for (auto it = cmdlist.begin(); it != cmdlist.end(); ++it) {
         cmds.push_back(*it);
@@ -1467,6 +1955,8 @@ PipelineReply RedisCluster::run_in_pipeline(CommandList& cmdlist)
             shard_found = true;
         }
     }
+    if (!shard_found)
+        shard_prefix = _get_first_prefix();
 
     // Run the commands
     return _run_pipeline(cmds, shard_prefix);
@@ -1477,12 +1967,17 @@ PipelineReply RedisCluster::_run_pipeline(
     std::vector<Command*>& cmds,
     std::string& shard_prefix)
 {
+    // Serve reads from a replica when enabled, unless it cannot answer
     PipelineReply reply;
+    if (cmds.size() > 0 && _is_replica_read(*cmds[0]) &&
+        _run_pipeline_on_replica(cmds, reply)) {
+        return reply;
+    }
+
     for (int i = 1; i <= _command_attempts; i++) {
         try {
             // Get pipeline object for shard (no new connection)
-            sw::redis::Pipeline pipeline =
-                _redis_cluster->pipeline(shard_prefix, false);
+            sw::redis::Pipeline pipeline = _get_pipeline(shard_prefix);
 
             // Loop over all commands and add to the pipeline
             for (size_t i = 0; i < cmds.size(); i++) {
@@ -1493,8 +1988,8 @@ PipelineReply RedisCluster::_run_pipeline(
             // Execute the pipeline
             reply = pipeline.exec();
 
-            // Check the replies
-            if (reply.has_error()) {
+            // Check the replies, running redirected commands again
+            if (reply.has_error() && !_reroute_pipeline(cmds, reply)) {
                 throw SRRuntimeException("Redis failed to execute the pipeline");
             }
 
@@ -1512,7 +2007,13 @@ PipelineReply RedisCluster::_run_pipeline(
                     std::string("Redis IO error when executing the pipeline: ") +
                     e.what());
             }
-            // else, Fall through for a retry
+            // else, reroute in case of a failover and fall through for a retry
+            for (size_t c = 0; c < cmds.size(); c++) {
+                if (cmds[c]->has_keys()) {
+                    _reroute_after_failure(*cmds[c], shard_prefix);
+                    break;
+                }
+            }
         }
         catch (sw::redis::ClosedError &e) {
             // For an error from Redis, retry unless we're out of chances
@@ -1521,7 +2022,13 @@ PipelineReply RedisCluster::_run_pipeline(
                     std::string("Redis Closed error when executing the "\
                                 "pipeline: ") + e.what());
             }
-            // else, Fall through for a retry
+            // else, reroute in case of a failover and fall through for a retry
+            for (size_t c = 0; c < cmds.size(); c++) {
+                if (cmds[c]->has_keys()) {
+                    _reroute_after_failure(*cmds[c], shard_prefix);
+                    break;
+                }
+            }
         }
         catch (sw::redis::Error &e) {
             // For other errors from Redis, report them immediately
@@ -1549,11 +2056,116 @@ PipelineReply RedisCluster::_run_pipeline(
     throw SRTimeoutException("Unable to execute pipeline");
 }
 
+// Run a CommandList atomically in a MULTI/EXEC transaction
+PipelineReply RedisCluster::run_in_transaction(CommandList& cmdlist)
+{
+    // Convert from CommandList to vector and grab the shard along
+    // the way
+    std::vector<Command*> cmds;
+    std::string shard_prefix;
+    bool shard_found = false;
+    for (auto it = cmdlist.begin(); it != cmdlist.end(); ++it) {
+        cmds.push_back(*it);
+        if (!shard_found && (*it)->has_keys()) {
+            shard_prefix = _get_db_node_prefix(*(*it));
+            shard_found = true;
+        }
+    }
+    if (!shard_found)
+        shard_prefix = _get_first_prefix();
+
+    // Run the commands
+    return _run_transaction(cmds, shard_prefix);
+}
+
+// Build and run a MULTI/EXEC transaction on a single shard
+PipelineReply RedisCluster::_run_transaction(
+    std::vector<Command*>& cmds,
+    std::string& shard_prefix)
+{
+    PipelineReply reply;
+    for (int i = 1; i <= _command_attempts; i++) {
+        try {
+            // Get transaction object for shard (not piped, no new connection)
+            sw::redis::Redis* local = _get_uds_connection(shard_prefix);
+            sw::redis::Transaction transaction = (local != NULL) ?
+                local->transaction(false, false) :
+                _redis_cluster->transaction(shard_prefix, false, false);
+
+            // Loop over all commands and queue them in the transaction
+            for (size_t i = 0; i < cmds.size(); i++) {
+                transaction.command(cmds[i]->cbegin(), cmds[i]->cend());
+            }
+
+            // Execute the transaction
+            reply = transaction.exec();
+
+            // Check the replies
+            if (reply.has_error()) {
+                throw SRRuntimeException("Redis failed to execute the transaction");
+            }
+
+            // If we get here, it all worked
+            return reply;
+        }
+        catch (SmartRedis::Exception& e) {
+            // Exception is already prepared, just propagate it
+            throw;
+        }
+        catch (sw::redis::IoError &e) {
+            // For an error from Redis, retry unless we're out of chances
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis IO error when executing the transaction: ") +
+                    e.what());
+            }
+            // else, Fall through for a retry
+        }
+        catch (sw::redis::ClosedError &e) {
+            // For an error from Redis, retry unless we're out of chances
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis Closed error when executing the "\
+                                "transaction: ") + e.what());
+            }
+            // else, Fall through for a retry
+        }
+        catch (sw::redis::Error &e) {
+            // For other errors from Redis (including a transaction aborted
+            // by EXECABORT), report them immediately
+            throw SRRuntimeException(
+                std::string("Redis error when executing the transaction: ") +
+                    e.what());
+        }
+        catch (std::exception& e) {
+            // Should never hit this, so bail immediately if we do
+            throw SRInternalException(
+                std::string("Unexpected exception executing the transaction: ") +
+                    e.what());
+        }
+        catch (...) {
+            // Should never hit this, so bail immediately if we do
+            throw SRInternalException(
+                "Non-standard exception encountered executing the transaction");
+        }
+
+        // Sleep before the next attempt
+        std::this_thread::sleep_for(std::chrono::milliseconds(_command_interval));
+    }
+
+    // If we get here, we've run out of retry attempts
+    throw SRTimeoutException("Unable to execute transaction");
+}
+
 // Create a string representation of the Redis connection
 std::string RedisCluster::to_string() const
 {
     std::string result("Clustered Redis connection:\n");
     result += RedisServer::to_string();
+    for (auto it = _uds_connections.begin(); it != _uds_connections.end(); it++) {
+        result += "  Shard " + it->first + " reached through " +
+                  it->second.address.to_string() + "\n";
+    }
     return result;
 }
 
@@ -62,7 +62,7 @@ RedisServer::RedisServer(ConfigOptions* cfgopts)
     _command_attempts = (_command_timeout * 1000) /
                          _command_interval + 1;
 
-    _tp = new ThreadPool(_context, _thread_count);
+    _tp = NULL;
     _model_chunk_size = _UNKNOWN_MODEL_CHUNK_SIZE;
 }
 
@@ -70,14 +70,38 @@ RedisServer::RedisServer(ConfigOptions* cfgopts)
 RedisServer::~RedisServer()
 {
     // Terminate the thread pool
-    _tp->shutdown();
-    delete _tp;
+    if (_tp != NULL) {
+        _tp->shutdown();
+        delete _tp;
+    }
+}
+
+// Get the thread pool, creating it on first use
+ThreadPool* RedisServer::_get_thread_pool()
+{
+    std::call_once(_tp_created, [this]() {
+        _tp = new ThreadPool(_context, _thread_count);
+    });
+    return _tp;
 }
 
 
 // Retrieve a single address, randomly chosen from a list of addresses if
 // applicable, from the SSDB environment variable
 SRAddress RedisServer::_get_ssdb()
+{
+    std::vector<SRAddress> address_choices = _get_ssdb_addresses();
+
+    // Pick an entry from the list at random
+    std::uniform_int_distribution<> distrib(0, address_choices.size() - 1);
+    auto choice = address_choices[distrib(_gen)];
+    _cfgopts->_get_log_context()->log_data(
+        LLDeveloper, "Picked: " + choice.to_string());
+    return choice;
+}
+
+// Retrieve all of the addresses listed in the SSDB environment variable
+std::vector<SRAddress> RedisServer::_get_ssdb_addresses()
 {
     // Retrieve the environment variable
     std::string db_spec = _cfgopts->_resolve_string_option("SSDB", "");
@@ -112,13 +136,7 @@ SRAddress RedisServer::_get_ssdb()
         _cfgopts->_get_log_context()->log_data(
             LLDeveloper, "\t" + address_choices[i].to_string());
     }
-
-    // Pick an entry from the list at random
-    std::uniform_int_distribution<> distrib(0, address_choices.size() - 1);
-    auto choice = address_choices[distrib(_gen)];
-    _cfgopts->_get_log_context()->log_data(
-        LLDeveloper, "Picked: " + choice.to_string());
-    return choice;
+    return address_choices;
 }
 
 // Check that the SSDB environment variable value does not have any errors
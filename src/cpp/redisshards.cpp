@@ -0,0 +1,741 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <unordered_set>
+#include "redisshards.h"
+#include "srexception.h"
+#include "utility.h"
+
+using namespace SmartRedis;
+
+// 64-bit FNV-1a hash.  Unlike std::hash, it is the same on every
+// platform, so clients on different nodes agree on the key placement.
+static uint64_t _fnv1a(std::string_view data)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Spread the bits of a 64-bit value over the ring (splitmix64 finalizer)
+static uint64_t _mix(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+// RedisShards constructor
+RedisShards::RedisShards(ConfigOptions* cfgopts)
+    : RedisServer(cfgopts)
+{
+    // Place the hash slots on the listed servers
+    _shard_addresses = _get_ssdb_addresses();
+    std::vector<std::string> shard_names;
+    _is_domain_socket = true;
+    for (size_t s = 0; s < _shard_addresses.size(); s++) {
+        shard_names.push_back(_shard_addresses[s].to_string());
+        _address_node_map.insert({shard_names[s], nullptr});
+        _is_domain_socket = _is_domain_socket && !_shard_addresses[s]._is_tcp;
+    }
+    _slot_shards = map_hash_slots(shard_names);
+
+    // Connect to each of them
+    for (size_t s = 0; s < shard_names.size(); s++)
+        _shards.push_back(std::make_unique<Redis>(cfgopts, shard_names[s]));
+
+    // Find a hash tag that places keys on each shard, for the temporary
+    // keys of model and script execution
+    _shard_prefixes.resize(_shards.size());
+    size_t n_found = 0;
+    for (uint64_t i = 0; n_found < _shards.size() && i < (1 << 20); i++) {
+        std::string prefix = std::to_string(i);
+        std::string& shard_prefix =
+            _shard_prefixes[_slot_shards[Command::get_hash_slot(prefix)]];
+        if (shard_prefix.size() == 0) {
+            shard_prefix = prefix;
+            n_found++;
+        }
+    }
+}
+
+// Assign the hash slots to shards on a consistent hash ring
+std::vector<uint16_t> RedisShards::map_hash_slots(
+    const std::vector<std::string>& shard_names)
+{
+    if (shard_names.size() == 0 || shard_names.size() > UINT16_MAX) {
+        throw SRParameterException("Between 1 and " +
+                                   std::to_string(UINT16_MAX) +
+                                   " shards are supported, not " +
+                                   std::to_string(shard_names.size()));
+    }
+    std::unordered_set<std::string> unique_names(shard_names.begin(),
+                                                 shard_names.end());
+    if (unique_names.size() != shard_names.size())
+        throw SRParameterException("A shard is listed more than once");
+
+    // Place each shard at several points of the ring
+    std::vector<std::pair<uint64_t, uint16_t>> ring;
+    ring.reserve(shard_names.size() * _RING_POINTS_PER_SHARD);
+    for (size_t s = 0; s < shard_names.size(); s++) {
+        uint64_t name_hash = _fnv1a(shard_names[s]);
+        for (size_t p = 0; p < _RING_POINTS_PER_SHARD; p++)
+            ring.push_back({_mix(name_hash + p), (uint16_t)s});
+    }
+    std::sort(ring.begin(), ring.end());
+
+    // Each hash slot goes to the shard at the next point of the ring
+    std::vector<uint16_t> slot_shards(_N_HASH_SLOTS);
+    for (size_t slot = 0; slot < _N_HASH_SLOTS; slot++) {
+        auto point = std::lower_bound(
+            ring.begin(), ring.end(), std::make_pair(_mix(slot), (uint16_t)0));
+        if (point == ring.end())
+            point = ring.begin();
+        slot_shards[slot] = point->second;
+    }
+    return slot_shards;
+}
+
+// Run a single-key Command on the shard holding its key
+CommandReply RedisShards::run(SingleKeyCommand& cmd)
+{
+    return _shards[_get_shard_index(cmd)]->run(cmd);
+}
+
+// Run a multi-key Command on the shard holding its keys
+CommandReply RedisShards::run(MultiKeyCommand& cmd)
+{
+    return _shards[_get_shard_index(cmd)]->run(cmd);
+}
+
+// Run a compound Command on the shard holding its keys
+CommandReply RedisShards::run(CompoundCommand& cmd)
+{
+    return _shards[_get_shard_index(cmd)]->run(cmd);
+}
+
+// Run an address-at Command on the shard at the address
+CommandReply RedisShards::run(AddressAtCommand& cmd)
+{
+    return _shards[_get_shard_index(cmd.get_address())]->run(cmd);
+}
+
+// Run an address-any Command on the first shard
+CommandReply RedisShards::run(AddressAnyCommand& cmd)
+{
+    return _shards[0]->run(cmd);
+}
+
+// Run an address-all Command on every shard
+CommandReply RedisShards::run(AddressAllCommand& cmd)
+{
+    CommandReply reply;
+    for (size_t s = 0; s < _shards.size(); s++) {
+        reply = _shards[s]->run(cmd);
+        if (reply.has_error() > 0)
+            break; // Short-circuit failure on error
+    }
+    return reply;
+}
+
+// Run a Command list on the shards
+std::vector<CommandReply> RedisShards::run(CommandList& cmds)
+{
+    std::vector<CommandReply> replies;
+    CommandList::iterator cmd = cmds.begin();
+    for ( ; cmd != cmds.end(); cmd++) {
+        replies.push_back(dynamic_cast<Command*>(*cmd)->run_me(this));
+    }
+    return replies;
+}
+
+// Run Commands in one pipeline per shard
+PipelineReply RedisShards::run_via_unordered_pipelines(CommandList& cmd_list)
+{
+    std::vector<Command*> cmds(cmd_list.begin(), cmd_list.end());
+    return _run_shard_pipelines(cmds);
+}
+
+// Check if a model or script key exists in the database
+bool RedisShards::model_key_exists(const std::string& key)
+{
+    return key_exists(key);
+}
+
+// Check if a key exists in the database
+bool RedisShards::key_exists(const std::string& key)
+{
+    return _shards[_get_shard_index(key)]->key_exists(key);
+}
+
+// Check if a hash field exists in the database
+bool RedisShards::hash_field_exists(const std::string& key,
+                                    const std::string& field)
+{
+    return _shards[_get_shard_index(key)]->hash_field_exists(key, field);
+}
+
+// Check if address is valid
+bool RedisShards::is_addressable(const SRAddress& address) const
+{
+    return _address_node_map.find(address.to_string()) !=
+        _address_node_map.end();
+}
+
+// Put a Tensor on the shard holding its key
+CommandReply RedisShards::put_tensor(TensorBase& tensor)
+{
+    return _shards[_get_shard_index(tensor.name())]->put_tensor(tensor);
+}
+
+// Get a Tensor from the shard holding its key
+CommandReply RedisShards::get_tensor(const std::string& key)
+{
+    return _shards[_get_shard_index(key)]->get_tensor(key);
+}
+
+// Get a list of Tensor from the shards
+PipelineReply RedisShards::get_tensors(const std::vector<std::string>& keys)
+{
+    // Build up the commands to get the tensors
+    CommandList cmdlist; // This just holds the memory
+    std::vector<Command*> cmds;
+    for (auto it = keys.begin(); it != keys.end(); ++it) {
+        GetTensorCommand* cmd = cmdlist.add_command<GetTensorCommand>();
+        (*cmd) << "AI.TENSORGET" << Keyfield(*it) << "META" << "BLOB";
+        cmds.push_back(cmd);
+    }
+
+    // Run them via pipelines
+    return _run_shard_pipelines(cmds);
+}
+
+// Rename a tensor in the database
+CommandReply RedisShards::rename_tensor(const std::string& key,
+                                        const std::string& new_key)
+{
+    // RENAME only works within a shard
+    size_t shard = _get_shard_index(key);
+    if (shard == _get_shard_index(new_key))
+        return _shards[shard]->rename_tensor(key, new_key);
+
+    CommandReply reply = copy_tensor(key, new_key);
+    (void)delete_tensor(key);
+    return reply;
+}
+
+// Delete a tensor in the database
+CommandReply RedisShards::delete_tensor(const std::string& key)
+{
+    return _shards[_get_shard_index(key)]->delete_tensor(key);
+}
+
+// Copy a tensor from the source key to the destination key
+CommandReply RedisShards::copy_tensor(const std::string& src_key,
+                                      const std::string& dest_key)
+{
+    size_t src_shard = _get_shard_index(src_key);
+    size_t dest_shard = _get_shard_index(dest_key);
+    if (src_shard == dest_shard)
+        return _shards[src_shard]->copy_tensor(src_key, dest_key);
+
+    // Fetch the tensor from the source shard
+    GetTensorCommand cmd_get;
+    cmd_get << "AI.TENSORGET" << Keyfield(src_key) << "META" << "BLOB";
+    CommandReply cmd_get_reply = _shards[src_shard]->run(cmd_get);
+    if (cmd_get_reply.has_error() > 0) {
+        throw SRRuntimeException("Failed to retrieve tensor " +
+                                 src_key + "from database");
+    }
+
+    // Decode the tensor
+    std::vector<size_t> dims = cmd_get.get_dims(cmd_get_reply);
+    std::string_view blob = cmd_get.get_data_blob(cmd_get_reply);
+    SRTensorType type = cmd_get.get_data_type(cmd_get_reply);
+
+    // Send it to the destination shard under the new key
+    SingleKeyCommand cmd_put;
+    cmd_put << "AI.TENSORSET" << Keyfield(dest_key) << TENSOR_STR_MAP.at(type)
+            << dims << "BLOB" << blob;
+    return _shards[dest_shard]->run(cmd_put);
+}
+
+// Copy a vector of tensors from source keys to destination keys
+CommandReply RedisShards::copy_tensors(const std::vector<std::string>& src,
+                                       const std::vector<std::string>& dest)
+{
+    // Make sure vectors are the same length
+    if (src.size() != dest.size()) {
+        throw SRRuntimeException("differing size vectors "\
+                                 "passed to copy_tensors");
+    }
+
+    // Copy tensors one at a time
+    CommandReply reply;
+    for (size_t i = 0; i < src.size(); i++) {
+        reply = copy_tensor(src[i], dest[i]);
+        if (reply.has_error() > 0) {
+            throw SRRuntimeException("tensor copy failed");
+        }
+    }
+    return reply;
+}
+
+// Set a model on every shard, so that it can run next to its inputs
+CommandReply RedisShards::set_model(const std::string& model_name,
+                                    const std::vector<std::string_view>& model,
+                                    const std::string& backend,
+                                    const std::string& device,
+                                    int batch_size,
+                                    int min_batch_size,
+                                    int min_batch_timeout,
+                                    const std::string& tag,
+                                    const std::vector<std::string>& inputs,
+                                    const std::vector<std::string>& outputs)
+{
+    CommandReply reply;
+    for (size_t s = 0; s < _shards.size(); s++) {
+        reply = _shards[s]->set_model(
+            model_name, model, backend, device, batch_size, min_batch_size,
+            min_batch_timeout, tag, inputs, outputs);
+        if (reply.has_error() > 0)
+            break;
+    }
+    return reply;
+}
+
+// Set a model on every shard for execution in a multi-GPU system
+void RedisShards::set_model_multigpu(const std::string& name,
+                                     const std::vector<std::string_view>& model,
+                                     const std::string& backend,
+                                     int first_gpu,
+                                     int num_gpus,
+                                     int batch_size,
+                                     int min_batch_size,
+                                     int min_batch_timeout,
+                                     const std::string& tag,
+                                     const std::vector<std::string>& inputs,
+                                     const std::vector<std::string>& outputs)
+{
+    for (size_t s = 0; s < _shards.size(); s++) {
+        _shards[s]->set_model_multigpu(
+            name, model, backend, first_gpu, num_gpus, batch_size,
+            min_batch_size, min_batch_timeout, tag, inputs, outputs);
+    }
+}
+
+// Set a script on every shard, so that it can run next to its inputs
+CommandReply RedisShards::set_script(const std::string& key,
+                                     const std::string& device,
+                                     std::string_view script)
+{
+    CommandReply reply;
+    for (size_t s = 0; s < _shards.size(); s++) {
+        reply = _shards[s]->set_script(key, device, script);
+        if (reply.has_error() > 0)
+            break;
+    }
+    return reply;
+}
+
+// Set a script on every shard for execution in a multi-GPU system
+void RedisShards::set_script_multigpu(const std::string& name,
+                                      const std::string_view& script,
+                                      int first_gpu,
+                                      int num_gpus)
+{
+    for (size_t s = 0; s < _shards.size(); s++)
+        _shards[s]->set_script_multigpu(name, script, first_gpu, num_gpus);
+}
+
+// Run a model on the shard holding its first input
+CommandReply RedisShards::run_model(const std::string& key,
+                                    std::vector<std::string> inputs,
+                                    std::vector<std::string> outputs)
+{
+    return _run_on_input_shard(inputs, outputs,
+        [&key](Redis& shard, const std::vector<std::string>& shard_inputs,
+               const std::vector<std::string>& shard_outputs) {
+            return shard.run_model(key, shard_inputs, shard_outputs);
+        });
+}
+
+// Run a model in the database using the
+// specified input and output tensors in a multi-GPU system
+void RedisShards::run_model_multigpu(const std::string& name,
+                                     std::vector<std::string> inputs,
+                                     std::vector<std::string> outputs,
+                                     int offset,
+                                     int first_gpu,
+                                     int num_gpus)
+{
+    int gpu = first_gpu + _modulo(offset, num_gpus);
+    std::string device = "GPU:" + std::to_string(gpu);
+    CommandReply result = run_model(name + "." + device, inputs, outputs);
+    if (result.has_error() > 0) {
+        throw SRRuntimeException(
+            "An error occured while executing the model on " + device);
+    }
+}
+
+// Run a script function on the shard holding its first input
+CommandReply RedisShards::run_script(const std::string& key,
+                                     const std::string& function,
+                                     std::vector<std::string> inputs,
+                                     std::vector<std::string> outputs)
+{
+    return _run_on_input_shard(inputs, outputs,
+        [&key, &function](Redis& shard,
+                          const std::vector<std::string>& shard_inputs,
+                          const std::vector<std::string>& shard_outputs) {
+            return shard.run_script(key, function, shard_inputs,
+                                    shard_outputs);
+        });
+}
+
+// Use multiple GPUs to run a script function in the database using the
+// specified input and output tensors
+void RedisShards::run_script_multigpu(const std::string& name,
+                                      const std::string& function,
+                                      std::vector<std::string>& inputs,
+                                      std::vector<std::string>& outputs,
+                                      int offset,
+                                      int first_gpu,
+                                      int num_gpus)
+{
+    int gpu = first_gpu + _modulo(offset, num_gpus);
+    std::string device = "GPU:" + std::to_string(gpu);
+    CommandReply result = run_script(
+        name + "." + device, function, inputs, outputs);
+    if (result.has_error() > 0) {
+        throw SRRuntimeException(
+            "An error occured while executing the script on " + device);
+    }
+}
+
+// Delete a model from every shard
+CommandReply RedisShards::delete_model(const std::string& key)
+{
+    CommandReply reply;
+    for (size_t s = 0; s < _shards.size(); s++) {
+        reply = _shards[s]->delete_model(key);
+        if (reply.has_error() > 0)
+            break;
+    }
+    return reply;
+}
+
+// Remove a model stored for use with multiple GPUs from every shard
+void RedisShards::delete_model_multigpu(
+    const std::string& name, int first_gpu, int num_gpus)
+{
+    for (size_t s = 0; s < _shards.size(); s++)
+        _shards[s]->delete_model_multigpu(name, first_gpu, num_gpus);
+}
+
+// Delete a script from every shard
+CommandReply RedisShards::delete_script(const std::string& key)
+{
+    CommandReply reply;
+    for (size_t s = 0; s < _shards.size(); s++) {
+        reply = _shards[s]->delete_script(key);
+        if (reply.has_error() > 0)
+            break;
+    }
+    return reply;
+}
+
+// Remove a script stored for use with multiple GPUs from every shard
+void RedisShards::delete_script_multigpu(
+    const std::string& name, int first_gpu, int num_gpus)
+{
+    for (size_t s = 0; s < _shards.size(); s++)
+        _shards[s]->delete_script_multigpu(name, first_gpu, num_gpus);
+}
+
+// Retrieve the model from the database
+CommandReply RedisShards::get_model(const std::string& key)
+{
+    return _shards[_get_shard_index(key)]->get_model(key);
+}
+
+// Retrieve the script from the database
+CommandReply RedisShards::get_script(const std::string& key)
+{
+    return _shards[_get_shard_index(key)]->get_script(key);
+}
+
+// Retrieve the model and script AI.INFO from the shard at an address
+CommandReply RedisShards::get_model_script_ai_info(const std::string& address,
+                                                   const std::string& key,
+                                                   const bool reset_stat)
+{
+    SRAddress db_address(address);
+    return _shards[_get_shard_index(db_address)]->get_model_script_ai_info(
+        address, key, reset_stat);
+}
+
+// Retrieve the current model chunk size
+int RedisShards::get_model_chunk_size()
+{
+    // If we've already set a chunk size, just return it
+    if (_model_chunk_size != _UNKNOWN_MODEL_CHUNK_SIZE)
+        return _model_chunk_size;
+    return _shards[0]->get_model_chunk_size();
+}
+
+// Reconfigure the model chunk size on every shard
+void RedisShards::set_model_chunk_size(int chunk_size)
+{
+    for (size_t s = 0; s < _shards.size(); s++)
+        _shards[s]->set_model_chunk_size(chunk_size);
+
+    // Store the new model chunk size for later
+    _model_chunk_size = chunk_size;
+}
+
+// Run a CommandList via one Pipeline per shard
+PipelineReply RedisShards::run_in_pipeline(CommandList& cmdlist)
+{
+    std::vector<Command*> cmds(cmdlist.begin(), cmdlist.end());
+    return _run_shard_pipelines(cmds);
+}
+
+// Run a CommandList atomically in a MULTI/EXEC transaction
+PipelineReply RedisShards::run_in_transaction(CommandList& cmdlist)
+{
+    // A transaction cannot span shards
+    size_t shard = 0;
+    bool shard_found = false;
+    for (auto it = cmdlist.begin(); it != cmdlist.end(); ++it) {
+        if ((*it)->get_key_count() == 0)
+            continue;
+        size_t cmd_shard = _get_shard_index(**it);
+        if (shard_found && cmd_shard != shard) {
+            throw SRRuntimeException("The keys of a transaction must be "\
+                                     "held by one shard; give them a "\
+                                     "common hash tag");
+        }
+        shard = cmd_shard;
+        shard_found = true;
+    }
+    return _shards[shard]->run_in_transaction(cmdlist);
+}
+
+// Create a string representation of the sharded Redis connection
+std::string RedisShards::to_string() const
+{
+    std::string result("Sharded Redis connection:\n");
+    result += RedisServer::to_string();
+    return result;
+}
+
+// Get the index of the shard holding a key
+size_t RedisShards::_get_shard_index(const std::string& key)
+{
+    return _slot_shards[Command::get_hash_slot(key)];
+}
+
+// Get the index of the shard holding the keys of a Command
+size_t RedisShards::_get_shard_index(const Command& cmd)
+{
+    size_t n_keys = cmd.get_key_count();
+    if (n_keys == 0)
+        return 0;
+
+    size_t shard = _slot_shards[cmd.get_key_hash_slot(0)];
+    for (size_t i = 1; i < n_keys; i++) {
+        if (_slot_shards[cmd.get_key_hash_slot(i)] != shard) {
+            throw SRRuntimeException("The keys of command " +
+                                     cmd.first_field() + " are held by "\
+                                     "different shards; give them a "\
+                                     "common hash tag");
+        }
+    }
+    return shard;
+}
+
+// Get the index of the shard at an address
+size_t RedisShards::_get_shard_index(const SRAddress& address)
+{
+    for (size_t s = 0; s < _shard_addresses.size(); s++) {
+        if (_shard_addresses[s] == address)
+            return s;
+    }
+    throw SRRuntimeException("No shard was found at address " +
+                             address.to_string());
+}
+
+// Run Commands in one pipeline per shard, in parallel
+PipelineReply RedisShards::_run_shard_pipelines(std::vector<Command*>& cmds)
+{
+    if (cmds.size() == 0)
+        return PipelineReply();
+
+    // Group the Commands by shard, remembering their positions
+    size_t n_shards = _shards.size();
+    std::vector<std::vector<Command*>> shard_cmds(n_shards);
+    std::vector<std::vector<size_t>> shard_cmd_indices(n_shards);
+    for (size_t i = 0; i < cmds.size(); i++) {
+        size_t shard = _get_shard_index(*cmds[i]);
+        shard_cmds[shard].push_back(cmds[i]);
+        shard_cmd_indices[shard].push_back(i);
+    }
+
+    // Commands for a single shard need no thread pool
+    size_t n_pending = 0;
+    for (size_t s = 0; s < n_shards; s++) {
+        if (shard_cmds[s].size() == cmds.size())
+            return _shards[s]->_run_pipeline(cmds);
+        n_pending += (shard_cmds[s].size() > 0);
+    }
+
+    // Run the pipeline of each shard on the thread pool
+    std::vector<PipelineReply> shard_replies(n_shards);
+    std::vector<std::exception_ptr> shard_errors(n_shards);
+    std::mutex results_mutex;
+    std::condition_variable all_done;
+    ThreadPool* tp = _get_thread_pool();
+    for (size_t s = 0; s < n_shards; s++) {
+        if (shard_cmds[s].size() == 0)
+            continue;
+        tp->submit_job([this, s, &shard_cmds, &shard_replies, &shard_errors,
+                        &results_mutex, &all_done, &n_pending]()
+        {
+            PipelineReply reply;
+            std::exception_ptr error;
+            try {
+                reply = _shards[s]->_run_pipeline(shard_cmds[s]);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+
+            std::unique_lock<std::mutex> results_lock(results_mutex);
+            shard_replies[s] = std::move(reply);
+            shard_errors[s] = error;
+            if (--n_pending == 0)
+                all_done.notify_one();
+        });
+    }
+
+    // Wait until all jobs have finished
+    {
+        std::unique_lock<std::mutex> results_lock(results_mutex);
+        all_done.wait(results_lock, [&n_pending]() { return n_pending == 0; });
+    }
+
+    // Throw an exception if one was generated in processing the threads
+    for (size_t s = 0; s < n_shards; s++) {
+        if (shard_errors[s])
+            std::rethrow_exception(shard_errors[s]);
+    }
+
+    // Put the replies back in the order of the Commands
+    PipelineReply all_replies;
+    std::vector<size_t> cmd_index_order;
+    cmd_index_order.reserve(cmds.size());
+    for (size_t s = 0; s < n_shards; s++) {
+        all_replies += std::move(shard_replies[s]);
+        cmd_index_order.insert(cmd_index_order.end(),
+                               shard_cmd_indices[s].begin(),
+                               shard_cmd_indices[s].end());
+    }
+    all_replies.reorder(cmd_index_order);
+    return all_replies;
+}
+
+// Run a model or script on the shard holding its first input
+CommandReply RedisShards::_run_on_input_shard(
+    const std::vector<std::string>& inputs,
+    const std::vector<std::string>& outputs,
+    const std::function<CommandReply(Redis&,
+        const std::vector<std::string>&,
+        const std::vector<std::string>&)>& run)
+{
+    size_t shard = 0;
+    if (inputs.size() > 0)
+        shard = _get_shard_index(inputs[0]);
+    else if (outputs.size() > 0)
+        shard = _get_shard_index(outputs[0]);
+
+    // Run in place when the shard holds all of the tensors
+    bool in_place = true;
+    for (size_t i = 0; i < inputs.size(); i++)
+        in_place = in_place && _get_shard_index(inputs[i]) == shard;
+    for (size_t i = 0; i < outputs.size(); i++)
+        in_place = in_place && _get_shard_index(outputs[i]) == shard;
+    if (in_place)
+        return run(*_shards[shard], inputs, outputs);
+
+    // Otherwise, copy the tensors through temporary keys on the shard
+    if (_shard_prefixes[shard].size() == 0)
+        throw SRInternalException("No hash tag was found for shard " +
+                                  _shard_addresses[shard].to_string());
+    std::vector<std::string> tmp_inputs;
+    std::vector<std::string> tmp_outputs;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        tmp_inputs.push_back(
+            "{" + _shard_prefixes[shard] + "}." + inputs[i] + ".TMP");
+    }
+    for (size_t i = 0; i < outputs.size(); i++) {
+        tmp_outputs.push_back(
+            "{" + _shard_prefixes[shard] + "}." + outputs[i] + ".TMP");
+    }
+    MultiKeyCommand cleanup_cmd;
+    cleanup_cmd << "DEL";
+    cleanup_cmd.add_keys(tmp_inputs);
+    cleanup_cmd.add_keys(tmp_outputs);
+
+    // Outputs are only copied back from a successful run, and the temp
+    // keys are cleaned up whether or not it succeeds
+    CommandReply reply;
+    try {
+        copy_tensors(inputs, tmp_inputs);
+        reply = run(*_shards[shard], tmp_inputs, tmp_outputs);
+        if (reply.has_error() == 0)
+            copy_tensors(tmp_outputs, outputs);
+    }
+    catch (...) {
+        try {
+            (void)_shards[shard]->run(cleanup_cmd);
+        }
+        catch (...) {
+            // Report the original error rather than the cleanup error
+        }
+        throw;
+    }
+    (void)_shards[shard]->run(cleanup_cmd);
+    return reply;
+}
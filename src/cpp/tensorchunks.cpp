@@ -0,0 +1,400 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include "tensorchunks.h"
+#include "srexception.h"
+
+using namespace SmartRedis;
+
+// Fixed-size header of a serialized manifest. The tensor dimensions
+// follow as uint64_t values.
+struct ChunkManifestHeader {
+    char magic[8];
+    uint32_t type;
+    uint32_t n_dims;
+    uint64_t total_bytes;
+    uint64_t chunk_size;
+    uint64_t generation;
+};
+
+static const char _CHUNK_MAGIC[8] = {'S', 'R', 'C', 'H', 'U', 'N', 'K', '1'};
+static const size_t _CHUNK_MAX_DIMS = 255;
+
+// Pick a generation number for the keys of a new put
+static uint64_t _new_generation()
+{
+    std::random_device source;
+    return ((uint64_t)source() << 32) ^ (uint64_t)source();
+}
+
+const size_t ChunkManifest::max_packed_size =
+    sizeof(ChunkManifestHeader) + _CHUNK_MAX_DIMS * sizeof(uint64_t);
+
+// ChunkManifest constructor for a new put
+ChunkManifest::ChunkManifest(SRTensorType type,
+                             const std::vector<size_t>& dims,
+                             uint64_t total_bytes,
+                             uint64_t chunk_size)
+    : type(type), dims(dims), total_bytes(total_bytes),
+      chunk_size(chunk_size)
+{
+    if (chunk_size == 0)
+        throw SRParameterException("The chunk size must be positive.");
+    if (dims.size() > _CHUNK_MAX_DIMS)
+        throw SRParameterException("Too many dimensions to store in chunks.");
+    generation = _new_generation();
+}
+
+// Get the number of chunks
+size_t ChunkManifest::n_chunks() const
+{
+    return (size_t)((total_bytes + chunk_size - 1) / chunk_size);
+}
+
+// Get the key of a chunk
+std::string ChunkManifest::chunk_key(const std::string& key,
+                                     size_t index) const
+{
+    char suffix[48];
+    std::snprintf(suffix, sizeof(suffix), ".chunk.%016llx.%zu",
+                  (unsigned long long)generation, index);
+    return key + suffix;
+}
+
+// Get the keys of all chunks
+std::vector<std::string> ChunkManifest::part_keys(const std::string& key) const
+{
+    std::vector<std::string> keys(n_chunks());
+    for (size_t i = 0; i < keys.size(); i++)
+        keys[i] = chunk_key(key, i);
+    return keys;
+}
+
+// Get the byte offset of a chunk in the tensor data
+uint64_t ChunkManifest::chunk_offset(size_t index) const
+{
+    return index * chunk_size;
+}
+
+// Get the size of a chunk
+uint64_t ChunkManifest::chunk_bytes(size_t index) const
+{
+    uint64_t offset = chunk_offset(index);
+    return std::min(chunk_size, total_bytes - offset);
+}
+
+// Serialize the manifest
+std::string ChunkManifest::pack() const
+{
+    ChunkManifestHeader header;
+    std::memcpy(header.magic, _CHUNK_MAGIC, sizeof(header.magic));
+    header.type = (uint32_t)type;
+    header.n_dims = (uint32_t)dims.size();
+    header.total_bytes = total_bytes;
+    header.chunk_size = chunk_size;
+    header.generation = generation;
+
+    std::string buf((const char*)&header, sizeof(header));
+    for (size_t i = 0; i < dims.size(); i++) {
+        uint64_t dim = dims[i];
+        buf.append((const char*)&dim, sizeof(dim));
+    }
+    return buf;
+}
+
+// Check whether a buffer holds a serialized manifest
+bool ChunkManifest::is_manifest(std::string_view buf)
+{
+    return buf.size() >= sizeof(ChunkManifestHeader) &&
+           std::memcmp(buf.data(), _CHUNK_MAGIC, sizeof(_CHUNK_MAGIC)) == 0;
+}
+
+// Deserialize a manifest
+ChunkManifest ChunkManifest::unpack(std::string_view buf)
+{
+    if (!is_manifest(buf))
+        throw SRRuntimeException("The buffer is not a chunk manifest.");
+    ChunkManifestHeader header;
+    std::memcpy(&header, buf.data(), sizeof(header));
+    if (header.n_dims > _CHUNK_MAX_DIMS || header.chunk_size == 0 ||
+        buf.size() != sizeof(header) + header.n_dims * sizeof(uint64_t)) {
+        throw SRRuntimeException("The chunk manifest is malformed.");
+    }
+
+    ChunkManifest manifest;
+    manifest.type = (SRTensorType)header.type;
+    manifest.total_bytes = header.total_bytes;
+    manifest.chunk_size = header.chunk_size;
+    manifest.generation = header.generation;
+    manifest.dims.resize(header.n_dims);
+    for (size_t i = 0; i < manifest.dims.size(); i++) {
+        uint64_t dim;
+        std::memcpy(&dim, buf.data() + sizeof(header) + i * sizeof(dim),
+                    sizeof(dim));
+        manifest.dims[i] = dim;
+    }
+    return manifest;
+}
+
+// Fixed-size header of a serialized tile manifest. The tensor
+// dimensions follow as uint64_t values, then the tile dimensions.
+struct TileManifestHeader {
+    char magic[8];
+    uint32_t type;
+    uint32_t n_dims;
+    uint64_t generation;
+};
+
+static const char _TILE_MAGIC[8] = {'S', 'R', 'T', 'I', 'L', 'E', 'S', '1'};
+
+const size_t TileManifest::max_packed_size =
+    sizeof(TileManifestHeader) + 2 * _CHUNK_MAX_DIMS * sizeof(uint64_t);
+
+// TileManifest constructor for a new put
+TileManifest::TileManifest(SRTensorType type,
+                           const std::vector<size_t>& dims,
+                           const std::vector<size_t>& tile_dims)
+    : type(type), dims(dims), tile_dims(tile_dims)
+{
+    if (tile_dims.size() != dims.size()) {
+        throw SRParameterException("The tile dimensions must have the "\
+                                   "same rank as the tensor.");
+    }
+    if (dims.size() > _CHUNK_MAX_DIMS)
+        throw SRParameterException("Too many dimensions to store in tiles.");
+    for (size_t i = 0; i < tile_dims.size(); i++) {
+        if (tile_dims[i] == 0)
+            throw SRParameterException("Tile dimensions must be positive.");
+    }
+    generation = _new_generation();
+}
+
+// Get the number of tiles
+size_t TileManifest::n_tiles() const
+{
+    size_t n = 1;
+    for (size_t i = 0; i < dims.size(); i++)
+        n *= (dims[i] + tile_dims[i] - 1) / tile_dims[i];
+    return n;
+}
+
+// Get the key of a tile
+std::string TileManifest::tile_key(const std::string& key,
+                                   size_t index) const
+{
+    char suffix[48];
+    std::snprintf(suffix, sizeof(suffix), ".tile.%016llx.%zu",
+                  (unsigned long long)generation, index);
+    return key + suffix;
+}
+
+// Get the keys of all tiles
+std::vector<std::string> TileManifest::part_keys(const std::string& key) const
+{
+    std::vector<std::string> keys(n_tiles());
+    for (size_t i = 0; i < keys.size(); i++)
+        keys[i] = tile_key(key, i);
+    return keys;
+}
+
+// Get the position of the first value of a tile
+std::vector<size_t> TileManifest::tile_origin(size_t index) const
+{
+    std::vector<size_t> origin(dims.size());
+    for (size_t d = dims.size(); d-- > 0; ) {
+        size_t n = (dims[d] + tile_dims[d] - 1) / tile_dims[d];
+        origin[d] = (index % n) * tile_dims[d];
+        index /= n;
+    }
+    return origin;
+}
+
+// Get the dimensions of a tile
+std::vector<size_t> TileManifest::tile_extent(size_t index) const
+{
+    std::vector<size_t> extent = tile_origin(index);
+    for (size_t d = 0; d < dims.size(); d++)
+        extent[d] = std::min(tile_dims[d], dims[d] - extent[d]);
+    return extent;
+}
+
+// Get the tiles that intersect a region of the tensor
+std::vector<size_t> TileManifest::tiles_in_region(
+    const std::vector<size_t>& offsets,
+    const std::vector<size_t>& counts) const
+{
+    // The range of tile coordinates along each dimension
+    size_t n_dims = dims.size();
+    std::vector<size_t> first(n_dims), last(n_dims), n_tiles_dim(n_dims);
+    for (size_t d = 0; d < n_dims; d++) {
+        if (counts[d] == 0)
+            return std::vector<size_t>();
+        first[d] = offsets[d] / tile_dims[d];
+        last[d] = (offsets[d] + counts[d] - 1) / tile_dims[d];
+        n_tiles_dim[d] = (dims[d] + tile_dims[d] - 1) / tile_dims[d];
+    }
+
+    // Walk the tile coordinates in row major order
+    std::vector<size_t> tiles;
+    std::vector<size_t> coord(first);
+    while (true) {
+        size_t index = 0;
+        for (size_t d = 0; d < n_dims; d++)
+            index = index * n_tiles_dim[d] + coord[d];
+        tiles.push_back(index);
+
+        size_t d = n_dims;
+        while (d-- > 0) {
+            if (++coord[d] <= last[d])
+                break;
+            coord[d] = first[d];
+        }
+        if (d == (size_t)-1)
+            break;
+    }
+    return tiles;
+}
+
+// Serialize the manifest
+std::string TileManifest::pack() const
+{
+    TileManifestHeader header;
+    std::memcpy(header.magic, _TILE_MAGIC, sizeof(header.magic));
+    header.type = (uint32_t)type;
+    header.n_dims = (uint32_t)dims.size();
+    header.generation = generation;
+
+    std::string buf((const char*)&header, sizeof(header));
+    for (const std::vector<size_t>* v : {&dims, &tile_dims}) {
+        for (size_t i = 0; i < v->size(); i++) {
+            uint64_t dim = (*v)[i];
+            buf.append((const char*)&dim, sizeof(dim));
+        }
+    }
+    return buf;
+}
+
+// Check whether a buffer holds a serialized manifest
+bool TileManifest::is_manifest(std::string_view buf)
+{
+    return buf.size() >= sizeof(TileManifestHeader) &&
+           std::memcmp(buf.data(), _TILE_MAGIC, sizeof(_TILE_MAGIC)) == 0;
+}
+
+// Deserialize a manifest
+TileManifest TileManifest::unpack(std::string_view buf)
+{
+    if (!is_manifest(buf))
+        throw SRRuntimeException("The buffer is not a tile manifest.");
+    TileManifestHeader header;
+    std::memcpy(&header, buf.data(), sizeof(header));
+    if (header.n_dims > _CHUNK_MAX_DIMS ||
+        buf.size() != sizeof(header) + 2 * header.n_dims * sizeof(uint64_t)) {
+        throw SRRuntimeException("The tile manifest is malformed.");
+    }
+
+    TileManifest manifest;
+    manifest.type = (SRTensorType)header.type;
+    manifest.generation = header.generation;
+    manifest.dims.resize(header.n_dims);
+    manifest.tile_dims.resize(header.n_dims);
+    const char* pos = buf.data() + sizeof(header);
+    for (std::vector<size_t>* v : {&manifest.dims, &manifest.tile_dims}) {
+        for (size_t i = 0; i < v->size(); i++) {
+            uint64_t dim;
+            std::memcpy(&dim, pos, sizeof(dim));
+            (*v)[i] = dim;
+            pos += sizeof(dim);
+        }
+    }
+    for (size_t i = 0; i < manifest.tile_dims.size(); i++) {
+        if (manifest.tile_dims[i] == 0)
+            throw SRRuntimeException("The tile manifest is malformed.");
+    }
+    return manifest;
+}
+
+// Copy the values in a box of tensor coordinates from one row major
+// block of values to another
+void SmartRedis::copy_tensor_box(const char* src,
+                                 const std::vector<size_t>& src_dims,
+                                 const std::vector<size_t>& src_origin,
+                                 char* dest,
+                                 const std::vector<size_t>& dest_dims,
+                                 const std::vector<size_t>& dest_origin,
+                                 const std::vector<size_t>& lo,
+                                 const std::vector<size_t>& hi,
+                                 size_t value_size)
+{
+    size_t n_dims = lo.size();
+    for (size_t d = 0; d < n_dims; d++) {
+        if (hi[d] <= lo[d])
+            return;
+    }
+    if (n_dims == 0) {
+        std::memcpy(dest, src, value_size);
+        return;
+    }
+
+    // Row major strides, in values, of each block
+    std::vector<size_t> src_strides(n_dims), dest_strides(n_dims);
+    size_t src_stride = 1, dest_stride = 1;
+    for (size_t d = n_dims; d-- > 0; ) {
+        src_strides[d] = src_stride;
+        dest_strides[d] = dest_stride;
+        src_stride *= src_dims[d];
+        dest_stride *= dest_dims[d];
+    }
+
+    // Copy one row along the last dimension at a time
+    size_t inner = n_dims - 1;
+    size_t row_bytes = (hi[inner] - lo[inner]) * value_size;
+    std::vector<size_t> coord(lo);
+    while (true) {
+        size_t src_index = 0, dest_index = 0;
+        for (size_t d = 0; d < n_dims; d++) {
+            src_index += (coord[d] - src_origin[d]) * src_strides[d];
+            dest_index += (coord[d] - dest_origin[d]) * dest_strides[d];
+        }
+        std::memcpy(dest + dest_index * value_size,
+                    src + src_index * value_size, row_bytes);
+
+        size_t d = inner;
+        while (d-- > 0) {
+            if (++coord[d] < hi[d])
+                break;
+            coord[d] = lo[d];
+        }
+        if (d == (size_t)-1)
+            break;
+    }
+}
@@ -0,0 +1,410 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include "tensorconvert.h"
+#include "srexception.h"
+#include "utility.h"
+
+namespace SmartRedis {
+
+// Element types for the 16 bit floating point formats, which have no
+// native C++ type. They are distinct so that the kernels can tell
+// them apart from uint16_t.
+struct Float16Value { uint16_t bits; };
+struct BFloat16Value { uint16_t bits; };
+
+// Read a value in a form that supports arithmetic
+template <typename T>
+inline T _load(const T& value)
+{
+    return value;
+}
+
+inline float _load(const Float16Value& value)
+{
+    return float16_to_float(value.bits);
+}
+
+inline float _load(const BFloat16Value& value)
+{
+    return bfloat16_to_float(value.bits);
+}
+
+// Round a double half to even into an IEEE binary format with
+// ExpBits exponent and ManBits mantissa bits, without going through
+// float or the floating point environment
+template <int ExpBits, int ManBits>
+inline uint16_t _round_double(double value)
+{
+    const int bias = (1 << (ExpBits - 1)) - 1;
+    const int max_exp = (1 << ExpBits) - 1;
+
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign = (uint16_t)((bits >> 63) << 15);
+    uint64_t magnitude = bits & 0x7fffffffffffffffull;
+    if (magnitude >= 0x7ff0000000000000ull) {
+        // Infinity, or NaN kept quiet
+        uint16_t nan = (magnitude > 0x7ff0000000000000ull) ?
+                       (uint16_t)(1u << (ManBits - 1)) : 0;
+        return sign | (uint16_t)(max_exp << ManBits) | nan;
+    }
+    // Double subnormals are far below the smallest half subnormal
+    if ((magnitude >> 52) == 0)
+        return sign;
+
+    int exponent = (int)(magnitude >> 52) - 1023 + bias;
+    if (exponent >= max_exp)
+        return sign | (uint16_t)(max_exp << ManBits);
+
+    // Drop the low mantissa bits, and more for subnormal results
+    uint64_t mantissa = (magnitude & 0xfffffffffffffull) | (1ull << 52);
+    int shift = 52 - ManBits + (exponent < 1 ? 1 - exponent : 0);
+    if (shift > 53)
+        return sign;
+    uint64_t kept = mantissa >> shift;
+    uint64_t dropped = mantissa & ((1ull << shift) - 1);
+    uint64_t half = 1ull << (shift - 1);
+    if (dropped > half || (dropped == half && (kept & 1u) != 0))
+        kept++;
+
+    // The hidden bit of a normal result carries into the exponent, as
+    // does a mantissa rounded up to the next power of two
+    uint64_t result = kept;
+    if (exponent >= 1)
+        result += (uint64_t)(exponent - 1) << ManBits;
+    if (result >= ((uint64_t)max_exp << ManBits))
+        result = (uint64_t)max_exp << ManBits;
+    return sign | (uint16_t)result;
+}
+
+// Widen a value to double for rounding to a half precision format.
+// 64-bit integers that double cannot hold are rounded to odd, which
+// keeps the second rounding correct.
+template <typename V>
+inline double _widen(V value)
+{
+    if constexpr (std::is_integral_v<V> && sizeof(V) == 8) {
+        bool negative = std::is_signed_v<V> && value < 0;
+        uint64_t magnitude = negative ? 0 - (uint64_t)value : (uint64_t)value;
+        int shift = 0;
+        while ((magnitude >> shift) >= (1ull << 53))
+            shift++;
+        uint64_t kept = magnitude >> shift;
+        if ((kept << shift) != magnitude)
+            kept |= 1u;
+        double widened = std::ldexp((double)kept, shift);
+        return negative ? -widened : widened;
+    }
+    else {
+        return static_cast<double>(value);
+    }
+}
+
+// Store a value, returning false if it cannot be represented
+template <typename D, typename V>
+inline bool _store(D& dest, V value)
+{
+    if constexpr (std::is_same_v<D, Float16Value>) {
+        // float and the half formats round once; wider values are
+        // rounded from double directly
+        if constexpr (std::is_same_v<V, float>)
+            dest.bits = float_to_float16(value);
+        else
+            dest.bits = double_to_float16(_widen(value));
+        return true;
+    }
+    else if constexpr (std::is_same_v<D, BFloat16Value>) {
+        if constexpr (std::is_same_v<V, float>)
+            dest.bits = float_to_bfloat16(value);
+        else
+            dest.bits = double_to_bfloat16(_widen(value));
+        return true;
+    }
+    else if constexpr (std::is_same_v<D, bool>) {
+        dest = (value != 0);
+        return true;
+    }
+    else if constexpr (std::is_floating_point_v<D>) {
+        dest = static_cast<D>(value);
+        return true;
+    }
+    else if constexpr (std::is_floating_point_v<V>) {
+        // Round, then check against the exactly representable powers
+        // of two bounding the integer type. NaN fails both tests.
+        constexpr int digits = std::numeric_limits<D>::digits;
+        const V upper = std::ldexp(V(1), digits);
+        const V lower = std::is_signed_v<D> ? -upper : V(0);
+        V rounded = std::nearbyint(value);
+        bool in_range = rounded >= lower && rounded < upper;
+        dest = in_range ? static_cast<D>(rounded) : D(0);
+        return in_range;
+    }
+    else {
+        bool in_range;
+        if constexpr (std::is_signed_v<V>) {
+            int64_t x = value;
+            if constexpr (std::is_signed_v<D>) {
+                in_range = x >= std::numeric_limits<D>::min() &&
+                           x <= std::numeric_limits<D>::max();
+            }
+            else {
+                in_range = x >= 0 &&
+                           uint64_t(x) <= std::numeric_limits<D>::max();
+            }
+        }
+        else {
+            uint64_t x = value;
+            in_range = x <= uint64_t(std::numeric_limits<D>::max());
+        }
+        dest = static_cast<D>(value);
+        return in_range;
+    }
+}
+
+// Convert n values in a single pass. The loop body is branch free
+// apart from the type dispatch resolved at compile time, so the
+// compiler can vectorize the common floating point conversions.
+template <typename S, typename D>
+void _convert_values(const S* src, D* dest, size_t n, SRTensorType dest_type)
+{
+    bool in_range = true;
+    for (size_t i = 0; i < n; i++)
+        in_range &= _store(dest[i], _load(src[i]));
+
+    if (!in_range) {
+        throw SRParameterException("A tensor value is NaN or out of range "\
+                                   "for the " + to_string(dest_type) +
+                                   " tensor type.");
+    }
+}
+
+// Dispatch on the destination type
+template <typename S>
+void _convert_from(const S* src, void* dest, SRTensorType dest_type, size_t n)
+{
+    switch (dest_type) {
+        case SRTensorTypeDouble:
+            _convert_values(src, (double*)dest, n, dest_type);
+            break;
+        case SRTensorTypeFloat:
+            _convert_values(src, (float*)dest, n, dest_type);
+            break;
+        case SRTensorTypeInt64:
+            _convert_values(src, (int64_t*)dest, n, dest_type);
+            break;
+        case SRTensorTypeInt32:
+            _convert_values(src, (int32_t*)dest, n, dest_type);
+            break;
+        case SRTensorTypeInt16:
+            _convert_values(src, (int16_t*)dest, n, dest_type);
+            break;
+        case SRTensorTypeInt8:
+            _convert_values(src, (int8_t*)dest, n, dest_type);
+            break;
+        case SRTensorTypeUint64:
+            _convert_values(src, (uint64_t*)dest, n, dest_type);
+            break;
+        case SRTensorTypeUint32:
+            _convert_values(src, (uint32_t*)dest, n, dest_type);
+            break;
+        case SRTensorTypeUint16:
+            _convert_values(src, (uint16_t*)dest, n, dest_type);
+            break;
+        case SRTensorTypeUint8:
+            _convert_values(src, (uint8_t*)dest, n, dest_type);
+            break;
+        case SRTensorTypeBool:
+            _convert_values(src, (bool*)dest, n, dest_type);
+            break;
+        case SRTensorTypeFloat16:
+            _convert_values(src, (Float16Value*)dest, n, dest_type);
+            break;
+        case SRTensorTypeBFloat16:
+            _convert_values(src, (BFloat16Value*)dest, n, dest_type);
+            break;
+        default:
+            throw SRParameterException("Invalid tensor type for "\
+                                       "conversion: " +
+                                       std::to_string((int)dest_type));
+    }
+}
+
+// Convert tensor values from one tensor type to another
+void convert_tensor_values(const void* src,
+                           SRTensorType src_type,
+                           void* dest,
+                           SRTensorType dest_type,
+                           size_t n_values)
+{
+    if (src_type == dest_type) {
+        std::memcpy(dest, src, n_values * tensor_type_size(src_type));
+        return;
+    }
+
+    switch (src_type) {
+        case SRTensorTypeDouble:
+            _convert_from((const double*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeFloat:
+            _convert_from((const float*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeInt64:
+            _convert_from((const int64_t*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeInt32:
+            _convert_from((const int32_t*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeInt16:
+            _convert_from((const int16_t*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeInt8:
+            _convert_from((const int8_t*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeUint64:
+            _convert_from((const uint64_t*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeUint32:
+            _convert_from((const uint32_t*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeUint16:
+            _convert_from((const uint16_t*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeUint8:
+            _convert_from((const uint8_t*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeBool:
+            _convert_from((const bool*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeFloat16:
+            _convert_from((const Float16Value*)src, dest, dest_type, n_values);
+            break;
+        case SRTensorTypeBFloat16:
+            _convert_from((const BFloat16Value*)src, dest, dest_type, n_values);
+            break;
+        default:
+            throw SRParameterException("Invalid tensor type for "\
+                                       "conversion: " +
+                                       std::to_string((int)src_type));
+    }
+}
+
+// Convert a float to IEEE half precision bits, rounding half to even
+uint16_t float_to_float16(float value)
+{
+    const uint32_t f32_infinity = 255u << 23;
+    const uint32_t f16_overflow = (127u + 16u) << 23;
+
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint16_t result;
+    if (bits >= f16_overflow) {
+        // Infinity, NaN (kept quiet) or a value too large for half
+        result = (bits > f32_infinity) ? 0x7e00 : 0x7c00;
+    }
+    else if (bits < (113u << 23)) {
+        // Subnormal or zero, which float holds exactly as a double.
+        // This avoids rounding with the FPU in the current mode.
+        return double_to_float16(value);
+    }
+    else {
+        // Normal: rebias the exponent and round the mantissa
+        uint32_t mantissa_odd = (bits >> 13) & 1u;
+        bits += ((uint32_t)(15 - 127) << 23) + 0xfffu;
+        bits += mantissa_odd;
+        result = (uint16_t)(bits >> 13);
+    }
+    return result | (uint16_t)(sign >> 16);
+}
+
+// Convert a double to IEEE half precision bits, rounding half to even
+uint16_t double_to_float16(double value)
+{
+    return _round_double<5, 10>(value);
+}
+
+// Convert IEEE half precision bits to a float
+float float16_to_float(uint16_t bits)
+{
+    uint32_t sign = (uint32_t)(bits & 0x8000u) << 16;
+    uint32_t exponent = (bits >> 10) & 0x1fu;
+    uint32_t mantissa = bits & 0x3ffu;
+
+    if (exponent == 0) {
+        // Zero or subnormal
+        float magnitude = std::ldexp((float)mantissa, -24);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+
+    uint32_t result;
+    if (exponent == 0x1fu)
+        result = sign | 0x7f800000u | (mantissa << 13);
+    else
+        result = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+
+    float value;
+    std::memcpy(&value, &result, sizeof(value));
+    return value;
+}
+
+// Convert a float to bfloat16 bits, rounding half to even
+uint16_t float_to_bfloat16(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7fffffffu) > 0x7f800000u) {
+        // Keep NaNs quiet rather than rounding them to infinity
+        return (uint16_t)((bits >> 16) | 0x40u);
+    }
+    bits += 0x7fffu + ((bits >> 16) & 1u);
+    return (uint16_t)(bits >> 16);
+}
+
+// Convert a double to bfloat16 bits, rounding half to even
+uint16_t double_to_bfloat16(double value)
+{
+    return _round_double<8, 7>(value);
+}
+
+// Convert bfloat16 bits to a float
+float bfloat16_to_float(uint16_t bits)
+{
+    uint32_t result = (uint32_t)bits << 16;
+    float value;
+    std::memcpy(&value, &result, sizeof(value));
+    return value;
+}
+
+} // namespace SmartRedis
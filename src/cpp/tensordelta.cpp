@@ -0,0 +1,187 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstring>
+#include <random>
+#include "tensordelta.h"
+#include "compression.h"
+#include "srexception.h"
+
+using namespace SmartRedis;
+
+// Header at the start of each frame. The frame kind is followed by
+// padding so that the identifiers are aligned.
+struct DeltaFrameHeader {
+    char magic[8];
+    uint8_t kind;
+    uint8_t reserved[7];
+    uint64_t stream_id;
+    uint64_t sequence;
+};
+
+static const char _DELTA_MAGIC[8] = {'S', 'R', 'D', 'E', 'L', 'T', 'A', '1'};
+static const uint8_t _DELTA_KEYFRAME = 0;
+static const uint8_t _DELTA_DELTA = 1;
+
+// XOR a buffer into another of the same size
+static void _xor_into(char* dest, const char* src, size_t n)
+{
+    size_t i = 0;
+    for ( ; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+        uint64_t a, b;
+        std::memcpy(&a, dest + i, sizeof(a));
+        std::memcpy(&b, src + i, sizeof(b));
+        a ^= b;
+        std::memcpy(dest + i, &a, sizeof(a));
+    }
+    for ( ; i < n; i++)
+        dest[i] ^= src[i];
+}
+
+// Pick an identifier for a new stream
+static uint64_t _new_stream_id()
+{
+    std::random_device source;
+    return ((uint64_t)source() << 32) ^ (uint64_t)source();
+}
+
+// DeltaEncoder constructor
+DeltaEncoder::DeltaEncoder(int keyframe_interval, int level)
+    : _stream_id(0), _sequence(0), _type(SRTensorTypeInvalid),
+      _keyframe_interval(keyframe_interval > 0 ? keyframe_interval : 1),
+      _level(level)
+{
+    // NOP
+}
+
+// Encode the next values of the tensor
+std::string DeltaEncoder::encode(std::string_view values,
+                                 SRTensorType type,
+                                 const std::vector<size_t>& dims,
+                                 bool& keyframe)
+{
+    keyframe = _sequence == 0 || _sequence >= (uint64_t)_keyframe_interval ||
+               type != _type || dims != _dims ||
+               values.size() != _last.size();
+    if (keyframe) {
+        _stream_id = _new_stream_id();
+        _sequence = 0;
+    }
+
+    // A delta is the bytewise XOR with the previous values
+    std::string delta;
+    std::string_view body = values;
+    if (!keyframe) {
+        delta.assign(values.data(), values.size());
+        _xor_into(delta.data(), _last.data(), delta.size());
+        body = delta;
+    }
+    size_t n_values = 1;
+    for (size_t i = 0; i < dims.size(); i++)
+        n_values *= dims[i];
+    size_t element_size = n_values > 0 ? values.size() / n_values : 1;
+
+    DeltaFrameHeader header;
+    std::memcpy(header.magic, _DELTA_MAGIC, sizeof(header.magic));
+    header.kind = keyframe ? _DELTA_KEYFRAME : _DELTA_DELTA;
+    std::memset(header.reserved, 0, sizeof(header.reserved));
+    header.stream_id = _stream_id;
+    header.sequence = _sequence;
+
+    std::string frame((const char*)&header, sizeof(header));
+    frame += compress_buffer(body, element_size, type, dims,
+                             SRCompressionShuffleLZ, _level);
+
+    _type = type;
+    _dims = dims;
+    _last.assign(values.data(), values.size());
+    _sequence++;
+    return frame;
+}
+
+// Make the next frame a keyframe
+void DeltaEncoder::reset()
+{
+    _sequence = 0;
+}
+
+// Get the number of frames encoded since the last keyframe
+uint64_t DeltaEncoder::stream_length() const
+{
+    return _sequence;
+}
+
+// Check whether a buffer is a frame encoded by DeltaEncoder
+bool SmartRedis::is_delta_frame(std::string_view buf)
+{
+    return buf.size() >= sizeof(DeltaFrameHeader) &&
+           std::memcmp(buf.data(), _DELTA_MAGIC, sizeof(_DELTA_MAGIC)) == 0;
+}
+
+// Reconstruct tensor values from encoded frames
+std::string SmartRedis::decode_delta_frames(
+    const std::vector<std::string_view>& frames,
+    SRTensorType& type,
+    std::vector<size_t>& dims)
+{
+    // Read the frame headers and find the last keyframe
+    std::vector<DeltaFrameHeader> headers(frames.size());
+    size_t start = frames.size();
+    for (size_t i = 0; i < frames.size(); i++) {
+        if (!is_delta_frame(frames[i]))
+            throw SRRuntimeException("The buffer is not a delta frame.");
+        std::memcpy(&headers[i], frames[i].data(), sizeof(DeltaFrameHeader));
+        if (headers[i].kind == _DELTA_KEYFRAME)
+            start = i;
+    }
+    if (start == frames.size())
+        throw SRRuntimeException("The delta-encoded tensor has no keyframe.");
+
+    std::string values = decompress_buffer(
+        frames[start].substr(sizeof(DeltaFrameHeader)), type, dims);
+    for (size_t i = start + 1; i < frames.size(); i++) {
+        if (headers[i].kind != _DELTA_DELTA ||
+            headers[i].stream_id != headers[start].stream_id ||
+            headers[i].sequence != headers[start].sequence + (i - start)) {
+            throw SRRuntimeException("The delta-encoded tensor was "\
+                                     "interrupted by another stream.");
+        }
+        SRTensorType delta_type;
+        std::vector<size_t> delta_dims;
+        std::string delta = decompress_buffer(
+            frames[i].substr(sizeof(DeltaFrameHeader)),
+            delta_type, delta_dims);
+        if (delta_type != type || delta_dims != dims ||
+            delta.size() != values.size()) {
+            throw SRRuntimeException("A delta does not match the shape of "\
+                                     "its keyframe.");
+        }
+        _xor_into(values.data(), delta.data(), values.size());
+    }
+    return values;
+}
@@ -0,0 +1,289 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "tensorfile.h"
+#include "srexception.h"
+
+using namespace SmartRedis;
+
+// The .npy data types of the tensor types, in the byte order of the
+// little-endian hosts SmartRedis runs on
+static const struct {
+    SRTensorType type;
+    const char* descr;
+} _NPY_TYPES[] = {
+    {SRTensorTypeDouble, "<f8"},
+    {SRTensorTypeFloat, "<f4"},
+    {SRTensorTypeFloat16, "<f2"},
+    {SRTensorTypeInt64, "<i8"},
+    {SRTensorTypeInt32, "<i4"},
+    {SRTensorTypeInt16, "<i2"},
+    {SRTensorTypeInt8, "|i1"},
+    {SRTensorTypeUint64, "<u8"},
+    {SRTensorTypeUint32, "<u4"},
+    {SRTensorTypeUint16, "<u2"},
+    {SRTensorTypeUint8, "|u1"},
+    {SRTensorTypeBool, "|b1"},
+};
+
+static const char _NPY_MAGIC[6] = {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+
+// Map an existing file for reading
+MappedFile::MappedFile(const std::string& path)
+    : _path(path), _fd(-1), _data(NULL), _size(0), _writable(false)
+{
+    _fd = ::open(path.c_str(), O_RDONLY);
+    if (_fd < 0) {
+        throw SRRuntimeException("Could not open " + path + ": " +
+                                 std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(_fd, &info) != 0) {
+        int error = errno;
+        ::close(_fd);
+        throw SRRuntimeException("Could not read the size of " + path +
+                                 ": " + std::strerror(error));
+    }
+    _size = (size_t)info.st_size;
+    _map(false);
+}
+
+// Create a file of a given size and map it for writing
+MappedFile::MappedFile(const std::string& path, size_t size)
+    : _path(path), _fd(-1), _data(NULL), _size(size), _writable(true)
+{
+    _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (_fd < 0) {
+        throw SRRuntimeException("Could not create " + path + ": " +
+                                 std::strerror(errno));
+    }
+    if (::ftruncate(_fd, (off_t)size) != 0) {
+        int error = errno;
+        ::close(_fd);
+        throw SRRuntimeException("Could not resize " + path + ": " +
+                                 std::strerror(error));
+    }
+    _map(true);
+}
+
+// MappedFile destructor
+MappedFile::~MappedFile()
+{
+    if (_data != NULL) {
+        if (_writable)
+            ::msync(_data, _size, MS_SYNC);
+        ::munmap(_data, _size);
+    }
+    if (_fd >= 0)
+        ::close(_fd);
+}
+
+// Map the open file
+void MappedFile::_map(bool writable)
+{
+    // An empty file cannot be mapped and needs no mapping
+    if (_size == 0)
+        return;
+
+    int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* addr = ::mmap(NULL, _size, prot, MAP_SHARED, _fd, 0);
+    if (addr == MAP_FAILED) {
+        int error = errno;
+        ::close(_fd);
+        _fd = -1;
+        throw SRRuntimeException("Could not map " + _path + ": " +
+                                 std::strerror(error));
+    }
+    _data = (char*)addr;
+
+    // The file is read and written front to back
+    ::madvise(_data, _size, MADV_SEQUENTIAL);
+}
+
+// Get the mapped contents of the file
+char* MappedFile::data() const
+{
+    return _data;
+}
+
+// Get the size of the file
+size_t MappedFile::size() const
+{
+    return _size;
+}
+
+// Write the modified pages back to the file
+void MappedFile::sync()
+{
+    if (_data != NULL && _writable && ::msync(_data, _size, MS_SYNC) != 0) {
+        throw SRRuntimeException("Could not write " + _path + ": " +
+                                 std::strerror(errno));
+    }
+}
+
+// Check whether a buffer starts with a .npy file header
+bool SmartRedis::is_npy_file(std::string_view buf)
+{
+    return buf.size() >= sizeof(_NPY_MAGIC) &&
+           std::memcmp(buf.data(), _NPY_MAGIC, sizeof(_NPY_MAGIC)) == 0;
+}
+
+// Find the value of a key in the dictionary of a .npy header
+static std::string_view _npy_value(std::string_view dict,
+                                   const std::string& key)
+{
+    size_t pos = dict.find("'" + key + "'");
+    if (pos == std::string_view::npos)
+        pos = dict.find("\"" + key + "\"");
+    if (pos == std::string_view::npos)
+        throw SRRuntimeException("The .npy header has no " + key + ".");
+    pos = dict.find(':', pos + key.size() + 2);
+    if (pos == std::string_view::npos)
+        throw SRRuntimeException("The .npy header is malformed.");
+    pos = dict.find_first_not_of(' ', pos + 1);
+    if (pos == std::string_view::npos)
+        throw SRRuntimeException("The .npy header is malformed.");
+    return dict.substr(pos);
+}
+
+// Read the header of a .npy file
+size_t SmartRedis::parse_npy_header(std::string_view buf,
+                                    SRTensorType& type,
+                                    std::vector<size_t>& dims,
+                                    bool& fortran_order)
+{
+    // Version 1 has a 16 bit header length and later versions 32 bits
+    if (!is_npy_file(buf) || buf.size() < 10)
+        throw SRRuntimeException("The file is not a .npy file.");
+    uint8_t major = (uint8_t)buf[6];
+    size_t prefix = major == 1 ? 10 : 12;
+    if (buf.size() < prefix)
+        throw SRRuntimeException("The .npy header is truncated.");
+    size_t dict_len = (uint8_t)buf[8] | ((size_t)(uint8_t)buf[9] << 8);
+    if (major != 1) {
+        dict_len |= ((size_t)(uint8_t)buf[10] << 16) |
+                    ((size_t)(uint8_t)buf[11] << 24);
+    }
+    if (buf.size() < prefix + dict_len)
+        throw SRRuntimeException("The .npy header is truncated.");
+    std::string_view dict = buf.substr(prefix, dict_len);
+
+    // The data type
+    std::string_view descr = _npy_value(dict, "descr");
+    if (descr.empty() || (descr[0] != '\'' && descr[0] != '"'))
+        throw SRRuntimeException("The .npy data type is not supported.");
+    size_t end = descr.find(descr[0], 1);
+    if (end == std::string_view::npos)
+        throw SRRuntimeException("The .npy header is malformed.");
+    std::string code(descr.substr(1, end - 1));
+    if (code.size() == 3 && code[0] == '=')
+        code[0] = code[2] == '1' ? '|' : '<';
+    if (code.size() == 3 && code[2] == '1' && code[0] == '<')
+        code[0] = '|';
+    type = SRTensorTypeInvalid;
+    for (const auto& entry : _NPY_TYPES) {
+        if (code == entry.descr)
+            type = entry.type;
+    }
+    if (type == SRTensorTypeInvalid) {
+        throw SRRuntimeException("The .npy data type " + code +
+                                 " is not supported.");
+    }
+
+    // The memory order
+    fortran_order = _npy_value(dict, "fortran_order").rfind("True", 0) == 0;
+
+    // The shape, a tuple of integers
+    std::string_view shape = _npy_value(dict, "shape");
+    size_t close = shape.find(')');
+    if (shape.empty() || shape[0] != '(' || close == std::string_view::npos)
+        throw SRRuntimeException("The .npy header is malformed.");
+    dims.clear();
+    std::string items(shape.substr(1, close - 1));
+    const char* pos = items.c_str();
+    while (*pos != '\0') {
+        while (*pos == ' ' || *pos == ',')
+            pos++;
+        if (*pos == '\0')
+            break;
+        char* next = NULL;
+        unsigned long long dim = std::strtoull(pos, &next, 10);
+        if (next == pos)
+            throw SRRuntimeException("The .npy header is malformed.");
+        dims.push_back((size_t)dim);
+        pos = next;
+    }
+    return prefix + dict_len;
+}
+
+// Build the header of a .npy file holding a row major array
+std::string SmartRedis::build_npy_header(SRTensorType type,
+                                         const std::vector<size_t>& dims)
+{
+    const char* descr = NULL;
+    for (const auto& entry : _NPY_TYPES) {
+        if (entry.type == type)
+            descr = entry.descr;
+    }
+    if (descr == NULL) {
+        throw SRParameterException("The tensor type has no .npy data "\
+                                   "type.");
+    }
+
+    std::string shape;
+    for (size_t i = 0; i < dims.size(); i++)
+        shape += std::to_string(dims[i]) + ", ";
+    if (dims.size() > 1)
+        shape.resize(shape.size() - 2);
+    else if (dims.size() == 1)
+        shape.resize(shape.size() - 1);
+    std::string dict = std::string("{'descr': '") + descr +
+                       "', 'fortran_order': False, 'shape': (" + shape +
+                       "), }";
+
+    // The dictionary is padded with spaces and ends with a newline
+    size_t prefix = dict.size() + 11 < 65536 ? 10 : 12;
+    size_t total = (prefix + dict.size() + 1 + 63) / 64 * 64;
+    dict.append(total - prefix - dict.size() - 1, ' ');
+    dict.push_back('\n');
+
+    std::string header(_NPY_MAGIC, sizeof(_NPY_MAGIC));
+    header.push_back(prefix == 10 ? '\x01' : '\x02');
+    header.push_back('\x00');
+    size_t dict_len = dict.size();
+    for (size_t i = 0; i < prefix - 8; i++)
+        header.push_back((char)((dict_len >> (8 * i)) & 0xff));
+    return header + dict;
+}
@@ -101,6 +101,20 @@ void TensorPack::add_tensor(const std::string& name,
             case SRTensorTypeUint8:
                 ptr = new Tensor<uint8_t>(name, data, dims, type, mem_layout);
                 break;
+            case SRTensorTypeUint32:
+                ptr = new Tensor<uint32_t>(name, data, dims, type, mem_layout);
+                break;
+            case SRTensorTypeUint64:
+                ptr = new Tensor<uint64_t>(name, data, dims, type, mem_layout);
+                break;
+            case SRTensorTypeBool:
+                ptr = new Tensor<bool>(name, data, dims, type, mem_layout);
+                break;
+            case SRTensorTypeFloat16:
+                // Fall through
+            case SRTensorTypeBFloat16:
+                ptr = new Tensor<uint16_t>(name, data, dims, type, mem_layout);
+                break;
             default:
                 throw SRRuntimeException("Unknown tensor type");
         }
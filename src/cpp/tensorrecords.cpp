@@ -0,0 +1,102 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cstring>
+#include "tensorrecords.h"
+#include "srexception.h"
+
+using namespace SmartRedis;
+
+static const char _RECORD_MAGIC[8] = {'S', 'R', 'R', 'E', 'C', 'R', 'D', '1'};
+
+// Encode one record of an appendable tensor
+std::string SmartRedis::encode_tensor_record(std::string_view values,
+                                             SRTensorType type,
+                                             const std::vector<size_t>& dims,
+                                             SRCompressionCodec codec,
+                                             int level,
+                                             double error_bound)
+{
+    size_t n_values = 1;
+    for (size_t i = 0; i < dims.size(); i++)
+        n_values *= dims[i];
+    size_t element_size = n_values > 0 ? values.size() / n_values : 1;
+
+    std::string record(_RECORD_MAGIC, sizeof(_RECORD_MAGIC));
+    record += compress_buffer(values, element_size, type, dims, codec,
+                              level, error_bound);
+    return record;
+}
+
+// Check whether a buffer is a record of an appendable tensor
+bool SmartRedis::is_tensor_record(std::string_view buf)
+{
+    return buf.size() > sizeof(_RECORD_MAGIC) &&
+           std::memcmp(buf.data(), _RECORD_MAGIC, sizeof(_RECORD_MAGIC)) == 0;
+}
+
+// Join consecutive records of an appendable tensor into a single tensor
+std::string SmartRedis::join_tensor_records(
+    const std::vector<std::string_view>& records,
+    SRTensorType& type,
+    std::vector<size_t>& dims)
+{
+    if (records.size() == 0)
+        throw SRRuntimeException("There are no tensor records to join.");
+
+    std::string values;
+    std::vector<size_t> record_dims;
+    size_t record_bytes = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (!is_tensor_record(records[i]))
+            throw SRRuntimeException("The buffer is not a tensor record.");
+        SRTensorType this_type;
+        std::vector<size_t> this_dims;
+        std::string record = decompress_buffer(
+            records[i].substr(sizeof(_RECORD_MAGIC)), this_type, this_dims);
+
+        // The first record sets the shape of the others
+        if (i == 0) {
+            type = this_type;
+            record_dims = this_dims;
+            record_bytes = record.size();
+            values.reserve(record_bytes * records.size());
+        }
+        else if (this_type != type || this_dims != record_dims ||
+                 record.size() != record_bytes) {
+            throw SRRuntimeException("Record " + std::to_string(i) +
+                                     " does not match the type and "\
+                                     "dimensions of the first record.");
+        }
+        values += record;
+    }
+
+    dims.clear();
+    dims.push_back(records.size());
+    dims.insert(dims.end(), record_dims.begin(), record_dims.end());
+    return values;
+}
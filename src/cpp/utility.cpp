@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <string>
 #include <cstring>
+#include <cstdint>
 #include <stdio.h>
 #include <stdexcept>
 #include "srexception.h"
@@ -171,6 +172,16 @@ std::string to_string(SRTensorType ttype)
             return "8 bit unsigned integer";
         case SRTensorTypeUint16:
             return "16 bit unsigned integer";
+        case SRTensorTypeUint32:
+            return "32 bit unsigned integer";
+        case SRTensorTypeUint64:
+            return "64 bit unsigned integer";
+        case SRTensorTypeBool:
+            return "boolean";
+        case SRTensorTypeFloat16:
+            return "half precision float";
+        case SRTensorTypeBFloat16:
+            return "bfloat16";
         case SRTensorTypeInvalid:
             // Fall through
         default:
@@ -178,6 +189,63 @@ std::string to_string(SRTensorType ttype)
     }
 }
 
+// Retrieve the size in bytes of a single element of a tensor type
+size_t tensor_type_size(SRTensorType ttype)
+{
+    switch (ttype) {
+        case SRTensorTypeDouble:
+            return sizeof(double);
+        case SRTensorTypeFloat:
+            return sizeof(float);
+        case SRTensorTypeInt8:
+            return sizeof(int8_t);
+        case SRTensorTypeInt16:
+            return sizeof(int16_t);
+        case SRTensorTypeInt32:
+            return sizeof(int32_t);
+        case SRTensorTypeInt64:
+            return sizeof(int64_t);
+        case SRTensorTypeUint8:
+            return sizeof(uint8_t);
+        case SRTensorTypeUint16:
+            return sizeof(uint16_t);
+        case SRTensorTypeUint32:
+            return sizeof(uint32_t);
+        case SRTensorTypeUint64:
+            return sizeof(uint64_t);
+        case SRTensorTypeBool:
+            return sizeof(bool);
+        case SRTensorTypeFloat16:
+            // Fall through
+        case SRTensorTypeBFloat16:
+            return sizeof(uint16_t);
+        case SRTensorTypeInvalid:
+            // Fall through
+        default:
+            throw SRParameterException("Invalid tensor type: " +
+                                       std::to_string((int)ttype));
+    }
+}
+
+// Check whether RedisAI can store tensors of a type
+bool is_redisai_tensor_type(SRTensorType ttype)
+{
+    switch (ttype) {
+        case SRTensorTypeUint32:
+            // Fall through
+        case SRTensorTypeUint64:
+            // Fall through
+        case SRTensorTypeFloat16:
+            // Fall through
+        case SRTensorTypeBFloat16:
+            // Fall through
+        case SRTensorTypeInvalid:
+            return false;
+        default:
+            return true;
+    }
+}
+
 // Create a string representation of a metadata field type
 std::string to_string(SRMetaDataType mdtype)
 {
@@ -28,6 +28,7 @@
 
 #include "pysrobject.h"
 #include "pyclient.h"
+#include "pyasyncclient.h"
 #include "pydataset.h"
 #include "pylogcontext.h"
 #include "srexception.h"
@@ -62,12 +63,24 @@ PYBIND11_MODULE(smartredisPy, m) {
         .def(py::init<const std::string&>())
         .def(py::init<PyConfigOptions&, const std::string&>())
         .CLIENT_METHOD(put_tensor)
+        .CLIENT_METHOD(put_tensor_as)
+        .CLIENT_METHOD(put_tensor_delta)
+        .CLIENT_METHOD(put_tensor_tiled)
+        .CLIENT_METHOD(append_to_tensor)
+        .CLIENT_METHOD(put_tensor_from_file)
         .CLIENT_METHOD(get_tensor)
+        .CLIENT_METHOD(get_tensor_range)
+        .CLIENT_METHOD(unpack_tensor)
+        .CLIENT_METHOD(unpack_tensor_as)
+        .CLIENT_METHOD(unpack_tensor_slice)
+        .CLIENT_METHOD(unpack_tensor_to_file)
         .CLIENT_METHOD(delete_tensor)
         .CLIENT_METHOD(copy_tensor)
         .CLIENT_METHOD(rename_tensor)
         .CLIENT_METHOD(put_dataset)
         .CLIENT_METHOD(get_dataset)
+        .CLIENT_METHOD(put_datasets)
+        .CLIENT_METHOD(get_datasets)
         .CLIENT_METHOD(delete_dataset)
         .CLIENT_METHOD(copy_dataset)
         .CLIENT_METHOD(rename_dataset)
@@ -100,6 +113,11 @@ PYBIND11_MODULE(smartredisPy, m) {
         .CLIENT_METHOD(set_data_source)
         .CLIENT_METHOD(use_tensor_ensemble_prefix)
         .CLIENT_METHOD(use_dataset_ensemble_prefix)
+        .CLIENT_METHOD(use_packed_datasets)
+        .CLIENT_METHOD(use_dataset_transactions)
+        .CLIENT_METHOD(set_tensor_ttl)
+        .CLIENT_METHOD(set_dataset_ttl)
+        .CLIENT_METHOD(set_list_retention)
         .CLIENT_METHOD(use_model_ensemble_prefix)
         .CLIENT_METHOD(use_list_ensemble_prefix)
         .CLIENT_METHOD(get_db_node_info)
@@ -123,6 +141,27 @@ PYBIND11_MODULE(smartredisPy, m) {
         .CLIENT_METHOD(to_string)
     ;
 
+    // Python asynchronous request executor
+    #define ASYNC_CLIENT_METHOD(name) CLASS_METHOD(PyAsyncClient, name)
+    py::class_<PyAsyncClient, PySRObject>(m, "PyAsyncClient")
+        .def(py::init<std::vector<PyClient*>, const std::string&>(),
+             py::keep_alive<1, 2>())
+        .ASYNC_CLIENT_METHOD(completion_fd)
+        .ASYNC_CLIENT_METHOD(completed)
+        .ASYNC_CLIENT_METHOD(result)
+        .ASYNC_CLIENT_METHOD(shutdown)
+        .ASYNC_CLIENT_METHOD(put_tensor)
+        .ASYNC_CLIENT_METHOD(get_tensor)
+        .ASYNC_CLIENT_METHOD(delete_tensor)
+        .ASYNC_CLIENT_METHOD(tensor_exists)
+        .ASYNC_CLIENT_METHOD(put_dataset)
+        .ASYNC_CLIENT_METHOD(get_dataset)
+        .ASYNC_CLIENT_METHOD(delete_dataset)
+        .ASYNC_CLIENT_METHOD(dataset_exists)
+        .ASYNC_CLIENT_METHOD(run_model)
+        .ASYNC_CLIENT_METHOD(run_script)
+    ;
+
     // Python Dataset class
     #define DATASET_METHOD(name) CLASS_METHOD(PyDataset, name)
     py::class_<PyDataset, PySRObject>(m, "PyDataset")
@@ -25,6 +25,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 __all__ = [
+    "AsyncClient",
     "Client",
     "ConfigOptions",
     "Dataset",
@@ -40,6 +41,7 @@ __all__ = [
     "LLDeveloper",
 ]
 
+from .async_client import AsyncClient
 from .client import Client
 from .configoptions import ConfigOptions
 from .dataset import Dataset
@@ -0,0 +1,386 @@
+# BSD 2-Clause License
+#
+# Copyright (c) 2021-2024, Hewlett Packard Enterprise
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import asyncio
+import typing as t
+
+import numpy as np
+
+from .client import Client
+from .dataset import Dataset
+from .smartredisPy import PyAsyncClient
+from .smartredisPy import RedisReplyError as PybindRedisReplyError
+from .util import (
+    Dtypes,
+    as_ndarray,
+    check_tensor_args,
+    convert_error,
+    typecheck,
+)
+
+
+class _ClientSettings:
+    """The Client of an AsyncClient, with its settings applied to
+    every connection of the AsyncClient"""
+
+    _SETTINGS = frozenset(
+        (
+            "set_data_source",
+            "use_tensor_ensemble_prefix",
+            "use_dataset_ensemble_prefix",
+            "use_model_ensemble_prefix",
+            "use_list_ensemble_prefix",
+            "use_packed_datasets",
+            "use_dataset_transactions",
+            "set_tensor_ttl",
+            "set_dataset_ttl",
+            "set_list_retention",
+        )
+    )
+
+    def __init__(self, clients: t.List[Client]):
+        self._clients = clients
+
+    def __getattr__(self, name: str) -> t.Any:
+        attr = getattr(self._clients[0], name)
+        if name not in self._SETTINGS:
+            return attr
+
+        def apply_to_all(*args: t.Any, **kwargs: t.Any) -> None:
+            for client in self._clients:
+                getattr(client, name)(*args, **kwargs)
+
+        return apply_to_all
+
+    def __str__(self) -> str:
+        return str(self._clients[0])
+
+
+class AsyncClient:
+    def __init__(
+        self, *a: t.Any, max_workers: t.Optional[int] = None, **kw: t.Any
+    ):
+        """Initialize an asyncio SmartRedis client
+
+        The AsyncClient offers coroutine versions of the most common
+        Client methods, so that a single asyncio event loop can keep
+        many database requests in flight. Requests are queued to a C++
+        thread pool and run without the GIL, each worker thread on its
+        own database connection. Completion is signalled through a pipe
+        that the event loop watches, so no Python thread is used per
+        request. Requests beyond the number of workers wait in the
+        queue.
+
+        All positional and keyword arguments other than max_workers
+        are forwarded to the Client constructor; see Client.__init__()
+        for the supported signatures.
+
+        :param a: Positional arguments for the Client constructor
+        :type a: tuple[any]
+        :param max_workers: The number of worker threads, and thus of
+                            database connections and of requests
+                            executed concurrently, defaults to 8
+        :type max_workers: int, optional
+        :param kw: Keyword arguments for the Client constructor
+        :type kw: dict[string, any]
+        :raises RedisConnectionError: if connection initialization fails
+        """
+        if max_workers is not None:
+            typecheck(max_workers, "max_workers", int)
+            if max_workers <= 0:
+                raise ValueError("max_workers must be greater than zero")
+        self._connections = [Client(*a, **kw) for _ in range(max_workers or 8)]
+        self._requests = PyAsyncClient(
+            [connection._client for connection in self._connections],
+            kw.get("logger_name", "Default"),
+        )
+        self._client = _ClientSettings(self._connections)
+        self._pending: t.Dict[int, t.Tuple[asyncio.Future, t.Tuple]] = {}
+        self._loop: t.Optional[asyncio.AbstractEventLoop] = None
+
+    @property
+    def client(self) -> Client:
+        """The blocking Client of the AsyncClient
+
+        The Client can be used to configure the AsyncClient (e.g.
+        prefixing, data source or DataSet storage settings), which
+        applies the settings to every connection, and to call methods
+        that have no coroutine version.
+
+        :return: The underlying Client
+        :rtype: Client
+        """
+        return t.cast(Client, self._client)
+
+    def close(self) -> None:
+        """Wait for requests in flight and stop the worker threads
+
+        This blocks the calling thread; in a coroutine, leave an
+        ``async with`` block or await aclose() instead.
+        """
+        self._requests.shutdown()
+        self._detach()
+
+    async def aclose(self) -> None:
+        """Wait for requests in flight and stop the worker threads
+
+        The event loop keeps running while the AsyncClient shuts down.
+        """
+        loop = asyncio.get_running_loop()
+        await loop.run_in_executor(None, self._requests.shutdown)
+        self._detach()
+
+    async def __aenter__(self) -> "AsyncClient":
+        return self
+
+    async def __aexit__(self, *exc_info: t.Any) -> None:
+        await self.aclose()
+
+    def _detach(self) -> None:
+        """Deliver the remaining completions and stop watching the pipe"""
+        self._on_completion()
+        if self._loop is not None and not self._loop.is_closed():
+            self._loop.remove_reader(self._requests.completion_fd())
+        self._loop = None
+
+    def _on_completion(self) -> None:
+        """Resolve the futures of the completed requests"""
+        for request_id in self._requests.completed():
+            future, _ = self._pending.pop(request_id)
+            try:
+                result = self._requests.result(request_id)
+            except PybindRedisReplyError as cpp_error:
+                if not future.cancelled():
+                    future.set_exception(cpp_error)
+                continue
+            if not future.cancelled():
+                future.set_result(result)
+
+    async def _wait(
+        self, method_name: str, request_id: int, *keep_alive: t.Any
+    ) -> t.Any:
+        """Wait for a request to complete
+
+        :param method_name: The name of the coroutine, for error messages
+        :type method_name: str
+        :param request_id: The identifier of the request
+        :type request_id: int
+        :param keep_alive: Objects the request uses, which are kept
+                           alive until it completes
+        :type keep_alive: tuple[any]
+        :return: The result of the request
+        """
+        loop = asyncio.get_running_loop()
+        if self._loop is not loop:
+            if self._loop is not None and not self._loop.is_closed():
+                self._loop.remove_reader(self._requests.completion_fd())
+            loop.add_reader(self._requests.completion_fd(), self._on_completion)
+            self._loop = loop
+        future = loop.create_future()
+        self._pending[request_id] = (future, keep_alive)
+        try:
+            # The request keeps running if the awaiting task is
+            # cancelled, so the future is shielded from cancellation
+            return await asyncio.shield(future)
+        except PybindRedisReplyError as cpp_error:
+            raise convert_error(cpp_error, "AsyncClient." + method_name) from None
+
+    async def put_tensor(
+        self, name: str, data: t.Any, dtype: t.Optional[t.Any] = None
+    ) -> None:
+        """Put a tensor to a Redis database
+
+        See Client.put_tensor() for details. The array must not be
+        modified until the coroutine completes.
+
+        :param name: name for tensor for be stored at
+        :type name: str
+        :param data: numpy array or DLPack tensor of tensor data
+        :type data: np.array
+        :param dtype: data type with which to store the tensor,
+            defaults to the data type of data
+        :type dtype: numpy dtype or str, optional
+        :raises RedisReplyError: if put fails
+        """
+        typecheck(name, "name", str)
+        data = as_ndarray(data, "data")
+        data_type = Dtypes.tensor_from_numpy(data)
+        buffer = np.ascontiguousarray(Dtypes.tensor_buffer(data))
+        store_type = "" if dtype is None else Dtypes.tensor_from_dtype(dtype)
+        request_id = self._requests.put_tensor(name, data_type, buffer, store_type)
+        await self._wait("put_tensor", request_id, data, buffer)
+
+    async def get_tensor(self, name: str) -> np.ndarray:
+        """Get a tensor from the database
+
+        See Client.get_tensor() for details.
+
+        :param name: name to get tensor from
+        :type name: str
+        :raises RedisReplyError: if get fails
+        :return: numpy array of tensor data
+        :rtype: np.array
+        """
+        typecheck(name, "name", str)
+        request_id = self._requests.get_tensor(name)
+        return await self._wait("get_tensor", request_id)
+
+    async def delete_tensor(self, name: str) -> None:
+        """Delete a tensor from the database
+
+        See Client.delete_tensor() for details.
+
+        :param name: name tensor is stored at
+        :type name: str
+        :raises RedisReplyError: if deletion fails
+        """
+        typecheck(name, "name", str)
+        request_id = self._requests.delete_tensor(name)
+        await self._wait("delete_tensor", request_id)
+
+    async def tensor_exists(self, name: str) -> bool:
+        """Check if a tensor exists in the database
+
+        See Client.tensor_exists() for details.
+
+        :param name: The tensor name that will be checked in the database
+        :type name: str
+        :returns: Returns true if the tensor exists in the database
+        :rtype: bool
+        :raises RedisReplyError: if checking for tensor existence causes an error
+        """
+        typecheck(name, "name", str)
+        request_id = self._requests.tensor_exists(name)
+        return await self._wait("tensor_exists", request_id)
+
+    async def put_dataset(self, dataset: Dataset) -> None:
+        """Put a Dataset instance into the database
+
+        See Client.put_dataset() for details. The dataset must not be
+        modified until the coroutine completes.
+
+        :param dataset: a Dataset instance
+        :type dataset: Dataset
+        :raises TypeError: if argument is not a Dataset
+        :raises RedisReplyError: if update fails
+        """
+        typecheck(dataset, "dataset", Dataset)
+        request_id = self._requests.put_dataset(dataset.get_data())
+        await self._wait("put_dataset", request_id, dataset)
+
+    async def get_dataset(self, name: str) -> Dataset:
+        """Get a dataset from the database
+
+        See Client.get_dataset() for details.
+
+        :param name: name the dataset is stored under
+        :type name: str
+        :raises RedisReplyError: if retrieval fails
+        :return: Dataset instance
+        :rtype: Dataset
+        """
+        typecheck(name, "name", str)
+        request_id = self._requests.get_dataset(name)
+        dataset = await self._wait("get_dataset", request_id)
+        return Dataset.from_pybind(dataset)
+
+    async def delete_dataset(self, name: str) -> None:
+        """Delete a dataset within the database
+
+        See Client.delete_dataset() for details.
+
+        :param name: name of the dataset
+        :type name: str
+        :raises RedisReplyError: if deletion fails
+        """
+        typecheck(name, "name", str)
+        request_id = self._requests.delete_dataset(name)
+        await self._wait("delete_dataset", request_id)
+
+    async def dataset_exists(self, name: str) -> bool:
+        """Check if a dataset exists in the database
+
+        See Client.dataset_exists() for details.
+
+        :param name: The dataset name that will be checked in the database
+        :type name: str
+        :returns: Returns true if the dataset exists in the database
+        :rtype: bool
+        :raises RedisReplyError: if `dataset_exists` fails (i.e. causes an error)
+        """
+        typecheck(name, "name", str)
+        request_id = self._requests.dataset_exists(name)
+        return await self._wait("dataset_exists", request_id)
+
+    async def run_model(
+        self,
+        name: str,
+        inputs: t.Optional[t.Union[str, t.List[str]]] = None,
+        outputs: t.Optional[t.Union[str, t.List[str]]] = None,
+    ) -> None:
+        """Execute a stored model
+
+        See Client.run_model() for details.
+
+        :param name: name for stored model
+        :type name: str
+        :param inputs: names of stored inputs to provide model, defaults to None
+        :type inputs: str | list[str] | None
+        :param outputs: names to store outputs under, defaults to None
+        :type outputs: str | list[str] | None
+        :raises RedisReplyError: if model execution fails
+        """
+        typecheck(name, "name", str)
+        inputs, outputs = check_tensor_args(inputs, outputs)
+        request_id = self._requests.run_model(name, inputs, outputs)
+        await self._wait("run_model", request_id)
+
+    async def run_script(
+        self,
+        name: str,
+        fn_name: str,
+        inputs: t.Union[str, t.List[str]],
+        outputs: t.Union[str, t.List[str]]
+    ) -> None:
+        """Execute TorchScript stored inside the database
+
+        See Client.run_script() for details.
+
+        :param name: the name the script is stored under
+        :type name: str
+        :param fn_name: name of a function within the script to execute
+        :type fn_name: str
+        :param inputs: database tensor names to use as script inputs
+        :type inputs: str | list[str]
+        :param outputs: database tensor names to receive script outputs
+        :type outputs: str | list[str]
+        :raises RedisReplyError: if script execution fails
+        """
+        typecheck(name, "name", str)
+        typecheck(fn_name, "fn_name", str)
+        inputs, outputs = check_tensor_args(inputs, outputs)
+        request_id = self._requests.run_script(name, fn_name, inputs, outputs)
+        await self._wait("run_script", request_id)
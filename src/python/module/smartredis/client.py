@@ -37,7 +37,13 @@ from .error import RedisConnectionError
 from .smartredisPy import PyClient
 from .smartredisPy import RedisReplyError as PybindRedisReplyError
 from .srobject import SRObject
-from .util import Dtypes, exception_handler, init_default, typecheck
+from .util import (
+    Dtypes,
+    as_ndarray,
+    check_tensor_args,
+    exception_handler,
+    typecheck,
+)
 
 
 class Client(SRObject):
@@ -62,6 +68,11 @@ class Client(SRObject):
         For detailed information on the second signature, please refer
         to the __address_construction() method below.
 
+        The Client releases the GIL while it waits on the database. It
+        may be shared by several Python threads, whose calls on it are
+        serialized; give each thread its own Client for parallel
+        throughput.
+
         :param a: The positional arguments supplied to this method;
                   see above for valid options
         :type a: tuple[any]; see above for valid options
@@ -167,26 +178,182 @@ class Client(SRObject):
         return self._srobject
 
     @exception_handler
-    def put_tensor(self, name: str, data: np.ndarray) -> None:
+    def put_tensor(
+        self, name: str, data: t.Any, dtype: t.Optional[t.Any] = None
+    ) -> None:
         """Put a tensor to a Redis database
 
         The final tensor key under which the tensor is stored
         may be formed by applying a prefix to the supplied
         name. See use_tensor_ensemble_prefix() for more details.
 
+        In addition to numpy arrays, any CPU tensor that implements
+        the DLPack protocol (``__dlpack__``), such as a PyTorch or JAX
+        tensor, is accepted without an intermediate copy. Arrays that
+        are not C-contiguous are gathered in a single pass.
+
+        If dtype is given, the values are converted to it while they
+        are copied into the outgoing tensor, e.g. to store float64
+        data as float32 or float16 without a temporary array. Floating
+        point values converted to integer types are rounded to the
+        nearest integer; values that are NaN or out of range of the
+        integer type raise an error.
+
+        :param name: name for tensor for be stored at
+        :type name: str
+        :param data: numpy array or DLPack tensor of tensor data
+        :type data: np.array
+        :param dtype: data type with which to store the tensor,
+            defaults to the data type of data
+        :type dtype: numpy dtype or str, optional
+        :raises RedisReplyError: if put fails
+        """
+        typecheck(name, "name", str)
+        data = as_ndarray(data, "data")
+        data_type = Dtypes.tensor_from_numpy(data)
+        buffer = Dtypes.tensor_buffer(data)
+        if dtype is None:
+            self._client.put_tensor(name, data_type, buffer)
+            return
+        store_type = Dtypes.tensor_from_dtype(dtype)
+        self._client.put_tensor_as(name, data_type, buffer, store_type)
+
+    @exception_handler
+    def put_tensor_delta(self, name: str, data: t.Any) -> None:
+        """Put a tensor to a Redis database as a delta against the
+        values this client last put under the same name
+
+        This is intended for tensors that are overwritten with slowly
+        changing values, e.g. once per time step. Only the bytewise
+        XOR with the previously sent values is sent, compressed,
+        except for a full keyframe every SR_DELTA_KEYFRAME_INTERVAL
+        puts and whenever the tensor type or shape changes. Readers
+        reconstruct the current values transparently with
+        get_tensor() and unpack_tensor(). Only one client should put
+        deltas under a given name.
+
+        The final tensor key under which the tensor is stored
+        may be formed by applying a prefix to the supplied
+        name. See use_tensor_ensemble_prefix() for more details.
+
+        :param name: name for tensor for be stored at
+        :type name: str
+        :param data: numpy array or DLPack tensor of tensor data
+        :type data: np.array
+        :raises RedisReplyError: if put fails
+        """
+        typecheck(name, "name", str)
+        data = as_ndarray(data, "data")
+        data_type = Dtypes.tensor_from_numpy(data)
+        buffer = Dtypes.tensor_buffer(data)
+        self._client.put_tensor_delta(name, data_type, buffer)
+
+    @exception_handler
+    def put_tensor_tiled(
+        self, name: str, data: t.Any, tile_shape: t.Sequence[int]
+    ) -> None:
+        """Put a tensor to a Redis database split into N-dimensional tiles
+
+        Each tile is stored under its own key, so that a sub-region of
+        the tensor can later be read with get_tensor_slice() by fetching
+        only the tiles it intersects. In a cluster the tiles are spread
+        over the shards. Tiles at the upper edge of a dimension that
+        does not divide into whole tiles are smaller. The whole tensor
+        can still be read with get_tensor() and unpack_tensor().
+
+        The final tensor key under which the tensor is stored
+        may be formed by applying a prefix to the supplied
+        name. See use_tensor_ensemble_prefix() for more details.
+
         :param name: name for tensor for be stored at
         :type name: str
-        :param data: numpy array of tensor data
+        :param data: numpy array or DLPack tensor of tensor data
         :type data: np.array
+        :param tile_shape: number of elements along each dimension
+            of a tile
+        :type tile_shape: sequence of int
         :raises RedisReplyError: if put fails
         """
         typecheck(name, "name", str)
-        typecheck(data, "data", np.ndarray)
-        dtype = Dtypes.tensor_from_numpy(data)
-        if data.base is None:
-            self._client.put_tensor(name, dtype, data)
+        data = as_ndarray(data, "data")
+        data_type = Dtypes.tensor_from_numpy(data)
+        buffer = Dtypes.tensor_buffer(data)
+        self._client.put_tensor_tiled(name, data_type, buffer, list(tile_shape))
+
+    @exception_handler
+    def put_tensor_from_file(
+        self,
+        name: str,
+        path: t.Union[str, "os.PathLike[str]"],
+        shape: t.Optional[t.Sequence[int]] = None,
+        dtype: t.Optional[t.Any] = None,
+        offset: int = 0,
+    ) -> None:
+        """Put a tensor to a Redis database from a file
+
+        The file is mapped into memory and sent without being read into
+        a buffer first, so the memory used stays small regardless of
+        the size of the tensor. If shape is not given, the file must be
+        a .npy file, whose header gives the shape and data type.
+        Otherwise the file holds raw C ordered values of the given
+        shape and dtype, starting offset bytes into the file.
+
+        The final tensor key under which the tensor is stored
+        may be formed by applying a prefix to the supplied
+        name. See use_tensor_ensemble_prefix() for more details.
+
+        :param name: name for tensor for be stored at
+        :type name: str
+        :param path: path of the file
+        :type path: str or os.PathLike
+        :param shape: shape of the tensor in a raw file
+        :type shape: sequence of int, optional
+        :param dtype: data type of the tensor in a raw file
+        :type dtype: numpy dtype or str, optional
+        :param offset: position in bytes of the first value in a raw file
+        :type offset: int
+        :raises RedisReplyError: if the file cannot be read or put fails
+        """
+        typecheck(name, "name", str)
+        typecheck(offset, "offset", int)
+        if shape is None:
+            dims: t.List[int] = []
+            data_type = ""
         else:
-            self._client.put_tensor(name, dtype, data.copy())
+            if dtype is None:
+                raise TypeError("dtype must be given with the shape of a raw file")
+            dims = list(shape)
+            data_type = Dtypes.tensor_from_dtype(dtype)
+        self._client.put_tensor_from_file(
+            name, os.fspath(path), dims, data_type, offset
+        )
+
+    @exception_handler
+    def append_to_tensor(self, name: str, data: t.Any) -> None:
+        """Append a record to a tensor that grows along its leading dimension
+
+        This is intended for time series, such as a diagnostic recorded
+        every step. Only the new record is sent, and the stored tensor
+        has the number of records as its leading dimension followed by
+        the shape of a record. All records must have the same shape and
+        data type. The whole tensor can be read with get_tensor() and a
+        window of records with get_tensor_range().
+
+        The final tensor key under which the tensor is stored
+        may be formed by applying a prefix to the supplied
+        name. See use_tensor_ensemble_prefix() for more details.
+
+        :param name: name of the appendable tensor
+        :type name: str
+        :param data: numpy array or DLPack tensor of the record
+        :type data: np.array
+        :raises RedisReplyError: if the append fails
+        """
+        typecheck(name, "name", str)
+        data = as_ndarray(data, "data")
+        data_type = Dtypes.tensor_from_numpy(data)
+        buffer = Dtypes.tensor_buffer(data)
+        self._client.append_to_tensor(name, data_type, buffer)
 
     @exception_handler
     def get_tensor(self, name: str) -> np.ndarray:
@@ -197,6 +364,9 @@ class Client(SRObject):
         name. See set_data_source()
         and use_tensor_ensemble_prefix() for more details.
 
+        The returned array supports the DLPack protocol, so it can
+        be handed to e.g. ``torch.from_dlpack()`` without a copy.
+
         :param name: name to get tensor from
         :type name: str
         :raises RedisReplyError: if get fails
@@ -206,6 +376,140 @@ class Client(SRObject):
         typecheck(name, "name", str)
         return self._client.get_tensor(name)
 
+    @exception_handler
+    def get_tensor_range(self, name: str, start: int, stop: int) -> np.ndarray:
+        """Get a window of the records of a tensor put with append_to_tensor()
+
+        The records from start up to but not including stop are joined
+        into an array whose leading dimension is the number of records.
+        A window extending past the last record is shortened to the
+        records that exist.
+
+        The tensor key used to locate the tensor
+        may be formed by applying a prefix to the supplied
+        name. See set_data_source()
+        and use_tensor_ensemble_prefix() for more details.
+
+        :param name: name of the appendable tensor
+        :type name: str
+        :param start: index of the first record
+        :type start: int
+        :param stop: index one past the last record
+        :type stop: int
+        :raises RedisReplyError: if the window holds no records
+        :return: numpy array of the records
+        :rtype: np.array
+        """
+        typecheck(name, "name", str)
+        typecheck(start, "start", int)
+        typecheck(stop, "stop", int)
+        return self._client.get_tensor_range(name, start, stop)
+
+    @exception_handler
+    def unpack_tensor(self, name: str, out: t.Any, convert: bool = False) -> None:
+        """Get a tensor from the database into an existing array
+
+        The tensor key used to locate the tensor
+        may be formed by applying a prefix to the supplied
+        name. See set_data_source()
+        and use_tensor_ensemble_prefix() for more details.
+
+        Unlike get_tensor(), no new array is allocated, so the same
+        memory can be reused across calls. The output may be a numpy
+        array or any writeable CPU tensor that implements the DLPack
+        protocol (``__dlpack__``). It must have the shape and data
+        type of the stored tensor, unless convert is set, in which
+        case the values are converted to the data type of out with the
+        same rules as put_tensor().
+
+        :param name: name to get tensor from
+        :type name: str
+        :param out: array that receives the tensor data
+        :type out: np.array
+        :param convert: whether to convert the tensor values to the
+            data type of out, defaults to False
+        :type convert: bool, optional
+        :raises RedisReplyError: if get fails or out does not match
+            the stored tensor
+        """
+        typecheck(name, "name", str)
+        typecheck(convert, "convert", bool)
+        out = as_ndarray(out, "out")
+        dtype = Dtypes.tensor_from_numpy(out)
+        if convert:
+            self._client.unpack_tensor_as(name, dtype, Dtypes.tensor_buffer(out))
+        else:
+            self._client.unpack_tensor(name, dtype, Dtypes.tensor_buffer(out))
+
+    @exception_handler
+    def unpack_tensor_to_file(
+        self, name: str, path: t.Union[str, "os.PathLike[str]"]
+    ) -> None:
+        """Get a tensor from the database into a file
+
+        The file is created, or replaced, and mapped into memory. If
+        path ends in .npy, the file is written in .npy format and can
+        be loaded with numpy.load(); otherwise it holds only the raw C
+        ordered values. The chunks or tiles of a large tensor are
+        written straight into the file.
+
+        The tensor key used to locate the tensor
+        may be formed by applying a prefix to the supplied
+        name. See set_data_source()
+        and use_tensor_ensemble_prefix() for more details.
+
+        :param name: name to get tensor from
+        :type name: str
+        :param path: path of the file
+        :type path: str or os.PathLike
+        :raises RedisReplyError: if get fails or the file cannot be written
+        """
+        typecheck(name, "name", str)
+        self._client.unpack_tensor_to_file(name, os.fspath(path))
+
+    @exception_handler
+    def get_tensor_slice(
+        self,
+        name: str,
+        offsets: t.Sequence[int],
+        counts: t.Sequence[int],
+        out: t.Any,
+    ) -> t.Any:
+        """Get a sub-region (hyperslab) of a tensor into an existing array
+
+        The region starts at the coordinates given by offsets and spans
+        counts values along each dimension. For a tensor put with
+        put_tensor_tiled(), only the tiles intersecting the region are
+        fetched, in parallel across the shards of a cluster; any other
+        tensor is fetched whole and the region copied out of it.
+
+        The tensor key used to locate the tensor
+        may be formed by applying a prefix to the supplied
+        name. See set_data_source()
+        and use_tensor_ensemble_prefix() for more details.
+
+        :param name: name to get tensor from
+        :type name: str
+        :param offsets: coordinates of the first value of the region
+        :type offsets: sequence of int
+        :param counts: number of values of the region along each dimension
+        :type counts: sequence of int
+        :param out: writeable array of shape counts and the data type
+            of the stored tensor that receives the region
+        :type out: np.array
+        :raises RedisReplyError: if get fails or the region is outside
+            the tensor
+        :return: out
+        :rtype: np.array
+        """
+        typecheck(name, "name", str)
+        buffer = as_ndarray(out, "out")
+        dtype = Dtypes.tensor_from_numpy(buffer)
+        self._client.unpack_tensor_slice(
+            name, dtype, list(offsets), list(counts), Dtypes.tensor_buffer(buffer)
+        )
+        return out
+
     @exception_handler
     def delete_tensor(self, name: str) -> None:
         """Delete a tensor from the database
@@ -301,6 +605,48 @@ class Client(SRObject):
         python_dataset = Dataset.from_pybind(dataset)
         return python_dataset
 
+    @exception_handler
+    def put_datasets(self, datasets: t.List[Dataset]) -> None:
+        """Put multiple Dataset instances into the database
+
+        The commands for all datasets are sent together, in one
+        pipeline per database shard, which avoids a round trip
+        per dataset. The final dataset keys are generated as for
+        put_dataset().
+
+        :param datasets: Dataset instances to store
+        :type datasets: list[Dataset]
+        :raises TypeError: if argument is not a list of Datasets
+        :raises RedisReplyError: if update fails
+        """
+        typecheck(datasets, "datasets", list)
+        for dataset in datasets:
+            typecheck(dataset, "dataset", Dataset)
+        pybind_datasets = [dataset.get_data() for dataset in datasets]
+        self._client.put_datasets(pybind_datasets)
+
+    @exception_handler
+    def get_datasets(self, names: t.List[str]) -> t.List[Dataset]:
+        """Get multiple datasets from the database
+
+        The dataset keys used to locate the datasets
+        may be formed by applying a prefix to the supplied
+        names. See set_data_source()
+        and use_dataset_ensemble_prefix() for more details.
+
+        :param names: names the datasets are stored under
+        :type names: list[str]
+        :raises RedisReplyError: if retrieval fails or any dataset
+            does not exist
+        :return: Dataset instances, in the order of names
+        :rtype: list[Dataset]
+        """
+        typecheck(names, "names", list)
+        for name in names:
+            typecheck(name, "name", str)
+        datasets = self._client.get_datasets(names)
+        return [Dataset.from_pybind(dataset) for dataset in datasets]
+
     @exception_handler
     def delete_dataset(self, name: str) -> None:
         """Delete a dataset within the database
@@ -575,7 +921,7 @@ class Client(SRObject):
         """
         typecheck(name, "name", str)
         typecheck(fn_name, "fn_name", str)
-        inputs, outputs = self.__check_tensor_args(inputs, outputs)
+        inputs, outputs = check_tensor_args(inputs, outputs)
         self._client.run_script(name, fn_name, inputs, outputs)
 
     @exception_handler
@@ -620,7 +966,7 @@ class Client(SRObject):
         typecheck(offset, "offset", int)
         typecheck(first_gpu, "first_gpu", int)
         typecheck(num_gpus, "num_gpus", int)
-        inputs, outputs = self.__check_tensor_args(inputs, outputs)
+        inputs, outputs = check_tensor_args(inputs, outputs)
         self._client.run_script_multigpu(
             name, fn_name, inputs, outputs, offset, first_gpu, num_gpus
         )
@@ -738,7 +1084,7 @@ class Client(SRObject):
         typecheck(tag, "tag", str)
         device = self.__check_device(device)
         backend = self.__check_backend(backend)
-        inputs, outputs = self.__check_tensor_args(inputs, outputs)
+        inputs, outputs = check_tensor_args(inputs, outputs)
         self._client.set_model(
             name,
             model,
@@ -810,7 +1156,7 @@ class Client(SRObject):
         typecheck(min_batch_timeout, "min_batch_timeout", int)
         typecheck(tag, "tag", str)
         backend = self.__check_backend(backend)
-        inputs, outputs = self.__check_tensor_args(inputs, outputs)
+        inputs, outputs = check_tensor_args(inputs, outputs)
         self._client.set_model_multigpu(
             name,
             model,
@@ -883,7 +1229,7 @@ class Client(SRObject):
         device = self.__check_device(device)
         backend = self.__check_backend(backend)
         m_file = self.__check_file(model_file)
-        inputs, outputs = self.__check_tensor_args(inputs, outputs)
+        inputs, outputs = check_tensor_args(inputs, outputs)
         self._client.set_model_from_file(
             name,
             m_file,
@@ -957,7 +1303,7 @@ class Client(SRObject):
         typecheck(tag, "tag", str)
         backend = self.__check_backend(backend)
         m_file = self.__check_file(model_file)
-        inputs, outputs = self.__check_tensor_args(inputs, outputs)
+        inputs, outputs = check_tensor_args(inputs, outputs)
         self._client.set_model_from_file_multigpu(
             name,
             m_file,
@@ -995,7 +1341,7 @@ class Client(SRObject):
         :raises RedisReplyError: if model execution fails
         """
         typecheck(name, "name", str)
-        inputs, outputs = self.__check_tensor_args(inputs, outputs)
+        inputs, outputs = check_tensor_args(inputs, outputs)
         self._client.run_model(name, inputs, outputs)
 
     @exception_handler
@@ -1034,7 +1380,7 @@ class Client(SRObject):
         typecheck(offset, "offset", int)
         typecheck(first_gpu, "first_gpu", int)
         typecheck(num_gpus, "num_gpus", int)
-        inputs, outputs = self.__check_tensor_args(inputs, outputs)
+        inputs, outputs = check_tensor_args(inputs, outputs)
         self._client.run_model_multigpu(
             name, inputs, outputs, offset, first_gpu, num_gpus
         )
@@ -1373,6 +1719,97 @@ class Client(SRObject):
         typecheck(use_prefix, "use_prefix", bool)
         return self._client.use_dataset_ensemble_prefix(use_prefix)
 
+    @exception_handler
+    def use_packed_datasets(self, use_packed: bool) -> None:
+        """Control whether datasets are stored in the packed format
+
+        In the packed format, all tensors and metadata fields of a
+        dataset are serialized into a single buffer, so that
+        put_dataset() issues two commands and get_dataset() a single
+        one regardless of the number of tensors in the dataset.
+        Tensors of packed datasets cannot be used as inputs or outputs
+        of run_model() or run_script().
+        Datasets are retrieved correctly regardless of this setting,
+        as the format is detected when the dataset is read.
+        By default, the client does not pack datasets.
+
+        :param use_packed: If set to true, all future put_dataset()
+                           operations will use the packed format
+        :type use_packed: bool
+        """
+        typecheck(use_packed, "use_packed", bool)
+        return self._client.use_packed_datasets(use_packed)
+
+    @exception_handler
+    def use_dataset_transactions(self, use_transactions: bool) -> None:
+        """Control whether datasets are published atomically
+
+        When enabled, the commands that place a dataset in the database
+        are wrapped in a MULTI/EXEC transaction, so other clients observe
+        either the complete dataset or no dataset at all. Consumers then
+        do not need to poll for the dataset to be complete.
+        By default, datasets are published in a pipeline and completion
+        is signalled by the dataset ack field.
+
+        :param use_transactions: If set to true, all future dataset
+                                 placement operations will be atomic
+        :type use_transactions: bool
+        """
+        typecheck(use_transactions, "use_transactions", bool)
+        return self._client.use_dataset_transactions(use_transactions)
+
+    @exception_handler
+    def set_tensor_ttl(self, ttl_ms: int) -> None:
+        """Set the time to live of tensors placed by put_tensor()
+
+        The expiry is applied in the same pipeline as the tensor
+        placement, so old tensors are reclaimed by the database
+        without explicit delete_tensor() calls.
+        By default, tensors do not expire.
+
+        :param ttl_ms: The time to live in milliseconds, or zero
+                       to disable expiry
+        :type ttl_ms: int
+        :raises RedisReplyError: if ttl_ms is negative
+        """
+        typecheck(ttl_ms, "ttl_ms", int)
+        return self._client.set_tensor_ttl(ttl_ms)
+
+    @exception_handler
+    def set_dataset_ttl(self, ttl_ms: int) -> None:
+        """Set the time to live of datasets
+
+        The expiry is applied to the metadata and every tensor of
+        datasets placed by put_dataset(), put_datasets() and
+        copy_dataset(), in the same pipeline as the placement.
+        By default, datasets do not expire.
+
+        :param ttl_ms: The time to live in milliseconds, or zero
+                       to disable expiry
+        :type ttl_ms: int
+        :raises RedisReplyError: if ttl_ms is negative
+        """
+        typecheck(ttl_ms, "ttl_ms", int)
+        return self._client.set_dataset_ttl(ttl_ms)
+
+    @exception_handler
+    def set_list_retention(self, max_length: int) -> None:
+        """Set the number of entries retained in aggregation lists
+
+        append_to_list() trims the list to its most recent
+        max_length entries in the same pipeline as the append.
+        The datasets referenced by trimmed entries are not deleted;
+        combine this setting with set_dataset_ttl() to bound the
+        memory they use. By default, lists are not trimmed.
+
+        :param max_length: The number of entries to retain, or zero
+                           to disable trimming
+        :type max_length: int
+        :raises RedisReplyError: if max_length is negative
+        """
+        typecheck(max_length, "max_length", int)
+        return self._client.set_list_retention(max_length)
+
     @exception_handler
     def get_db_node_info(self, addresses: t.List[str]) -> t.List[t.Dict]:
         """Returns information about given database nodes
@@ -1836,20 +2273,6 @@ class Client(SRObject):
 
     # ---- helpers --------------------------------------------------------
 
-    @staticmethod
-    def __check_tensor_args(
-        inputs: t.Optional[t.Union[t.List[str], str]],
-        outputs: t.Optional[t.Union[t.List[str], str]],
-    ) -> t.Tuple[t.List[str], t.List[str]]:
-        inputs = init_default([], inputs, (list, str))
-        outputs = init_default([], outputs, (list, str))
-        assert inputs is not None and outputs is not None
-        if isinstance(inputs, str):
-            inputs = [inputs]
-        if isinstance(outputs, str):
-            outputs = [outputs]
-        return inputs, outputs
-
     @staticmethod
     def __check_backend(backend: str) -> str:
         backend = backend.upper()
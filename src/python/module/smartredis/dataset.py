@@ -108,11 +108,11 @@ class Dataset(SRObject):
         typecheck(data, "data", np.ndarray)
         if data.base is None:
             dtype = Dtypes.tensor_from_numpy(data)
-            self._data.add_tensor(name, data, dtype)
+            self._data.add_tensor(name, Dtypes.tensor_buffer(data), dtype)
         else:
             view_copy = data.copy()
             dtype = Dtypes.tensor_from_numpy(view_copy)
-            self._data.add_tensor(name, view_copy, dtype)
+            self._data.add_tensor(name, Dtypes.tensor_buffer(view_copy), dtype)
 
     @exception_handler
     def get_tensor(self, name: str) -> np.ndarray:
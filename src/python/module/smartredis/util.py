@@ -41,24 +41,66 @@ if t.TYPE_CHECKING:
     _RT = t.TypeVar("_RT")
 
 
+def _bfloat16_type() -> t.Type:
+    """Get the numpy scalar type used for bfloat16 tensors
+
+    :return: The ml_dtypes bfloat16 type if ml_dtypes is installed,
+        otherwise np.uint16, which holds the raw 16 bit patterns
+    :rtype: type
+    """
+    try:
+        import ml_dtypes  # pylint: disable=import-outside-toplevel
+
+        return ml_dtypes.bfloat16
+    except ImportError:
+        return np.uint16
+
+
 class Dtypes:
     @staticmethod
     def tensor_from_numpy(array: np.ndarray) -> str:
+        return Dtypes.tensor_from_dtype(array.dtype)
+
+    @staticmethod
+    def tensor_from_dtype(dtype: t.Any) -> str:
         mapping = {
             "float64": "DOUBLE",
             "float32": "FLOAT",
+            "float16": "FLOAT16",
+            "bfloat16": "BFLOAT16",
             "uint8": "UINT8",
             "uint16": "UINT16",
+            "uint32": "UINT32",
+            "uint64": "UINT64",
             "int8": "INT8",
             "int16": "INT16",
             "int32": "INT32",
             "int64": "INT64",
+            "bool": "BOOL",
         }
-        dtype = str(array.dtype)
+        # bfloat16 is only known to numpy once ml_dtypes is imported
+        dtype = "bfloat16" if str(dtype) == "bfloat16" else str(np.dtype(dtype))
         if dtype in mapping:
             return mapping[dtype]
         raise TypeError(f"Incompatible tensor type provided {dtype}")
 
+    @staticmethod
+    def tensor_buffer(array: np.ndarray) -> np.ndarray:
+        """Return a view of a tensor array that exposes the buffer protocol
+
+        numpy has no native bfloat16 type, and arrays of the bfloat16
+        type provided by ml_dtypes cannot be exported through the buffer
+        protocol. Their 16 bit patterns are passed on as uint16 instead.
+
+        :param array: The tensor array
+        :type array: np.ndarray
+        :return: The array, or a uint16 view of a bfloat16 array
+        :rtype: np.ndarray
+        """
+        if str(array.dtype) == "bfloat16":
+            return array.view(np.uint16)
+        return array
+
     @staticmethod
     def metadata_from_numpy(array: np.ndarray) -> str:
         mapping = {
@@ -87,6 +129,9 @@ class Dtypes:
             "INT16": np.int16,
             "INT32": np.int32,
             "INT64": np.int64,
+            "BOOL": np.bool_,
+            "FLOAT16": np.float16,
+            "BFLOAT16": _bfloat16_type(),
             "STRING": str,
         }
         if type_name in mapping:
@@ -110,6 +155,79 @@ def init_default(
     return init_value
 
 
+def as_ndarray(data: t.Any, arg_name: str) -> np.ndarray:
+    """Return a numpy view of a numpy array or DLPack tensor
+
+    :param data: A numpy array or object implementing __dlpack__
+    :type data: np.ndarray | DLPack tensor
+    :param arg_name: The name of the argument, for error messages
+    :type arg_name: str
+    :raises TypeError: if data is neither a numpy array nor
+        a DLPack tensor
+    :return: The data as a numpy array, sharing its memory
+    :rtype: np.ndarray
+    """
+    if isinstance(data, np.ndarray):
+        return data
+    if hasattr(data, "__dlpack__"):
+        if not hasattr(np, "from_dlpack"):
+            raise TypeError(
+                f"Argument {arg_name} is a DLPack tensor, which "
+                "requires numpy 1.22 or later"
+            )
+        return np.from_dlpack(data)
+    raise TypeError(
+        f"Argument {arg_name} is of type {type(data).__name__}, "
+        "not a numpy array or DLPack tensor"
+    )
+
+
+def check_tensor_args(
+    inputs: t.Optional[t.Union[t.List[str], str]],
+    outputs: t.Optional[t.Union[t.List[str], str]],
+) -> t.Tuple[t.List[str], t.List[str]]:
+    """Normalize the input and output tensor names of a model or script
+
+    :param inputs: A tensor name, a list of tensor names or None
+    :type inputs: str | list[str] | None
+    :param outputs: A tensor name, a list of tensor names or None
+    :type outputs: str | list[str] | None
+    :raises TypeError: if an argument is of another type
+    :return: The input and output tensor names as lists
+    :rtype: tuple[list[str], list[str]]
+    """
+    inputs = init_default([], inputs, (list, str))
+    outputs = init_default([], outputs, (list, str))
+    assert inputs is not None and outputs is not None
+    if isinstance(inputs, str):
+        inputs = [inputs]
+    if isinstance(outputs, str):
+        outputs = [outputs]
+    return inputs, outputs
+
+
+def convert_error(cpp_error: PybindRedisReplyError, method_name: str) -> Exception:
+    """Convert an exception from the SmartRedis library to the matching
+    class of the smartredis.error module
+
+    :param cpp_error: The exception raised by the library
+    :type cpp_error: RedisReplyError from the pybind module
+    :param method_name: The fully specified name of the calling method
+    :type method_name: str
+    :return: The converted exception
+    :rtype: RedisReplyError
+    """
+    # The smartredis.error hierarchy exactly
+    # parallels the one built via pybind to enable this
+    exception_name = cpp_error.__class__.__name__
+    error_loc = c_get_last_error_location()
+    if error_loc == "unavailable":
+        cpp_error_str = str(cpp_error)
+    else:
+        cpp_error_str = f"File {error_loc}, in SmartRedis library\n{str(cpp_error)}"
+    return getattr(error, exception_name)(cpp_error_str, method_name)
+
+
 def exception_handler(func: "t.Callable[_PR, _RT]") -> "t.Callable[_PR, _RT]":
     """Route exceptions raised in processing SmartRedis API calls to our
     Python wrappers
@@ -141,18 +259,7 @@ def exception_handler(func: "t.Callable[_PR, _RT]") -> "t.Callable[_PR, _RT]":
                 src_class = args[0].__class__
             # Build the fully specified name of the calling context
             method_name = src_class.__name__ + "." + func.__name__
-            # Get our exception from the global symbol table.
-            # The smartredis.error hierarchy exactly
-            # parallels the one built via pybind to enable this
-            exception_name = cpp_error.__class__.__name__
-            error_loc = c_get_last_error_location()
-            if error_loc == "unavailable":
-                cpp_error_str = str(cpp_error)
-            else:
-                cpp_error_str = (
-                    f"File {error_loc}, in SmartRedis library\n{str(cpp_error)}"
-                )
-            raise getattr(error, exception_name)(cpp_error_str, method_name) from None
+            raise convert_error(cpp_error, method_name) from None
 
     return smartredis_api_wrapper
 
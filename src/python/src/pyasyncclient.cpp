@@ -0,0 +1,295 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "pyasyncclient.h"
+#include "srexception.h"
+
+using namespace SmartRedis;
+
+namespace py = pybind11;
+
+// PyAsyncClient constructor
+PyAsyncClient::PyAsyncClient(std::vector<PyClient*> clients,
+                             const std::string& logger_name)
+    : PySRObject(logger_name), _clients(clients), _next_id(0),
+      _n_in_flight(0), _shut_down(false)
+{
+    if (_clients.size() == 0)
+        throw SRParameterException("An AsyncClient needs a connection");
+
+    // Both ends of the pipe are non-blocking: workers must never wait
+    // on a full pipe, and the event loop drains it without blocking
+    if (pipe(_completion_pipe) != 0) {
+        throw SRInternalException("Failed to create the completion pipe: " +
+                                  std::string(std::strerror(errno)));
+    }
+    for (int end = 0; end < 2; end++) {
+        int flags = fcntl(_completion_pipe[end], F_GETFL);
+        fcntl(_completion_pipe[end], F_SETFL, flags | O_NONBLOCK);
+        fcntl(_completion_pipe[end], F_SETFD, FD_CLOEXEC);
+    }
+
+    for (size_t i = 0; i < _clients.size(); i++)
+        _free_clients.push_back(i);
+    _tp = std::make_unique<ThreadPool>(_clients[0]->_client, _clients.size());
+}
+
+// PyAsyncClient destructor
+PyAsyncClient::~PyAsyncClient()
+{
+    shutdown();
+    close(_completion_pipe[0]);
+    close(_completion_pipe[1]);
+}
+
+// Get the file descriptor that becomes readable when requests complete
+int PyAsyncClient::completion_fd()
+{
+    return _completion_pipe[0];
+}
+
+// Take the identifiers of the requests completed since the last call
+std::vector<uint64_t> PyAsyncClient::completed()
+{
+    // Drain the pipe before taking the list, so that a completion
+    // recorded in between leaves the pipe readable
+    char buf[256];
+    while (read(_completion_pipe[0], buf, sizeof(buf)) > 0)
+        ; // Discard the wakeups
+
+    std::vector<uint64_t> request_ids;
+    std::unique_lock<std::mutex> lock(_lock);
+    request_ids.swap(_completed);
+    return request_ids;
+}
+
+// Take the result of a completed request
+py::object PyAsyncClient::result(uint64_t request_id)
+{
+    Result result;
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        auto it = _results.find(request_id);
+        if (it == _results.end()) {
+            throw SRInternalException("Request " + std::to_string(request_id) +
+                                      " has not completed");
+        }
+        result = std::move(it->second);
+        _results.erase(it);
+    }
+
+    if (result.error)
+        std::rethrow_exception(result.error);
+    if (result.tensor != NULL)
+        return tensor_to_array(result.tensor.release());
+    if (result.dataset != NULL) {
+        return py::cast(new PyDataset(result.dataset.release()),
+                        py::return_value_policy::take_ownership);
+    }
+    if (result.has_flag)
+        return py::bool_(result.flag);
+    return py::none();
+}
+
+// Wait for the requests in flight and stop the worker threads
+void PyAsyncClient::shutdown()
+{
+    py::gil_scoped_release release;
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _shut_down = true;
+        _request_done.wait(lock, [this]() { return _n_in_flight == 0; });
+    }
+    if (_tp != NULL) {
+        _tp->shutdown();
+        _tp.reset();
+    }
+}
+
+// Submit a put_tensor request
+uint64_t PyAsyncClient::put_tensor(const std::string& name,
+                                   const std::string& type,
+                                   py::array data,
+                                   const std::string& store_type)
+{
+    if (!(data.flags() & py::array::c_style))
+        throw SRParameterException("The tensor data must be C-contiguous");
+    py::buffer_info buffer = data.request();
+    void* ptr = buffer.ptr;
+    std::vector<size_t> dims(buffer.shape.begin(), buffer.shape.end());
+    SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
+    SRTensorType stype =
+        store_type.size() > 0 ? TENSOR_TYPE_MAP.at(store_type) : ttype;
+
+    return _submit([name, ptr, dims, ttype, stype](Client& client, Result&) {
+        if (stype == ttype)
+            client.put_tensor(name, ptr, dims, ttype, SRMemLayoutContiguous);
+        else
+            client.put_tensor_as(name, ptr, dims, ttype, stype,
+                                 SRMemLayoutContiguous);
+    });
+}
+
+// Submit a get_tensor request
+uint64_t PyAsyncClient::get_tensor(const std::string& name)
+{
+    return _submit([name](Client& client, Result& result) {
+        result.tensor.reset(client._get_tensorbase_obj(name));
+    });
+}
+
+// Submit a delete_tensor request
+uint64_t PyAsyncClient::delete_tensor(const std::string& name)
+{
+    return _submit([name](Client& client, Result&) {
+        client.delete_tensor(name);
+    });
+}
+
+// Submit a tensor_exists request
+uint64_t PyAsyncClient::tensor_exists(const std::string& name)
+{
+    return _submit([name](Client& client, Result& result) {
+        result.flag = client.tensor_exists(name);
+        result.has_flag = true;
+    });
+}
+
+// Submit a put_dataset request
+uint64_t PyAsyncClient::put_dataset(PyDataset& dataset)
+{
+    DataSet* data = dataset.get();
+    return _submit([data](Client& client, Result&) {
+        client.put_dataset(*data);
+    });
+}
+
+// Submit a get_dataset request
+uint64_t PyAsyncClient::get_dataset(const std::string& name)
+{
+    return _submit([name](Client& client, Result& result) {
+        result.dataset.reset(new DataSet(client.get_dataset(name)));
+    });
+}
+
+// Submit a delete_dataset request
+uint64_t PyAsyncClient::delete_dataset(const std::string& name)
+{
+    return _submit([name](Client& client, Result&) {
+        client.delete_dataset(name);
+    });
+}
+
+// Submit a dataset_exists request
+uint64_t PyAsyncClient::dataset_exists(const std::string& name)
+{
+    return _submit([name](Client& client, Result& result) {
+        result.flag = client.dataset_exists(name);
+        result.has_flag = true;
+    });
+}
+
+// Submit a run_model request
+uint64_t PyAsyncClient::run_model(const std::string& name,
+                                  std::vector<std::string> inputs,
+                                  std::vector<std::string> outputs)
+{
+    return _submit([name, inputs, outputs](Client& client, Result&) {
+        client.run_model(name, inputs, outputs);
+    });
+}
+
+// Submit a run_script request
+uint64_t PyAsyncClient::run_script(const std::string& name,
+                                   const std::string& function,
+                                   std::vector<std::string> inputs,
+                                   std::vector<std::string> outputs)
+{
+    return _submit([name, function, inputs, outputs](Client& client,
+                                                     Result&) {
+        client.run_script(name, function, inputs, outputs);
+    });
+}
+
+// Queue a request for the worker threads
+uint64_t PyAsyncClient::_submit(std::function<void(Client&, Result&)> request)
+{
+    uint64_t request_id = 0;
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        if (_shut_down)
+            throw SRRuntimeException("The AsyncClient has been closed");
+        request_id = _next_id++;
+        _n_in_flight++;
+    }
+    _tp->submit_job([this, request_id, request]() {
+        _execute(request_id, request);
+    });
+    return request_id;
+}
+
+// Run a request on a free connection and record its result
+void PyAsyncClient::_execute(uint64_t request_id,
+                             const std::function<void(Client&, Result&)>& request)
+{
+    // There is a connection per worker thread, so one is always free
+    size_t slot = 0;
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        slot = _free_clients.back();
+        _free_clients.pop_back();
+    }
+
+    // The connection may also be in use by its Python Client
+    Result result;
+    try {
+        std::unique_lock<std::mutex> client_lock(_clients[slot]->_client_lock);
+        request(*_clients[slot]->_client, result);
+    }
+    catch (...) {
+        result.error = std::current_exception();
+        result.tensor.reset();
+        result.dataset.reset();
+    }
+
+    // Record the result and wake the event loop
+    std::unique_lock<std::mutex> lock(_lock);
+    _free_clients.push_back(slot);
+    _results[request_id] = std::move(result);
+    if (_completed.size() == 0) {
+        char wakeup = 1;
+        (void)write(_completion_pipe[1], &wakeup, 1);
+    }
+    _completed.push_back(request_id);
+    _n_in_flight--;
+    _request_done.notify_all();
+}
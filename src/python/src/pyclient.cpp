@@ -26,9 +26,12 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <cstring>
+#include <memory>
 #include "pyclient.h"
 #include "tensorbase.h"
 #include "tensor.h"
+#include "tensorconvert.h"
 #include "srexception.h"
 
 using namespace SmartRedis;
@@ -65,7 +68,86 @@ auto pb_client_api(T&& client_api_func, const char* name)
   return decorated;
 }
 
-// Macro to invoke the decorator with a lambda function
+// Copy between a strided buffer and contiguous row-major memory in
+// one pass. If to_buffer is true, the contiguous memory is scattered
+// into the buffer; otherwise the buffer is gathered into it.
+static void strided_copy(const py::buffer_info& buffer,
+                         char* contiguous,
+                         bool to_buffer)
+{
+    if (buffer.size == 0)
+        return;
+
+    size_t item_size = buffer.itemsize;
+    if (buffer.ndim == 0) {
+        if (to_buffer)
+            std::memcpy(buffer.ptr, contiguous, item_size);
+        else
+            std::memcpy(contiguous, buffer.ptr, item_size);
+        return;
+    }
+
+    // Walk the outer dimensions like an odometer and copy the
+    // innermost dimension in a tight loop
+    size_t inner = buffer.ndim - 1;
+    py::ssize_t inner_len = buffer.shape[inner];
+    py::ssize_t inner_stride = buffer.strides[inner];
+    std::vector<py::ssize_t> index(buffer.ndim, 0);
+    char* base = static_cast<char*>(buffer.ptr);
+    size_t n_rows = buffer.size / inner_len;
+    for (size_t row = 0; row < n_rows; row++) {
+        char* item = base;
+        for (size_t d = 0; d < inner; d++)
+            item += index[d] * buffer.strides[d];
+        for (py::ssize_t i = 0; i < inner_len; i++) {
+            if (to_buffer)
+                std::memcpy(item, contiguous, item_size);
+            else
+                std::memcpy(contiguous, item, item_size);
+            contiguous += item_size;
+            item += inner_stride;
+        }
+        for (size_t d = inner; d-- > 0; ) {
+            if (++index[d] < buffer.shape[d])
+                break;
+            index[d] = 0;
+        }
+    }
+}
+
+// Point at the values of a buffer in contiguous row-major memory,
+// gathering a strided buffer into the given storage first
+static void* contiguous_values(const py::buffer_info& buffer,
+                               bool c_style,
+                               std::vector<char>& gathered)
+{
+    if (c_style)
+        return buffer.ptr;
+    gathered.resize(buffer.size * buffer.itemsize);
+    strided_copy(buffer, gathered.data(), false);
+    return gathered.data();
+}
+
+// Release the GIL and take exclusive use of the C++ client for the
+// lifetime of the guard. The C++ client is not thread safe, so Python
+// threads sharing a Client take turns; threads with their own Client
+// run in parallel. The GIL is released before the lock is taken, so a
+// thread waiting for the client never blocks the interpreter.
+class ClientCallGuard
+{
+    public:
+        ClientCallGuard(std::mutex& client_lock)
+            : _release(), _lock(client_lock) {}
+
+    private:
+        py::gil_scoped_release _release;
+        std::lock_guard<std::mutex> _lock;
+};
+
+// Macro to invoke the decorator with a lambda function.
+// Calls into the C++ client are made under a ClientCallGuard so that
+// other Python threads can run in the meantime. Python objects must
+// only be touched while the GIL is held, i.e. outside the guard.
 #define MAKE_CLIENT_API(stuff)\
     pb_client_api([&] { stuff }, __func__)()
 
@@ -73,6 +155,7 @@ PyClient::PyClient(const std::string& logger_name)
     : PySRObject(logger_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client = new Client(logger_name);
     });
 }
@@ -84,6 +167,7 @@ PyClient::PyClient(
 {
     MAKE_CLIENT_API({
         ConfigOptions* co = config_options.get();
+        ClientCallGuard guard(_client_lock);
         _client = new Client(co, logger_name);
     });
 }
@@ -92,6 +176,7 @@ PyClient::PyClient(bool cluster, const std::string& logger_name)
     : PySRObject(logger_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client = new Client(cluster, logger_name);
     });
 }
@@ -111,7 +196,7 @@ void PyClient::put_tensor(
 {
     MAKE_CLIENT_API({
         auto buffer = data.request();
-        void* ptr = buffer.ptr;
+        bool c_style = (data.flags() & py::array::c_style) != 0;
 
         // get dims
         std::vector<size_t> dims(buffer.ndim);
@@ -121,65 +206,379 @@ void PyClient::put_tensor(
 
         SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
 
+        ClientCallGuard guard(_client_lock);
+
+        // Gather strided arrays into contiguous memory
+        std::vector<char> gathered;
+        void* ptr = contiguous_values(buffer, c_style, gathered);
+
         _client->put_tensor(name, ptr, dims, ttype, SRMemLayoutContiguous);
     });
 }
 
+void PyClient::put_tensor_delta(
+    std::string& name, std::string& type, py::array data)
+{
+    MAKE_CLIENT_API({
+        auto buffer = data.request();
+        bool c_style = (data.flags() & py::array::c_style) != 0;
+
+        // get dims
+        std::vector<size_t> dims(buffer.ndim);
+        for (size_t i = 0; i < buffer.shape.size(); i++) {
+            dims[i] = (size_t)buffer.shape[i];
+        }
+
+        SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
+
+        ClientCallGuard guard(_client_lock);
+
+        // Gather strided arrays into contiguous memory
+        std::vector<char> gathered;
+        void* ptr = contiguous_values(buffer, c_style, gathered);
+
+        _client->put_tensor_delta(name, ptr, dims, ttype,
+                                  SRMemLayoutContiguous);
+    });
+}
+
+void PyClient::put_tensor_tiled(
+    std::string& name, std::string& type, py::array data,
+    std::vector<size_t>& tile_dims)
+{
+    MAKE_CLIENT_API({
+        auto buffer = data.request();
+        bool c_style = (data.flags() & py::array::c_style) != 0;
+
+        // get dims
+        std::vector<size_t> dims(buffer.ndim);
+        for (size_t i = 0; i < buffer.shape.size(); i++) {
+            dims[i] = (size_t)buffer.shape[i];
+        }
+
+        SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
+
+        ClientCallGuard guard(_client_lock);
+
+        // Gather strided arrays into contiguous memory
+        std::vector<char> gathered;
+        void* ptr = contiguous_values(buffer, c_style, gathered);
+
+        _client->put_tensor_tiled(name, ptr, dims, tile_dims, ttype,
+                                  SRMemLayoutContiguous);
+    });
+}
+
+void PyClient::put_tensor_from_file(const std::string& name,
+                                    const std::string& path,
+                                    std::vector<size_t>& dims,
+                                    const std::string& type,
+                                    size_t offset)
+{
+    MAKE_CLIENT_API({
+        SRTensorType ttype = SRTensorTypeInvalid;
+        if (!type.empty())
+            ttype = TENSOR_TYPE_MAP.at(type);
+
+        ClientCallGuard guard(_client_lock);
+        _client->put_tensor_from_file(name, path, dims, ttype, offset);
+    });
+}
+
+void PyClient::append_to_tensor(
+    std::string& name, std::string& type, py::array data)
+{
+    MAKE_CLIENT_API({
+        auto buffer = data.request();
+        bool c_style = (data.flags() & py::array::c_style) != 0;
+
+        // get dims
+        std::vector<size_t> dims(buffer.ndim);
+        for (size_t i = 0; i < buffer.shape.size(); i++) {
+            dims[i] = (size_t)buffer.shape[i];
+        }
+
+        SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
+
+        ClientCallGuard guard(_client_lock);
+
+        // Gather strided arrays into contiguous memory
+        std::vector<char> gathered;
+        void* ptr = contiguous_values(buffer, c_style, gathered);
+
+        _client->append_to_tensor(name, ptr, dims, ttype,
+                                  SRMemLayoutContiguous);
+    });
+}
+
+void PyClient::put_tensor_as(
+    std::string& name, std::string& type, py::array data,
+    std::string& store_type)
+{
+    MAKE_CLIENT_API({
+        auto buffer = data.request();
+        bool c_style = (data.flags() & py::array::c_style) != 0;
+
+        // get dims
+        std::vector<size_t> dims(buffer.ndim);
+        for (size_t i = 0; i < buffer.shape.size(); i++) {
+            dims[i] = (size_t)buffer.shape[i];
+        }
+
+        SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
+        SRTensorType stype = TENSOR_TYPE_MAP.at(store_type);
+
+        ClientCallGuard guard(_client_lock);
+
+        // Gather strided arrays into contiguous memory
+        std::vector<char> gathered;
+        void* ptr = contiguous_values(buffer, c_style, gathered);
+
+        _client->put_tensor_as(name, ptr, dims, ttype, stype,
+                               SRMemLayoutContiguous);
+    });
+}
+
+// Wrap a TensorBase in a numpy array that takes ownership of it
+py::array SmartRedis::tensor_to_array(TensorBase* tensor)
+{
+    // Define py::capsule lambda function for destructor
+    py::capsule free_when_done((void*)tensor, [](void *tensor) {
+            delete reinterpret_cast<TensorBase*>(tensor);
+            });
+
+    // detect data type
+    switch (tensor->type()) {
+        case SRTensorTypeDouble: {
+            double* data = reinterpret_cast<double*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeFloat: {
+            float* data = reinterpret_cast<float*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeInt64: {
+            int64_t* data = reinterpret_cast<int64_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeInt32: {
+            int32_t* data = reinterpret_cast<int32_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeInt16: {
+            int16_t* data = reinterpret_cast<int16_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeInt8: {
+            int8_t* data = reinterpret_cast<int8_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeUint16: {
+            uint16_t* data = reinterpret_cast<uint16_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeUint8: {
+            uint8_t* data = reinterpret_cast<uint8_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeUint32: {
+            uint32_t* data = reinterpret_cast<uint32_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeUint64: {
+            uint64_t* data = reinterpret_cast<uint64_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeBool: {
+            bool* data = reinterpret_cast<bool*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeFloat16: {
+            void* data = tensor->data_view(SRMemLayoutContiguous);
+            py::dtype float16 = py::dtype::from_args(py::str("float16"));
+            return py::array(float16, tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeBFloat16: {
+            void* data = tensor->data_view(SRMemLayoutContiguous);
+            return py::array(bfloat16_dtype(), tensor->dims(), data,
+                             free_when_done);
+        }
+        default :
+            throw SRRuntimeException("Could not infer type in "\
+                                    "PyClient::get_tensor().");
+    }
+}
+
 py::array PyClient::get_tensor(const std::string& name)
 {
     return MAKE_CLIENT_API({
-        TensorBase* tensor = _client->_get_tensorbase_obj(name);
-
-        // Define py::capsule lambda function for destructor
-        py::capsule free_when_done((void*)tensor, [](void *tensor) {
-                delete reinterpret_cast<TensorBase*>(tensor);
-                });
-
-        // detect data type
-        switch (tensor->type()) {
-            case SRTensorTypeDouble: {
-                double* data = reinterpret_cast<double*>(tensor->data_view(
-                    SRMemLayoutContiguous));
-                return py::array(tensor->dims(), data, free_when_done);
-            }
-            case SRTensorTypeFloat: {
-                float* data = reinterpret_cast<float*>(tensor->data_view(
-                    SRMemLayoutContiguous));
-                return py::array(tensor->dims(), data, free_when_done);
-            }
-            case SRTensorTypeInt64: {
-                int64_t* data = reinterpret_cast<int64_t*>(tensor->data_view(
-                    SRMemLayoutContiguous));
-                return py::array(tensor->dims(), data, free_when_done);
-            }
-            case SRTensorTypeInt32: {
-                int32_t* data = reinterpret_cast<int32_t*>(tensor->data_view(
-                    SRMemLayoutContiguous));
-                return py::array(tensor->dims(), data, free_when_done);
-            }
-            case SRTensorTypeInt16: {
-                int16_t* data = reinterpret_cast<int16_t*>(tensor->data_view(
-                    SRMemLayoutContiguous));
-                return py::array(tensor->dims(), data, free_when_done);
-            }
-            case SRTensorTypeInt8: {
-                int8_t* data = reinterpret_cast<int8_t*>(tensor->data_view(
-                    SRMemLayoutContiguous));
-                return py::array(tensor->dims(), data, free_when_done);
-            }
-            case SRTensorTypeUint16: {
-                uint16_t* data = reinterpret_cast<uint16_t*>(tensor->data_view(
-                    SRMemLayoutContiguous));
-                return py::array(tensor->dims(), data, free_when_done);
-            }
-            case SRTensorTypeUint8: {
-                uint8_t* data = reinterpret_cast<uint8_t*>(tensor->data_view(
-                    SRMemLayoutContiguous));
-                return py::array(tensor->dims(), data, free_when_done);
-            }
-            default :
-                throw SRRuntimeException("Could not infer type in "\
-                                        "PyClient::get_tensor().");
+        TensorBase* tensor = NULL;
+        {
+            ClientCallGuard guard(_client_lock);
+            tensor = _client->_get_tensorbase_obj(name);
+        }
+
+        return tensor_to_array(tensor);
+    });
+}
+
+py::array PyClient::get_tensor_range(const std::string& name,
+                                     size_t start,
+                                     size_t stop)
+{
+    return MAKE_CLIENT_API({
+        TensorBase* tensor = NULL;
+        {
+            ClientCallGuard guard(_client_lock);
+            tensor = _client->_get_tensor_range_obj(name, start, stop);
+        }
+
+        return tensor_to_array(tensor);
+    });
+}
+
+void PyClient::unpack_tensor(const std::string& name,
+                             const std::string& type,
+                             py::array out)
+{
+    MAKE_CLIENT_API({
+        if (!out.writeable())
+            throw SRParameterException("The output array is not writeable");
+        py::buffer_info buffer = out.request(true);
+        bool contiguous = (out.flags() & py::array::c_style) != 0;
+        SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
+
+        ClientCallGuard guard(_client_lock);
+
+        // Chunked and tiled tensors are reassembled directly into
+        // contiguous arrays
+        CommandReply reply;
+        std::string decompressed;
+        SRTensorType reply_type;
+        std::vector<size_t> dims;
+        std::string_view blob;
+        void* dest = contiguous ? buffer.ptr : NULL;
+        _client->_fetch_named_tensor(name, reply, decompressed, reply_type,
+                                     dims, blob, dest, ttype,
+                                     buffer.size * buffer.itemsize);
+
+        // The array must match the stored tensor exactly
+        if (reply_type != ttype) {
+            throw SRParameterException("The type of the output array does "\
+                                       "not match the type of tensor " + name);
+        }
+        bool same_shape = dims.size() == (size_t)buffer.ndim;
+        for (size_t i = 0; same_shape && i < dims.size(); i++)
+            same_shape = dims[i] == (size_t)buffer.shape[i];
+        if (!same_shape) {
+            throw SRParameterException("The shape of the output array does "\
+                                       "not match the shape of tensor " + name);
+        }
+
+        // Other tensors are copied once, straight from the reply
+        if (blob.data() == (const char*)dest)
+            return;
+        if (contiguous)
+            std::memcpy(buffer.ptr, blob.data(), blob.size());
+        else
+            strided_copy(buffer, const_cast<char*>(blob.data()), true);
+    });
+}
+
+void PyClient::unpack_tensor_to_file(const std::string& name,
+                                     const std::string& path)
+{
+    MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
+        _client->unpack_tensor_to_file(name, path);
+    });
+}
+
+void PyClient::unpack_tensor_slice(const std::string& name,
+                                   const std::string& type,
+                                   std::vector<size_t>& offsets,
+                                   std::vector<size_t>& counts,
+                                   py::array out)
+{
+    MAKE_CLIENT_API({
+        if (!out.writeable())
+            throw SRParameterException("The output array is not writeable");
+        py::buffer_info buffer = out.request(true);
+        bool contiguous = (out.flags() & py::array::c_style) != 0;
+        SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
+
+        // The array must have the shape of the region
+        bool same_shape = counts.size() == (size_t)buffer.ndim;
+        for (size_t i = 0; same_shape && i < counts.size(); i++)
+            same_shape = counts[i] == (size_t)buffer.shape[i];
+        if (!same_shape) {
+            throw SRParameterException("The shape of the output array does "\
+                                       "not match the counts of the region");
+        }
+
+        ClientCallGuard guard(_client_lock);
+
+        // Strided arrays are filled from contiguous memory
+        if (contiguous) {
+            _client->unpack_tensor_slice(name, offsets, counts, buffer.ptr,
+                                         ttype);
+        }
+        else {
+            std::vector<char> region(buffer.size * buffer.itemsize);
+            _client->unpack_tensor_slice(name, offsets, counts,
+                                         region.data(), ttype);
+            strided_copy(buffer, region.data(), true);
+        }
+    });
+}
+
+void PyClient::unpack_tensor_as(const std::string& name,
+                                const std::string& type,
+                                py::array out)
+{
+    MAKE_CLIENT_API({
+        if (!out.writeable())
+            throw SRParameterException("The output array is not writeable");
+        py::buffer_info buffer = out.request(true);
+        bool contiguous = (out.flags() & py::array::c_style) != 0;
+        SRTensorType ttype = TENSOR_TYPE_MAP.at(type);
+
+        ClientCallGuard guard(_client_lock);
+        std::unique_ptr<TensorBase> tensor(_client->_get_tensorbase_obj(name));
+
+        // The array must match the shape of the stored tensor
+        std::vector<size_t> dims = tensor->dims();
+        bool same_shape = dims.size() == (size_t)buffer.ndim;
+        for (size_t i = 0; same_shape && i < dims.size(); i++)
+            same_shape = dims[i] == (size_t)buffer.shape[i];
+        if (!same_shape) {
+            throw SRParameterException("The shape of the output array does "\
+                                       "not match the shape of tensor " + name);
+        }
+
+        // Convert straight into contiguous arrays; strided arrays
+        // are filled from a converted copy
+        void* src = tensor->data_view(SRMemLayoutContiguous);
+        if (contiguous) {
+            convert_tensor_values(src, tensor->type(), buffer.ptr, ttype,
+                                  tensor->num_values());
+        }
+        else {
+            std::vector<char> converted(buffer.size * buffer.itemsize);
+            convert_tensor_values(src, tensor->type(), converted.data(),
+                                  ttype, tensor->num_values());
+            strided_copy(buffer, converted.data(), true);
         }
     });
 }
@@ -187,6 +586,7 @@ py::array PyClient::get_tensor(const std::string& name)
 void PyClient::delete_tensor(const std::string& name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->delete_tensor(name);
     });
 }
@@ -195,6 +595,7 @@ void PyClient::copy_tensor(const std::string& src_name,
                            const std::string& dest_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->copy_tensor(src_name, dest_name);
     });
 }
@@ -203,6 +604,7 @@ void PyClient::rename_tensor(const std::string& old_name,
                              const std::string& new_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->rename_tensor(old_name, new_name);
     });
 }
@@ -210,6 +612,7 @@ void PyClient::rename_tensor(const std::string& old_name,
 void PyClient::put_dataset(PyDataset& dataset)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->put_dataset(*(dataset.get()));
     });
 }
@@ -217,14 +620,46 @@ void PyClient::put_dataset(PyDataset& dataset)
 PyDataset* PyClient::get_dataset(const std::string& name)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         DataSet* data = new DataSet(_client->get_dataset(name));
         return new PyDataset(data);
     });
 }
 
+void PyClient::put_datasets(std::vector<PyDataset*>& datasets)
+{
+    MAKE_CLIENT_API({
+        std::vector<DataSet*> dataset_ptrs;
+        for (auto it = datasets.begin(); it != datasets.end(); it++) {
+            dataset_ptrs.push_back((*it)->get());
+        }
+        ClientCallGuard guard(_client_lock);
+        _client->put_datasets(dataset_ptrs);
+    });
+}
+
+py::list PyClient::get_datasets(const std::vector<std::string>& names)
+{
+    return MAKE_CLIENT_API({
+        std::vector<DataSet> datasets;
+        {
+            ClientCallGuard guard(_client_lock);
+            datasets = _client->get_datasets(names);
+        }
+        std::vector<PyDataset*> result;
+        for (auto it = datasets.begin(); it != datasets.end(); it++) {
+            DataSet* ds = new DataSet(std::move(*it));
+            result.push_back(new PyDataset(ds));
+        }
+        py::list result_list = py::cast(result);
+        return result_list;
+    });
+}
+
 void PyClient::delete_dataset(const std::string& name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->delete_dataset(name);
     });
 }
@@ -233,6 +668,7 @@ void PyClient::copy_dataset(
     const std::string& src_name, const std::string& dest_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->copy_dataset(src_name, dest_name);
     });
 }
@@ -241,6 +677,7 @@ void PyClient::rename_dataset(
     const std::string& old_name, const std::string& new_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->rename_dataset(old_name, new_name);
     });
 }
@@ -250,6 +687,7 @@ void PyClient::set_script_from_file(const std::string& name,
                                     const std::string& script_file)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_script_from_file(name, device, script_file);
     });
 }
@@ -260,6 +698,7 @@ void PyClient::set_script_from_file_multigpu(const std::string& name,
                                              int num_gpus)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_script_from_file_multigpu(
             name, script_file, first_gpu, num_gpus);
     });
@@ -270,6 +709,7 @@ void PyClient::set_script(const std::string& name,
                           const std::string_view& script)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_script(name, device, script);
     });
 }
@@ -280,6 +720,7 @@ void PyClient::set_script_multigpu(const std::string& name,
                                    int num_gpus)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_script_multigpu(name, script, first_gpu, num_gpus);
     });
 }
@@ -287,6 +728,7 @@ void PyClient::set_script_multigpu(const std::string& name,
 std::string_view PyClient::get_script(const std::string& name)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->get_script(name);
     });
 }
@@ -297,6 +739,7 @@ void PyClient::run_script(const std::string& name,
                 std::vector<std::string>& outputs)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->run_script(name, function, inputs, outputs);
     });
 }
@@ -310,6 +753,7 @@ void PyClient::run_script_multigpu(const std::string& name,
                                    int num_gpus)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->run_script_multigpu(
             name, function, inputs, outputs, offset, first_gpu, num_gpus);
     });
@@ -318,6 +762,7 @@ void PyClient::run_script_multigpu(const std::string& name,
 void PyClient::delete_script(const std::string& name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->delete_script(name);
     });
 }
@@ -326,6 +771,7 @@ void PyClient::delete_script_multigpu(
     const std::string& name, int first_gpu, int num_gpus)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->delete_script_multigpu(name, first_gpu, num_gpus);
     });
 }
@@ -333,7 +779,11 @@ void PyClient::delete_script_multigpu(
 py::bytes PyClient::get_model(const std::string& name)
 {
     return MAKE_CLIENT_API({
-        std::string model(_client->get_model(name));
+        std::string model;
+        {
+            ClientCallGuard guard(_client_lock);
+            model = std::string(_client->get_model(name));
+        }
         return py::bytes(model);
     });
 }
@@ -350,6 +800,7 @@ void PyClient::set_model(const std::string& name,
                  const std::vector<std::string>& outputs)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_model(name, model, backend, device,
                            batch_size, min_batch_size, min_batch_timeout,
                            tag, inputs, outputs);
@@ -369,6 +820,7 @@ void PyClient::set_model_multigpu(const std::string& name,
                                   const std::vector<std::string>& outputs)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_model_multigpu(name, model, backend, first_gpu, num_gpus,
                                     batch_size, min_batch_size, min_batch_timeout,
                                     tag, inputs, outputs);
@@ -387,6 +839,7 @@ void PyClient::set_model_from_file(const std::string& name,
                                    const std::vector<std::string>& outputs)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_model_from_file(name, model_file, backend, device,
                                            batch_size, min_batch_size, min_batch_timeout,
                                            tag, inputs, outputs);
@@ -406,6 +859,7 @@ void PyClient::set_model_from_file_multigpu(const std::string& name,
                                             const std::vector<std::string>& outputs)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_model_from_file_multigpu(
             name, model_file, backend, first_gpu, num_gpus, batch_size,
             min_batch_size, min_batch_timeout, tag, inputs, outputs);
@@ -417,6 +871,7 @@ void PyClient::run_model(const std::string& name,
                          std::vector<std::string> outputs)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->run_model(name, inputs, outputs);
     });
 }
@@ -429,6 +884,7 @@ void PyClient::run_model_multigpu(const std::string& name,
                                   int num_gpus)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->run_model_multigpu(name, inputs, outputs, offset, first_gpu, num_gpus);
     });
 }
@@ -436,6 +892,7 @@ void PyClient::run_model_multigpu(const std::string& name,
 void PyClient::delete_model(const std::string& name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->delete_model(name);
     });
 }
@@ -444,6 +901,7 @@ void PyClient::delete_model_multigpu(
     const std::string& name, int first_gpu, int num_gpus)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->delete_model_multigpu(name, first_gpu, num_gpus);
     });
 }
@@ -451,6 +909,7 @@ void PyClient::delete_model_multigpu(
 void PyClient::set_data_source(const std::string& source_id)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->set_data_source(source_id);
     });
 }
@@ -458,6 +917,7 @@ void PyClient::set_data_source(const std::string& source_id)
 bool PyClient::key_exists(const std::string& key)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->key_exists(key);
     });
 }
@@ -467,6 +927,7 @@ bool PyClient::poll_key(const std::string& key,
                         int num_tries)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->poll_key(key, poll_frequency_ms, num_tries);
     });
 }
@@ -474,6 +935,7 @@ bool PyClient::poll_key(const std::string& key,
 bool PyClient::model_exists(const std::string& name)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->model_exists(name);
     });
 }
@@ -481,6 +943,7 @@ bool PyClient::model_exists(const std::string& name)
 bool PyClient::tensor_exists(const std::string& name)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->tensor_exists(name);
     });
 }
@@ -488,6 +951,7 @@ bool PyClient::tensor_exists(const std::string& name)
 bool PyClient::dataset_exists(const std::string& name)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return this->_client->dataset_exists(name);
     });
 }
@@ -497,6 +961,7 @@ bool PyClient::poll_tensor(const std::string& name,
                            int num_tries)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->poll_tensor(name, poll_frequency_ms, num_tries);
     });
 }
@@ -506,6 +971,7 @@ bool PyClient::poll_dataset(const std::string& name,
                             int num_tries)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->poll_dataset(name, poll_frequency_ms, num_tries);
     });
 }
@@ -515,6 +981,7 @@ bool PyClient::poll_model(const std::string& name,
                           int num_tries)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->poll_model(name, poll_frequency_ms, num_tries);
     });
 }
@@ -522,6 +989,7 @@ bool PyClient::poll_model(const std::string& name,
 void PyClient::use_tensor_ensemble_prefix(bool use_prefix)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->use_tensor_ensemble_prefix(use_prefix);
     });
 }
@@ -529,13 +997,55 @@ void PyClient::use_tensor_ensemble_prefix(bool use_prefix)
 void PyClient::use_dataset_ensemble_prefix(bool use_prefix)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->use_dataset_ensemble_prefix(use_prefix);
     });
 }
 
+void PyClient::use_packed_datasets(bool use_packed)
+{
+    MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
+        _client->use_packed_datasets(use_packed);
+    });
+}
+
+void PyClient::use_dataset_transactions(bool use_transactions)
+{
+    MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
+        _client->use_dataset_transactions(use_transactions);
+    });
+}
+
+void PyClient::set_tensor_ttl(int ttl_ms)
+{
+    MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
+        _client->set_tensor_ttl(ttl_ms);
+    });
+}
+
+void PyClient::set_dataset_ttl(int ttl_ms)
+{
+    MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
+        _client->set_dataset_ttl(ttl_ms);
+    });
+}
+
+void PyClient::set_list_retention(int max_length)
+{
+    MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
+        _client->set_list_retention(max_length);
+    });
+}
+
 void PyClient::use_model_ensemble_prefix(bool use_prefix)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->use_model_ensemble_prefix(use_prefix);
     });
 }
@@ -543,6 +1053,7 @@ void PyClient::use_model_ensemble_prefix(bool use_prefix)
 void PyClient::use_list_ensemble_prefix(bool use_prefix)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->use_list_ensemble_prefix(use_prefix);
     });
 }
@@ -553,7 +1064,11 @@ std::vector<py::dict> PyClient::get_db_node_info(std::vector<std::string> addres
     return MAKE_CLIENT_API({
         std::vector<py::dict> addresses_info;
         for (size_t i = 0; i < addresses.size(); i++) {
-            parsed_reply_nested_map info_map = _client->get_db_node_info(addresses[i]);
+            parsed_reply_nested_map info_map;
+            {
+                ClientCallGuard guard(_client_lock);
+                info_map = _client->get_db_node_info(addresses[i]);
+            }
             py::dict info_dict = py::cast(info_map);
             addresses_info.push_back(info_dict);
         }
@@ -566,7 +1081,11 @@ std::vector<py::dict> PyClient::get_db_cluster_info(std::vector<std::string> add
     return MAKE_CLIENT_API({
         std::vector<py::dict> addresses_info;
         for (size_t i = 0; i < addresses.size(); i++) {
-            parsed_reply_map info_map = _client->get_db_cluster_info(addresses[i]);
+            parsed_reply_map info_map;
+            {
+                ClientCallGuard guard(_client_lock);
+                info_map = _client->get_db_cluster_info(addresses[i]);
+            }
             py::dict info_dict = py::cast(info_map);
             addresses_info.push_back(info_dict);
         }
@@ -583,8 +1102,11 @@ std::vector<py::dict> PyClient::get_ai_info(
     return MAKE_CLIENT_API({
         std::vector<py::dict> ai_info;
         for (size_t i = 0; i < addresses.size(); i++) {
-            parsed_reply_map result =
-                _client->get_ai_info(addresses[i], key, reset_stat);
+            parsed_reply_map result;
+            {
+                ClientCallGuard guard(_client_lock);
+                result = _client->get_ai_info(addresses[i], key, reset_stat);
+            }
             ai_info.push_back(py::cast(result));
         }
         return ai_info;
@@ -596,6 +1118,7 @@ void PyClient::flush_db(std::vector<std::string> addresses)
 {
     for (size_t i = 0; i < addresses.size(); i++) {
         MAKE_CLIENT_API({
+            ClientCallGuard guard(_client_lock);
             _client->flush_db(addresses[i]);
         });
     }
@@ -605,7 +1128,11 @@ void PyClient::flush_db(std::vector<std::string> addresses)
 py::dict PyClient::config_get(std::string expression, std::string address)
 {
     return MAKE_CLIENT_API({
-        auto result_map = _client->config_get(expression, address);
+        parsed_reply_map result_map;
+        {
+            ClientCallGuard guard(_client_lock);
+            result_map = _client->config_get(expression, address);
+        }
         return py::cast(result_map);
     });
 }
@@ -615,6 +1142,7 @@ void PyClient::config_set(
     std::string config_param, std::string value, std::string address)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->config_set(config_param, value, address);
     });
 }
@@ -624,6 +1152,7 @@ void PyClient::save(std::vector<std::string> addresses)
 {
     for (size_t address_index = 0; address_index < addresses.size(); address_index++) {
         MAKE_CLIENT_API({
+            ClientCallGuard guard(_client_lock);
             _client->save(addresses[address_index]);
         });
     }
@@ -634,6 +1163,7 @@ void PyClient::save(std::vector<std::string> addresses)
 void PyClient::append_to_list(const std::string& list_name, PyDataset& dataset)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->append_to_list(list_name, *dataset.get());
     });
 }
@@ -642,6 +1172,7 @@ void PyClient::append_to_list(const std::string& list_name, PyDataset& dataset)
 void PyClient::delete_list(const std::string& list_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->delete_list(list_name);
     });
 }
@@ -650,6 +1181,7 @@ void PyClient::delete_list(const std::string& list_name)
 void PyClient::copy_list(const std::string& src_name, const std::string& dest_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->copy_list(src_name, dest_name);
     });
 }
@@ -658,6 +1190,7 @@ void PyClient::copy_list(const std::string& src_name, const std::string& dest_na
 void PyClient::rename_list(const std::string& src_name, const std::string& dest_name)
 {
     MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         _client->rename_list(src_name, dest_name);
     });
 }
@@ -666,6 +1199,7 @@ void PyClient::rename_list(const std::string& src_name, const std::string& dest_
 int PyClient::get_list_length(const std::string& list_name)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->get_list_length(list_name);
     });
 }
@@ -675,6 +1209,7 @@ bool PyClient::poll_list_length(const std::string& name, int list_length,
                                 int poll_frequency_ms, int num_tries)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->poll_list_length(
             name, list_length, poll_frequency_ms, num_tries);
     });
@@ -685,6 +1220,7 @@ bool PyClient::poll_list_length_gte(const std::string& name, int list_length,
                                     int poll_frequency_ms, int num_tries)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->poll_list_length_gte(
             name, list_length, poll_frequency_ms, num_tries);
     });
@@ -695,6 +1231,7 @@ bool PyClient::poll_list_length_lte(const std::string& name, int list_length,
                                    int poll_frequency_ms, int num_tries)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->poll_list_length_lte(
             name, list_length, poll_frequency_ms, num_tries);
     });
@@ -704,7 +1241,11 @@ bool PyClient::poll_list_length_lte(const std::string& name, int list_length,
 py::list PyClient::get_datasets_from_list(const std::string& list_name)
 {
     return MAKE_CLIENT_API({
-        std::vector<DataSet> datasets = _client->get_datasets_from_list(list_name);
+        std::vector<DataSet> datasets;
+        {
+            ClientCallGuard guard(_client_lock);
+            datasets = _client->get_datasets_from_list(list_name);
+        }
         std::vector<PyDataset*> result;
         for (auto it = datasets.begin(); it != datasets.end(); it++) {
             DataSet* ds = new DataSet(std::move(*it));
@@ -720,8 +1261,12 @@ py::list PyClient::get_dataset_list_range(
     const std::string& list_name, const int start_index, const int end_index)
 {
     return MAKE_CLIENT_API({
-        std::vector<DataSet> datasets = _client->get_dataset_list_range(
-            list_name, start_index, end_index);
+        std::vector<DataSet> datasets;
+        {
+            ClientCallGuard guard(_client_lock);
+            datasets = _client->get_dataset_list_range(
+                list_name, start_index, end_index);
+        }
         std::vector<PyDataset*> result;
         for (auto it = datasets.begin(); it != datasets.end(); it++) {
             DataSet* ds = new DataSet(std::move(*it));
@@ -736,6 +1281,7 @@ py::list PyClient::get_dataset_list_range(
 void PyClient::set_model_chunk_size(int chunk_size)
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->set_model_chunk_size(chunk_size);
     });
 }
@@ -744,6 +1290,7 @@ void PyClient::set_model_chunk_size(int chunk_size)
 std::string PyClient::to_string()
 {
     return MAKE_CLIENT_API({
+        ClientCallGuard guard(_client_lock);
         return _client->to_string();
     });
 }
@@ -165,6 +165,31 @@ py::array PyDataset::get_tensor(const std::string& name)
                     tensor->data_view(SRMemLayoutContiguous));
                 return py::array(tensor->dims(), data, free_when_done);
             }
+            case SRTensorTypeUint32: {
+                uint32_t* data = reinterpret_cast<uint32_t*>(
+                    tensor->data_view(SRMemLayoutContiguous));
+                return py::array(tensor->dims(), data, free_when_done);
+            }
+            case SRTensorTypeUint64: {
+                uint64_t* data = reinterpret_cast<uint64_t*>(
+                    tensor->data_view(SRMemLayoutContiguous));
+                return py::array(tensor->dims(), data, free_when_done);
+            }
+            case SRTensorTypeBool: {
+                bool* data = reinterpret_cast<bool*>(
+                    tensor->data_view(SRMemLayoutContiguous));
+                return py::array(tensor->dims(), data, free_when_done);
+            }
+            case SRTensorTypeFloat16: {
+                void* data = tensor->data_view(SRMemLayoutContiguous);
+                py::dtype float16 = py::dtype::from_args(py::str("float16"));
+                return py::array(float16, tensor->dims(), data, free_when_done);
+            }
+            case SRTensorTypeBFloat16: {
+                void* data = tensor->data_view(SRMemLayoutContiguous);
+                return py::array(bfloat16_dtype(), tensor->dims(), data,
+                                 free_when_done);
+            }
             default :
                 throw SRRuntimeException("Could not infer type in "\
                                          "PyDataSet::get_tensor().");
@@ -281,9 +306,19 @@ std::string PyDataset::get_tensor_type(const std::string& name)
             case SRTensorTypeInt8:
                 return "INT8";
             case SRTensorTypeUint16:
-                return "UINT6";
+                return "UINT16";
             case SRTensorTypeUint8:
                 return "UINT8";
+            case SRTensorTypeUint32:
+                return "UINT32";
+            case SRTensorTypeUint64:
+                return "UINT64";
+            case SRTensorTypeBool:
+                return "BOOL";
+            case SRTensorTypeFloat16:
+                return "FLOAT16";
+            case SRTensorTypeBFloat16:
+                return "BFLOAT16";
             default :
                 throw SRRuntimeException("Unrecognized type in "\
                                          "PyDataSet::get_tensor_type().");
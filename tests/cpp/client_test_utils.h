@@ -48,6 +48,18 @@ class RedisClusterTestObject : public RedisCluster
         std::string get_crc16_prefix(uint64_t hash_slot) {
             return _get_crc16_prefix(hash_slot);
         }
+
+        std::string get_db_node_prefix(const Command& cmd) {
+            return _get_db_node_prefix(cmd);
+        }
+
+        void refresh_cluster_map(uint16_t hash_slot) {
+            _refresh_cluster_map(std::chrono::steady_clock::now(), hash_slot);
+        }
+
+        std::vector<DBNode> get_db_nodes() {
+            return _get_db_nodes();
+        }
 };
 
 inline void to_lower(char* s) {
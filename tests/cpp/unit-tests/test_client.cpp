@@ -28,12 +28,22 @@
 
 #include "../../../third-party/catch/single_include/catch2/catch.hpp"
 #include "client.h"
+#include "tensorchunks.h"
 #include "dataset.h"
 #include "../client_test_utils.h"
 #include "srexception.h"
 #include <sstream>
 #include "logger.h"
 #include "logcontext.h"
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <functional>
 
 unsigned long get_time_offset();
 
@@ -188,9 +198,1488 @@ SCENARIO("Testing Dataset Functions on Client Object", "[Client]")
                 CHECK(dataset.get_tensor_names() ==
                       retrieved_dataset.get_tensor_names());
             }
+
+            AND_THEN("The DataSet and its tensors can be deleted")
+            {
+                std::string tensor_key =
+                    "{" + dataset_name + "}." + tensor_name;
+                CHECK(client.key_exists(tensor_key));
+
+                client.delete_dataset(dataset_name);
+                CHECK_FALSE(client.dataset_exists(dataset_name));
+                CHECK_FALSE(client.key_exists(tensor_key));
+
+                // deleting a nonexistent DataSet throws an error
+                CHECK_THROWS_AS(
+                    client.delete_dataset(dataset_name),
+                    RuntimeException);
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End Client testing***");
+}
+
+SCENARIO("Testing packed Dataset Functions on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing packed Dataset Functions on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client packed DataSet testing***");
+    GIVEN("A Client object that packs DataSets")
+    {
+        Client client("test_client");
+        client.use_packed_datasets(true);
+
+        WHEN("A dataset is created and put into the Client")
+        {
+            // Create the DataSet
+            std::string dataset_name = "test_packed_dataset_name";
+            DataSet dataset(dataset_name);
+
+            // Add meta scalar and string to DataSet
+            std::string meta_scalar_name = "dbl_field";
+            const double dbl_meta = std::numeric_limits<double>::max();
+            SRMetaDataType meta_type = SRMetadataTypeDouble;
+            dataset.add_meta_scalar(meta_scalar_name,
+                                     &dbl_meta,
+                                     meta_type);
+            dataset.add_meta_string("str_field", "packed");
+
+            // Add tensors to DataSet
+            std::vector<size_t> dims = {1, 2, 3};
+            size_t tensor_size = dims.at(0) * dims.at(1) * dims.at(2);
+            std::vector<float> flt_tensor(tensor_size, 2.0);
+            std::vector<int8_t> i8_tensor(tensor_size, 3);
+            dataset.add_tensor("flt_tensor", flt_tensor.data(), dims,
+                               SRTensorTypeFloat, SRMemLayoutContiguous);
+            dataset.add_tensor("i8_tensor", i8_tensor.data(), dims,
+                               SRTensorTypeInt8, SRMemLayoutContiguous);
+
+            // Put the DataSet into the Client
+            client.put_dataset(dataset);
+
+            THEN("The DataSet exists and can be retrieved")
+            {
+                CHECK(client.dataset_exists(dataset_name));
+
+                // Retrieving does not depend on the packing setting
+                client.use_packed_datasets(false);
+                DataSet retrieved_dataset = client.get_dataset(dataset_name);
+
+                double* retrieved_meta_data;
+                size_t retrieved_meta_length;
+                retrieved_dataset.get_meta_scalars(meta_scalar_name,
+                                                  (void*&)retrieved_meta_data,
+                                                   retrieved_meta_length,
+                                                   meta_type);
+                CHECK(*retrieved_meta_data == dbl_meta);
+                CHECK(retrieved_dataset.get_meta_strings("str_field")[0] ==
+                      "packed");
+                CHECK(dataset.get_tensor_names() ==
+                      retrieved_dataset.get_tensor_names());
+
+                std::vector<float> flt_result(tensor_size, 0);
+                std::vector<int8_t> i8_result(tensor_size, 0);
+                retrieved_dataset.unpack_tensor(
+                    "flt_tensor", flt_result.data(), dims,
+                    SRTensorTypeFloat, SRMemLayoutContiguous);
+                retrieved_dataset.unpack_tensor(
+                    "i8_tensor", i8_result.data(), dims,
+                    SRTensorTypeInt8, SRMemLayoutContiguous);
+                CHECK(flt_result == flt_tensor);
+                CHECK(i8_result == i8_tensor);
+            }
+
+            AND_THEN("The DataSet can be renamed and deleted")
+            {
+                std::string renamed_dataset_name = "renamed_" + dataset_name;
+                client.rename_dataset(dataset_name, renamed_dataset_name);
+                CHECK_FALSE(client.dataset_exists(dataset_name));
+
+                DataSet retrieved_dataset =
+                    client.get_dataset(renamed_dataset_name);
+                CHECK(dataset.get_tensor_names() ==
+                      retrieved_dataset.get_tensor_names());
+
+                client.delete_dataset(renamed_dataset_name);
+                CHECK_FALSE(client.dataset_exists(renamed_dataset_name));
+            }
+
+            AND_THEN("The DataSet can be retrieved from an aggregation list")
+            {
+                std::string list_name = "test_packed_list";
+                client.delete_list(list_name);
+                client.append_to_list(list_name, dataset);
+                std::vector<DataSet> datasets =
+                    client.get_datasets_from_list(list_name);
+                REQUIRE(datasets.size() == 1);
+                CHECK(datasets[0].get_tensor_names() ==
+                      dataset.get_tensor_names());
+                client.delete_list(list_name);
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End Client packed DataSet testing***");
+}
+
+SCENARIO("Testing transactional Dataset publication on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing transactional Dataset publication on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client DataSet transaction testing***");
+    GIVEN("A Client object that publishes DataSets in transactions")
+    {
+        Client client("test_client");
+        client.use_dataset_transactions(true);
+
+        // Create the DataSet
+        std::string dataset_name = "test_transaction_dataset_name";
+        DataSet dataset(dataset_name);
+        std::vector<size_t> dims = {2, 2};
+        std::vector<double> tensor(4, 1.5);
+        dataset.add_tensor("dbl_tensor", tensor.data(), dims,
+                           SRTensorTypeDouble, SRMemLayoutContiguous);
+        dataset.add_meta_string("str_field", "atomic");
+
+        WHEN("The DataSet is put into the database")
+        {
+            client.put_dataset(dataset);
+
+            THEN("The complete DataSet can be retrieved")
+            {
+                CHECK(client.dataset_exists(dataset_name));
+                DataSet retrieved_dataset = client.get_dataset(dataset_name);
+                std::vector<double> result(4, 0);
+                retrieved_dataset.unpack_tensor(
+                    "dbl_tensor", result.data(), dims,
+                    SRTensorTypeDouble, SRMemLayoutContiguous);
+                CHECK(result == tensor);
+                CHECK(retrieved_dataset.get_meta_strings("str_field")[0] ==
+                      "atomic");
+            }
+
+            AND_THEN("The DataSet can be copied in a transaction")
+            {
+                std::string copy_name = "copy_" + dataset_name;
+                client.copy_dataset(dataset_name, copy_name);
+                DataSet retrieved_dataset = client.get_dataset(copy_name);
+                CHECK(retrieved_dataset.get_tensor_names() ==
+                      dataset.get_tensor_names());
+                client.delete_dataset(copy_name);
+            }
+        }
+
+        WHEN("A packed DataSet is put into the database")
+        {
+            client.use_packed_datasets(true);
+            client.put_dataset(dataset);
+
+            THEN("The complete DataSet can be retrieved")
+            {
+                DataSet retrieved_dataset = client.get_dataset(dataset_name);
+                CHECK(retrieved_dataset.get_tensor_names() ==
+                      dataset.get_tensor_names());
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End Client DataSet transaction testing***");
+}
+
+SCENARIO("Testing bulk Dataset Functions on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing bulk Dataset Functions on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client bulk DataSet testing***");
+    GIVEN("A Client object and several DataSets")
+    {
+        Client client("test_client");
+
+        std::vector<size_t> dims = {3};
+        std::vector<std::string> names;
+        std::vector<DataSet> datasets;
+        for (size_t i = 0; i < 4; i++) {
+            names.push_back("test_bulk_dataset_" + std::to_string(i));
+            datasets.push_back(DataSet(names.back()));
+            std::vector<float> tensor(3, (float)i);
+            datasets.back().add_tensor("flt_tensor", tensor.data(), dims,
+                                       SRTensorTypeFloat,
+                                       SRMemLayoutContiguous);
+            datasets.back().add_meta_string("index", std::to_string(i));
+        }
+
+        WHEN("The DataSets are put into the database in bulk")
+        {
+            client.put_datasets(datasets);
+
+            THEN("Each DataSet exists and can be retrieved in bulk")
+            {
+                for (size_t i = 0; i < names.size(); i++)
+                    CHECK(client.dataset_exists(names[i]));
+
+                std::vector<DataSet> retrieved = client.get_datasets(names);
+                REQUIRE(retrieved.size() == names.size());
+                for (size_t i = 0; i < names.size(); i++) {
+                    CHECK(retrieved[i].get_name() == names[i]);
+                    CHECK(retrieved[i].get_meta_strings("index")[0] ==
+                          std::to_string(i));
+                    std::vector<float> result(3, -1.0);
+                    retrieved[i].unpack_tensor(
+                        "flt_tensor", result.data(), dims,
+                        SRTensorTypeFloat, SRMemLayoutContiguous);
+                    CHECK(result == std::vector<float>(3, (float)i));
+                }
+            }
+
+            AND_THEN("Requesting a missing DataSet in bulk throws")
+            {
+                std::vector<std::string> bad_names = names;
+                bad_names.push_back("test_bulk_dataset_missing");
+                CHECK_THROWS_AS(client.get_datasets(bad_names), KeyException);
+            }
+
+            AND_THEN("An empty request returns no DataSets")
+            {
+                CHECK(client.get_datasets(std::vector<std::string>()).empty());
+            }
+        }
+
+        WHEN("Packed DataSets are put into the database in bulk")
+        {
+            client.use_packed_datasets(true);
+            client.put_datasets(datasets);
+
+            THEN("The DataSets can be retrieved in bulk")
+            {
+                std::vector<DataSet> retrieved = client.get_datasets(names);
+                REQUIRE(retrieved.size() == names.size());
+                for (size_t i = 0; i < names.size(); i++) {
+                    CHECK(retrieved[i].get_tensor_names() ==
+                          datasets[i].get_tensor_names());
+                }
+            }
+        }
+
+        WHEN("A NULL DataSet is put into the database in bulk")
+        {
+            std::vector<DataSet*> dataset_ptrs = {&datasets[0], NULL};
+
+            THEN("A ParameterException is thrown in either publication mode")
+            {
+                CHECK_THROWS_AS(client.put_datasets(dataset_ptrs),
+                                ParameterException);
+                client.use_dataset_transactions(true);
+                CHECK_THROWS_AS(client.put_datasets(dataset_ptrs),
+                                ParameterException);
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End Client bulk DataSet testing***");
+}
+
+SCENARIO("Testing expiry and list retention on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing expiry and list retention on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client expiry testing***");
+    GIVEN("A Client object")
+    {
+        Client client("test_client");
+
+        THEN("Negative expiry and retention settings throw errors")
+        {
+            CHECK_THROWS_AS(client.set_tensor_ttl(-1), ParameterException);
+            CHECK_THROWS_AS(client.set_dataset_ttl(-1), ParameterException);
+            CHECK_THROWS_AS(client.set_list_retention(-1),
+                            ParameterException);
+        }
+
+        WHEN("A tensor and a DataSet are put with a time to live")
+        {
+            client.set_tensor_ttl(250);
+            client.set_dataset_ttl(250);
+
+            std::vector<size_t> dims = {4};
+            std::vector<double> tensor(4, 3.0);
+            client.put_tensor("test_ttl_tensor", tensor.data(), dims,
+                              SRTensorTypeDouble, SRMemLayoutContiguous);
+
+            DataSet dataset("test_ttl_dataset");
+            dataset.add_tensor("dbl_tensor", tensor.data(), dims,
+                               SRTensorTypeDouble, SRMemLayoutContiguous);
+            client.put_dataset(dataset);
+
+            THEN("They exist until their time to live has elapsed")
+            {
+                CHECK(client.tensor_exists("test_ttl_tensor"));
+                CHECK(client.dataset_exists("test_ttl_dataset"));
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(750));
+                CHECK_FALSE(client.tensor_exists("test_ttl_tensor"));
+                CHECK_FALSE(client.dataset_exists("test_ttl_dataset"));
+                CHECK_FALSE(client.key_exists("{test_ttl_dataset}.dbl_tensor"));
+            }
+        }
+
+        WHEN("DataSets are appended to a list with a retention limit")
+        {
+            std::string list_name = "test_retention_list";
+            client.delete_list(list_name);
+            client.set_list_retention(2);
+
+            std::vector<std::string> names;
+            for (size_t i = 0; i < 3; i++) {
+                names.push_back("test_retention_dataset_" + std::to_string(i));
+                DataSet dataset(names.back());
+                dataset.add_meta_string("index", std::to_string(i));
+                client.put_dataset(dataset);
+                client.append_to_list(list_name, dataset);
+            }
+
+            THEN("Only the most recent entries are retained")
+            {
+                CHECK(client.get_list_length(list_name) == 2);
+                std::vector<DataSet> datasets =
+                    client.get_datasets_from_list(list_name);
+                REQUIRE(datasets.size() == 2);
+                CHECK(datasets[0].get_name() == names[1]);
+                CHECK(datasets[1].get_name() == names[2]);
+            }
+            client.delete_list(list_name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client expiry testing***");
+}
+
+SCENARIO("Testing strided Tensor Functions on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing strided Tensor Functions on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client strided tensor testing***");
+    GIVEN("A Client object and a halo-padded array")
+    {
+        Client client("test_client");
+
+        const size_t n_rows = 5;
+        const size_t n_cols = 6;
+        std::vector<float> padded(n_rows * n_cols);
+        for (size_t i = 0; i < padded.size(); i++)
+            padded[i] = (float)i;
+
+        // Interior 3x4 block starting at (1, 1)
+        std::vector<size_t> dims = {3, 4};
+        std::vector<size_t> strides = {n_cols, 1};
+        size_t offset = n_cols + 1;
+
+        WHEN("The interior block is put with strides")
+        {
+            std::string name = "test_strided_tensor";
+            client.put_tensor_strided(name, padded.data(), dims, strides,
+                                      offset, SRTensorTypeFloat);
+
+            THEN("The tensor holds the packed interior values")
+            {
+                std::vector<float> packed(12);
+                client.unpack_tensor(name, packed.data(), {12},
+                                     SRTensorTypeFloat,
+                                     SRMemLayoutContiguous);
+                for (size_t i = 0; i < dims[0]; i++)
+                    for (size_t j = 0; j < dims[1]; j++)
+                        CHECK(packed[i * dims[1] + j] ==
+                              padded[offset + i * n_cols + j]);
+            }
+
+            AND_THEN("It can be unpacked into the interior of another array")
+            {
+                std::vector<float> result(n_rows * n_cols, -1.0);
+                client.unpack_tensor_strided(name, result.data(), dims,
+                                             strides, offset,
+                                             SRTensorTypeFloat);
+                for (size_t i = 0; i < n_rows; i++) {
+                    for (size_t j = 0; j < n_cols; j++) {
+                        bool interior = i >= 1 && i <= 3 && j >= 1 && j <= 4;
+                        float expected = interior ? padded[i * n_cols + j] : -1.0;
+                        CHECK(result[i * n_cols + j] == expected);
+                    }
+                }
+            }
+
+            AND_THEN("Mismatched strides or types are rejected")
+            {
+                std::vector<float> result(n_rows * n_cols);
+                std::vector<size_t> bad_strides = {1};
+                CHECK_THROWS_AS(
+                    client.put_tensor_strided(name, padded.data(), dims,
+                                              bad_strides, offset,
+                                              SRTensorTypeFloat),
+                    ParameterException);
+                CHECK_THROWS_AS(
+                    client.unpack_tensor_strided(name, result.data(), dims,
+                                                 bad_strides, offset,
+                                                 SRTensorTypeFloat),
+                    ParameterException);
+                CHECK_THROWS_AS(
+                    client.unpack_tensor_strided(name, result.data(), dims,
+                                                 strides, offset,
+                                                 SRTensorTypeDouble),
+                    RuntimeException);
+            }
+            client.delete_tensor(name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client strided tensor testing***");
+}
+
+SCENARIO("Testing native Fortran layout on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing native Fortran layout on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client native Fortran layout testing***");
+    GIVEN("A Client object storing column major tensors natively")
+    {
+        Client client("test_client");
+        client.use_native_fortran_layout(true);
+
+        // A 2x3 column major array
+        std::vector<size_t> dims = {2, 3};
+        std::vector<double> f_array = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+        std::string name = "test_native_fortran_tensor";
+
+        WHEN("A column major tensor is put")
+        {
+            client.put_tensor(name, f_array.data(), dims, SRTensorTypeDouble,
+                              SRMemLayoutFortranContiguous);
+
+            THEN("It is stored unchanged with its dimensions reversed")
+            {
+                void* data = NULL;
+                std::vector<size_t> stored_dims;
+                SRTensorType type;
+                client.use_native_fortran_layout(false);
+                client.get_tensor(name, data, stored_dims, type,
+                                  SRMemLayoutContiguous);
+                CHECK(stored_dims == std::vector<size_t>({3, 2}));
+                for (size_t i = 0; i < f_array.size(); i++)
+                    CHECK(((double*)data)[i] == f_array[i]);
+            }
+
+            AND_THEN("It can be retrieved column major without a transpose")
+            {
+                std::vector<double> result(f_array.size(), 0.0);
+                client.unpack_tensor(name, result.data(), dims,
+                                     SRTensorTypeDouble,
+                                     SRMemLayoutFortranContiguous);
+                CHECK(result == f_array);
+
+                void* data = NULL;
+                std::vector<size_t> fetched_dims;
+                SRTensorType type;
+                client.get_tensor(name, data, fetched_dims, type,
+                                  SRMemLayoutFortranContiguous);
+                CHECK(fetched_dims == dims);
+                for (size_t i = 0; i < f_array.size(); i++)
+                    CHECK(((double*)data)[i] == f_array[i]);
+            }
+
+            AND_THEN("Unpacking into mismatched dimensions is rejected")
+            {
+                std::vector<double> result(f_array.size(), 0.0);
+                CHECK_THROWS_AS(
+                    client.unpack_tensor(name, result.data(), {3, 2},
+                                         SRTensorTypeDouble,
+                                         SRMemLayoutFortranContiguous),
+                    RuntimeException);
+            }
+            client.delete_tensor(name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client native Fortran layout testing***");
+}
+
+SCENARIO("Testing extended tensor types on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing extended tensor types on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client extended tensor type testing***");
+    GIVEN("A Client object")
+    {
+        Client client("test_client");
+
+        WHEN("A boolean tensor is put")
+        {
+            std::string name = "test_bool_tensor";
+            bool values[6] = {true, false, false, true, true, false};
+            std::vector<size_t> dims = {2, 3};
+            client.put_tensor(name, values, dims, SRTensorTypeBool,
+                              SRMemLayoutContiguous);
+
+            THEN("It is retrieved with the same type and values")
+            {
+                bool result[6];
+                client.unpack_tensor(name, result, {6}, SRTensorTypeBool,
+                                     SRMemLayoutContiguous);
+                for (size_t i = 0; i < 6; i++)
+                    CHECK(result[i] == values[i]);
+            }
+            client.delete_tensor(name);
+        }
+
+        WHEN("Tensors of types without a RedisAI equivalent are put")
+        {
+            std::vector<size_t> dims = {2, 2};
+            uint16_t half_bits[4] = {0x3c00, 0x4000, 0xc000, 0x7bff};
+            uint32_t u32[4] = {0, 1, 4000000000u, 7};
+            uint64_t u64[4] = {0, 1, 18000000000000000000ull, 7};
+            client.put_tensor("test_fp16_tensor", half_bits, dims,
+                              SRTensorTypeFloat16, SRMemLayoutContiguous);
+            client.put_tensor("test_bf16_tensor", half_bits, dims,
+                              SRTensorTypeBFloat16, SRMemLayoutContiguous);
+            client.put_tensor("test_u32_tensor", u32, dims,
+                              SRTensorTypeUint32, SRMemLayoutContiguous);
+            client.put_tensor("test_u64_tensor", u64, dims,
+                              SRTensorTypeUint64, SRMemLayoutContiguous);
+
+            THEN("They keep their types and values")
+            {
+                uint16_t fp16_result[4];
+                uint16_t bf16_result[4];
+                uint32_t u32_result[4];
+                uint64_t u64_result[4];
+                client.unpack_tensor("test_fp16_tensor", fp16_result, {4},
+                                     SRTensorTypeFloat16,
+                                     SRMemLayoutContiguous);
+                client.unpack_tensor("test_bf16_tensor", bf16_result, {4},
+                                     SRTensorTypeBFloat16,
+                                     SRMemLayoutContiguous);
+                client.unpack_tensor("test_u32_tensor", u32_result, {4},
+                                     SRTensorTypeUint32,
+                                     SRMemLayoutContiguous);
+                client.unpack_tensor("test_u64_tensor", u64_result, {4},
+                                     SRTensorTypeUint64,
+                                     SRMemLayoutContiguous);
+                for (size_t i = 0; i < 4; i++) {
+                    CHECK(fp16_result[i] == half_bits[i]);
+                    CHECK(bf16_result[i] == half_bits[i]);
+                    CHECK(u32_result[i] == u32[i]);
+                    CHECK(u64_result[i] == u64[i]);
+                }
+
+                void* data = NULL;
+                std::vector<size_t> fetched_dims;
+                SRTensorType type;
+                client.get_tensor("test_u64_tensor", data, fetched_dims, type,
+                                  SRMemLayoutContiguous);
+                CHECK(type == SRTensorTypeUint64);
+                CHECK(fetched_dims == dims);
+
+                // Values are converted from the stored type when asked
+                double converted[4];
+                client.unpack_tensor_as("test_u32_tensor", converted, {4},
+                                        SRTensorTypeDouble,
+                                        SRMemLayoutContiguous);
+                CHECK(converted[2] == 4000000000.0);
+            }
+            client.delete_tensor("test_fp16_tensor");
+            client.delete_tensor("test_bf16_tensor");
+            client.delete_tensor("test_u32_tensor");
+            client.delete_tensor("test_u64_tensor");
+        }
+
+        WHEN("Such tensors are put in an unpacked DataSet")
+        {
+            std::vector<size_t> dims = {4};
+            uint16_t half_bits[4] = {0x3c00, 0x4000, 0xc000, 0x7bff};
+            uint32_t u32[4] = {0, 1, 4000000000u, 7};
+            uint64_t u64[4] = {0, 1, 18000000000000000000ull, 7};
+            float f32[4] = {0.5f, 1.5f, 2.5f, 3.5f};
+
+            DataSet dataset("test_unpacked_extended_types");
+            dataset.add_tensor("fp16", half_bits, dims, SRTensorTypeFloat16,
+                               SRMemLayoutContiguous);
+            dataset.add_tensor("bf16", half_bits, dims, SRTensorTypeBFloat16,
+                               SRMemLayoutContiguous);
+            dataset.add_tensor("u32", u32, dims, SRTensorTypeUint32,
+                               SRMemLayoutContiguous);
+            dataset.add_tensor("u64", u64, dims, SRTensorTypeUint64,
+                               SRMemLayoutContiguous);
+            dataset.add_tensor("f32", f32, dims, SRTensorTypeFloat,
+                               SRMemLayoutContiguous);
+            client.put_dataset(dataset);
+
+            THEN("They keep their types and values, alongside RedisAI tensors")
+            {
+                client.copy_dataset("test_unpacked_extended_types",
+                                    "test_unpacked_extended_types_copy");
+                std::vector<std::string> names = {
+                    "test_unpacked_extended_types",
+                    "test_unpacked_extended_types_copy"};
+                for (size_t n = 0; n < names.size(); n++) {
+                    INFO(names[n]);
+                    DataSet retrieved = client.get_dataset(names[n]);
+                    CHECK(retrieved.get_tensor_type("fp16") == SRTensorTypeFloat16);
+                    CHECK(retrieved.get_tensor_type("bf16") == SRTensorTypeBFloat16);
+                    CHECK(retrieved.get_tensor_type("u32") == SRTensorTypeUint32);
+                    CHECK(retrieved.get_tensor_type("u64") == SRTensorTypeUint64);
+                    CHECK(retrieved.get_tensor_type("f32") == SRTensorTypeFloat);
+
+                    uint16_t fp16_result[4];
+                    uint16_t bf16_result[4];
+                    uint32_t u32_result[4];
+                    uint64_t u64_result[4];
+                    float f32_result[4];
+                    retrieved.unpack_tensor("fp16", fp16_result, {4},
+                                            SRTensorTypeFloat16,
+                                            SRMemLayoutContiguous);
+                    retrieved.unpack_tensor("bf16", bf16_result, {4},
+                                            SRTensorTypeBFloat16,
+                                            SRMemLayoutContiguous);
+                    retrieved.unpack_tensor("u32", u32_result, {4},
+                                            SRTensorTypeUint32,
+                                            SRMemLayoutContiguous);
+                    retrieved.unpack_tensor("u64", u64_result, {4},
+                                            SRTensorTypeUint64,
+                                            SRMemLayoutContiguous);
+                    retrieved.unpack_tensor("f32", f32_result, {4},
+                                            SRTensorTypeFloat,
+                                            SRMemLayoutContiguous);
+                    for (size_t i = 0; i < 4; i++) {
+                        CHECK(fp16_result[i] == half_bits[i]);
+                        CHECK(bf16_result[i] == half_bits[i]);
+                        CHECK(u32_result[i] == u32[i]);
+                        CHECK(u64_result[i] == u64[i]);
+                        CHECK(f32_result[i] == f32[i]);
+                    }
+                }
+            }
+            client.delete_dataset("test_unpacked_extended_types");
+            if (client.dataset_exists("test_unpacked_extended_types_copy"))
+                client.delete_dataset("test_unpacked_extended_types_copy");
+        }
+
+        WHEN("Tensors of types without a RedisAI equivalent are put "\
+             "in a packed DataSet")
+        {
+            client.use_packed_datasets(true);
+            std::vector<size_t> dims = {4};
+            uint16_t half_bits[4] = {0x3c00, 0x4000, 0xc000, 0x7bff};
+            uint32_t u32[4] = {0, 1, 4000000000u, 7};
+            uint64_t u64[4] = {0, 1, 18000000000000000000ull, 7};
+
+            DataSet dataset("test_extended_types");
+            dataset.add_tensor("fp16", half_bits, dims, SRTensorTypeFloat16,
+                               SRMemLayoutContiguous);
+            dataset.add_tensor("bf16", half_bits, dims, SRTensorTypeBFloat16,
+                               SRMemLayoutContiguous);
+            dataset.add_tensor("u32", u32, dims, SRTensorTypeUint32,
+                               SRMemLayoutContiguous);
+            dataset.add_tensor("u64", u64, dims, SRTensorTypeUint64,
+                               SRMemLayoutContiguous);
+            client.put_dataset(dataset);
+
+            THEN("They keep their types and values")
+            {
+                DataSet retrieved = client.get_dataset("test_extended_types");
+                CHECK(retrieved.get_tensor_type("fp16") == SRTensorTypeFloat16);
+                CHECK(retrieved.get_tensor_type("bf16") == SRTensorTypeBFloat16);
+                CHECK(retrieved.get_tensor_type("u32") == SRTensorTypeUint32);
+                CHECK(retrieved.get_tensor_type("u64") == SRTensorTypeUint64);
+
+                uint16_t half_result[4];
+                uint32_t u32_result[4];
+                uint64_t u64_result[4];
+                retrieved.unpack_tensor("bf16", half_result, {4},
+                                        SRTensorTypeBFloat16,
+                                        SRMemLayoutContiguous);
+                retrieved.unpack_tensor("u32", u32_result, {4},
+                                        SRTensorTypeUint32,
+                                        SRMemLayoutContiguous);
+                retrieved.unpack_tensor("u64", u64_result, {4},
+                                        SRTensorTypeUint64,
+                                        SRMemLayoutContiguous);
+                for (size_t i = 0; i < 4; i++) {
+                    CHECK(half_result[i] == half_bits[i]);
+                    CHECK(u32_result[i] == u32[i]);
+                    CHECK(u64_result[i] == u64[i]);
+                }
+            }
+            client.delete_dataset("test_extended_types");
+        }
+    }
+    log_data(context, LLDebug, "***End Client extended tensor type testing***");
+}
+
+SCENARIO("Testing tensor type conversion on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing tensor type conversion on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client tensor type conversion testing***");
+    GIVEN("A Client object and double precision data")
+    {
+        Client client("test_client");
+        std::string name = "test_converted_tensor";
+        std::vector<size_t> dims = {2, 3};
+        std::vector<double> values = {0.5, 1.5, 2.25, -3.0, 4.75, 1.0e6};
+
+        WHEN("The data is put as a float tensor")
+        {
+            client.put_tensor_as(name, values.data(), dims,
+                                 SRTensorTypeDouble, SRTensorTypeFloat,
+                                 SRMemLayoutContiguous);
+
+            THEN("It is stored as float")
+            {
+                void* data = NULL;
+                std::vector<size_t> stored_dims;
+                SRTensorType type;
+                client.get_tensor(name, data, stored_dims, type,
+                                  SRMemLayoutContiguous);
+                CHECK(type == SRTensorTypeFloat);
+                CHECK(stored_dims == dims);
+                for (size_t i = 0; i < values.size(); i++)
+                    CHECK(((float*)data)[i] == (float)values[i]);
+            }
+
+            AND_THEN("It can be unpacked into double and integer memory")
+            {
+                std::vector<double> result(values.size(), 0.0);
+                client.unpack_tensor_as(name, result.data(), {values.size()},
+                                        SRTensorTypeDouble,
+                                        SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                std::vector<int32_t> f_result(values.size(), 0);
+                client.unpack_tensor_as(name, f_result.data(), dims,
+                                        SRTensorTypeInt32,
+                                        SRMemLayoutFortranContiguous);
+                CHECK(f_result == std::vector<int32_t>(
+                    {0, -3, 2, 5, 2, 1000000}));
+            }
+
+            AND_THEN("Values that do not fit the memory type are rejected")
+            {
+                std::vector<int16_t> result(values.size(), 0);
+                CHECK_THROWS_AS(
+                    client.unpack_tensor_as(name, result.data(),
+                                            {values.size()},
+                                            SRTensorTypeInt16,
+                                            SRMemLayoutContiguous),
+                    ParameterException);
+            }
+            client.delete_tensor(name);
+        }
+
+        WHEN("Column major data is put as a float16 tensor")
+        {
+            client.put_tensor_as(name, values.data(), dims,
+                                 SRTensorTypeDouble, SRTensorTypeFloat16,
+                                 SRMemLayoutFortranContiguous);
+
+            THEN("It is transposed and converted")
+            {
+                void* data = NULL;
+                std::vector<size_t> stored_dims;
+                SRTensorType type;
+                client.get_tensor(name, data, stored_dims, type,
+                                  SRMemLayoutContiguous);
+                CHECK(type == SRTensorTypeFloat16);
+                uint16_t* bits = (uint16_t*)data;
+                CHECK(float16_to_float(bits[0]) == 0.5f);
+                CHECK(float16_to_float(bits[1]) == 2.25f);
+                CHECK(float16_to_float(bits[3]) == 1.5f);
+                CHECK(std::isinf(float16_to_float(bits[5])));
+            }
+            client.delete_tensor(name);
+        }
+
+        WHEN("The stored type is the source type")
+        {
+            client.put_tensor_as(name, values.data(), dims,
+                                 SRTensorTypeDouble, SRTensorTypeDouble,
+                                 SRMemLayoutContiguous);
+
+            THEN("It is stored unchanged")
+            {
+                std::vector<double> result(values.size(), 0.0);
+                client.unpack_tensor(name, result.data(), {values.size()},
+                                     SRTensorTypeDouble,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+            }
+            client.delete_tensor(name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client tensor type conversion testing***");
+}
+
+SCENARIO("Testing compressed tensors and DataSets on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing compressed tensors and DataSets on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client compression testing***");
+    GIVEN("A Client object with compression enabled and one without")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_string_option("SR_COMPRESSION", "shuffle-lz");
+        cfgopts->override_integer_option("SR_COMPRESSION_LEVEL", 3);
+        Client client(cfgopts.get(), "test_client");
+        Client plain_client("test_client");
+
+        std::vector<size_t> dims = {16, 32};
+        std::vector<double> values(dims[0] * dims[1]);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = std::cos(0.01 * i);
+
+        WHEN("A tensor is put by the compressing client")
+        {
+            std::string name = "test_compressed_tensor";
+            client.put_tensor(name, values.data(), dims,
+                              SRTensorTypeDouble, SRMemLayoutContiguous);
+
+            THEN("Either client retrieves it transparently")
+            {
+                CHECK(plain_client.tensor_exists(name));
+
+                std::vector<double> result(values.size(), 0.0);
+                plain_client.unpack_tensor(name, result.data(),
+                                           {values.size()},
+                                           SRTensorTypeDouble,
+                                           SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                void* data = NULL;
+                std::vector<size_t> fetched_dims;
+                SRTensorType type;
+                client.get_tensor(name, data, fetched_dims, type,
+                                  SRMemLayoutContiguous);
+                CHECK(type == SRTensorTypeDouble);
+                CHECK(fetched_dims == dims);
+                for (size_t i = 0; i < values.size(); i++)
+                    CHECK(((double*)data)[i] == values[i]);
+
+                std::vector<float> converted(values.size(), 0.0f);
+                client.unpack_tensor_as(name, converted.data(),
+                                        {values.size()}, SRTensorTypeFloat,
+                                        SRMemLayoutContiguous);
+                for (size_t i = 0; i < values.size(); i++)
+                    CHECK(converted[i] == (float)values[i]);
+            }
+            client.delete_tensor(name);
+        }
+
+        WHEN("A packed DataSet is put by the compressing client")
+        {
+            client.use_packed_datasets(true);
+            DataSet dataset("test_compressed_dataset");
+            dataset.add_tensor("field", values.data(), dims,
+                               SRTensorTypeDouble, SRMemLayoutContiguous);
+            dataset.add_meta_string("units", "m/s");
+            client.put_dataset(dataset);
+
+            THEN("Either client retrieves it transparently")
+            {
+                DataSet fetched = plain_client.get_dataset(dataset.get_name());
+                std::vector<double> result(values.size(), 0.0);
+                fetched.unpack_tensor("field", result.data(),
+                                      {values.size()}, SRTensorTypeDouble,
+                                      SRMemLayoutContiguous);
+                CHECK(result == values);
+                CHECK(fetched.get_meta_strings("units") ==
+                      std::vector<std::string>({"m/s"}));
+            }
+            client.delete_dataset(dataset.get_name());
+        }
+    }
+
+    GIVEN("A Client object with lossy compression enabled")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_string_option("SR_COMPRESSION", "quantize");
+        cfgopts->override_string_option("SR_COMPRESSION_ERROR_BOUND", "1e-4");
+        Client client(cfgopts.get(), "test_client");
+        Client plain_client("test_client");
+
+        std::vector<double> values(4096);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = std::sin(0.01 * i);
+
+        WHEN("A tensor is put by the lossy client")
+        {
+            std::string name = "test_quantized_tensor";
+            client.put_tensor(name, values.data(), {values.size()},
+                              SRTensorTypeDouble, SRMemLayoutContiguous);
+
+            THEN("Either client retrieves it to within the error bound")
+            {
+                std::vector<double> result(values.size(), 0.0);
+                plain_client.unpack_tensor(name, result.data(),
+                                           {values.size()},
+                                           SRTensorTypeDouble,
+                                           SRMemLayoutContiguous);
+                for (size_t i = 0; i < values.size(); i++)
+                    CHECK(std::fabs(result[i] - values[i]) <= 1e-4);
+            }
+            client.delete_tensor(name);
+        }
+    }
+
+    GIVEN("A lossy codec without an error bound")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_string_option("SR_COMPRESSION", "quantize");
+        THEN("The Client cannot be created")
+        {
+            CHECK_THROWS_AS(Client(cfgopts.get(), "test_client"),
+                            ParameterException);
+        }
+    }
+
+    GIVEN("An unknown compression codec")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_string_option("SR_COMPRESSION", "zip");
+        THEN("The Client cannot be created")
+        {
+            CHECK_THROWS_AS(Client(cfgopts.get(), "test_client"),
+                            ParameterException);
+        }
+    }
+    log_data(context, LLDebug, "***End Client compression testing***");
+}
+
+SCENARIO("Testing delta-encoded tensors on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing delta-encoded tensors on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client delta encoding testing***");
+    GIVEN("A producing Client object and a reading Client object")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_integer_option("SR_DELTA_KEYFRAME_INTERVAL", 3);
+        Client producer(cfgopts.get(), "test_client");
+        Client reader("test_client");
+
+        std::string name = "test_delta_tensor";
+        std::vector<size_t> dims = {8, 16};
+        std::vector<float> values(dims[0] * dims[1], 2.0f);
+
+        WHEN("A tensor is put as deltas over several steps")
+        {
+            THEN("The reader sees the latest values after each step")
+            {
+                for (size_t step = 0; step < 7; step++) {
+                    values[step] = (float)step;
+                    producer.put_tensor_delta(name, values.data(), dims,
+                                              SRTensorTypeFloat,
+                                              SRMemLayoutContiguous);
+                    std::vector<float> result(values.size(), 0.0f);
+                    reader.unpack_tensor(name, result.data(),
+                                         {values.size()}, SRTensorTypeFloat,
+                                         SRMemLayoutContiguous);
+                    CHECK(result == values);
+                }
+                CHECK(reader.tensor_exists(name));
+            }
+
+            AND_THEN("The stream recovers when the tensor is overwritten")
+            {
+                producer.put_tensor_delta(name, values.data(), dims,
+                                          SRTensorTypeFloat,
+                                          SRMemLayoutContiguous);
+                reader.put_tensor(name, values.data(), dims,
+                                  SRTensorTypeFloat, SRMemLayoutContiguous);
+                values[0] = -1.0f;
+                producer.put_tensor_delta(name, values.data(), dims,
+                                          SRTensorTypeFloat,
+                                          SRMemLayoutContiguous);
+
+                void* data = NULL;
+                std::vector<size_t> fetched_dims;
+                SRTensorType type;
+                reader.get_tensor(name, data, fetched_dims, type,
+                                  SRMemLayoutContiguous);
+                CHECK(type == SRTensorTypeFloat);
+                CHECK(fetched_dims == dims);
+                CHECK(((float*)data)[0] == -1.0f);
+            }
+            producer.delete_tensor(name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client delta encoding testing***");
+}
+
+SCENARIO("Testing chunked tensors on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing chunked tensors on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client chunked tensor testing***");
+    GIVEN("A Client object with a small tensor chunk size")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_integer_option("SR_TENSOR_CHUNK_SIZE", 1000);
+        Client client(cfgopts.get(), "test_client");
+        Client plain_client("test_client");
+
+        std::string name = "test_chunked_tensor";
+        std::vector<size_t> dims = {30, 17};
+        std::vector<double> values(dims[0] * dims[1]);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = 0.5 * i;
+
+        WHEN("A tensor larger than the chunk size is put")
+        {
+            client.put_tensor(name, values.data(), dims,
+                              SRTensorTypeDouble, SRMemLayoutContiguous);
+
+            THEN("It is reassembled by any client")
+            {
+                std::vector<double> result(values.size(), 0.0);
+                plain_client.unpack_tensor(name, result.data(),
+                                           {values.size()},
+                                           SRTensorTypeDouble,
+                                           SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                std::vector<float> converted(values.size(), 0.0f);
+                client.unpack_tensor_as(name, converted.data(),
+                                        {values.size()}, SRTensorTypeFloat,
+                                        SRMemLayoutContiguous);
+                for (size_t i = 0; i < values.size(); i++)
+                    CHECK(converted[i] == (float)values[i]);
+
+                void* data = NULL;
+                std::vector<size_t> fetched_dims;
+                SRTensorType type;
+                plain_client.get_tensor(name, data, fetched_dims, type,
+                                        SRMemLayoutContiguous);
+                CHECK(type == SRTensorTypeDouble);
+                CHECK(fetched_dims == dims);
+                for (size_t i = 0; i < values.size(); i++)
+                    CHECK(((double*)data)[i] == values[i]);
+            }
+
+            AND_THEN("It can be copied and renamed with its chunks")
+            {
+                std::string copy_name = name + "_copy";
+                std::string renamed = name + "_renamed";
+                client.copy_tensor(name, copy_name);
+                client.copy_tensor(name, copy_name);
+                client.rename_tensor(copy_name, renamed);
+                CHECK(client.tensor_exists(name));
+                CHECK_FALSE(client.tensor_exists(copy_name));
+
+                std::vector<double> result(values.size(), 0.0);
+                plain_client.unpack_tensor(renamed, result.data(),
+                                           {values.size()},
+                                           SRTensorTypeDouble,
+                                           SRMemLayoutContiguous);
+                CHECK(result == values);
+                client.delete_tensor(renamed);
+            }
+
+            AND_THEN("It can be replaced and deleted")
+            {
+                values[0] = -1.0;
+                client.put_tensor(name, values.data(), dims,
+                                  SRTensorTypeDouble, SRMemLayoutContiguous);
+                std::vector<double> result(values.size(), 0.0);
+                client.unpack_tensor(name, result.data(), {values.size()},
+                                     SRTensorTypeDouble,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                client.delete_tensor(name);
+                CHECK_FALSE(client.tensor_exists(name));
+            }
+            if (client.tensor_exists(name))
+                client.delete_tensor(name);
         }
     }
-    log_data(context, LLDebug, "***End Client testing***");
+    log_data(context, LLDebug, "***End Client chunked tensor testing***");
+}
+
+SCENARIO("Testing tiled tensors on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing tiled tensors on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client tiled tensor testing***");
+    GIVEN("A Client object")
+    {
+        Client client("test_client");
+
+        std::string name = "test_tiled_tensor";
+        std::vector<size_t> dims = {9, 8, 5};
+        std::vector<float> values(dims[0] * dims[1] * dims[2]);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = 0.25f * i;
+
+        WHEN("A tensor is put in tiles")
+        {
+            client.put_tensor_tiled(name, values.data(), dims, {4, 3, 5},
+                                    SRTensorTypeFloat, SRMemLayoutContiguous);
+
+            AND_THEN("It can be copied and renamed with its tiles")
+            {
+                std::string copy_name = name + "_copy";
+                std::string renamed = name + "_renamed";
+                client.copy_tensor(name, copy_name);
+                client.rename_tensor(copy_name, renamed);
+                CHECK_FALSE(client.tensor_exists(copy_name));
+
+                std::vector<float> result(values.size(), 0.0f);
+                client.unpack_tensor(renamed, result.data(), {values.size()},
+                                     SRTensorTypeFloat,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                std::vector<float> region(4, -1.0f);
+                client.unpack_tensor_slice(renamed, {8, 6, 3}, {1, 2, 2},
+                                           region.data(), SRTensorTypeFloat);
+                CHECK(region[3] == values[(8 * dims[1] + 7) * dims[2] + 4]);
+                client.delete_tensor(renamed);
+            }
+
+            THEN("A sub-region can be read")
+            {
+                std::vector<size_t> offsets = {2, 5, 1};
+                std::vector<size_t> counts = {6, 3, 2};
+                std::vector<float> region(36, -1.0f);
+                client.unpack_tensor_slice(name, offsets, counts,
+                                           region.data(), SRTensorTypeFloat);
+                for (size_t i = 0; i < counts[0]; i++) {
+                    for (size_t j = 0; j < counts[1]; j++) {
+                        for (size_t k = 0; k < counts[2]; k++) {
+                            size_t index = ((i + offsets[0]) * dims[1] +
+                                            j + offsets[1]) * dims[2] +
+                                           k + offsets[2];
+                            CHECK(region[(i * counts[1] + j) * counts[2] + k]
+                                  == values[index]);
+                        }
+                    }
+                }
+
+                CHECK_THROWS_AS(
+                    client.unpack_tensor_slice(name, {8, 0, 0}, {2, 1, 1},
+                                               region.data(),
+                                               SRTensorTypeFloat),
+                    ParameterException);
+                CHECK_THROWS_AS(
+                    client.unpack_tensor_slice(name, {0, 0, 0}, {1, 1, 1},
+                                               region.data(),
+                                               SRTensorTypeDouble),
+                    RuntimeException);
+            }
+
+            AND_THEN("The whole tensor can be read, replaced and deleted")
+            {
+                std::vector<float> result(values.size(), 0.0f);
+                client.unpack_tensor(name, result.data(), {values.size()},
+                                     SRTensorTypeFloat,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                values[0] = -1.0f;
+                client.put_tensor_tiled(name, values.data(), dims, {2, 2, 2},
+                                        SRTensorTypeFloat,
+                                        SRMemLayoutContiguous);
+                float first = 0.0f;
+                client.unpack_tensor_slice(name, {0, 0, 0}, {1, 1, 1},
+                                           &first, SRTensorTypeFloat);
+                CHECK(first == -1.0f);
+
+                client.delete_tensor(name);
+                CHECK_FALSE(client.tensor_exists(name));
+            }
+            if (client.tensor_exists(name))
+                client.delete_tensor(name);
+        }
+
+        WHEN("A tensor is put without tiles")
+        {
+            client.put_tensor(name, values.data(), dims,
+                              SRTensorTypeFloat, SRMemLayoutContiguous);
+
+            THEN("A sub-region can still be read")
+            {
+                std::vector<float> region(2, -1.0f);
+                client.unpack_tensor_slice(name, {1, 2, 3}, {1, 1, 2},
+                                           region.data(), SRTensorTypeFloat);
+                CHECK(region[0] == values[(1 * 8 + 2) * 5 + 3]);
+                CHECK(region[1] == values[(1 * 8 + 2) * 5 + 4]);
+            }
+            client.delete_tensor(name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client tiled tensor testing***");
+}
+
+SCENARIO("Testing appendable tensors on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing appendable tensors on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client appendable tensor testing***");
+    GIVEN("A Client object")
+    {
+        Client client("test_client");
+        std::string name = "test_appendable_tensor";
+        if (client.tensor_exists(name))
+            client.delete_tensor(name);
+
+        WHEN("Records are appended to a tensor")
+        {
+            std::vector<size_t> dims = {2, 2};
+            for (int step = 0; step < 5; step++) {
+                std::vector<double> record(4, (double)step);
+                record[3] = -step;
+                client.append_to_tensor(name, record.data(), dims,
+                                        SRTensorTypeDouble,
+                                        SRMemLayoutContiguous);
+            }
+
+            THEN("A window of records can be retrieved")
+            {
+                void* data = NULL;
+                std::vector<size_t> fetched_dims;
+                SRTensorType type;
+                client.get_tensor_range(name, 1, 3, data, fetched_dims, type,
+                                        SRMemLayoutContiguous);
+                CHECK(type == SRTensorTypeDouble);
+                CHECK(fetched_dims == std::vector<size_t>({2, 2, 2}));
+                CHECK(((double*)data)[0] == 1.0);
+                CHECK(((double*)data)[4] == 2.0);
+                CHECK(((double*)data)[7] == -2.0);
+
+                // A window past the last record is shortened
+                client.get_tensor_range(name, 3, 10, data, fetched_dims, type,
+                                        SRMemLayoutContiguous);
+                CHECK(fetched_dims == std::vector<size_t>({2, 2, 2}));
+                CHECK(((double*)data)[4] == 4.0);
+
+                CHECK_THROWS_AS(
+                    client.get_tensor_range(name, 5, 6, data, fetched_dims,
+                                            type, SRMemLayoutContiguous),
+                    KeyException);
+            }
+
+            AND_THEN("The whole tensor can be retrieved")
+            {
+                std::vector<double> result(20, 0.0);
+                client.unpack_tensor(name, result.data(), {20},
+                                     SRTensorTypeDouble,
+                                     SRMemLayoutContiguous);
+                CHECK(result[16] == 4.0);
+                CHECK(result[19] == -4.0);
+
+                // Records of another shape are rejected when read
+                std::vector<double> other(3, 0.0);
+                client.append_to_tensor(name, other.data(), {3},
+                                        SRTensorTypeDouble,
+                                        SRMemLayoutContiguous);
+                CHECK_THROWS_AS(
+                    client.unpack_tensor(name, result.data(), {20},
+                                         SRTensorTypeDouble,
+                                         SRMemLayoutContiguous),
+                    RuntimeException);
+            }
+            client.delete_tensor(name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client appendable tensor testing***");
+}
+
+SCENARIO("Testing tensor overwrites across storage formats on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing tensor overwrites across storage formats on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client tensor overwrite testing***");
+    GIVEN("Clients storing tensors in each format")
+    {
+        auto compress_opts = ConfigOptions::create_from_environment("");
+        compress_opts->override_string_option("SR_COMPRESSION", "shuffle-lz");
+        Client compressing_client(compress_opts.get(), "test_client");
+        auto chunk_opts = ConfigOptions::create_from_environment("");
+        chunk_opts->override_integer_option("SR_TENSOR_CHUNK_SIZE", 100);
+        Client chunking_client(chunk_opts.get(), "test_client");
+        Client client("test_client");
+
+        std::string name = "test_overwritten_tensor";
+        std::vector<size_t> dims = {8, 16};
+        size_t n_values = dims[0] * dims[1];
+        typedef std::function<void(const std::vector<float>&)> Putter;
+        std::vector<std::pair<std::string, Putter>> formats = {
+            {"plain", [&](const std::vector<float>& v) {
+                client.put_tensor(name, v.data(), dims, SRTensorTypeFloat,
+                                  SRMemLayoutContiguous); }},
+            {"compressed", [&](const std::vector<float>& v) {
+                compressing_client.put_tensor(name, v.data(), dims,
+                                              SRTensorTypeFloat,
+                                              SRMemLayoutContiguous); }},
+            {"chunked", [&](const std::vector<float>& v) {
+                chunking_client.put_tensor(name, v.data(), dims,
+                                           SRTensorTypeFloat,
+                                           SRMemLayoutContiguous); }},
+            {"tiled", [&](const std::vector<float>& v) {
+                client.put_tensor_tiled(name, v.data(), dims, {3, 5},
+                                        SRTensorTypeFloat,
+                                        SRMemLayoutContiguous); }},
+            {"delta", [&](const std::vector<float>& v) {
+                client.put_tensor_delta(name, v.data(), dims,
+                                        SRTensorTypeFloat,
+                                        SRMemLayoutContiguous); }},
+            {"appendable", [&](const std::vector<float>& v) {
+                client.append_to_tensor(name, v.data(), dims,
+                                        SRTensorTypeFloat,
+                                        SRMemLayoutContiguous); }},
+        };
+
+        WHEN("A tensor in each format is overwritten in every other format")
+        {
+            THEN("The new values replace the old ones")
+            {
+                float step = 0.0f;
+                for (size_t old_fmt = 0; old_fmt < formats.size(); old_fmt++) {
+                    for (size_t new_fmt = 0; new_fmt < formats.size(); new_fmt++) {
+                        // Records are appended to an appendable tensor
+                        // rather than replacing it
+                        if (old_fmt == new_fmt || formats[new_fmt].first == "appendable")
+                            continue;
+                        INFO(formats[old_fmt].first + " overwritten as " +
+                             formats[new_fmt].first);
+                        if (client.tensor_exists(name))
+                            client.delete_tensor(name);
+
+                        std::vector<float> old_values(n_values, step++);
+                        std::vector<float> new_values(n_values);
+                        for (size_t i = 0; i < n_values; i++)
+                            new_values[i] = step + 0.5f * i;
+                        step++;
+
+                        formats[old_fmt].second(old_values);
+                        formats[new_fmt].second(new_values);
+
+                        std::vector<float> result(n_values, 0.0f);
+                        client.unpack_tensor(name, result.data(), {n_values},
+                                             SRTensorTypeFloat,
+                                             SRMemLayoutContiguous);
+                        CHECK(result == new_values);
+
+                        // A client storing strings reads the key type first
+                        std::vector<float> probed(n_values, 0.0f);
+                        compressing_client.unpack_tensor(name, probed.data(),
+                                                         {n_values},
+                                                         SRTensorTypeFloat,
+                                                         SRMemLayoutContiguous);
+                        CHECK(probed == new_values);
+                    }
+                }
+                client.delete_tensor(name);
+                CHECK_FALSE(client.tensor_exists(name));
+            }
+        }
+
+        WHEN("A record is appended to a tensor in another format")
+        {
+            THEN("The append is refused and the tensor is unchanged")
+            {
+                std::vector<float> values(n_values);
+                for (size_t i = 0; i < n_values; i++)
+                    values[i] = 0.25f * i;
+                std::vector<float> record(n_values, 1.0f);
+
+                for (size_t fmt = 0; fmt < formats.size(); fmt++) {
+                    if (formats[fmt].first == "appendable")
+                        continue;
+                    INFO(formats[fmt].first + " appended to");
+                    if (client.tensor_exists(name))
+                        client.delete_tensor(name);
+                    formats[fmt].second(values);
+
+                    CHECK_THROWS_AS(
+                        client.append_to_tensor(name, record.data(), dims,
+                                                SRTensorTypeFloat,
+                                                SRMemLayoutContiguous),
+                        RuntimeException);
+
+                    std::vector<float> result(n_values, 0.0f);
+                    client.unpack_tensor(name, result.data(), {n_values},
+                                         SRTensorTypeFloat,
+                                         SRMemLayoutContiguous);
+                    CHECK(result == values);
+                }
+                client.delete_tensor(name);
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End Client tensor overwrite testing***");
+}
+
+SCENARIO("Testing tensor transfer through files on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing tensor transfer through files on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client tensor file testing***");
+    GIVEN("A Client object and a raw file of values after a header")
+    {
+        Client client("test_client");
+        std::string name = "test_file_tensor";
+        std::string dir = std::filesystem::temp_directory_path().string();
+        std::string raw_path = dir + "/smartredis_test_client_tensor.raw";
+        std::string npy_path = dir + "/smartredis_test_client_tensor.npy";
+
+        std::vector<float> values(24);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = 0.5f * i;
+        std::string header(16, 'h');
+        {
+            std::ofstream raw(raw_path, std::ios::binary);
+            raw.write(header.data(), header.size());
+            raw.write((const char*)values.data(), values.size() * sizeof(float));
+        }
+
+        WHEN("The file is put into the database")
+        {
+            client.put_tensor_from_file(name, raw_path, {2, 3, 4},
+                                        SRTensorTypeFloat, header.size());
+
+            THEN("The tensor holds the values from the file")
+            {
+                std::vector<float> result(24, 0.0f);
+                client.unpack_tensor(name, result.data(), {24},
+                                     SRTensorTypeFloat,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+            }
+
+            AND_THEN("The tensor can be retrieved into a .npy file and put back")
+            {
+                client.unpack_tensor_to_file(name, npy_path);
+                client.delete_tensor(name);
+                client.put_tensor_from_file(name, npy_path);
+
+                void* data = NULL;
+                std::vector<size_t> dims;
+                SRTensorType type;
+                client.get_tensor(name, data, dims, type,
+                                  SRMemLayoutContiguous);
+                CHECK(type == SRTensorTypeFloat);
+                CHECK(dims == std::vector<size_t>({2, 3, 4}));
+                CHECK(std::memcmp(data, values.data(),
+                                  values.size() * sizeof(float)) == 0);
+            }
+
+            AND_THEN("A raw file that is too short is rejected")
+            {
+                CHECK_THROWS_AS(
+                    client.put_tensor_from_file(name, raw_path, {5, 5},
+                                                SRTensorTypeFloat,
+                                                header.size()),
+                    ParameterException);
+                CHECK_THROWS_AS(client.put_tensor_from_file(name, raw_path),
+                                ParameterException);
+            }
+            client.delete_tensor(name);
+        }
+        std::remove(raw_path.c_str());
+        std::remove(npy_path.c_str());
+    }
+    log_data(context, LLDebug, "***End Client tensor file testing***");
 }
 
 SCENARIO("Testing Tensor Functions on Client Object", "[Client]")
@@ -858,6 +2347,501 @@ SCENARIO("Test that prefixing covers all hash slots of a cluster", "[Client]")
     log_data(context, LLDebug, "***End Client prefix coverage testing***");
 }
 
+SCENARIO("Test routing of commands to cluster shards", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Test routing of commands to cluster shards" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client command routing testing***");
+
+    if(use_cluster()==false)
+        return;
+
+    GIVEN("A test RedisCluster test object")
+    {
+        ConfigOptions* cfgopts = ConfigOptions::create_from_environment("").release();
+        LogContext context("test_client");
+        cfgopts->_set_log_context(&context);
+        RedisClusterTestObject redis_cluster(cfgopts);
+
+        // One command per hash slot, keyed by the prefix of that slot
+        std::vector<SingleKeyCommand> cmds(16384);
+        std::vector<std::string> prefixes(16384);
+        for (size_t hash_slot = 0; hash_slot < 16384; hash_slot++) {
+            prefixes[hash_slot] = redis_cluster.get_crc16_prefix(hash_slot);
+            cmds[hash_slot] << "GET"
+                            << Keyfield("{" + prefixes[hash_slot] + "}.key");
+        }
+
+        THEN("Each command is routed to the shard serving its hash slot")
+        {
+            for (size_t hash_slot = 0; hash_slot < 16384; hash_slot++) {
+                const std::string& prefix =
+                    redis_cluster.get_db_node_prefix(cmds[hash_slot]);
+                SingleKeyCommand check;
+                check << "GET" << Keyfield("{" + prefix + "}.key");
+                CHECK(redis_cluster.get_db_node_prefix(check) == prefix);
+
+                // The prefix is that of the first slot of the shard
+                CHECK(check.get_key_hash_slot(0) <= hash_slot);
+                CHECK(redis_cluster.get_db_node_prefix(cmds[
+                    check.get_key_hash_slot(0)]) == prefix);
+            }
+        }
+
+        AND_THEN("Routing is cheap enough to do for every command")
+        {
+            // Microbenchmark: route every command repeatedly and report
+            // the mean time per command
+            const size_t n_rounds = 20;
+            size_t n_routed = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t round = 0; round < n_rounds; round++) {
+                for (size_t i = 0; i < cmds.size(); i++)
+                    n_routed += redis_cluster.get_db_node_prefix(cmds[i]).size() > 0;
+            }
+            auto stop = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+            std::cout << "Routed " << n_routed << " commands in "
+                      << ns / n_routed << " ns per command" << std::endl;
+            CHECK(n_routed == n_rounds * cmds.size());
+        }
+
+        AND_THEN("Commands still route after concurrent slot map refreshes")
+        {
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < 4; t++) {
+                threads.push_back(std::thread([&redis_cluster, t]() {
+                    redis_cluster.refresh_cluster_map(t * 4096);
+                }));
+            }
+            for (size_t t = 0; t < threads.size(); t++)
+                threads[t].join();
+
+            for (size_t hash_slot = 0; hash_slot < 16384; hash_slot += 97) {
+                std::string prefix =
+                    redis_cluster.get_db_node_prefix(cmds[hash_slot]);
+                CHECK(prefix.size() > 0);
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End Client command routing testing***");
+}
+
+// Run a CLUSTER command on one node of a cluster
+static CommandReply run_cluster_command(RedisClusterTestObject& redis_cluster,
+                                        const DBNode& node,
+                                        std::vector<std::string> args)
+{
+    AddressAtCommand cmd;
+    cmd.set_exec_address(node.address);
+    cmd << "CLUSTER";
+    for (size_t i = 0; i < args.size(); i++)
+        cmd << args[i];
+    CommandReply reply = redis_cluster.run(cmd);
+    REQUIRE(reply.has_error() == 0);
+    return reply;
+}
+
+// Hand an empty hash slot over to another node, as a resharding would
+static void move_slot(RedisClusterTestObject& redis_cluster,
+                      const std::vector<DBNode>& nodes,
+                      const DBNode& from, const DBNode& to,
+                      const std::string& slot, bool finish)
+{
+    if (!finish) {
+        run_cluster_command(redis_cluster, to,
+                            {"SETSLOT", slot, "IMPORTING", from.name});
+        run_cluster_command(redis_cluster, from,
+                            {"SETSLOT", slot, "MIGRATING", to.name});
+        return;
+    }
+    run_cluster_command(redis_cluster, to, {"SETSLOT", slot, "NODE", to.name});
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].name != to.name) {
+            run_cluster_command(redis_cluster, nodes[i],
+                                {"SETSLOT", slot, "NODE", to.name});
+        }
+    }
+}
+
+SCENARIO("Test cluster redirects during a resharding", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Test cluster redirects during a resharding" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client redirect testing***");
+
+    if(use_cluster()==false)
+        return;
+
+    GIVEN("A Client object and a hash slot moving between shards")
+    {
+        ConfigOptions* cfgopts = ConfigOptions::create_from_environment("").release();
+        LogContext log_context("test_client");
+        cfgopts->_set_log_context(&log_context);
+        RedisClusterTestObject redis_cluster(cfgopts);
+        Client client("test_client");
+
+        std::vector<DBNode> nodes = redis_cluster.get_db_nodes();
+        if (nodes.size() < 2)
+            return;
+
+        // Pick a key whose hash slot holds no other keys, so that the
+        // slot can be handed over without migrating data
+        std::string name;
+        std::string slot;
+        size_t from = 0;
+        for (size_t i = 0; name.size() == 0; i++) {
+            std::string candidate = "test_redirected_tensor_" + std::to_string(i);
+            SingleKeyCommand probe;
+            probe << "EXISTS" << Keyfield(candidate);
+            uint16_t hash_slot = probe.get_key_hash_slot(0);
+            for (from = 0; from < nodes.size(); from++) {
+                if (hash_slot >= nodes[from].lower_hash_slot &&
+                    hash_slot <= nodes[from].upper_hash_slot)
+                    break;
+            }
+            REQUIRE(from < nodes.size());
+            CommandReply count = run_cluster_command(
+                redis_cluster, nodes[from],
+                {"COUNTKEYSINSLOT", std::to_string(hash_slot)});
+            if (count.integer() == 0) {
+                name = candidate;
+                slot = std::to_string(hash_slot);
+            }
+        }
+        const DBNode& source = nodes[from];
+        const DBNode& target = nodes[(from + 1) % nodes.size()];
+
+        std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f};
+        std::vector<size_t> dims = {4};
+
+        WHEN("The slot is migrating and then moved to another shard")
+        {
+            // The source answers ASK for keys it does not hold
+            move_slot(redis_cluster, nodes, source, target, slot, false);
+            client.put_tensor(name, values.data(), dims,
+                              SRTensorTypeFloat, SRMemLayoutContiguous);
+
+            // The Client still routes the slot to the source, which
+            // now answers MOVED
+            move_slot(redis_cluster, nodes, source, target, slot, true);
+            std::vector<float> result(values.size(), 0.0f);
+            client.unpack_tensor(name, result.data(), dims,
+                                 SRTensorTypeFloat, SRMemLayoutContiguous);
+
+            THEN("The Client follows the redirects")
+            {
+                CHECK(result == values);
+                CHECK(client.tensor_exists(name));
+                CommandReply count = run_cluster_command(
+                    redis_cluster, target, {"COUNTKEYSINSLOT", slot});
+                CHECK(count.integer() == 1);
+            }
+
+            // Hand the slot back to where it was
+            client.delete_tensor(name);
+            move_slot(redis_cluster, nodes, target, source, slot, false);
+            move_slot(redis_cluster, nodes, target, source, slot, true);
+        }
+    }
+    log_data(context, LLDebug, "***End Client redirect testing***");
+}
+
+// Count the part keys that exist and the shards they are stored on
+static size_t count_part_keys(RedisClusterTestObject& redis_cluster,
+                              const std::vector<std::string>& keys,
+                              size_t& n_shards)
+{
+    std::set<std::string> prefixes;
+    size_t n_existing = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        SingleKeyCommand cmd;
+        cmd << "EXISTS" << Keyfield(keys[i]);
+        prefixes.insert(redis_cluster.get_db_node_prefix(cmd));
+        n_existing += redis_cluster.run(cmd).integer();
+    }
+    n_shards = prefixes.size();
+    return n_existing;
+}
+
+SCENARIO("Testing chunked tensors spread over cluster shards", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing chunked tensors spread over cluster shards" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client clustered chunk testing***");
+
+    if(use_cluster()==false)
+        return;
+
+    GIVEN("A Client object with a small tensor chunk size on a cluster")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_integer_option("SR_TENSOR_CHUNK_SIZE", 64);
+        Client client(cfgopts.get(), "test_client");
+        ConfigOptions* cluster_opts =
+            ConfigOptions::create_from_environment("").release();
+        LogContext log_context("test_client");
+        cluster_opts->_set_log_context(&log_context);
+        RedisClusterTestObject redis_cluster(cluster_opts);
+
+        std::string name = "test_clustered_chunked_tensor";
+        std::vector<size_t> dims = {40, 50};
+        std::vector<double> values(dims[0] * dims[1]);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = 0.25 * i;
+
+        // Get the chunk keys from the manifest stored under the key
+        auto get_part_keys = [&redis_cluster, &name]() {
+            SingleKeyCommand cmd;
+            cmd << "GET" << Keyfield(name);
+            CommandReply reply = redis_cluster.run(cmd);
+            std::string_view buf(reply.str(), reply.str_len());
+            REQUIRE(ChunkManifest::is_manifest(buf));
+            return ChunkManifest::unpack(buf).part_keys(name);
+        };
+
+        WHEN("A tensor of many chunks is put")
+        {
+            client.put_tensor(name, values.data(), dims,
+                              SRTensorTypeDouble, SRMemLayoutContiguous);
+            std::vector<std::string> keys = get_part_keys();
+
+            THEN("The chunks are spread over the shards and reassembled")
+            {
+                size_t n_shards = 0;
+                CHECK(keys.size() == values.size() * sizeof(double) / 64);
+                CHECK(count_part_keys(redis_cluster, keys, n_shards) ==
+                      keys.size());
+                CHECK(n_shards > 1);
+
+                std::vector<double> result(values.size(), 0.0);
+                client.unpack_tensor(name, result.data(), {values.size()},
+                                     SRTensorTypeDouble,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+            }
+
+            AND_THEN("Replacing and deleting it removes the chunks of every shard")
+            {
+                size_t n_shards = 0;
+                values[0] = -1.0;
+                client.put_tensor(name, values.data(), dims,
+                                  SRTensorTypeDouble, SRMemLayoutContiguous);
+                CHECK(count_part_keys(redis_cluster, keys, n_shards) == 0);
+
+                std::vector<std::string> new_keys = get_part_keys();
+                std::vector<double> result(values.size(), 0.0);
+                client.unpack_tensor(name, result.data(), {values.size()},
+                                     SRTensorTypeDouble,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                client.delete_tensor(name);
+                CHECK_FALSE(client.tensor_exists(name));
+                CHECK(count_part_keys(redis_cluster, new_keys, n_shards) == 0);
+            }
+            if (client.tensor_exists(name))
+                client.delete_tensor(name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client clustered chunk testing***");
+}
+
+SCENARIO("Testing tiled tensors spread over cluster shards", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing tiled tensors spread over cluster shards" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client clustered tile testing***");
+
+    if(use_cluster()==false)
+        return;
+
+    GIVEN("A Client object on a cluster")
+    {
+        Client client("test_client");
+        ConfigOptions* cluster_opts =
+            ConfigOptions::create_from_environment("").release();
+        LogContext log_context("test_client");
+        cluster_opts->_set_log_context(&log_context);
+        RedisClusterTestObject redis_cluster(cluster_opts);
+
+        std::string name = "test_clustered_tiled_tensor";
+        std::vector<size_t> dims = {16, 12};
+        std::vector<float> values(dims[0] * dims[1]);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = 0.5f * i;
+
+        WHEN("A tensor of many tiles is put")
+        {
+            client.put_tensor_tiled(name, values.data(), dims, {2, 3},
+                                    SRTensorTypeFloat, SRMemLayoutContiguous);
+
+            SingleKeyCommand cmd;
+            cmd << "GET" << Keyfield(name);
+            CommandReply reply = redis_cluster.run(cmd);
+            std::string_view buf(reply.str(), reply.str_len());
+            REQUIRE(TileManifest::is_manifest(buf));
+            std::vector<std::string> keys =
+                TileManifest::unpack(buf).part_keys(name);
+
+            THEN("The tiles are spread over the shards and read back")
+            {
+                size_t n_shards = 0;
+                CHECK(keys.size() == 32);
+                CHECK(count_part_keys(redis_cluster, keys, n_shards) ==
+                      keys.size());
+                CHECK(n_shards > 1);
+
+                std::vector<size_t> offsets = {3, 2};
+                std::vector<size_t> counts = {10, 9};
+                std::vector<float> region(counts[0] * counts[1], -1.0f);
+                client.unpack_tensor_slice(name, offsets, counts,
+                                           region.data(), SRTensorTypeFloat);
+                for (size_t i = 0; i < counts[0]; i++) {
+                    for (size_t j = 0; j < counts[1]; j++) {
+                        CHECK(region[i * counts[1] + j] ==
+                              values[(i + offsets[0]) * dims[1] +
+                                     j + offsets[1]]);
+                    }
+                }
+            }
+
+            AND_THEN("Deleting it removes the tiles of every shard")
+            {
+                size_t n_shards = 0;
+                client.delete_tensor(name);
+                CHECK_FALSE(client.tensor_exists(name));
+                CHECK(count_part_keys(redis_cluster, keys, n_shards) == 0);
+            }
+            if (client.tensor_exists(name))
+                client.delete_tensor(name);
+        }
+    }
+    log_data(context, LLDebug, "***End Client clustered tile testing***");
+}
+
+SCENARIO("Testing replica reads on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing replica reads on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client replica read testing***");
+
+    if(use_cluster()==false)
+        return;
+
+    GIVEN("A Client object reading from replicas and one writing")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_string_option("SR_REPLICA_READS", "round-robin");
+        Client reader(cfgopts.get(), "test_client");
+        Client writer("test_client");
+
+        std::vector<size_t> dims = {8, 4};
+        std::vector<float> values(dims[0] * dims[1]);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = 0.5f * i;
+
+        WHEN("Tensors and DataSets are written")
+        {
+            writer.put_tensor("test_replica_tensor", values.data(), dims,
+                              SRTensorTypeFloat, SRMemLayoutContiguous);
+            DataSet dataset("test_replica_dataset");
+            dataset.add_tensor("tensor", values.data(), dims,
+                               SRTensorTypeFloat, SRMemLayoutContiguous);
+            dataset.add_meta_string("meta", "value");
+            writer.put_dataset(dataset);
+
+            THEN("The reading Client sees them, from the master when "\
+                 "a replica has not caught up")
+            {
+                CHECK(reader.poll_tensor("test_replica_tensor", 10, 100));
+                std::vector<float> result(values.size(), 0.0f);
+                reader.unpack_tensor("test_replica_tensor", result.data(),
+                                     {values.size()}, SRTensorTypeFloat,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                CHECK(reader.dataset_exists("test_replica_dataset"));
+                DataSet retrieved = reader.get_dataset("test_replica_dataset");
+                CHECK(retrieved.get_meta_strings("meta") ==
+                      std::vector<std::string>{"value"});
+            }
+
+            AND_THEN("Missing keys are still reported as missing")
+            {
+                CHECK_FALSE(reader.tensor_exists("test_replica_missing"));
+                CHECK_THROWS(reader.unpack_tensor("test_replica_missing",
+                                                  values.data(),
+                                                  {values.size()},
+                                                  SRTensorTypeFloat,
+                                                  SRMemLayoutContiguous));
+            }
+        }
+    }
+
+    AND_GIVEN("An unknown replica read policy")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_string_option("SR_REPLICA_READS", "nearest");
+        CHECK_THROWS_AS(Client(cfgopts.get(), "test_client"),
+                        ParameterException);
+    }
+    log_data(context, LLDebug, "***End Client replica read testing***");
+}
+
+SCENARIO("Testing sharded standalone databases on Client Object", "[Client]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing sharded standalone databases on Client Object" << std::endl;
+    std::string context("test_client");
+    log_data(context, LLDebug, "***Beginning Client sharded testing***");
+
+    if(use_cluster())
+        return;
+
+    GIVEN("A Client object in sharded mode")
+    {
+        auto cfgopts = ConfigOptions::create_from_environment("");
+        cfgopts->override_string_option("SR_DB_TYPE", "Sharded");
+        Client client(cfgopts.get(), "test_client");
+
+        std::vector<size_t> dims = {4, 2};
+        std::vector<double> values(dims[0] * dims[1]);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = 0.25 * i;
+
+        WHEN("Tensors and DataSets are stored")
+        {
+            client.put_tensor("test_sharded_tensor", values.data(), dims,
+                              SRTensorTypeDouble, SRMemLayoutContiguous);
+            DataSet dataset("test_sharded_dataset");
+            dataset.add_tensor("tensor", values.data(), dims,
+                               SRTensorTypeDouble, SRMemLayoutContiguous);
+            dataset.add_meta_string("meta", "value");
+            client.put_dataset(dataset);
+
+            THEN("They can be retrieved, copied and deleted")
+            {
+                std::vector<double> result(values.size(), 0.0);
+                client.unpack_tensor("test_sharded_tensor", result.data(),
+                                     {values.size()}, SRTensorTypeDouble,
+                                     SRMemLayoutContiguous);
+                CHECK(result == values);
+
+                client.copy_tensor("test_sharded_tensor",
+                                   "test_sharded_tensor_copy");
+                CHECK(client.tensor_exists("test_sharded_tensor_copy"));
+                client.delete_tensor("test_sharded_tensor_copy");
+                CHECK_FALSE(client.tensor_exists("test_sharded_tensor_copy"));
+
+                DataSet retrieved = client.get_dataset("test_sharded_dataset");
+                CHECK(retrieved.get_meta_strings("meta") ==
+                      std::vector<std::string>{"value"});
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End Client sharded testing***");
+}
+
 SCENARIO("Testing Multi-GPU Function error cases", "[Client]")
 {
     std::cout << std::to_string(get_time_offset()) << ": Testing Multi-GPU Function error cases" << std::endl;
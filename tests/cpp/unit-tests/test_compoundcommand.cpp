@@ -138,4 +138,59 @@ SCENARIO("Testing copy constructor and deep copy operator for CompoundCommand",
         }
     }
     log_data(context, LLDebug, "***End CompoundCommand testing***");
-}
\ No newline at end of file
+}
+
+SCENARIO("Testing CompoundCommand fields beyond the inline arena", "[CompoundCommand]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing CompoundCommand fields beyond the inline arena" << std::endl;
+    std::string context("test_compoundcommand");
+    log_data(context, LLDebug, "***Beginning CompoundCommand arena testing***");
+
+    GIVEN("A CompoundCommand with small, large, numeric and pointer fields")
+    {
+        CompoundCommand cmd;
+        std::string large(10000, 'x');
+        char blob[5] = "BLOB";
+        std::vector<size_t> dims = {2, 30000, 18446744073709551615ULL};
+        std::vector<int> offsets = {-7, 0};
+
+        cmd << "AI.TENSORSET" << Keyfield("{tensor}.key") << "FLOAT";
+        cmd << dims << offsets;
+        cmd.add_field_ptr(blob, 4);
+        cmd << large;
+        for (int i = 0; i < 100; i++)
+            cmd << std::string("field_") + std::to_string(i);
+        std::string output = cmd.to_string();
+
+        THEN("Integers are formatted like std::to_string")
+        {
+            Command::const_iterator it = cmd.cbegin() + 3;
+            CHECK(*it++ == "2");
+            CHECK(*it++ == "30000");
+            CHECK(*it++ == "18446744073709551615");
+            CHECK(*it++ == "-7");
+            CHECK(*it++ == "0");
+            CHECK(it->data() == blob);
+        }
+
+        AND_THEN("Copies and moves own their fields")
+        {
+            CompoundCommand copy(cmd);
+            CompoundCommand assigned;
+            assigned << "PING";
+            assigned = copy;
+            CompoundCommand moved(std::move(copy));
+            CHECK(copy.get_field_count() == 0);
+            CHECK(assigned.to_string() == output);
+            CHECK(moved.to_string() == output);
+            CHECK(moved.cbegin()->data() != cmd.cbegin()->data());
+            CHECK((moved.cbegin() + 8)->data() == blob);
+            CHECK(moved.get_keys() == std::vector<std::string>({"{tensor}.key"}));
+
+            moved.set_field_at("{tensor}.other", 1, true);
+            CHECK(moved.get_keys() == std::vector<std::string>({"{tensor}.other"}));
+            CHECK(cmd.to_string() == output);
+        }
+    }
+    log_data(context, LLDebug, "***End CompoundCommand arena testing***");
+}
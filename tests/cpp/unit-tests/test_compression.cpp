@@ -0,0 +1,257 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "compression.h"
+#include "srexception.h"
+#include "logger.h"
+
+unsigned long get_time_offset();
+
+using namespace SmartRedis;
+
+// A site-specific codec that stores the bytes reversed
+class ReverseCodec : public CompressionCodec
+{
+    public:
+        std::string compress(std::string_view raw, size_t element_size,
+                             SRTensorType type, int level,
+                             double error_bound) const override
+        {
+            // Drop the trailing zero so that the payload is kept
+            return std::string(raw.rbegin() + 1, raw.rend());
+        }
+
+        void decompress(std::string_view payload, size_t element_size,
+                        SRTensorType type, double error_bound,
+                        void* raw, size_t raw_size) const override
+        {
+            if (payload.size() + 1 != raw_size)
+                throw SRRuntimeException("Bad reversed payload");
+            char* out = (char*)raw;
+            std::copy(payload.rbegin(), payload.rend(), out);
+            out[raw_size - 1] = 0;
+        }
+};
+
+SCENARIO("Testing buffer compression", "[Compression]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing buffer compression" << std::endl;
+    std::string context("test_compression");
+    log_data(context, LLDebug, "***Beginning buffer compression testing***");
+
+    GIVEN("A smooth double precision field")
+    {
+        std::vector<size_t> dims = {32, 64};
+        std::vector<double> field(dims[0] * dims[1]);
+        for (size_t i = 0; i < field.size(); i++)
+            field[i] = std::sin(1.0e-3 * i);
+        std::string_view raw((const char*)field.data(),
+                             field.size() * sizeof(double));
+
+        WHEN("It is compressed with the shuffle-lz codec")
+        {
+            int level = GENERATE(1, 5, 9);
+            std::string compressed = compress_buffer(
+                raw, sizeof(double), SRTensorTypeDouble, dims,
+                SRCompressionShuffleLZ, level);
+
+            THEN("It is smaller and round trips with its type and dims")
+            {
+                CHECK(compressed.size() < raw.size());
+                CHECK(is_compressed_buffer(compressed));
+
+                SRTensorType type;
+                std::vector<size_t> stored_dims;
+                std::string values = decompress_buffer(compressed, type,
+                                                       stored_dims);
+                CHECK(type == SRTensorTypeDouble);
+                CHECK(stored_dims == dims);
+                CHECK(values == std::string(raw));
+            }
+
+            AND_THEN("A truncated or corrupted buffer is rejected")
+            {
+                SRTensorType type;
+                std::vector<size_t> stored_dims;
+                std::string truncated =
+                    compressed.substr(0, compressed.size() - 1);
+                CHECK_THROWS_AS(
+                    decompress_buffer(truncated, type, stored_dims),
+                    RuntimeException);
+                CHECK_THROWS_AS(
+                    decompress_buffer(raw, type, stored_dims),
+                    RuntimeException);
+            }
+        }
+    }
+
+    GIVEN("Incompressible bytes")
+    {
+        std::string noise(1000, '\0');
+        unsigned int state = 12345;
+        for (size_t i = 0; i < noise.size(); i++) {
+            state = state * 1103515245u + 12345u;
+            noise[i] = (char)(state >> 24);
+        }
+
+        THEN("They are stored as they are and still round trip")
+        {
+            std::string compressed = compress_buffer(
+                noise, 1, SRTensorTypeInvalid, {}, SRCompressionShuffleLZ, 1);
+            CHECK(compressed.size() <= noise.size() + 64);
+
+            SRTensorType type;
+            std::vector<size_t> dims;
+            CHECK(decompress_buffer(compressed, type, dims) == noise);
+            CHECK(type == SRTensorTypeInvalid);
+            CHECK(dims.size() == 0);
+        }
+    }
+
+    GIVEN("Codec names")
+    {
+        THEN("Known names are accepted in any case")
+        {
+            CHECK(compression_codec_from_string("none") == SRCompressionNone);
+            CHECK(compression_codec_from_string("Shuffle-LZ") ==
+                  SRCompressionShuffleLZ);
+            CHECK_THROWS_AS(compression_codec_from_string("zip"),
+                            ParameterException);
+        }
+    }
+    log_data(context, LLDebug, "***End buffer compression testing***");
+}
+
+SCENARIO("Testing lossy and registered compression codecs", "[Compression]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing lossy and registered compression codecs" << std::endl;
+    std::string context("test_compression");
+    log_data(context, LLDebug, "***Beginning lossy compression testing***");
+
+    GIVEN("A smooth single precision field with a non-finite value")
+    {
+        std::vector<size_t> dims = {100, 100};
+        std::vector<float> field(dims[0] * dims[1]);
+        for (size_t i = 0; i < field.size(); i++)
+            field[i] = 50.0f * std::sin(1.0e-3f * i);
+        field[17] = NAN;
+        std::string_view raw((const char*)field.data(),
+                             field.size() * sizeof(float));
+
+        WHEN("It is quantized with an error bound")
+        {
+            double bound = GENERATE(1.0e-1, 1.0e-3);
+            std::string compressed = compress_buffer(
+                raw, sizeof(float), SRTensorTypeFloat, dims,
+                SRCompressionQuantize, 1, bound);
+
+            THEN("Every value is within the bound, which is recorded")
+            {
+                CHECK(compressed.size() < raw.size());
+                CHECK(compressed_buffer_error_bound(compressed) == bound);
+
+                SRTensorType type;
+                std::vector<size_t> stored_dims;
+                std::string values = decompress_buffer(compressed, type,
+                                                       stored_dims);
+                CHECK(type == SRTensorTypeFloat);
+                CHECK(stored_dims == dims);
+                REQUIRE(values.size() == raw.size());
+                const float* result = (const float*)values.data();
+                CHECK(std::isnan(result[17]));
+                for (size_t i = 0; i < field.size(); i++) {
+                    if (i != 17)
+                        CHECK(std::fabs(result[i] - field[i]) <= bound);
+                }
+            }
+        }
+
+        THEN("Quantization requires a positive error bound")
+        {
+            CHECK_THROWS_AS(
+                compress_buffer(raw, sizeof(float), SRTensorTypeFloat, dims,
+                                SRCompressionQuantize, 1, 0.0),
+                ParameterException);
+        }
+    }
+
+    GIVEN("A buffer of a type that cannot be quantized")
+    {
+        std::string bytes(4096, 'x');
+
+        THEN("It is compressed losslessly instead")
+        {
+            std::string compressed = compress_buffer(
+                bytes, 1, SRTensorTypeInvalid, {}, SRCompressionQuantize,
+                1, 0.5);
+            CHECK(compressed_buffer_error_bound(compressed) == 0.0);
+            SRTensorType type;
+            std::vector<size_t> dims;
+            CHECK(decompress_buffer(compressed, type, dims) == bytes);
+        }
+    }
+
+    GIVEN("A site-specific codec")
+    {
+        THEN("It can be registered, selected by name and used")
+        {
+            SRCompressionCodec id = (SRCompressionCodec)200;
+            register_compression_codec("Reverse", id,
+                                       std::make_shared<ReverseCodec>());
+            CHECK(compression_codec_from_string("reverse") == id);
+            CHECK_THROWS_AS(
+                register_compression_codec(
+                    "other", id, std::make_shared<ReverseCodec>()),
+                ParameterException);
+            CHECK_THROWS_AS(
+                register_compression_codec(
+                    "shuffle-lz", SRCompressionUserFirst,
+                    std::make_shared<ReverseCodec>()),
+                ParameterException);
+            CHECK_THROWS_AS(
+                register_compression_codec(
+                    "low", SRCompressionQuantize,
+                    std::make_shared<ReverseCodec>()),
+                ParameterException);
+
+            std::string bytes = "abcdefgh";
+            bytes.push_back('\0');
+            std::string compressed = compress_buffer(
+                bytes, 1, SRTensorTypeInvalid, {}, id, 1);
+            SRTensorType type;
+            std::vector<size_t> dims;
+            CHECK(decompress_buffer(compressed, type, dims) == bytes);
+        }
+    }
+    log_data(context, LLDebug, "***End lossy compression testing***");
+}
@@ -0,0 +1,119 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "redisshards.h"
+#include "command.h"
+#include "srexception.h"
+#include "logger.h"
+
+unsigned long get_time_offset();
+
+using namespace SmartRedis;
+
+SCENARIO("Testing the hash slot map of RedisShards", "[RedisShards]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing the hash slot map of RedisShards" << std::endl;
+    std::string context("test_redisshards");
+    log_data(context, LLDebug, "***Beginning RedisShards slot map testing***");
+
+    GIVEN("A list of standalone database addresses")
+    {
+        std::vector<std::string> shards = {
+            "10.0.0.1:6379", "10.0.0.2:6379", "10.0.0.3:6379", "10.0.0.4:6379"};
+
+        WHEN("The hash slots are mapped onto them")
+        {
+            std::vector<uint16_t> slot_shards =
+                RedisShards::map_hash_slots(shards);
+
+            THEN("Every slot is assigned and the load is balanced")
+            {
+                REQUIRE(slot_shards.size() == 16384);
+                std::vector<size_t> counts(shards.size(), 0);
+                for (size_t slot = 0; slot < slot_shards.size(); slot++) {
+                    REQUIRE(slot_shards[slot] < shards.size());
+                    counts[slot_shards[slot]]++;
+                }
+                for (size_t s = 0; s < counts.size(); s++) {
+                    CHECK(counts[s] > 16384 / shards.size() / 2);
+                    CHECK(counts[s] < 16384 / shards.size() * 2);
+                }
+            }
+
+            AND_THEN("The map does not depend on the order of the list")
+            {
+                std::vector<std::string> reversed(shards.rbegin(),
+                                                  shards.rend());
+                std::vector<uint16_t> reversed_slot_shards =
+                    RedisShards::map_hash_slots(reversed);
+                for (size_t slot = 0; slot < slot_shards.size(); slot++) {
+                    CHECK(shards[slot_shards[slot]] ==
+                          reversed[reversed_slot_shards[slot]]);
+                }
+            }
+
+            AND_THEN("Adding a shard only moves slots onto the new shard")
+            {
+                std::vector<std::string> grown(shards);
+                grown.push_back("10.0.0.5:6379");
+                std::vector<uint16_t> grown_slot_shards =
+                    RedisShards::map_hash_slots(grown);
+                size_t n_moved = 0;
+                for (size_t slot = 0; slot < slot_shards.size(); slot++) {
+                    if (grown_slot_shards[slot] != slot_shards[slot]) {
+                        CHECK(grown_slot_shards[slot] == shards.size());
+                        n_moved++;
+                    }
+                }
+                CHECK(n_moved < 16384 / 2);
+            }
+
+            AND_THEN("Keys with a common hash tag share a shard")
+            {
+                for (size_t i = 0; i < 100; i++) {
+                    std::string tag = "{run_" + std::to_string(i) + "}";
+                    CHECK(slot_shards[Command::get_hash_slot(tag + ".a")] ==
+                          slot_shards[Command::get_hash_slot(tag + ".b")]);
+                }
+            }
+        }
+    }
+
+    AND_GIVEN("An invalid list of addresses")
+    {
+        THEN("Empty lists and repeated addresses are rejected")
+        {
+            CHECK_THROWS_AS(RedisShards::map_hash_slots({}),
+                            ParameterException);
+            CHECK_THROWS_AS(RedisShards::map_hash_slots(
+                {"10.0.0.1:6379", "10.0.0.1:6379"}), ParameterException);
+        }
+    }
+    log_data(context, LLDebug, "***End RedisShards slot map testing***");
+}
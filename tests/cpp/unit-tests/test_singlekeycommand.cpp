@@ -128,4 +128,74 @@ SCENARIO("Testing copy constructor for SingleKeyCommand on heap", "[SingleKeyCom
         }
     }
     log_data(context, LLDebug, "***End SingleKeyCommand copy testing***");
-}
\ No newline at end of file
+}
+
+SCENARIO("Testing cached hash slots of SingleKeyCommand keys", "[SingleKeyCommand]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing cached hash slots of SingleKeyCommand keys" << std::endl;
+    std::string context("test_singlekeycommand");
+    log_data(context, LLDebug, "***Beginning SingleKeyCommand hash slot testing***");
+
+    GIVEN("Keys with and without hash tags")
+    {
+        THEN("Hash slots follow the Redis cluster specification")
+        {
+            CHECK(Command::get_hash_slot("123456789") == 12739);
+            CHECK(Command::get_hash_slot("{user1000}.following") ==
+                  Command::get_hash_slot("user1000"));
+            CHECK(Command::get_hash_slot("foo{}{bar}") !=
+                  Command::get_hash_slot("bar"));
+            CHECK(Command::get_hash_slot("foo{{bar}}zap") ==
+                  Command::get_hash_slot("{bar"));
+            CHECK(Command::get_hash_slot("foo{bar}{zap}") ==
+                  Command::get_hash_slot("bar"));
+        }
+
+        AND_THEN("A SingleKeyCommand caches the hash slot of its key")
+        {
+            SingleKeyCommand cmd;
+            cmd << "GET" << Keyfield("{user1000}.followers");
+            REQUIRE(cmd.get_key_count() == 1);
+            CHECK(cmd.get_key_hash_slot(0) ==
+                  Command::get_hash_slot("user1000"));
+
+            SingleKeyCommand cmd_cpy(cmd);
+            CHECK(cmd_cpy.get_key_hash_slot(0) == cmd.get_key_hash_slot(0));
+
+            cmd.set_field_at("123456789", 1, true);
+            CHECK(cmd.get_key_count() == 1);
+            CHECK(cmd.get_key_hash_slot(0) == 12739);
+        }
+    }
+    log_data(context, LLDebug, "***End SingleKeyCommand hash slot testing***");
+}
+
+SCENARIO("Testing read-only classification of SingleKeyCommand", "[SingleKeyCommand]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing read-only classification of SingleKeyCommand" << std::endl;
+    std::string context("test_singlekeycommand");
+    log_data(context, LLDebug, "***Beginning SingleKeyCommand read-only testing***");
+
+    GIVEN("Commands that read and commands that write")
+    {
+        SingleKeyCommand get_cmd;
+        get_cmd << "AI.TENSORGET" << Keyfield("tensor") << "META" << "BLOB";
+        SingleKeyCommand exists_cmd;
+        exists_cmd << "EXISTS" << Keyfield("tensor");
+        SingleKeyCommand set_cmd;
+        set_cmd << "AI.TENSORSET" << Keyfield("tensor") << "FLOAT" << "1";
+        SingleKeyCommand del_cmd;
+        del_cmd << "DEL" << Keyfield("tensor");
+        SingleKeyCommand empty_cmd;
+
+        THEN("Only the reads may be served by a replica")
+        {
+            CHECK(get_cmd.is_read_only());
+            CHECK(exists_cmd.is_read_only());
+            CHECK_FALSE(set_cmd.is_read_only());
+            CHECK_FALSE(del_cmd.is_read_only());
+            CHECK_FALSE(empty_cmd.is_read_only());
+        }
+    }
+    log_data(context, LLDebug, "***End SingleKeyCommand read-only testing***");
+}
@@ -103,10 +103,15 @@ SCENARIO("Additional Testing for various SSDBs", "[SSDB]")
             test_ssdb.clear_cached_SSDB();
             CHECK_THROWS_AS(test_ssdb.get_ssdb(), SmartRedis::RuntimeException);
 
-            // SSDB points to a unix domain socket and we're using clustered Redis
+            // SSDB points to a missing unix domain socket and we're using
+            // clustered Redis, so connecting to the shard fails quickly
             // FINDME: This test uses a deprecated constructor and will need to be rewritten
             setenv_ssdb ("unix://127.0.0.1:6349");
-            CHECK_THROWS_AS(c = new Client(true, "test_ssdb"), SmartRedis::RuntimeException);
+            setenv("SR_CONN_TIMEOUT", "1", true);
+            setenv("SR_CONN_INTERVAL", "100", true);
+            CHECK_THROWS_AS(c = new Client(true, "test_ssdb"), SmartRedis::DatabaseException);
+            unsetenv("SR_CONN_TIMEOUT");
+            unsetenv("SR_CONN_INTERVAL");
 
             setenv_ssdb(old_ssdb);
         }
@@ -140,4 +140,94 @@ SCENARIO("Testing Tensor", "[Tensor]")
         }
     }
     log_data(context, LLDebug, "***End Tensor testing***");
-}
\ No newline at end of file
+}
+
+SCENARIO("Testing strided Tensor", "[Tensor]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing strided Tensor" << std::endl;
+    std::string context("test_tensor");
+    log_data(context, LLDebug, "***Beginning strided Tensor testing***");
+
+    GIVEN("A halo-padded 6x7 array")
+    {
+        const size_t n_rows = 6;
+        const size_t n_cols = 7;
+        std::vector<double> padded(n_rows * n_cols);
+        for (size_t i = 0; i < padded.size(); i++)
+            padded[i] = (double)i;
+
+        // Interior 4x5 block starting at (1, 1)
+        std::vector<size_t> dims = {4, 5};
+        std::vector<size_t> strides = {n_cols, 1};
+        size_t offset = n_cols + 1;
+
+        WHEN("A Tensor is constructed from the interior block")
+        {
+            Tensor<double> t("test_strided", padded.data(), dims,
+                             strides, offset, SRTensorTypeDouble);
+
+            THEN("The interior values are gathered in row major order")
+            {
+                CHECK(t.dims() == dims);
+                CHECK(t.num_values() == 20);
+                double* values = (double*)t.data();
+                for (size_t i = 0; i < dims[0]; i++) {
+                    for (size_t j = 0; j < dims[1]; j++) {
+                        CHECK(values[i * dims[1] + j] ==
+                              padded[offset + i * n_cols + j]);
+                    }
+                }
+            }
+
+            AND_THEN("The values can be scattered back into a padded array")
+            {
+                std::vector<double> result(n_rows * n_cols, -1.0);
+                t.fill_mem_space_strided(result.data(), dims, strides, offset);
+                for (size_t i = 0; i < n_rows; i++) {
+                    for (size_t j = 0; j < n_cols; j++) {
+                        bool interior = i >= 1 && i <= 4 && j >= 1 && j <= 5;
+                        double expected = interior ? padded[i * n_cols + j] : -1.0;
+                        CHECK(result[i * n_cols + j] == expected);
+                    }
+                }
+            }
+
+            AND_THEN("Mismatched dimensions or strides are rejected")
+            {
+                std::vector<double> result(n_rows * n_cols);
+                std::vector<size_t> bad_dims = {5, 4};
+                std::vector<size_t> bad_strides = {n_cols};
+                CHECK_THROWS_AS(
+                    t.fill_mem_space_strided(result.data(), bad_dims,
+                                             strides, offset),
+                    RuntimeException);
+                CHECK_THROWS_AS(
+                    t.fill_mem_space_strided(result.data(), dims,
+                                             bad_strides, offset),
+                    ParameterException);
+            }
+        }
+
+        AND_WHEN("A Tensor is constructed from a column major interior block")
+        {
+            // Treat the array as column major with a leading dimension of 7
+            std::vector<size_t> f_dims = {5, 4};
+            std::vector<size_t> f_strides = {1, n_cols};
+            Tensor<double> t("test_strided", padded.data(), f_dims,
+                             f_strides, offset, SRTensorTypeDouble);
+
+            THEN("It matches a FortranContiguous Tensor of the same block")
+            {
+                std::vector<double> packed;
+                for (size_t j = 0; j < f_dims[1]; j++)
+                    for (size_t i = 0; i < f_dims[0]; i++)
+                        packed.push_back(padded[offset + j * n_cols + i]);
+                Tensor<double> f_t("test_packed", packed.data(), f_dims,
+                                   SRTensorTypeDouble,
+                                   SRMemLayoutFortranContiguous);
+                CHECK(t.buf() == f_t.buf());
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End strided Tensor testing***");
+}
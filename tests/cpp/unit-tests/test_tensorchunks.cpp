@@ -0,0 +1,190 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "tensorchunks.h"
+#include "srexception.h"
+#include "logger.h"
+
+unsigned long get_time_offset();
+
+using namespace SmartRedis;
+
+SCENARIO("Testing chunk manifests", "[TensorChunks]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing chunk manifests" << std::endl;
+    std::string context("test_tensorchunks");
+    log_data(context, LLDebug, "***Beginning chunk manifest testing***");
+
+    GIVEN("A manifest for a tensor that does not divide into whole chunks")
+    {
+        std::vector<size_t> dims = {10, 25};
+        ChunkManifest manifest(SRTensorTypeDouble, dims, 2000, 300);
+
+        THEN("The chunks cover the tensor data exactly")
+        {
+            CHECK(manifest.n_chunks() == 7);
+            CHECK(manifest.chunk_offset(6) == 1800);
+            CHECK(manifest.chunk_bytes(0) == 300);
+            CHECK(manifest.chunk_bytes(6) == 200);
+        }
+
+        AND_THEN("Chunk keys are distinct and differ between puts")
+        {
+            ChunkManifest other(SRTensorTypeDouble, dims, 2000, 300);
+            CHECK(manifest.chunk_key("field", 0) !=
+                  manifest.chunk_key("field", 1));
+            CHECK(manifest.chunk_key("field", 0) !=
+                  other.chunk_key("field", 0));
+            CHECK(manifest.chunk_key("field", 0).rfind("field.chunk.", 0) == 0);
+        }
+
+        AND_THEN("The manifest round trips through its serialized form")
+        {
+            std::string packed = manifest.pack();
+            CHECK(packed.size() <= ChunkManifest::max_packed_size);
+            REQUIRE(ChunkManifest::is_manifest(packed));
+            ChunkManifest unpacked = ChunkManifest::unpack(packed);
+            CHECK(unpacked.type == SRTensorTypeDouble);
+            CHECK(unpacked.dims == dims);
+            CHECK(unpacked.total_bytes == 2000);
+            CHECK(unpacked.chunk_size == 300);
+            CHECK(unpacked.chunk_key("field", 3) ==
+                  manifest.chunk_key("field", 3));
+
+            CHECK_FALSE(ChunkManifest::is_manifest("not a manifest"));
+            CHECK_THROWS_AS(
+                ChunkManifest::unpack(packed.substr(0, packed.size() - 1)),
+                RuntimeException);
+        }
+    }
+
+    GIVEN("A chunk size of zero")
+    {
+        THEN("The manifest cannot be created")
+        {
+            CHECK_THROWS_AS(ChunkManifest(SRTensorTypeFloat, {4}, 16, 0),
+                            ParameterException);
+        }
+    }
+    log_data(context, LLDebug, "***End chunk manifest testing***");
+}
+
+SCENARIO("Testing tile manifests", "[TensorChunks]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing tile manifests" << std::endl;
+    std::string context("test_tensorchunks");
+    log_data(context, LLDebug, "***Beginning tile manifest testing***");
+
+    GIVEN("A manifest for a tensor that does not divide into whole tiles")
+    {
+        std::vector<size_t> dims = {10, 7};
+        TileManifest manifest(SRTensorTypeInt32, dims, {4, 3});
+
+        THEN("The tiles cover the tensor exactly")
+        {
+            CHECK(manifest.n_tiles() == 9);
+            CHECK(manifest.tile_origin(0) == std::vector<size_t>({0, 0}));
+            CHECK(manifest.tile_origin(5) == std::vector<size_t>({4, 6}));
+            CHECK(manifest.tile_extent(4) == std::vector<size_t>({4, 3}));
+            CHECK(manifest.tile_extent(8) == std::vector<size_t>({2, 1}));
+            CHECK(manifest.part_keys("field").size() == 9);
+            CHECK(manifest.tile_key("field", 0).rfind("field.tile.", 0) == 0);
+        }
+
+        AND_THEN("Only the tiles intersecting a region are selected")
+        {
+            CHECK(manifest.tiles_in_region({3, 2}, {2, 2}) ==
+                  std::vector<size_t>({0, 1, 3, 4}));
+            CHECK(manifest.tiles_in_region({9, 6}, {1, 1}) ==
+                  std::vector<size_t>({8}));
+            CHECK(manifest.tiles_in_region({0, 0}, {10, 7}).size() == 9);
+            CHECK(manifest.tiles_in_region({0, 0}, {0, 7}).empty());
+        }
+
+        AND_THEN("The manifest round trips through its serialized form")
+        {
+            std::string packed = manifest.pack();
+            CHECK(packed.size() <= TileManifest::max_packed_size);
+            REQUIRE(TileManifest::is_manifest(packed));
+            CHECK_FALSE(ChunkManifest::is_manifest(packed));
+            TileManifest unpacked = TileManifest::unpack(packed);
+            CHECK(unpacked.type == SRTensorTypeInt32);
+            CHECK(unpacked.dims == dims);
+            CHECK(unpacked.tile_dims == std::vector<size_t>({4, 3}));
+            CHECK(unpacked.tile_key("field", 3) ==
+                  manifest.tile_key("field", 3));
+            CHECK_THROWS_AS(
+                TileManifest::unpack(packed.substr(0, packed.size() - 1)),
+                RuntimeException);
+        }
+    }
+
+    GIVEN("Tile dimensions that do not match the tensor")
+    {
+        THEN("The manifest cannot be created")
+        {
+            CHECK_THROWS_AS(TileManifest(SRTensorTypeFloat, {4, 4}, {2}),
+                            ParameterException);
+            CHECK_THROWS_AS(TileManifest(SRTensorTypeFloat, {4, 4}, {2, 0}),
+                            ParameterException);
+        }
+    }
+
+    GIVEN("A tensor and a tile of it")
+    {
+        std::vector<size_t> dims = {5, 6};
+        std::vector<int> values(30);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = (int)i;
+
+        THEN("A box can be copied out of the tensor and back")
+        {
+            // The values at rows 1-2 and columns 2-4 of the tensor
+            std::vector<int> box(6, -1);
+            copy_tensor_box((const char*)values.data(), dims, {0, 0},
+                            (char*)box.data(), {2, 3}, {1, 2},
+                            {1, 2}, {3, 5}, sizeof(int));
+            CHECK(box == std::vector<int>({8, 9, 10, 14, 15, 16}));
+
+            // Part of the box copied into a second tensor
+            std::vector<int> copy(30, -1);
+            copy_tensor_box((const char*)box.data(), {2, 3}, {1, 2},
+                            (char*)copy.data(), dims, {0, 0},
+                            {2, 3}, {3, 5}, sizeof(int));
+            CHECK(copy[15] == 15);
+            CHECK(copy[16] == 16);
+            CHECK(copy[14] == -1);
+            CHECK(copy[9] == -1);
+        }
+    }
+    log_data(context, LLDebug, "***End tile manifest testing***");
+}
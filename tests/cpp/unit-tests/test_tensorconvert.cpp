@@ -0,0 +1,188 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "tensorconvert.h"
+#include "srexception.h"
+#include "logger.h"
+
+unsigned long get_time_offset();
+
+using namespace SmartRedis;
+
+SCENARIO("Testing tensor value conversion", "[TensorConvert]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing tensor value conversion" << std::endl;
+    std::string context("test_tensorconvert");
+    log_data(context, LLDebug, "***Beginning tensor value conversion testing***");
+
+    GIVEN("Double precision values")
+    {
+        std::vector<double> values = {1.5, 2.5, -1.5, 3.25, -0.4, 100.0};
+
+        WHEN("They are converted to float")
+        {
+            std::vector<float> result(values.size());
+            convert_tensor_values(values.data(), SRTensorTypeDouble,
+                                  result.data(), SRTensorTypeFloat,
+                                  values.size());
+            THEN("The values are unchanged")
+            {
+                for (size_t i = 0; i < values.size(); i++)
+                    CHECK(result[i] == (float)values[i]);
+            }
+        }
+
+        WHEN("They are converted to int32")
+        {
+            std::vector<int32_t> result(values.size());
+            convert_tensor_values(values.data(), SRTensorTypeDouble,
+                                  result.data(), SRTensorTypeInt32,
+                                  values.size());
+            THEN("The values are rounded half to even")
+            {
+                CHECK(result == std::vector<int32_t>({2, 2, -2, 3, 0, 100}));
+            }
+        }
+
+        WHEN("They are converted to bool")
+        {
+            bool result[6];
+            convert_tensor_values(values.data(), SRTensorTypeDouble,
+                                  result, SRTensorTypeBool, values.size());
+            THEN("Non-zero values are true")
+            {
+                for (size_t i = 0; i < values.size(); i++)
+                    CHECK(result[i]);
+            }
+        }
+    }
+
+    GIVEN("Values that do not fit in the destination type")
+    {
+        THEN("Out of range and NaN values are rejected")
+        {
+            double big = 3.0e9;
+            double nan = std::nan("");
+            int64_t negative = -1;
+            int32_t i32;
+            uint8_t u8;
+            CHECK_THROWS_AS(
+                convert_tensor_values(&big, SRTensorTypeDouble,
+                                      &i32, SRTensorTypeInt32, 1),
+                ParameterException);
+            CHECK_THROWS_AS(
+                convert_tensor_values(&nan, SRTensorTypeDouble,
+                                      &i32, SRTensorTypeInt32, 1),
+                ParameterException);
+            CHECK_THROWS_AS(
+                convert_tensor_values(&negative, SRTensorTypeInt64,
+                                      &u8, SRTensorTypeUint8, 1),
+                ParameterException);
+        }
+
+        AND_THEN("Values at the edge of the range are accepted")
+        {
+            int16_t edge[2] = {-128, 127};
+            int8_t result[2];
+            convert_tensor_values(edge, SRTensorTypeInt16,
+                                  result, SRTensorTypeInt8, 2);
+            CHECK(result[0] == -128);
+            CHECK(result[1] == 127);
+        }
+    }
+
+    GIVEN("Single precision values converted to 16 bit floating point")
+    {
+        std::vector<float> values = {1.0f, -2.0f, 0.5f, 65504.0f, 65520.0f, 0.1f};
+
+        THEN("float16 conversion rounds half to even and overflows to infinity")
+        {
+            std::vector<uint16_t> bits(values.size());
+            convert_tensor_values(values.data(), SRTensorTypeFloat,
+                                  bits.data(), SRTensorTypeFloat16,
+                                  values.size());
+            CHECK(bits == std::vector<uint16_t>(
+                {0x3c00, 0xc000, 0x3800, 0x7bff, 0x7c00, 0x2e66}));
+
+            std::vector<float> back(values.size());
+            convert_tensor_values(bits.data(), SRTensorTypeFloat16,
+                                  back.data(), SRTensorTypeFloat,
+                                  values.size());
+            for (size_t i = 0; i < 4; i++)
+                CHECK(back[i] == values[i]);
+            CHECK(std::isinf(back[4]));
+            CHECK(std::fabs(back[5] - 0.1f) < 1.0e-4f);
+        }
+
+        AND_THEN("bfloat16 conversion keeps the float exponent range")
+        {
+            CHECK(float_to_bfloat16(1.0f) == 0x3f80);
+            CHECK(float_to_bfloat16(65520.0f) == 0x4780);
+            CHECK(bfloat16_to_float(0x4780) == 65536.0f);
+            CHECK(std::isnan(bfloat16_to_float(float_to_bfloat16(std::nanf("")))));
+        }
+
+        AND_THEN("float16 subnormals survive a round trip")
+        {
+            uint16_t smallest = 0x0001;
+            float value = float16_to_float(smallest);
+            CHECK(value == std::ldexp(1.0f, -24));
+            CHECK(float_to_float16(value) == smallest);
+        }
+
+        AND_THEN("Doubles and 64-bit integers are rounded to half precision once")
+        {
+            // Just above a float16 tie, but exactly on it once in float
+            std::vector<double> values = {1.0 + std::ldexp(1.0, -11) +
+                                          std::ldexp(1.0, -40)};
+            std::vector<uint16_t> bits(values.size());
+            convert_tensor_values(values.data(), SRTensorTypeDouble,
+                                  bits.data(), SRTensorTypeFloat16,
+                                  values.size());
+            CHECK(bits[0] == 0x3c01);
+            CHECK(double_to_float16(values[0]) == 0x3c01);
+
+            // Just above a bfloat16 tie, but exactly on it once in double
+            int64_t big = (int64_t(1) << 60) + (int64_t(1) << 52) + 1;
+            uint16_t big_bits = 0;
+            convert_tensor_values(&big, SRTensorTypeInt64,
+                                  &big_bits, SRTensorTypeBFloat16, 1);
+            CHECK(big_bits == 0x5d81);
+
+            CHECK(double_to_bfloat16(1.0) == 0x3f80);
+            CHECK(double_to_float16(-65520.0) == 0xfc00);
+            CHECK(double_to_float16(std::ldexp(1.0, -25)) == 0x0000);
+            CHECK(double_to_float16(std::ldexp(3.0, -26)) == 0x0001);
+        }
+    }
+    log_data(context, LLDebug, "***End tensor value conversion testing***");
+}
@@ -0,0 +1,128 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "tensordelta.h"
+#include "srexception.h"
+#include "logger.h"
+
+unsigned long get_time_offset();
+
+using namespace SmartRedis;
+
+SCENARIO("Testing delta encoding of tensors", "[TensorDelta]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing delta encoding of tensors" << std::endl;
+    std::string context("test_tensordelta");
+    log_data(context, LLDebug, "***Beginning tensor delta encoding testing***");
+
+    GIVEN("A field that changes in a few places at each step")
+    {
+        std::vector<size_t> dims = {64, 64};
+        std::vector<double> field(dims[0] * dims[1], 1.0);
+        std::string_view values((const char*)field.data(),
+                                field.size() * sizeof(double));
+        DeltaEncoder encoder(4, 1);
+
+        WHEN("Successive steps are encoded")
+        {
+            std::vector<std::string> frames;
+            std::vector<bool> keyframes;
+            for (size_t step = 0; step < 6; step++) {
+                field[step * 100] += 0.5;
+                bool keyframe;
+                frames.push_back(encoder.encode(values, SRTensorTypeDouble,
+                                                dims, keyframe));
+                keyframes.push_back(keyframe);
+
+                // Each step reconstructs from the frames so far
+                std::vector<std::string_view> stored(frames.begin(),
+                                                     frames.end());
+                SRTensorType type;
+                std::vector<size_t> stored_dims;
+                CHECK(decode_delta_frames(stored, type, stored_dims) ==
+                      std::string(values));
+                CHECK(type == SRTensorTypeDouble);
+                CHECK(stored_dims == dims);
+            }
+
+            THEN("Keyframes recur at the interval and deltas are small")
+            {
+                CHECK(keyframes == std::vector<bool>(
+                    {true, false, false, false, true, false}));
+                CHECK(is_delta_frame(frames[1]));
+                CHECK(frames[1].size() < values.size() / 20);
+                CHECK(encoder.stream_length() == 2);
+            }
+
+            AND_THEN("Frames from the last keyframe on are sufficient")
+            {
+                std::vector<std::string_view> stored = {frames[4], frames[5]};
+                SRTensorType type;
+                std::vector<size_t> stored_dims;
+                CHECK(decode_delta_frames(stored, type, stored_dims) ==
+                      std::string(values));
+            }
+
+            AND_THEN("Broken streams are rejected")
+            {
+                SRTensorType type;
+                std::vector<size_t> stored_dims;
+                std::vector<std::string_view> no_keyframe = {frames[1]};
+                CHECK_THROWS_AS(
+                    decode_delta_frames(no_keyframe, type, stored_dims),
+                    RuntimeException);
+                std::vector<std::string_view> gap = {frames[0], frames[2]};
+                CHECK_THROWS_AS(
+                    decode_delta_frames(gap, type, stored_dims),
+                    RuntimeException);
+                std::vector<std::string_view> mixed = {frames[4], frames[1]};
+                CHECK_THROWS_AS(
+                    decode_delta_frames(mixed, type, stored_dims),
+                    RuntimeException);
+            }
+        }
+
+        WHEN("The dimensions change")
+        {
+            bool keyframe;
+            encoder.encode(values, SRTensorTypeDouble, dims, keyframe);
+            std::vector<size_t> flat = {field.size()};
+            encoder.encode(values, SRTensorTypeDouble, flat, keyframe);
+
+            THEN("A keyframe is encoded")
+            {
+                CHECK(keyframe);
+            }
+        }
+    }
+    log_data(context, LLDebug, "***End tensor delta encoding testing***");
+}
@@ -0,0 +1,139 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "tensorfile.h"
+#include "srexception.h"
+#include "logger.h"
+
+unsigned long get_time_offset();
+
+using namespace SmartRedis;
+
+SCENARIO("Testing .npy headers and mapped files", "[TensorFile]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing .npy headers and mapped files" << std::endl;
+    std::string context("test_tensorfile");
+    log_data(context, LLDebug, "***Beginning tensor file testing***");
+
+    GIVEN("A .npy header built for a 3x4 float array")
+    {
+        std::string header = build_npy_header(SRTensorTypeFloat, {3, 4});
+
+        THEN("The header is aligned and parses back to the same array")
+        {
+            CHECK(header.size() % 64 == 0);
+            CHECK(header.back() == '\n');
+            CHECK(is_npy_file(header));
+
+            SRTensorType type = SRTensorTypeInvalid;
+            std::vector<size_t> dims;
+            bool fortran_order = true;
+            CHECK(parse_npy_header(header, type, dims, fortran_order) ==
+                  header.size());
+            CHECK(type == SRTensorTypeFloat);
+            CHECK(dims == std::vector<size_t>({3, 4}));
+            CHECK_FALSE(fortran_order);
+        }
+    }
+
+    AND_GIVEN("A header written in the style of numpy.save")
+    {
+        std::string dict = "{'descr': '<i8', 'fortran_order': True, "\
+                           "'shape': (5,), }";
+        std::string header("\x93NUMPY\x01\x00", 8);
+        size_t length = dict.size() + 1;
+        length += (64 - (10 + length) % 64) % 64;
+        dict.resize(length - 1, ' ');
+        dict += '\n';
+        header += (char)(length & 0xFF);
+        header += (char)(length >> 8);
+        header += dict;
+
+        THEN("The type, shape and order are read from it")
+        {
+            SRTensorType type = SRTensorTypeInvalid;
+            std::vector<size_t> dims;
+            bool fortran_order = false;
+            CHECK(parse_npy_header(header, type, dims, fortran_order) ==
+                  header.size());
+            CHECK(type == SRTensorTypeInt64);
+            CHECK(dims == std::vector<size_t>({5}));
+            CHECK(fortran_order);
+        }
+
+        AND_THEN("Unsupported or truncated headers are rejected")
+        {
+            SRTensorType type = SRTensorTypeInvalid;
+            std::vector<size_t> dims;
+            bool fortran_order = false;
+            std::string complex_header = header;
+            complex_header.replace(complex_header.find("<i8"), 3, "<c8");
+            CHECK_THROWS_AS(parse_npy_header(complex_header, type, dims,
+                                             fortran_order),
+                            RuntimeException);
+            CHECK_THROWS_AS(parse_npy_header(header.substr(0, 20), type,
+                                             dims, fortran_order),
+                            RuntimeException);
+            CHECK_FALSE(is_npy_file("not a .npy file"));
+        }
+    }
+
+    AND_GIVEN("A file created and mapped for writing")
+    {
+        std::string path = (std::filesystem::temp_directory_path() /
+                            "smartredis_test_tensorfile.bin").string();
+        std::vector<double> values = {1.5, -2.0, 3.25, 8.0};
+        {
+            MappedFile file(path, values.size() * sizeof(double));
+            CHECK(file.size() == values.size() * sizeof(double));
+            std::memcpy(file.data(), values.data(), file.size());
+            file.sync();
+        }
+
+        THEN("Mapping the file again for reading gives the same values")
+        {
+            MappedFile file(path);
+            REQUIRE(file.size() == values.size() * sizeof(double));
+            CHECK(std::memcmp(file.data(), values.data(), file.size()) == 0);
+        }
+
+        AND_THEN("A file that does not exist cannot be mapped")
+        {
+            CHECK_THROWS_AS(MappedFile(path + ".missing"), RuntimeException);
+        }
+        std::remove(path.c_str());
+    }
+    log_data(context, LLDebug, "***End tensor file testing***");
+}
@@ -0,0 +1,101 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2024, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "tensorrecords.h"
+#include "srexception.h"
+#include "logger.h"
+
+unsigned long get_time_offset();
+
+using namespace SmartRedis;
+
+SCENARIO("Testing records of appendable tensors", "[TensorRecords]")
+{
+    std::cout << std::to_string(get_time_offset()) << ": Testing records of appendable tensors" << std::endl;
+    std::string context("test_tensorrecords");
+    log_data(context, LLDebug, "***Beginning tensor record testing***");
+
+    GIVEN("Records of a time series of 2x3 fields")
+    {
+        std::vector<size_t> dims = {2, 3};
+        std::vector<std::string> encoded;
+        std::vector<float> expected;
+        for (int step = 0; step < 4; step++) {
+            std::vector<float> field(6);
+            for (size_t i = 0; i < field.size(); i++)
+                field[i] = 10.0f * step + i;
+            expected.insert(expected.end(), field.begin(), field.end());
+            std::string_view values((const char*)field.data(),
+                                    field.size() * sizeof(float));
+            SRCompressionCodec codec = step % 2 == 0 ?
+                SRCompressionNone : SRCompressionShuffleLZ;
+            encoded.push_back(encode_tensor_record(
+                values, SRTensorTypeFloat, dims, codec, 5));
+        }
+        std::vector<std::string_view> records(encoded.begin(),
+                                              encoded.end());
+
+        THEN("A window of records is joined along a leading dimension")
+        {
+            REQUIRE(is_tensor_record(records[0]));
+            std::vector<std::string_view> window(records.begin() + 1,
+                                                 records.begin() + 3);
+            SRTensorType type;
+            std::vector<size_t> joined_dims;
+            std::string values = join_tensor_records(window, type,
+                                                     joined_dims);
+            CHECK(type == SRTensorTypeFloat);
+            CHECK(joined_dims == std::vector<size_t>({2, 2, 3}));
+            REQUIRE(values.size() == 12 * sizeof(float));
+            CHECK(std::memcmp(values.data(), expected.data() + 6,
+                              values.size()) == 0);
+        }
+
+        AND_THEN("Records of another shape cannot be joined")
+        {
+            std::vector<float> other(3, 1.0f);
+            std::string mismatched = encode_tensor_record(
+                std::string_view((const char*)other.data(), 12),
+                SRTensorTypeFloat, {3}, SRCompressionNone, 5);
+            records.push_back(mismatched);
+            SRTensorType type;
+            std::vector<size_t> joined_dims;
+            CHECK_THROWS_AS(join_tensor_records(records, type, joined_dims),
+                            RuntimeException);
+            CHECK_THROWS_AS(join_tensor_records({}, type, joined_dims),
+                            RuntimeException);
+            CHECK_FALSE(is_tensor_record("not a record"));
+        }
+    }
+    log_data(context, LLDebug, "***End tensor record testing***");
+}
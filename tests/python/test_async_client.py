@@ -0,0 +1,158 @@
+# BSD 2-Clause License
+#
+# Copyright (c) 2021-2024, Hewlett Packard Enterprise
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import asyncio
+
+import numpy as np
+import pytest
+
+from smartredis import AsyncClient, Client, Dataset
+from smartredis.error import RedisReplyError
+
+# ----- Tests -----------------------------------------------------------
+
+
+def test_async_put_get_tensor(mock_data, context):
+    """Test that many tensors can be in flight concurrently"""
+
+    async def run():
+        async with AsyncClient(None, logger_name=context) as client:
+            data = mock_data.create_data((10, 10))
+            keys = [f"async_array_{i}" for i in range(len(data))]
+            await asyncio.gather(
+                *[client.put_tensor(k, d) for k, d in zip(keys, data)]
+            )
+            results = await asyncio.gather(*[client.get_tensor(k) for k in keys])
+            for array, result in zip(data, results):
+                np.testing.assert_array_equal(array, result)
+            assert all(
+                await asyncio.gather(*[client.tensor_exists(k) for k in keys])
+            )
+            await asyncio.gather(*[client.delete_tensor(k) for k in keys])
+            assert not any(
+                await asyncio.gather(*[client.tensor_exists(k) for k in keys])
+            )
+
+    asyncio.run(run())
+
+
+def test_async_put_get_dataset(context):
+    """Test dataset coroutines"""
+
+    async def run():
+        async with AsyncClient(None, logger_name=context) as client:
+            dataset = Dataset("async_dataset")
+            dataset.add_tensor("array", np.arange(16, dtype=np.float32))
+            await client.put_dataset(dataset)
+            assert await client.dataset_exists("async_dataset")
+            result = await client.get_dataset("async_dataset")
+            np.testing.assert_array_equal(
+                result.get_tensor("array"), np.arange(16, dtype=np.float32)
+            )
+            await client.delete_dataset("async_dataset")
+            assert not await client.dataset_exists("async_dataset")
+
+    asyncio.run(run())
+
+
+def test_async_errors(context):
+    """Test that errors are raised from the awaiting coroutine"""
+
+    async def run():
+        async with AsyncClient(None, logger_name=context) as client:
+            with pytest.raises(RedisReplyError):
+                await client.get_tensor("async_tensor_does_not_exist")
+
+    asyncio.run(run())
+
+    with pytest.raises(ValueError):
+        AsyncClient(None, logger_name=context, max_workers=0)
+
+
+def test_async_more_requests_than_workers(context):
+    """Test that requests beyond the number of workers are queued"""
+
+    async def run():
+        async with AsyncClient(None, logger_name=context, max_workers=2) as client:
+            arrays = [np.full((32, 32), i, dtype=np.float32) for i in range(50)]
+            keys = [f"async_queued_{i}" for i in range(len(arrays))]
+            await asyncio.gather(
+                *[client.put_tensor(k, a) for k, a in zip(keys, arrays)]
+            )
+            results = await asyncio.gather(*[client.get_tensor(k) for k in keys])
+            for array, result in zip(arrays, results):
+                np.testing.assert_array_equal(array, result)
+            await asyncio.gather(*[client.delete_tensor(k) for k in keys])
+
+    asyncio.run(run())
+
+
+def test_async_settings_apply_to_all_connections(context):
+    """Test that settings made through the client property reach every
+    connection"""
+
+    async def run():
+        async with AsyncClient(None, logger_name=context, max_workers=3) as client:
+            client.client.set_tensor_ttl(60000)
+            keys = [f"async_ttl_{i}" for i in range(9)]
+            await asyncio.gather(*[client.put_tensor(k, np.ones(4)) for k in keys])
+            for key in keys:
+                assert client.client.tensor_exists(key)
+            client.client.set_tensor_ttl(0)
+            await asyncio.gather(*[client.delete_tensor(k) for k in keys])
+
+    asyncio.run(run())
+
+
+def test_async_close_does_not_block_loop(context):
+    """Test that leaving the async context keeps the event loop running"""
+
+    async def run():
+        ticks = []
+
+        async def ticker():
+            while True:
+                ticks.append(None)
+                await asyncio.sleep(0.001)
+
+        task = asyncio.create_task(ticker())
+        async with AsyncClient(None, logger_name=context) as client:
+            puts = [
+                client.put_tensor(f"async_close_{i}", np.ones((256, 256)))
+                for i in range(20)
+            ]
+            pending = asyncio.gather(*puts)
+            # Let the puts be submitted before the AsyncClient closes
+            await asyncio.sleep(0)
+            ticks.clear()
+        await pending
+        task.cancel()
+        assert ticks
+        client = Client(None, logger_name=context)
+        for i in range(20):
+            client.delete_tensor(f"async_close_{i}")
+
+    asyncio.run(run())
@@ -26,9 +26,13 @@
 
 import numpy as np
 import os
+import pytest
+import threading
+import time
 
 
-from smartredis import Client
+from smartredis import Client, Dataset
+from smartredis.error import RedisReplyError
 
 # ----- Tests -----------------------------------------------------------
 
@@ -123,6 +127,318 @@ def test_3D_transpose_put_get(mock_data, context):
     send_get_arrays(client, modified)
 
 
+def test_unpack_tensor(mock_data, context):
+    """Test unpack_tensor into preallocated and strided arrays"""
+
+    client = Client(None, logger_name=context)
+    data = mock_data.create_data((4, 6))
+    for index, array in enumerate(data):
+        key = f"unpack_array_{index}"
+        client.put_tensor(key, array)
+
+        out = np.empty_like(array)
+        client.unpack_tensor(key, out)
+        np.testing.assert_array_equal(out, array)
+
+        # A non-contiguous destination is filled through its strides
+        strided = np.empty((6, 4), dtype=array.dtype).T
+        client.unpack_tensor(key, strided)
+        np.testing.assert_array_equal(strided, array)
+
+        with pytest.raises(RedisReplyError):
+            client.unpack_tensor(key, np.empty((6, 4), dtype=array.dtype))
+
+
+def test_put_strided_views(context):
+    """Test that strided views are stored with their logical layout"""
+
+    client = Client(None, logger_name=context)
+    array = np.arange(60, dtype=np.float64).reshape((3, 4, 5))
+    views = [array[:, ::2, 1:4], array[::-1, ...], array.transpose((2, 0, 1))]
+    for index, view in enumerate(views):
+        key = f"strided_view_{index}"
+        client.put_tensor(key, view)
+        np.testing.assert_array_equal(client.get_tensor(key), view)
+
+
+@pytest.mark.skipif(
+    not hasattr(np, "from_dlpack"), reason="requires numpy DLPack support"
+)
+def test_put_get_dlpack(context):
+    """Test DLPack import in put_tensor and unpack_tensor"""
+
+    class DLPackTensor:
+        """Minimal tensor exposing only the DLPack protocol"""
+
+        def __init__(self, array):
+            self._array = array
+
+        def __dlpack__(self, stream=None):
+            return self._array.__dlpack__()
+
+        def __dlpack_device__(self):
+            return self._array.__dlpack_device__()
+
+    client = Client(None, logger_name=context)
+    array = np.arange(12, dtype=np.int32).reshape((3, 4))
+    client.put_tensor("dlpack_tensor", DLPackTensor(array))
+    result = client.get_tensor("dlpack_tensor")
+    np.testing.assert_array_equal(result, array)
+    np.testing.assert_array_equal(np.from_dlpack(result), array)
+
+
+def test_put_get_bool(context):
+    """Test that boolean tensors round trip through the database"""
+    client = Client(None, logger_name=context)
+    data = np.random.rand(4, 5) > 0.5
+    client.put_tensor("bool_tensor", data)
+    result = client.get_tensor("bool_tensor")
+    assert result.dtype == np.bool_
+    np.testing.assert_array_equal(result, data)
+
+
+@pytest.mark.parametrize("dtype", [np.float16, np.uint32, np.uint64])
+def test_extended_dtypes_in_packed_dataset(context, dtype):
+    """Test that dtypes without a RedisAI equivalent round trip
+    through packed DataSets
+    """
+    client = Client(None, logger_name=context)
+    client.use_packed_datasets(True)
+    data = (np.random.rand(3, 4) * 100).astype(dtype)
+    dataset = Dataset(f"extended_dtype_{np.dtype(dtype).name}")
+    dataset.add_tensor("tensor", data)
+    client.put_dataset(dataset)
+    result = client.get_dataset(dataset.get_name()).get_tensor("tensor")
+    assert result.dtype == data.dtype
+    np.testing.assert_array_equal(result, data)
+
+
+def test_put_unpack_with_conversion(context):
+    """Test that tensors can be stored and unpacked with another dtype"""
+    client = Client(None, logger_name=context)
+    data = np.array([[0.5, 1.5, 2.25], [-3.0, 4.75, 10.0]])
+    client.put_tensor("converted_tensor", data.T, dtype=np.float32)
+    result = client.get_tensor("converted_tensor")
+    assert result.dtype == np.float32
+    np.testing.assert_array_equal(result, data.T.astype(np.float32))
+
+    out = np.empty((3, 2), dtype=np.int32)
+    client.unpack_tensor("converted_tensor", out, convert=True)
+    np.testing.assert_array_equal(out, np.rint(data.T).astype(np.int32))
+
+    with pytest.raises(RedisReplyError):
+        client.unpack_tensor("converted_tensor", out)
+    with pytest.raises(RedisReplyError):
+        client.put_tensor("converted_tensor", np.array([np.nan]), dtype=np.int8)
+
+
+def test_put_get_compressed(monkeypatch, context):
+    """Test that tensors stored compressed are read back transparently"""
+    monkeypatch.setenv("SR_COMPRESSION", "shuffle-lz")
+    client = Client(None, logger_name=context)
+    monkeypatch.delenv("SR_COMPRESSION")
+    plain_client = Client(None, logger_name=context)
+
+    data = np.sin(np.linspace(0, 10, 4096)).reshape(64, 64)
+    client.put_tensor("compressed_tensor", data)
+    np.testing.assert_array_equal(
+        plain_client.get_tensor("compressed_tensor"), data)
+    out = np.empty_like(data)
+    client.unpack_tensor("compressed_tensor", out)
+    np.testing.assert_array_equal(out, data)
+    client.delete_tensor("compressed_tensor")
+
+
+def test_put_get_quantized(monkeypatch, context):
+    """Test that lossy compression keeps values within the error bound"""
+    monkeypatch.setenv("SR_COMPRESSION", "quantize")
+    monkeypatch.setenv("SR_COMPRESSION_ERROR_BOUND", "1e-3")
+    client = Client(None, logger_name=context)
+
+    data = np.sin(np.linspace(0, 10, 4096)).astype(np.float32)
+    client.put_tensor("quantized_tensor", data)
+    result = client.get_tensor("quantized_tensor")
+    assert result.dtype == np.float32
+    assert np.max(np.abs(result - data)) <= 1e-3
+    client.delete_tensor("quantized_tensor")
+
+
+def test_put_tensor_delta(monkeypatch, context):
+    """Test that tensors put as deltas are reconstructed by readers"""
+    monkeypatch.setenv("SR_DELTA_KEYFRAME_INTERVAL", "3")
+    producer = Client(None, logger_name=context)
+    reader = Client(None, logger_name=context)
+
+    data = np.zeros((16, 16))
+    for step in range(7):
+        data[step, step] = step + 1.0
+        producer.put_tensor_delta("delta_tensor", data)
+        np.testing.assert_array_equal(reader.get_tensor("delta_tensor"), data)
+    producer.delete_tensor("delta_tensor")
+
+
+def test_put_get_chunked(monkeypatch, context):
+    """Test that tensors larger than the chunk size round trip"""
+    monkeypatch.setenv("SR_TENSOR_CHUNK_SIZE", "4096")
+    client = Client(None, logger_name=context)
+
+    data = np.arange(10000, dtype=np.float64).reshape(100, 100)
+    client.put_tensor("chunked_tensor", data)
+    np.testing.assert_array_equal(client.get_tensor("chunked_tensor"), data)
+    out = np.empty_like(data)
+    client.unpack_tensor("chunked_tensor", out)
+    np.testing.assert_array_equal(out, data)
+    client.delete_tensor("chunked_tensor")
+    assert not client.tensor_exists("chunked_tensor")
+
+
+def test_put_get_tiled(context):
+    """Test that sub-regions of a tiled tensor can be read"""
+    client = Client(None, logger_name=context)
+
+    data = np.arange(2400, dtype=np.int32).reshape(20, 12, 10)
+    client.put_tensor_tiled("tiled_tensor", data, (8, 5, 10))
+    out = np.empty((7, 4, 3), dtype=np.int32)
+    client.get_tensor_slice("tiled_tensor", (6, 3, 2), (7, 4, 3), out)
+    np.testing.assert_array_equal(out, data[6:13, 3:7, 2:5])
+    np.testing.assert_array_equal(client.get_tensor("tiled_tensor"), data)
+
+    # Regions outside the tensor are rejected
+    with pytest.raises(RedisReplyError):
+        client.get_tensor_slice("tiled_tensor", (15, 0, 0), (7, 4, 3), out)
+    client.delete_tensor("tiled_tensor")
+    assert not client.tensor_exists("tiled_tensor")
+
+
+def test_append_to_tensor(context):
+    """Test that records appended to a tensor can be read in windows"""
+    client = Client(None, logger_name=context)
+    if client.tensor_exists("appended_tensor"):
+        client.delete_tensor("appended_tensor")
+
+    steps = [np.full((3, 2), step, dtype=np.float32) for step in range(6)]
+    for step in steps:
+        client.append_to_tensor("appended_tensor", step)
+    np.testing.assert_array_equal(
+        client.get_tensor_range("appended_tensor", 2, 5), np.stack(steps[2:5])
+    )
+    np.testing.assert_array_equal(
+        client.get_tensor("appended_tensor"), np.stack(steps)
+    )
+    client.delete_tensor("appended_tensor")
+
+
+def test_tensor_file_transfer(context, tmp_path):
+    """Test that tensors can be put from and retrieved into files"""
+    client = Client(None, logger_name=context)
+    array = np.arange(24, dtype=np.float64).reshape(2, 3, 4)
+
+    raw_path = tmp_path / "tensor.raw"
+    raw_path.write_bytes(b"header" + array.tobytes())
+    client.put_tensor_from_file(
+        "file_tensor", raw_path, shape=(2, 3, 4), dtype=np.float64, offset=6
+    )
+    np.testing.assert_array_equal(client.get_tensor("file_tensor"), array)
+
+    npy_path = tmp_path / "tensor.npy"
+    client.unpack_tensor_to_file("file_tensor", npy_path)
+    np.testing.assert_array_equal(np.load(npy_path), array)
+
+    np.save(npy_path, np.asfortranarray(array))
+    client.put_tensor_from_file("file_tensor", npy_path)
+    np.testing.assert_array_equal(client.get_tensor("file_tensor"), array)
+    client.delete_tensor("file_tensor")
+
+
+def test_threaded_put_get(mock_data, context):
+    """Test that one client can be shared by concurrent Python threads"""
+
+    client = Client(None, logger_name=context)
+    data = mock_data.create_data((10, 10))
+    errors = []
+
+    def worker(offset):
+        try:
+            for index, array in enumerate(data):
+                key = f"threaded_array_{offset}_{index}"
+                client.put_tensor(key, array)
+                np.testing.assert_array_equal(client.get_tensor(key), array)
+        except Exception as exc:
+            errors.append(exc)
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert not errors
+
+
+def test_threaded_put_get_throughput(context):
+    """Benchmark put/get throughput of Python threads with a Client each"""
+
+    array = np.random.rand(64, 1024)
+    n_ops = 100
+
+    def worker(offset, client, errors):
+        try:
+            for index in range(n_ops):
+                key = f"throughput_array_{offset}_{index % 10}"
+                client.put_tensor(key, array)
+                client.get_tensor(key)
+        except Exception as exc:
+            errors.append(exc)
+
+    rates = {}
+    for n_threads in (1, 4):
+        clients = [Client(None, logger_name=context) for _ in range(n_threads)]
+        errors = []
+        threads = [
+            threading.Thread(target=worker, args=(i, clients[i], errors))
+            for i in range(n_threads)
+        ]
+        start = time.perf_counter()
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        elapsed = time.perf_counter() - start
+        assert not errors
+        rates[n_threads] = n_threads * n_ops / elapsed
+        print(f"{n_threads} thread(s): {rates[n_threads]:.1f} put/get pairs/s")
+
+    # Throughput depends on the machine, so it is reported, not asserted
+    assert all(rate > 0 for rate in rates.values())
+
+
+def test_gil_released_while_polling(context):
+    """Test that other threads run while a thread waits on the database"""
+
+    poller = Client(None, logger_name=context)
+    client = Client(None, logger_name=context)
+    key = "gil_release_poll_tensor"
+    if client.tensor_exists(key):
+        client.delete_tensor(key)
+
+    polling = threading.Event()
+    result = {}
+
+    def poll():
+        polling.set()
+        result["found"] = poller.poll_tensor(key, 50, 40)
+
+    thread = threading.Thread(target=poll)
+    thread.start()
+    polling.wait()
+
+    # If the polling thread held the GIL, this could not run until
+    # polling had given up
+    time.sleep(0.2)
+    client.put_tensor(key, np.ones(4))
+    thread.join()
+    assert result["found"]
+
+
 # ------- Helper Functions -----------------------------------------------
 
 